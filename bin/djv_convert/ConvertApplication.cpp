@@ -40,6 +40,8 @@
 #include <QDir>
 #include <QTimer>
 
+#include <vector>
+
 namespace djv
 {
     namespace convert
@@ -289,9 +291,11 @@ namespace djv
             {
                 try
                 {
-                    save->write(
-                        slate,
-                        Graphics::ImageIOFrameInfo(saveInfo.sequence.frames.first()));
+                    const Graphics::ImageIOFrameInfo frameInfo(saveInfo.sequence.frames.first());
+                    if (!save->hasFrame(frameInfo))
+                    {
+                        save->write(slate, frameInfo);
+                    }
                     saveInfo.sequence.frames.pop_front();
                 }
                 catch (Core::Error error)
@@ -306,11 +310,34 @@ namespace djv
                 }
             }
             const qint64 length = static_cast<qint64>(saveInfo.sequence.frames.count());
+
+            // Skip the frames that were already written by an interrupted
+            // conversion.
+            std::vector<bool> written(length ? length : 1, false);
+            qint64 writtenCount = 0;
+            for (size_t i = 0; i < written.size(); ++i)
+            {
+                written[i] = save->hasFrame(Graphics::ImageIOFrameInfo(
+                    length ? saveInfo.sequence.frames[i] : -1));
+                if (written[i])
+                {
+                    ++writtenCount;
+                }
+            }
+            if (writtenCount)
+            {
+                _context->print(qApp->translate("djv::convert::Application", "Resuming, %1 frames already written").
+                    arg(writtenCount));
+            }
+
             float    progressAccum = 0.f;
             Core::Timer progressTimer;
             progressTimer.start();
             for (qint64 i = 0; i < length; ++i)
             {
+                if (written[i])
+                    continue;
+
                 Core::Timer frameTimer;
                 frameTimer.start();
 
@@ -31,22 +31,42 @@
 
 #include <djv_info/InfoContext.h>
 
+#include <djvGraphics/Image.h>
 #include <djvGraphics/ImageIO.h>
+#include <djvGraphics/PixelDataUtil.h>
 
 #include <djvCore/DebugLog.h>
+#include <djvCore/ErrorUtil.h>
 #include <djvCore/FileInfoUtil.h>
 #include <djvCore/Time.h>
+#include <djvCore/Timer.h>
 #include <djvCore/VectorUtil.h>
 
 #include <QDir>
+#include <QJsonArray>
+#include <QJsonDocument>
 #include <QTimer>
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
 namespace djv
 {
     namespace info
     {
+        namespace
+        {
+            //! The number of directory items to probe at a time.
+            const int probeBatchSize = 1000;
+
+        } // namespace
+
         Application::Application(int & argc, char ** argv) :
-            QGuiApplication(argc, argv),
+            QCoreApplication(argc, argv),
             _context(0)
         {
             //DJV_DEBUG("Application::Application");
@@ -126,50 +146,134 @@ namespace djv
                 list += Core::FileInfo(".");
             }
 
-            // Print the files.
-            for (int i = 0; i < list.count(); ++i)
+            // Print the files. Consecutive files are probed together.
+            Core::FileInfoList items;
+            for (int i = 0; i < list.count() && !isVerifyStopped(); ++i)
             {
                 if (Core::FileInfo::DIRECTORY == list[i].type())
                 {
+                    if (!printItems(items))
+                    {
+                        r = 1;
+                    }
+                    items.clear();
                     printDirectory(
                         list[i],
                         ((list.count() > 1) || _context->hasRecurse()) && !_context->hasFilePath());
                 }
                 else
                 {
-                    try
-                    {
-                        printItem(list[i], _context->hasFilePath(), _context->hasInfo());
-                    }
-                    catch (const Core::Error & error)
-                    {
-                        _context->printError(error);
-                        r = 1;
-                    }
+                    items += list[i];
                 }
             }
+            if (!printItems(items))
+            {
+                r = 1;
+            }
+            if (_verifyError)
+            {
+                r = 1;
+            }
 
             exit(r);
         }
 
-        void Application::printItem(const Core::FileInfo & in, bool path, bool info)
+        bool Application::printItems(const Core::FileInfoList & in)
+        {
+            //DJV_DEBUG("Application::printItems");
+            //DJV_DEBUG_PRINT("in = " << in);
+            bool out = true;
+            const QVector<Graphics::ImageIOProbe> probes = _context->imageIOFactory()->probe(in, _context->threads());
+            Q_FOREACH(const Graphics::ImageIOProbe & probe, probes)
+            {
+                if (isVerifyStopped())
+                    break;
+                if (probe.valid)
+                {
+                    printItem(probe.fileInfo, probe.info, _context->hasFilePath(), _context->hasInfo());
+                }
+                else
+                {
+                    printError(probe);
+                    out = false;
+                }
+            }
+            return out;
+        }
+
+        void Application::printError(const Graphics::ImageIOProbe & probe)
+        {
+            //DJV_DEBUG("Application::printError");
+            //DJV_DEBUG_PRINT("file = " << probe.fileInfo);
+
+            // A file that cannot be opened is a verify failure.
+            if (_context->hasVerify())
+            {
+                _verifyError = true;
+            }
+
+            Core::Error error(probe.error);
+            error.add(
+                qApp->translate("djv::info::Application", "Cannot open image: \"%1\"").
+                arg(QDir::toNativeSeparators(probe.fileInfo)));
+            if (_context->hasJSON())
+            {
+                QJsonObject object;
+                object["file"] = QDir::toNativeSeparators(probe.fileInfo.fileName(-1, true));
+                object["error"] = QJsonArray::fromStringList(Core::ErrorUtil::format(error));
+                printJSON(object);
+            }
+            else
+            {
+                _context->printError(error);
+            }
+        }
+
+        void Application::printItem(const Core::FileInfo & in, const Graphics::ImageIOInfo & _info, bool path, bool info)
         {
             //DJV_DEBUG("Application::printItem");
             //DJV_DEBUG_PRINT("in = " << in);
 
-            // Open the file.
-            Graphics::ImageIOInfo _info;
-            QScopedPointer<Graphics::ImageLoad> load;
-            try
+            if (_context->hasVerify())
             {
-                load.reset(_context->imageIOFactory()->load(in, _info));
+                verifyItem(in, _info, path);
+                return;
             }
-            catch (Core::Error error)
+
+            if (_context->hasJSON())
             {
-                error.add(
-                    qApp->translate("djv::info::Application", "Cannot open image: \"%1\"").
-                    arg(QDir::toNativeSeparators(in)));
-                throw error;
+                QJsonObject object;
+                object["file"] = QDir::toNativeSeparators(in.fileName(-1, true));
+                if (info)
+                {
+                    QJsonArray layers;
+                    for (int i = 0; i < _info.layerCount(); ++i)
+                    {
+                        QStringList pixelLabel;
+                        pixelLabel << _info[i].pixel;
+                        QJsonObject layer;
+                        layer["name"] = _info[i].layerName;
+                        layer["width"] = _info[i].size.x;
+                        layer["height"] = _info[i].size.y;
+                        layer["aspect"] = Core::VectorUtil::aspect(_info[i].size);
+                        layer["pixel"] = pixelLabel.join(", ");
+                        layers.append(layer);
+                    }
+                    object["layers"] = layers;
+                    object["start"] = static_cast<double>(_info.sequence.start());
+                    object["end"] = static_cast<double>(_info.sequence.end());
+                    object["frames"] = _info.sequence.frames.count();
+                    object["speed"] = Core::Speed::speedToFloat(_info.sequence.speed);
+                    QJsonObject tags;
+                    const QStringList keys = _info.tags.keys();
+                    for (int i = 0; i < keys.count(); ++i)
+                    {
+                        tags[keys[i]] = _info.tags[keys[i]];
+                    }
+                    object["tags"] = tags;
+                }
+                printJSON(object);
+                return;
             }
 
             // Print the file.
@@ -283,51 +387,286 @@ namespace djv
             //DJV_DEBUG("Application::printDirectory");
             //DJV_DEBUG_PRINT("in = " << in);
 
-            // Read the directory contents.
-            Core::FileInfoList items;
-            items = Core::FileInfoUtil::list(in, Core::Sequence::format());
+            // Read the directory contents in parallel.
+            Core::DirectoryWalk walk;
+            walk.setSequenceFormat(Core::Sequence::format());
+            walk.setRecurse(_context->hasRecurse());
+            walk.setThreads(_context->threads());
+            walk.setProcessCallback([](Core::DirectoryWalk::Directory & directory)
+            {
+                Core::FileInfoUtil::filter(directory.items, Core::FileInfoUtil::FILTER_DIRECTORIES);
+            });
 
-            // Process the items.
-            Core::FileInfoUtil::filter(items, Core::FileInfoUtil::FILTER_DIRECTORIES);
+            // Small directories are batched together so the images can be
+            // probed in parallel while the walk continues.
+            QVector<Core::DirectoryWalk::Directory> batch;
+            int batchItems = 0;
+            walk.walk(
+                Core::FileInfoList() << in,
+                [this, label, &batch, &batchItems](const Core::DirectoryWalk::Directory & directory)
+            {
+                if (isVerifyStopped())
+                    return;
+                batch += directory;
+                batchItems += directory.items.count();
+                if (batchItems >= probeBatchSize)
+                {
+                    printDirectories(batch, label);
+                    batch.clear();
+                    batchItems = 0;
+                }
+            });
+            printDirectories(batch, label);
+        }
 
-            // Print the items.
-            if (label)
+        void Application::printDirectories(const QVector<Core::DirectoryWalk::Directory> & in, bool label)
+        {
+            //DJV_DEBUG("Application::printDirectories");
+            if (isVerifyStopped())
+                return;
+            Core::FileInfoList items;
+            Q_FOREACH(const Core::DirectoryWalk::Directory & directory, in)
+            {
+                items += directory.items;
+            }
+            const QVector<Graphics::ImageIOProbe> probes = _context->imageIOFactory()->probe(items, _context->threads());
+            const bool text = !_context->hasJSON();
+            int index = 0;
+            Q_FOREACH(const Core::DirectoryWalk::Directory & directory, in)
             {
-                _context->print(qApp->translate("djv::info::Application", "%1:").
-                    arg(QDir::toNativeSeparators(in)));
-                if (_context->hasVerbose())
+                if (label && text)
+                {
+                    _context->print(qApp->translate("djv::info::Application", "%1:").
+                        arg(QDir::toNativeSeparators(directory.fileInfo)));
+                    if (_context->hasVerbose())
+                    {
+                        _context->printSeparator();
+                    }
+                }
+                for (int i = 0; i < directory.items.count() && !isVerifyStopped(); ++i, ++index)
+                {
+                    if (probes[index].valid)
+                    {
+                        printItem(probes[index].fileInfo, probes[index].info, _context->hasFilePath(), _context->hasInfo());
+                    }
+                    else if (_context->hasVerify() &&
+                        _context->imageIOFactory()->isExtension(probes[index].fileInfo))
+                    {
+                        // Other files in the directory are skipped, but images
+                        // that cannot be opened are verify failures.
+                        printError(probes[index]);
+                    }
+                }
+                if (label && text)
                 {
                     _context->printSeparator();
                 }
             }
-            for (int i = 0; i < items.count(); ++i)
+        }
+
+        void Application::printJSON(const QJsonObject & in)
+        {
+            _context->print(QString::fromUtf8(QJsonDocument(in).toJson(QJsonDocument::Compact)));
+        }
+
+        void Application::verifyItem(const Core::FileInfo & in, const Graphics::ImageIOInfo & info, bool path)
+        {
+            //DJV_DEBUG("Application::verifyItem");
+            //DJV_DEBUG_PRINT("in = " << in);
+            const bool stop = _context->hasVerifyStop();
+            if (isVerifyStopped())
+                return;
+
+            // Find the frames missing from the sequence.
+            QVector<qint64> frames = info.sequence.frames;
+            std::sort(frames.begin(), frames.end());
+            Core::Sequence missing;
+            missing.pad = info.sequence.pad;
+            if (Core::FileInfo::SEQUENCE == in.type())
             {
-                try
+                for (int i = 1; i < frames.count(); ++i)
                 {
-                    printItem(items[i], _context->hasFilePath(), _context->hasInfo());
+                    for (qint64 frame = frames[i - 1] + 1; frame < frames[i]; ++frame)
+                    {
+                        missing.frames += frame;
+                    }
                 }
-                catch (const Core::Error &)
+            }
+            if (frames.isEmpty())
+            {
+                frames += -1;
+            }
+
+            // Decode the frames. Each thread has its own loader and takes the
+            // next frame until they are all done. Movies are decoded by a single
+            // thread since they are read sequentially.
+            const int count = frames.count();
+            int threads = _context->threads() > 0 ?
+                _context->threads() :
+                std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+            if (in.type() != Core::FileInfo::SEQUENCE)
+            {
+                threads = 1;
+            }
+            threads = std::min(threads, count);
+            QVector<Core::Error> errors(count);
+            QVector<bool> errorsValid(count, false);
+            std::atomic<int> next(0);
+            std::atomic<bool> cancel(false);
+            std::atomic<quint64> byteCount(0);
+            std::atomic<int> frameCount(0);
+            Core::Error * errorsData = errors.data();
+            bool * errorsValidData = errorsValid.data();
+            Graphics::ImageIOFactory * imageIOFactory = _context->imageIOFactory();
+
+            // Open the image once and give the other threads clones of the
+            // loader. Loaders that cannot be cloned open the image again in
+            // each thread.
+            std::vector<std::unique_ptr<Graphics::ImageLoad> > loads(threads);
+            try
+            {
+                Graphics::ImageIOInfo tmp;
+                loads[0].reset(imageIOFactory->load(in, tmp));
+                for (int i = 1; i < threads; ++i)
                 {
+                    loads[i].reset(loads[0]->clone());
                 }
             }
-            if (label)
+            catch (const Core::Error &)
+            {}
+            auto work = [in, stop, count, imageIOFactory, &frames, &next, &cancel, &byteCount, &frameCount, errorsData, errorsValidData]
+                (std::unique_ptr<Graphics::ImageLoad> & load)
             {
-                _context->printSeparator();
+                int i = next++;
+                while (i < count && !cancel)
+                {
+                    try
+                    {
+                        if (!load)
+                        {
+                            Graphics::ImageIOInfo tmp;
+                            load.reset(imageIOFactory->load(in, tmp));
+                        }
+                        Graphics::Image image;
+                        load->read(image, Graphics::ImageIOFrameInfo(frames[i]));
+                        byteCount += Graphics::PixelDataUtil::dataByteCount(image.info());
+                        ++frameCount;
+                    }
+                    catch (const Core::Error & error)
+                    {
+                        errorsData[i] = error;
+                        errorsValidData[i] = true;
+                        if (stop)
+                        {
+                            cancel = true;
+                        }
+                    }
+                    catch (const std::exception & error)
+                    {
+                        errorsData[i] = Core::Error("djv_info", error.what());
+                        errorsValidData[i] = true;
+                        if (stop)
+                        {
+                            cancel = true;
+                        }
+                    }
+                    i = next++;
+                }
+            };
+            Core::Timer timer;
+            std::vector<std::thread> workers;
+            for (int i = 1; i < threads; ++i)
+            {
+                workers.push_back(std::thread(work, std::ref(loads[i])));
+            }
+            work(loads[0]);
+            for (auto & worker : workers)
+            {
+                worker.join();
+            }
+            timer.check();
+            const float seconds = timer.seconds();
+            const float fps = seconds > 0.f ? frameCount / seconds : 0.f;
+            const float megabytes = byteCount / 1024.f / 1024.f;
+            const float megabytesPerSecond = seconds > 0.f ? megabytes / seconds : 0.f;
+            int errorCount = 0;
+            for (int i = 0; i < count; ++i)
+            {
+                if (errorsValid[i])
+                {
+                    ++errorCount;
+                }
+            }
+            if (errorCount || missing.frames.count())
+            {
+                _verifyError = true;
             }
 
-            // Recurse.
-            if (_context->hasRecurse())
+            // Print the results.
+            if (_context->hasJSON())
             {
-                Core::FileInfoList list = Core::FileInfoUtil::list(in, Core::Sequence::format());
-                Core::FileInfoUtil::filter(
-                    list,
-                    Core::FileInfoUtil::FILTER_FILES | Core::FileInfoUtil::FILTER_HIDDEN);
-                for (int i = 0; i < list.count(); ++i)
+                QJsonObject object;
+                object["file"] = QDir::toNativeSeparators(in.fileName(-1, true));
+                object["frames"] = frameCount.load();
+                object["seconds"] = seconds;
+                object["fps"] = fps;
+                object["bytes"] = static_cast<double>(byteCount.load());
+                QJsonArray missingArray;
+                Q_FOREACH(qint64 frame, missing.frames)
                 {
-                    printDirectory(list[i], label);
+                    missingArray.append(static_cast<double>(frame));
+                }
+                object["missing"] = missingArray;
+                QJsonArray errorsArray;
+                for (int i = 0; i < count; ++i)
+                {
+                    if (errorsValid[i])
+                    {
+                        QJsonObject error;
+                        error["frame"] = static_cast<double>(frames[i]);
+                        error["error"] = QJsonArray::fromStringList(Core::ErrorUtil::format(errors[i]));
+                        errorsArray.append(error);
+                    }
+                }
+                object["errors"] = errorsArray;
+                printJSON(object);
+            }
+            else
+            {
+                const QString name = in.fileName(-1, path);
+                const QString str = qApp->translate("djv::info::Application",
+                    "%1 frames, %2 errors, %3 missing, %4 seconds, %5 fps, %6 MB/s").
+                    arg(frameCount.load()).
+                    arg(errorCount).
+                    arg(missing.frames.count()).
+                    arg(seconds, 0, 'f', 2).
+                    arg(fps, 0, 'f', 2).
+                    arg(megabytesPerSecond, 0, 'f', 2);
+                const int columns = _context->columns();
+                _context->print(qApp->translate("djv::info::Application", "%1 %2").
+                    arg(QDir::toNativeSeparators(name)).
+                    arg(str, columns - name.length() - 2));
+                if (missing.frames.count())
+                {
+                    _context->print(qApp->translate("djv::info::Application", "    Missing frames: %1").
+                        arg(Core::Sequence::sequenceToString(missing)));
+                }
+                for (int i = 0; i < count; ++i)
+                {
+                    if (errorsValid[i])
+                    {
+                        _context->print(qApp->translate("djv::info::Application", "    Frame %1: %2").
+                            arg(frames[i]).
+                            arg(Core::ErrorUtil::format(errors[i]).join(" ")));
+                    }
                 }
             }
         }
 
+        bool Application::isVerifyStopped() const
+        {
+            return _context->hasVerifyStop() && _verifyError;
+        }
+
     } // namespace info
 } // namespace djv
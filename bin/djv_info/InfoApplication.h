@@ -29,10 +29,14 @@
 
 #pragma once
 
+#include <djvGraphics/ImageIO.h>
+
+#include <djvCore/DirectoryWalk.h>
 #include <djvCore/Error.h>
 #include <djvCore/FileInfo.h>
 
-#include <QGuiApplication>
+#include <QCoreApplication>
+#include <QJsonObject>
 
 namespace djv
 {
@@ -42,7 +46,7 @@ namespace djv
 
         //! This program provides a command line tool for displaying information about
         //! images and movies.
-        class Application : public QGuiApplication
+        class Application : public QCoreApplication
         {
             Q_OBJECT
 
@@ -55,10 +59,17 @@ namespace djv
             void work();
 
         private:
-            void printItem(const Core::FileInfo &, bool path = false, bool info = true);
+            bool printItems(const Core::FileInfoList &);
+            void printItem(const Core::FileInfo &, const Graphics::ImageIOInfo &, bool path, bool info);
+            void printError(const Graphics::ImageIOProbe &);
             void printDirectory(const Core::FileInfo &, bool label);
+            void printDirectories(const QVector<Core::DirectoryWalk::Directory> &, bool label);
+            void printJSON(const QJsonObject &);
+            void verifyItem(const Core::FileInfo &, const Graphics::ImageIOInfo &, bool path);
+            bool isVerifyStopped() const;
 
-            Context * _context = nullptr;
+            Context * _context     = nullptr;
+            bool      _verifyError = false;
         };
 
     } // namespace info
@@ -38,7 +38,7 @@ namespace djv
     namespace info
     {
         Context::Context(int & argc, char ** argv, QObject * parent) :
-            Graphics::GraphicsContext(argc, argv, parent),
+            Graphics::GraphicsContext(argc, argv, Graphics::GraphicsContext::OPENGL_INIT_DEFERRED, parent),
             _columns(Core::System::terminalWidth())
         {
             //DJV_DEBUG("Context::Context");
@@ -82,6 +82,26 @@ namespace djv
             return _columns;
         }
 
+        bool Context::hasJSON() const
+        {
+            return _json;
+        }
+
+        int Context::threads() const
+        {
+            return _threads;
+        }
+
+        bool Context::hasVerify() const
+        {
+            return _verify;
+        }
+
+        bool Context::hasVerifyStop() const
+        {
+            return _verifyStop;
+        }
+
         bool Context::commandLineParse(QStringList & in)
         {
             //DJV_DEBUG("Context::commandLineParse");
@@ -128,6 +148,27 @@ namespace djv
                     {
                         in >> _columns;
                     }
+                    else if (
+                        qApp->translate("djv::info::Context", "-json") == arg)
+                    {
+                        _json = true;
+                    }
+                    else if (
+                        qApp->translate("djv::info::Context", "-threads") == arg)
+                    {
+                        in >> _threads;
+                    }
+                    else if (
+                        qApp->translate("djv::info::Context", "-verify") == arg)
+                    {
+                        _verify = true;
+                    }
+                    else if (
+                        qApp->translate("djv::info::Context", "-verify_stop") == arg)
+                    {
+                        _verify = true;
+                        _verifyStop = true;
+                    }
 
                     // Parse the arguments.
                     else
@@ -189,6 +230,16 @@ namespace djv
                 "    -columns, -c (value)\n"
                 "        Set the number of columns used to format the output. "
                 "Setting this value to zero disables formatting.\n"
+                "    -json\n"
+                "        Output one JSON object per line instead of formatted text.\n"
+                "    -threads (value)\n"
+                "        Set the number of threads used to read directories and images. "
+                "Setting this value to zero uses the number of hardware threads.\n"
+                "    -verify\n"
+                "        Decode every frame to find missing, truncated, or corrupt frames. "
+                "The decode time and throughput are also shown.\n"
+                "    -verify_stop\n"
+                "        Verify and stop at the first error.\n"
                 "%1"
                 "\n"
                 "Examples\n"
@@ -200,7 +251,10 @@ namespace djv
                 "    > djv_info image.1-100.sgi\n"
                 "\n"
                 "    Display information about all images within a directory:\n"
-                "    > djv_info ~/pics\n");
+                "    > djv_info ~/pics\n"
+                "\n"
+                "    Verify all of the image sequences within a directory tree:\n"
+                "    > djv_info ~/renders -recurse -verify\n");
             return QString(label).
                 arg(Graphics::GraphicsContext::commandLineHelp());
         }
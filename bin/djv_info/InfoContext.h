@@ -62,6 +62,18 @@ namespace djv
             //! Get the number of columns for formatting the output.
             int columns() const;
 
+            //! Get whether to output JSON Lines.
+            bool hasJSON() const;
+
+            //! Get the number of threads, zero uses the number of hardware threads.
+            int threads() const;
+
+            //! Get whether to verify images by decoding every frame.
+            bool hasVerify() const;
+
+            //! Get whether to stop verifying at the first error.
+            bool hasVerifyStop() const;
+
         protected:
             bool commandLineParse(QStringList &) override;
             QString commandLineHelp() const override;
@@ -73,6 +85,10 @@ namespace djv
             bool        _filePath = false;
             bool        _recurse  = false;
             int         _columns  = 0;
+            bool        _json     = false;
+            int         _threads  = 0;
+            bool        _verify     = false;
+            bool        _verifyStop = false;
         };
 
     } // namespace info
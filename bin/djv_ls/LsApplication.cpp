@@ -32,11 +32,14 @@
 #include <djv_ls/LsContext.h>
 
 #include <djvCore/DebugLog.h>
+#include <djvCore/DirectoryWalk.h>
 #include <djvCore/Math.h>
 #include <djvCore/Memory.h>
 #include <djvCore/Time.h>
 
 #include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QTimer>
 
 namespace djv
@@ -44,7 +47,7 @@ namespace djv
     namespace ls
     {
         Application::Application(int & argc, char ** argv) :
-            QGuiApplication(argc, argv),
+            QCoreApplication(argc, argv),
             _context(0)
         {
             //DJV_DEBUG("Application::Application");
@@ -191,6 +194,24 @@ namespace djv
             //DJV_DEBUG_PRINT("info = " << info);
             //DJV_DEBUG_PRINT("columns = " << _columns);
 
+            if (_context->hasJSON())
+            {
+                QJsonObject object;
+                object["file"] = QDir::toNativeSeparators(in.fileName(-1, true));
+                if (info)
+                {
+                    object["type"] = Core::FileInfo::typeLabels()[in.type()];
+                    object["size"] = static_cast<double>(in.size());
+#if ! defined(DJV_WINDOWS)
+                    object["user"] = Core::User::uidToString(in.user());
+#endif // DJV_WINDOWS
+                    object["permissions"] = Core::FileInfo::permissionsLabel(in.permissions());
+                    object["time"] = Core::Time::timeToString(in.time());
+                }
+                _context->print(QString::fromUtf8(QJsonDocument(object).toJson(QJsonDocument::Compact)));
+                return;
+            }
+
             QString name = in.fileName(-1, path);
 
             if (info)
@@ -244,44 +265,43 @@ namespace djv
             //DJV_DEBUG("Application::printDirectory");
             //DJV_DEBUG_PRINT("in = " << in);
 
-            // Read the directory contents.
-            if (!QDir(in.path()).exists())
-                return false;
-            Core::FileInfoList items = Core::FileInfoUtil::list(in, Core::Sequence::format());
-
-            // Process the items.
-            process(items);
-
-            // Print the items.
-            if (label)
-            {
-                _context->print(qApp->translate("djv::ls::Application", "%1:").
-                    arg(QDir::toNativeSeparators(in)));
-            }
-            for (int i = 0; i < items.count(); ++i)
+            // Read and process the directory contents in parallel.
+            Core::DirectoryWalk walk;
+            walk.setSequenceFormat(Core::Sequence::format());
+            walk.setRecurse(_context->hasRecurse());
+            walk.setHidden(_context->hasHidden());
+            walk.setThreads(_context->threads());
+            walk.setProcessCallback([this](Core::DirectoryWalk::Directory & directory)
             {
-                printItem(items[i], _context->hasFilePath(), _context->hasFileInfo());
-            }
-            if (label)
-            {
-                _context->printSeparator();
-            }
+                process(directory.items);
+            });
 
-            // Recurse.
+            // Print the items.
             bool r = true;
-            if (_context->hasRecurse())
+            const bool text = !_context->hasJSON();
+            walk.walk(
+                Core::FileInfoList() << in,
+                [this, label, text, &r](const Core::DirectoryWalk::Directory & directory)
             {
-                Core::FileInfoList items = Core::FileInfoUtil::list(in, Core::Sequence::format());
-                Core::FileInfoUtil::filter(
-                    items,
-                    Core::FileInfoUtil::FILTER_FILES |
-                    (!_context->hasHidden() ? Core::FileInfoUtil::FILTER_HIDDEN : 0));
-                for (int i = 0; i < items.count(); ++i)
+                if (!directory.valid)
                 {
-                    r &= printDirectory(items[i], label);
+                    r = false;
+                    return;
                 }
-            }
-
+                if (label && text)
+                {
+                    _context->print(qApp->translate("djv::ls::Application", "%1:").
+                        arg(QDir::toNativeSeparators(directory.fileInfo)));
+                }
+                for (int i = 0; i < directory.items.count(); ++i)
+                {
+                    printItem(directory.items[i], _context->hasFilePath(), _context->hasFileInfo());
+                }
+                if (label && text)
+                {
+                    _context->printSeparator();
+                }
+            });
             return r;
         }
 
@@ -31,7 +31,7 @@
 
 #include <djvCore/FileInfo.h>
 
-#include <QGuiApplication>
+#include <QCoreApplication>
 
 namespace djv
 {
@@ -41,7 +41,7 @@ namespace djv
 
         //! This program provides a command line tool for listing directories with file
         //! sequences.
-        class Application : public QGuiApplication
+        class Application : public QCoreApplication
         {
             Q_OBJECT
 
@@ -38,7 +38,7 @@ namespace djv
     namespace ls
     {
         Context::Context(int & argc, char ** argv, QObject * parent) :
-            Graphics::GraphicsContext(argc, argv, parent),
+            Graphics::GraphicsContext(argc, argv, Graphics::GraphicsContext::OPENGL_INIT_DEFERRED, parent),
             _columns(Core::System::terminalWidth())
         {
             //DJV_DEBUG("Context::Context");
@@ -87,6 +87,16 @@ namespace djv
             return _columns;
         }
 
+        bool Context::hasJSON() const
+        {
+            return _json;
+        }
+
+        int Context::threads() const
+        {
+            return _threads;
+        }
+
         Core::FileInfoUtil::SORT Context::sort() const
         {
             return _sort;
@@ -148,6 +158,16 @@ namespace djv
                     {
                         in >> _columns;
                     }
+                    else if (
+                        qApp->translate("djv::ls::Context", "-json") == arg)
+                    {
+                        _json = true;
+                    }
+                    else if (
+                        qApp->translate("djv::ls::Context", "-threads") == arg)
+                    {
+                        in >> _threads;
+                    }
 
                     // Parse the sorting options.
                     else if (
@@ -221,6 +241,11 @@ namespace djv
                 "    -columns, -c (value)\n"
                 "        Set the number of columns used to format the output. "
                 "Setting this value to zero disables formatting.\n"
+                "    -json\n"
+                "        Output one JSON object per line instead of formatted text.\n"
+                "    -threads (value)\n"
+                "        Set the number of threads used to read directories. "
+                "Setting this value to zero uses the number of hardware threads.\n"
                 "\n"
                 "Sorting Options\n"
                 "\n"
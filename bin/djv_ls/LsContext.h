@@ -67,6 +67,12 @@ namespace djv
             //! Get the number of columns for formatting the output.
             int columns() const;
 
+            //! Get whether to output JSON Lines.
+            bool hasJSON() const;
+
+            //! Get the number of threads, zero uses the number of hardware threads.
+            int threads() const;
+
             //! Get the sorting.
             Core::FileInfoUtil::SORT sort() const;
 
@@ -88,6 +94,8 @@ namespace djv
             bool                     _hidden        = false;
             QStringList              _glob;
             int                      _columns       = 0;
+            bool                     _json          = false;
+            int                      _threads       = 0;
             Core::FileInfoUtil::SORT _sort          = Core::FileInfoUtil::SORT_NAME;
             bool                     _reverseSort   = false;
             bool                     _sortDirsFirst = true;
@@ -36,9 +36,12 @@
 #include <djvCore/FileInfoUtil.h>
 #include <djvCore/Math.h>
 #include <djvCore/Memory.h>
+#include <djvCore/MemoryBudget.h>
 #include <djvCore/Sequence.h>
 #include <djvCore/System.h>
 #include <djvCore/Time.h>
+#include <djvCore/Timer.h>
+#include <djvCore/Trace.h>
 
 #include <QCoreApplication>
 #include <QDir>
@@ -48,6 +51,8 @@
 #include <QScopedPointer>
 #include <QTranslator>
 
+#include <mutex>
+
 namespace djv
 {
     namespace Core
@@ -61,6 +66,8 @@ namespace djv
             bool endline = false;
             bool separator = false;
             QScopedPointer<DebugLog> debugLog;
+            std::mutex memoryBudgetMutex;
+            QScopedPointer<MemoryBudget> memoryBudget;
         };
         
         CoreContext::CoreContext(int & argc, char ** argv, QObject * parent) :
@@ -68,7 +75,8 @@ namespace djv
             _p(new Private)
         {
             //DJV_DEBUG("CoreContext::CoreContext");
-            
+            Timer timer;
+
             qRegisterMetaType<FileInfo>("djv::Core::FileInfo");
             qRegisterMetaType<FileInfoList>("djv::Core::FileInfoList");
             qRegisterMetaType<Sequence>("djv::Core::Sequence");
@@ -81,11 +89,27 @@ namespace djv
                 QLibraryInfo::location(QLibraryInfo::TranslationsPath));
             qApp->installTranslator(qtTranslator);
             loadTranslator("djvCore");
+
+            timer.check();
+            DJV_LOG(debugLog(), "djv::Core::CoreContext",
+                QString("Startup timing: core = %1 seconds").arg(timer.seconds()));
         }
 
         CoreContext::~CoreContext()
         {
             //DJV_DEBUG("CoreContext::~CoreContext");    
+            if (Trace::isEnabled() && !Trace::fileName().isEmpty())
+            {
+                Trace::setEnabled(false);
+                try
+                {
+                    Trace::write(Trace::fileName());
+                }
+                catch (const Error & error)
+                {
+                    printError(error);
+                }
+            }
         }
 
         namespace
@@ -128,6 +152,7 @@ namespace djv
                 QString("Command line: %1").arg(StringUtil::addQuotes(args).join(", ")));
             DJV_LOG(debugLog(), "djv::Core::CoreContext", "");
 
+            Timer timer;
             try
             {
                 if (!commandLineParse(args))
@@ -143,6 +168,9 @@ namespace djv
 
                 return false;
             }
+            timer.check();
+            DJV_LOG(debugLog(), "djv::Core::CoreContext",
+                QString("Startup timing: command line = %1 seconds").arg(timer.seconds()));
 
             DJV_LOG(debugLog(), "djv::Core::CoreContext", "Information:");
             DJV_LOG(debugLog(), "djv::Core::CoreContext", "");
@@ -171,6 +199,14 @@ namespace djv
             speedLabel << Speed::speed();
             QStringList endianLabel;
             endianLabel << Memory::endian();
+            QString memoryBudgetLabel;
+            {
+                // Don't create the memory budget just to report on it.
+                std::unique_lock<std::mutex> lock(_p->memoryBudgetMutex);
+                memoryBudgetLabel = _p->memoryBudget ?
+                    _p->memoryBudget->info() :
+                    qApp->translate("djv::Core::CoreContext", "Memory budget: not in use");
+            }
             static const QString label = qApp->translate(
                 "djv::Core::CoreContext",
                 "General\n"
@@ -189,6 +225,10 @@ namespace djv
                 "    Units: %6\n"
                 "    Default speed: %7\n"
                 "\n"
+                "Memory\n"
+                "\n"
+                "    %14\n"
+                "\n"
                 "System\n"
                 "\n"
                 "    %8\n"
@@ -210,7 +250,8 @@ namespace djv
                 arg(QLocale::system().name()).
                 arg(StringUtil::addQuotes(System::searchPath()).join(", ")).
                 arg(documentationPath()).
-                arg(qVersion());
+                arg(qVersion()).
+                arg(memoryBudgetLabel);
         }
 
         QString CoreContext::about() const
@@ -324,6 +365,21 @@ namespace djv
             return _p->debugLog.data();
         }
 
+        QPointer<MemoryBudget> CoreContext::memoryBudget() const
+        {
+            // The memory budget is created the first time it is needed, since
+            // it polls the process memory usage and most of the command line
+            // applications never use it. It always belongs to the thread of
+            // the context.
+            std::unique_lock<std::mutex> lock(_p->memoryBudgetMutex);
+            if (!_p->memoryBudget)
+            {
+                _p->memoryBudget.reset(new MemoryBudget(debugLog()));
+                _p->memoryBudget->moveToThread(thread());
+            }
+            return _p->memoryBudget.data();
+        }
+
         void CoreContext::printMessage(const QString & string)
         {
             print(string);
@@ -401,6 +457,25 @@ namespace djv
                         in >> value;
                         Speed::setSpeed(value);
                     }
+                    else if (qApp->translate("djv::Core::CoreContext", "-memory_budget") == arg)
+                    {
+                        float value = 0.f;
+                        in >> value;
+                        memoryBudget()->setBudget(static_cast<quint64>(value * Memory::gigabyte));
+                    }
+                    else if (qApp->translate("djv::Core::CoreContext", "-memory_cgroup") == arg)
+                    {
+                        bool value = false;
+                        in >> value;
+                        memoryBudget()->setCgroupAware(value);
+                    }
+                    else if (qApp->translate("djv::Core::CoreContext", "-trace") == arg)
+                    {
+                        QString value;
+                        in >> value;
+                        Trace::setFileName(value);
+                        Trace::setEnabled(true);
+                    }
                     else if (qApp->translate("djv::Core::CoreContext", "-debug_log") == arg)
                     {
                         Q_FOREACH(const QString & message, debugLog()->messages())
@@ -466,6 +541,8 @@ namespace djv
             timeUnitsLabel << Time::units();
             QStringList speedLabel;
             speedLabel << Speed::speed();
+            QStringList memoryCgroupLabel;
+            memoryCgroupLabel << memoryBudget()->isCgroupAware();
             static const QString label = qApp->translate(
                 "djv::Core::CoreContext",
                 "\n"
@@ -487,10 +564,19 @@ namespace djv
                 "    -default_speed (value)\n"
                 "        Set the default speed: %10. Default = %11.\n"
                 "\n"
+                "Memory Options\n"
+                "\n"
+                "    -memory_budget (value)\n"
+                "        Set the memory budget in gigabytes, zero to use the system and cgroup memory. Default = %12.\n"
+                "    -memory_cgroup (value)\n"
+                "        Set whether the cgroup memory limit is used: %13. Default = %14.\n"
+                "\n"
                 "Miscellaneous Options\n"
                 "\n"
                 "    -debug_log\n"
                 "        Print debug log messages.\n"
+                "    -trace (file)\n"
+                "        Record a trace and write it to the file on exit. The trace uses the Chrome trace event format.\n"
                 "    -help, -h\n"
                 "        Show the command line documentation.\n"
                 "    -info\n"
@@ -508,7 +594,10 @@ namespace djv
                 arg(Time::unitsLabels().join(", ")).
                 arg(timeUnitsLabel.join(", ")).
                 arg(Speed::fpsLabels().join(", ")).
-                arg(speedLabel.join(", "));
+                arg(speedLabel.join(", ")).
+                arg(0).
+                arg(StringUtil::boolLabels().join(", ")).
+                arg(memoryCgroupLabel.join(", "));
         }
 
         void CoreContext::consolePrint(const QString & string, bool newline, int indent)
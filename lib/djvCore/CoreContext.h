@@ -47,6 +47,7 @@ namespace djv
     namespace Core
     {
         class DebugLog;
+        class MemoryBudget;
 
         //! This class provides global functionality for the library.
         class CoreContext : public QObject
@@ -82,6 +83,10 @@ namespace djv
             //! Get the debugging log.
             QPointer<DebugLog> debugLog() const;
 
+            //! Get the process-wide memory budget. The memory budget is created
+            //! the first time this is called.
+            QPointer<MemoryBudget> memoryBudget() const;
+
         public Q_SLOTS:
             //! Print a message.
             void printMessage(const QString &);
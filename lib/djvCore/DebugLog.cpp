@@ -32,12 +32,10 @@
 #include <djvCore/Debug.h>
 
 #include <QCoreApplication>
-#include <QPointer>
-#include <QRegExp>
-#include <QStringList>
-#include <QVector>
+#include <QThread>
 
-#include <mutex>
+#include <atomic>
+#include <cstddef>
 
 namespace djv
 {
@@ -45,41 +43,199 @@ namespace djv
     {
         namespace
         {
-            const int max = 10000;
+            //! The number of slots in the queue. This must be a power of two.
+            const size_t queueSize = 16384;
+
+            //! A queued message. The message is formatted when it is delivered.
+            //! The sequence number tells whether the slot is free for the
+            //! writer (equal to the write position) or ready for the reader
+            //! (equal to the read position plus one).
+            struct Slot
+            {
+                std::atomic<size_t> sequence;
+                QString             context;
+                QString             message;
+            };
 
         } // namespace
 
+        const int DebugLog::messagesMax = 10000;
+
         struct DebugLog::Private
         {
-            QVector<QString> messages;
-            std::mutex mutex;
+            //! The queue is a preallocated ring of slots. Any thread may add
+            //! messages and only the owning thread removes them.
+            std::unique_ptr<Slot[]> queue;
+            std::atomic<size_t>     queueWrite;
+            size_t                  queueRead = 0;
+            std::atomic<int>        dropped;
+            std::atomic<bool>       flushPending;
+            bool                    flushing = false;
+
+            //! The messages are kept in a ring buffer that is only accessed by
+            //! the owning thread.
+            QVector<QString>        messages;
+            int                     messagesStart = 0;
+
+            bool push(const QString & context, const QString & message);
+            bool pop(QString & context, QString & message);
         };
 
+        bool DebugLog::Private::push(const QString & context, const QString & message)
+        {
+            size_t pos = queueWrite.load(std::memory_order_relaxed);
+            Slot * slot = nullptr;
+            for (;;)
+            {
+                slot = &queue[pos & (queueSize - 1)];
+                const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+                const std::ptrdiff_t diff =
+                    static_cast<std::ptrdiff_t>(sequence) -
+                    static_cast<std::ptrdiff_t>(pos);
+                if (0 == diff)
+                {
+                    if (queueWrite.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = queueWrite.load(std::memory_order_relaxed);
+                }
+            }
+
+            // The strings are implicitly shared, so this does not copy the
+            // characters.
+            slot->context = context;
+            slot->message = message;
+            slot->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool DebugLog::Private::pop(QString & context, QString & message)
+        {
+            Slot & slot = queue[queueRead & (queueSize - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != queueRead + 1)
+                return false;
+            context.swap(slot.context);
+            message.swap(slot.message);
+            slot.context.clear();
+            slot.message.clear();
+            slot.sequence.store(queueRead + queueSize, std::memory_order_release);
+            ++queueRead;
+            return true;
+        }
+
         DebugLog::DebugLog(QObject * parent) :
             QObject(parent),
             _p(new Private)
-        {}
+        {
+            _p->queue.reset(new Slot[queueSize]);
+            for (size_t i = 0; i < queueSize; ++i)
+            {
+                _p->queue[i].sequence.store(i, std::memory_order_relaxed);
+            }
+            _p->queueWrite.store(0);
+            _p->dropped.store(0);
+            _p->flushPending.store(false);
+            _p->messages.reserve(messagesMax);
+        }
 
         DebugLog::~DebugLog()
-        {}
+        {
+            // Deliver the messages that are still queued, for example from
+            // worker threads that finished just before exit.
+            _drain();
+        }
 
-        const QVector<QString> & DebugLog::messages() const
+        QVector<QString> DebugLog::messages() const
         {
-            return _p->messages;
+            QVector<QString> out;
+            out.reserve(_p->messages.count());
+            for (int i = _p->messagesStart; i < _p->messages.count(); ++i)
+            {
+                out.append(_p->messages[i]);
+            }
+            for (int i = 0; i < _p->messagesStart; ++i)
+            {
+                out.append(_p->messages[i]);
+            }
+            return out;
         }
 
         void DebugLog::addMessage(const QString & context, const QString & message)
         {
-            std::unique_lock<std::mutex> lock(_p->mutex);
-            Q_FOREACH(const QString & line, message.split(QRegExp("[\n\r]")))
+            if (!_p->push(context, message))
+            {
+                _p->dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (QThread::currentThread() == thread())
+            {
+                flush();
+            }
+            else if (!_p->flushPending.exchange(true))
+            {
+                QMetaObject::invokeMethod(this, "flush", Qt::QueuedConnection);
+            }
+        }
+
+        void DebugLog::flush()
+        {
+            if (QThread::currentThread() != thread())
             {
-                QString s = QString("[%1] %2").arg(context, -30).arg(line);
-                _p->messages.append(s);
-                if (_p->messages.count() > max)
+                if (!_p->flushPending.exchange(true))
                 {
-                    _p->messages.pop_front();
+                    QMetaObject::invokeMethod(this, "flush", Qt::QueuedConnection);
                 }
-                Q_EMIT this->message(s);
+                return;
+            }
+            if (_p->flushing)
+                return;
+            _p->flushing = true;
+            _p->flushPending.store(false);
+            _drain();
+            _p->flushing = false;
+        }
+
+        void DebugLog::_drain()
+        {
+            const auto append = [this](const QString & value)
+            {
+                if (_p->messages.count() < messagesMax)
+                {
+                    _p->messages.append(value);
+                }
+                else
+                {
+                    _p->messages[_p->messagesStart] = value;
+                    _p->messagesStart = (_p->messagesStart + 1) % messagesMax;
+                }
+                Q_EMIT message(value);
+            };
+
+            // Format the messages, one per line.
+            QString context;
+            QString message;
+            while (_p->pop(context, message))
+            {
+                const QString prefix = '[' + context.leftJustified(30) + "] ";
+                int i = 0;
+                for (int j = 0; j <= message.size(); ++j)
+                {
+                    if (j == message.size() || '\n' == message[j] || '\r' == message[j])
+                    {
+                        append(prefix + message.mid(i, j - i));
+                        i = j + 1;
+                    }
+                }
+            }
+            if (const int dropped = _p->dropped.exchange(0))
+            {
+                append('[' + QString("djv::Core::DebugLog").leftJustified(30) + "] " +
+                    QString("%1 messages dropped").arg(dropped));
             }
         }
 
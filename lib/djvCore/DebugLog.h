@@ -32,6 +32,7 @@
 #include <djvCore/Util.h>
 
 #include <QObject>
+#include <QVector>
 
 #include <memory>
 
@@ -40,6 +41,14 @@ namespace djv
     namespace Core
     {
         //! This class provides a log for debugging.
+        //!
+        //! Messages may be added from any thread without locking or allocating.
+        //! They are queued in a fixed size ring and then formatted and delivered
+        //! in batches on the thread that owns the log, either immediately when
+        //! added from that thread or from the event loop. If the ring is full
+        //! new messages are dropped until it has been drained. Messages that are
+        //! still queued when the log is destroyed are delivered by the
+        //! destructor. The log keeps a fixed number of the most recent messages.
         class DebugLog : public QObject
         {
             Q_OBJECT
@@ -48,18 +57,29 @@ namespace djv
             explicit DebugLog(QObject * parent = nullptr);
             ~DebugLog() override;
 
-            //! Get the messages.    
-            const QVector<QString> & messages() const;
+            //! Get the maximum number of messages.
+            static const int messagesMax;
+
+            //! Get the messages. This should be called from the thread that owns
+            //! the log.
+            QVector<QString> messages() const;
 
         public Q_SLOTS:
             //! Add a message.
             void addMessage(const QString & context, const QString & message);
 
+            //! Deliver the queued messages. This is called automatically.
+            void flush();
+
         Q_SIGNALS:
             //! This signal is emitted when a message is added.
             void message(const QString &);
 
         private:
+            void _drain();
+
+            DJV_PRIVATE_COPY(DebugLog);
+
             struct Private;
             std::unique_ptr<Private> _p;
         };
@@ -0,0 +1,254 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCore/DirectoryWalk.h>
+
+#include <djvCore/Debug.h>
+#include <djvCore/FileInfoUtil.h>
+
+#include <QDir>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace
+        {
+            struct Node
+            {
+                DirectoryWalk::Directory directory;
+                std::vector<std::unique_ptr<Node> > children;
+                bool done = false;
+            };
+
+        } // namespace
+
+        struct DirectoryWalk::Private
+        {
+            Sequence::FORMAT sequenceFormat = Sequence::FORMAT_SPARSE;
+            bool recurse = false;
+            bool hidden = false;
+            int threads = 0;
+            ProcessCallback process;
+        };
+
+        DirectoryWalk::DirectoryWalk() :
+            _p(new Private)
+        {}
+
+        DirectoryWalk::~DirectoryWalk()
+        {}
+
+        Sequence::FORMAT DirectoryWalk::sequenceFormat() const
+        {
+            return _p->sequenceFormat;
+        }
+
+        void DirectoryWalk::setSequenceFormat(Sequence::FORMAT value)
+        {
+            _p->sequenceFormat = value;
+        }
+
+        bool DirectoryWalk::hasRecurse() const
+        {
+            return _p->recurse;
+        }
+
+        void DirectoryWalk::setRecurse(bool value)
+        {
+            _p->recurse = value;
+        }
+
+        bool DirectoryWalk::hasHidden() const
+        {
+            return _p->hidden;
+        }
+
+        void DirectoryWalk::setHidden(bool value)
+        {
+            _p->hidden = value;
+        }
+
+        int DirectoryWalk::threads() const
+        {
+            return _p->threads;
+        }
+
+        void DirectoryWalk::setThreads(int value)
+        {
+            _p->threads = value;
+        }
+
+        void DirectoryWalk::setProcessCallback(const ProcessCallback & value)
+        {
+            _p->process = value;
+        }
+
+        void DirectoryWalk::walk(const FileInfoList & in, const OutputCallback & output) const
+        {
+            //DJV_DEBUG("DirectoryWalk::walk");
+            //DJV_DEBUG_PRINT("in = " << in);
+
+            std::vector<std::unique_ptr<Node> > roots;
+            std::deque<Node *> queue;
+            for (int i = 0; i < in.count(); ++i)
+            {
+                std::unique_ptr<Node> node(new Node);
+                node->directory.fileInfo = in[i];
+                queue.push_back(node.get());
+                roots.push_back(std::move(node));
+            }
+
+            // The number of directories that are queued or being listed. The
+            // workers finish when this reaches zero.
+            size_t pending = queue.size();
+            bool stop = false;
+            std::mutex mutex;
+            std::condition_variable condition;
+            auto work = [this, &queue, &pending, &stop, &mutex, &condition]
+            {
+                while (true)
+                {
+                    Node * node = nullptr;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        condition.wait(lock, [&queue, &pending, &stop]
+                        {
+                            return queue.size() || !pending || stop;
+                        });
+                        if (stop || queue.empty())
+                            return;
+                        node = queue.front();
+                        queue.pop_front();
+                    }
+
+                    // Read the directory contents and find the sub-directories.
+                    Directory & directory = node->directory;
+                    std::vector<std::unique_ptr<Node> > children;
+                    directory.valid = QDir(directory.fileInfo).exists();
+                    if (directory.valid)
+                    {
+                        directory.items = FileInfoUtil::list(directory.fileInfo, _p->sequenceFormat);
+                        if (_p->recurse)
+                        {
+                            FileInfoList directories = directory.items;
+                            FileInfoUtil::filter(
+                                directories,
+                                FileInfoUtil::FILTER_FILES |
+                                (!_p->hidden ? FileInfoUtil::FILTER_HIDDEN : 0));
+                            for (int i = 0; i < directories.count(); ++i)
+                            {
+                                std::unique_ptr<Node> child(new Node);
+                                child->directory.fileInfo = directories[i];
+                                child->directory.depth = directory.depth + 1;
+                                children.push_back(std::move(child));
+                            }
+                        }
+                        if (_p->process)
+                        {
+                            _p->process(directory);
+                        }
+                    }
+
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        for (const auto & child : children)
+                        {
+                            queue.push_back(child.get());
+                        }
+                        pending += children.size();
+                        node->children = std::move(children);
+                        node->done = true;
+                        --pending;
+                    }
+                    condition.notify_all();
+                }
+            };
+            int threads = _p->threads > 0 ?
+                _p->threads :
+                std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+            std::vector<std::thread> workers;
+            for (int i = 0; i < threads; ++i)
+            {
+                workers.push_back(std::thread(work));
+            }
+
+            // Output the directories in depth-first order, waiting for each one
+            // to be listed.
+            try
+            {
+                std::vector<Node *> stack;
+                for (auto i = roots.rbegin(); i != roots.rend(); ++i)
+                {
+                    stack.push_back(i->get());
+                }
+                while (stack.size())
+                {
+                    Node * node = stack.back();
+                    stack.pop_back();
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        condition.wait(lock, [node] { return node->done; });
+                    }
+                    output(node->directory);
+                    node->directory.items.clear();
+                    for (auto i = node->children.rbegin(); i != node->children.rend(); ++i)
+                    {
+                        stack.push_back(i->get());
+                    }
+                }
+            }
+            catch (...)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    stop = true;
+                }
+                condition.notify_all();
+                for (auto & worker : workers)
+                {
+                    worker.join();
+                }
+                throw;
+            }
+            for (auto & worker : workers)
+            {
+                worker.join();
+            }
+        }
+
+    } // namespace Core
+} // namespace djv
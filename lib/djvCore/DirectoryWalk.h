@@ -0,0 +1,118 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvCore/FileInfo.h>
+#include <djvCore/Sequence.h>
+
+#include <functional>
+#include <memory>
+
+namespace djv
+{
+    namespace Core
+    {
+        //! This class provides a parallel recursive directory walk.
+        //!
+        //! Directories are listed by a pool of threads that take work from a
+        //! shared queue. The results are passed to the output callback on the
+        //! calling thread in depth-first order as they become available, so the
+        //! output is the same as a serial walk.
+        class DirectoryWalk
+        {
+        public:
+            DirectoryWalk();
+            ~DirectoryWalk();
+
+            //! This struct provides a directory in the walk.
+            struct Directory
+            {
+                //! The directory.
+                FileInfo fileInfo;
+
+                //! Whether the directory could be read.
+                bool valid = false;
+
+                //! The depth of the directory, the inputs have a depth of zero.
+                int depth = 0;
+
+                //! The directory contents.
+                FileInfoList items;
+            };
+
+            //! This typedef provides a callback for processing a directory. It is
+            //! called from the worker threads after the directory contents have
+            //! been read and may modify the contents. It must not throw.
+            typedef std::function<void(Directory &)> ProcessCallback;
+
+            //! This typedef provides a callback for outputting a directory. It is
+            //! called from the thread that started the walk.
+            typedef std::function<void(const Directory &)> OutputCallback;
+
+            //! Get the file sequence format.
+            Sequence::FORMAT sequenceFormat() const;
+
+            //! Set the file sequence format.
+            void setSequenceFormat(Sequence::FORMAT);
+
+            //! Get whether sub-directories are walked.
+            bool hasRecurse() const;
+
+            //! Set whether sub-directories are walked.
+            void setRecurse(bool);
+
+            //! Get whether hidden sub-directories are walked.
+            bool hasHidden() const;
+
+            //! Set whether hidden sub-directories are walked.
+            void setHidden(bool);
+
+            //! Get the number of threads. Zero uses the number of hardware
+            //! threads.
+            int threads() const;
+
+            //! Set the number of threads.
+            void setThreads(int);
+
+            //! Set the process callback.
+            void setProcessCallback(const ProcessCallback &);
+
+            //! Walk the given directories.
+            void walk(const FileInfoList &, const OutputCallback &) const;
+
+        private:
+            DJV_PRIVATE_COPY(DirectoryWalk);
+
+            struct Private;
+            std::unique_ptr<Private> _p;
+        };
+
+    } // namespace Core
+} // namespace djv
@@ -89,7 +89,12 @@ namespace djv
             quint64         pos = 0;
             quint64         size = 0;
             bool            endian = false;
+            bool            mmapEnabled = true;
             void *          mmap = nullptr;
+            quint64         mmapRangeOffset = 0;
+            quint64         mmapRangeSize = 0;
+            quint64         mmapOffset = 0;
+            quint64         mmapSize = 0;
             const quint8 *  mmapStart = nullptr;
             const quint8 *  mmapEnd = nullptr;
             const quint8 *  mmapP = nullptr;
@@ -167,9 +172,27 @@ namespace djv
 
             // Memory mapping.
 #if defined(DJV_MMAP)
-            if (READ == _p->mode && _p->size > 0)
+            if (READ == _p->mode && _p->size > 0 && _p->mmapEnabled)
             {
                 //DJV_DEBUG_PRINT("mmap");
+                _p->mmapOffset = 0;
+                _p->mmapSize = _p->size;
+                if (_p->mmapRangeSize)
+                {
+                    if (_p->mmapRangeOffset >= _p->size)
+                    {
+                        throw Error(
+                            "djv::Core::FileIO",
+                            errorLabels()[ERROR_READ].
+                            arg(QDir::toNativeSeparators(_p->fileName)));
+                    }
+                    const quint64 offset = _p->mmapRangeOffset;
+                    const quint64 end = Math::min(offset + _p->mmapRangeSize, _p->size);
+                    _p->mmapOffset = offset / mmapAlignment() * mmapAlignment();
+                    _p->mmapSize = end - _p->mmapOffset;
+                }
+                //DJV_DEBUG_PRINT("mmap offset = " << _p->mmapOffset);
+                //DJV_DEBUG_PRINT("mmap size = " << _p->mmapSize);
 #if defined(DJV_WINDOWS)
                 _p->mmap = ::CreateFileMapping(_p->f, 0, PAGE_READONLY, 0, 0, 0);
                 if (!_p->mmap)
@@ -180,8 +203,12 @@ namespace djv
                         arg(QDir::toNativeSeparators(_p->fileName)).
                         arg(ErrorUtil::lastError()));
                 }
-                _p->mmapStart = reinterpret_cast<const quint8 *>(
-                    ::MapViewOfFile(_p->mmap, FILE_MAP_READ, 0, 0, 0));
+                _p->mmapStart = reinterpret_cast<const quint8 *>(::MapViewOfFile(
+                    _p->mmap,
+                    FILE_MAP_READ,
+                    static_cast<DWORD>(_p->mmapOffset >> 32),
+                    static_cast<DWORD>(_p->mmapOffset & 0xffffffff),
+                    static_cast<SIZE_T>(_p->mmapSize)));
                 if (!_p->mmapStart)
                 {
                     throw Error(
@@ -190,11 +217,11 @@ namespace djv
                         arg(QDir::toNativeSeparators(_p->fileName)).
                         arg(ErrorUtil::lastError()));
                 }
-                _p->mmapEnd = _p->mmapStart + _p->size;
+                _p->mmapEnd = _p->mmapStart + _p->mmapSize;
                 _p->mmapP = _p->mmapStart;
 #else // DJV_WINDOWS
         //DJV_DEBUG_PRINT("mmap 2");
-                _p->mmap = ::mmap(0, _p->size, PROT_READ, MAP_SHARED, _p->f, 0);
+                _p->mmap = ::mmap(0, _p->mmapSize, PROT_READ, MAP_SHARED, _p->f, _p->mmapOffset);
                 if (_p->mmap == (void *)-1)
                 {
                     throw Error(
@@ -203,9 +230,10 @@ namespace djv
                         arg(QDir::toNativeSeparators(_p->fileName)));
                 }
                 _p->mmapStart = reinterpret_cast<const quint8 *>(_p->mmap);
-                _p->mmapEnd = _p->mmapStart + _p->size;
+                _p->mmapEnd = _p->mmapStart + _p->mmapSize;
                 _p->mmapP = _p->mmapStart;
 #endif // DJV_WINDOWS
+                _p->pos = _p->mmapOffset;
             }
 #endif // DJV_MMAP
         }
@@ -237,7 +265,7 @@ namespace djv
             if (_p->mmap != (void *)-1)
             {
                 //DJV_DEBUG_PRINT("munmap");
-                int r = ::munmap(_p->mmap, _p->size);
+                int r = ::munmap(_p->mmap, _p->mmapSize);
                 if (-1 == r)
                 {
                     //const QString err(::strerror(errno));
@@ -248,6 +276,8 @@ namespace djv
 #endif // DJV_WINDOWS
             _p->mmapEnd = 0;
             _p->mmapP = 0;
+            _p->mmapOffset = 0;
+            _p->mmapSize = 0;
 #endif // DJV_MMAP
             _p->fileName.clear();
 #if defined(DJV_WINDOWS)
@@ -302,48 +332,51 @@ namespace djv
             //DJV_DEBUG_PRINT("word size = " << wordSize);
 
 #if defined(DJV_MMAP)
-            const quint8 * p = _p->mmapP + size * wordSize;
-            if (p > _p->mmapEnd)
+            if (_p->mmapStart)
+            {
+                const quint8 * p = _p->mmapP + size * wordSize;
+                if (p > _p->mmapEnd)
+                {
+                    throw Error(
+                        "djv::Core::FileIO",
+                        errorLabels()[ERROR_READ].
+                        arg(QDir::toNativeSeparators(_p->fileName)));
+                }
+                if (_p->endian && wordSize > 1)
+                {
+                    Memory::convertEndian(_p->mmapP, in, size, wordSize);
+                }
+                else
+                {
+                    memcpy(in, _p->mmapP, size * wordSize);
+                }
+                _p->mmapP = p;
+                _p->pos += size * wordSize;
+                return;
+            }
+#endif // DJV_MMAP
+#if defined(DJV_WINDOWS)
+            DWORD n;
+            if (!::ReadFile(_p->f, in, size * wordSize, &n, 0) || n != size * wordSize)
             {
                 throw Error(
                     "djv::Core::FileIO",
                     errorLabels()[ERROR_READ].
                     arg(QDir::toNativeSeparators(_p->fileName)));
             }
-            if (_p->endian && wordSize > 1)
-            {
-                Memory::convertEndian(_p->mmapP, in, size, wordSize);
-            }
-            else
-            {
-                memcpy(in, _p->mmapP, size * wordSize);
-            }
-            _p->mmapP = p;
-#else // DJV_MMAP
-#if defined(DJV_WINDOWS)
-            DWORD n;
-            if (!::ReadFile(_p->f, in, size * wordSize, &n, 0))
+#else // DJV_WINDOWS
+            if (::read(_p->f, in, size * wordSize) != static_cast<ssize_t>(size * wordSize))
             {
                 throw Error(
                     "djv::Core::FileIO",
                     errorLabels()[ERROR_READ].
                     arg(QDir::toNativeSeparators(_p->fileName)));
             }
-#else // DJV_WINDOWS
-    //if (-1 == ::read(_p->f, in, size * wordSize) == (size * wordSize))
-    //{
-    //    throw Error(
-    //        "djv::Core::FileIO",
-    //        errorLabels()[ERROR_READ].
-    //        arg(QDir::toNativeSeparators(_p->fileName)));
-    //}
-            ::read(_p->f, in, size * wordSize);
+#endif // DJV_WINDOWS
             if (_p->endian && wordSize > 1)
             {
                 Memory::convertEndian(in, size, wordSize);
             }
-#endif // DJV_WINDOWS
-#endif // DJV_MMAP
             _p->pos += size * wordSize;
         }
 
@@ -389,15 +422,18 @@ namespace djv
         void FileIO::readAhead()
         {
 #if defined(DJV_MMAP)
+            if (_p->mmapStart)
+            {
 #if defined(DJV_LINUX)
-            ::madvise((void *)_p->mmapStart, _p->size, MADV_WILLNEED);
+                ::madvise((void *)_p->mmapStart, _p->mmapSize, MADV_WILLNEED);
 #endif // DJV_LINUX
-#else // DJV_MMAP
+                return;
+            }
+#endif // DJV_MMAP
 #if defined(DJV_LINUX)
             ::posix_fadvise(_p->f, 0, _p->size, POSIX_FADV_NOREUSE);
             ::posix_fadvise(_p->f, 0, _p->size, POSIX_FADV_WILLNEED);
 #endif // DJV_LINUX
-#endif // DJV_MMAP
         }
 
         const quint8 * FileIO::mmapP() const
@@ -445,6 +481,33 @@ namespace djv
             setPos(in, true);
         }
 
+        bool FileIO::hasMmap() const
+        {
+            return _p->mmapEnabled;
+        }
+
+        void FileIO::setMmap(bool in)
+        {
+            _p->mmapEnabled = in;
+        }
+
+        void FileIO::setMmapRange(quint64 offset, quint64 size)
+        {
+            _p->mmapRangeOffset = offset;
+            _p->mmapRangeSize = size;
+        }
+
+        quint64 FileIO::mmapAlignment()
+        {
+#if defined(DJV_WINDOWS)
+            SYSTEM_INFO info;
+            ::GetSystemInfo(&info);
+            return info.dwAllocationGranularity;
+#else // DJV_WINDOWS
+            return static_cast<quint64>(::sysconf(_SC_PAGESIZE));
+#endif // DJV_WINDOWS
+        }
+
         bool FileIO::endian() const
         {
             return _p->endian;
@@ -465,25 +528,34 @@ namespace djv
             {
             case READ:
 #if defined(DJV_MMAP)
-                if (!seek)
-                {
-                    _p->mmapP = reinterpret_cast<const quint8 *>(_p->mmapStart) + in;
-                }
-                else
-                {
-                    _p->mmapP += in;
-                }
-                if (_p->mmapP > _p->mmapEnd)
+                if (_p->mmapStart)
                 {
-                    throw Error(
-                        "djv::Core::FileIO",
-                        errorLabels()[ERROR_SET_POS].
-                        arg(QDir::toNativeSeparators(_p->fileName)));
+                    if (!seek)
+                    {
+                        if (in < _p->mmapOffset)
+                        {
+                            throw Error(
+                                "djv::Core::FileIO",
+                                errorLabels()[ERROR_SET_POS].
+                                arg(QDir::toNativeSeparators(_p->fileName)));
+                        }
+                        _p->mmapP = reinterpret_cast<const quint8 *>(_p->mmapStart) + (in - _p->mmapOffset);
+                    }
+                    else
+                    {
+                        _p->mmapP += in;
+                    }
+                    if (_p->mmapP > _p->mmapEnd)
+                    {
+                        throw Error(
+                            "djv::Core::FileIO",
+                            errorLabels()[ERROR_SET_POS].
+                            arg(QDir::toNativeSeparators(_p->fileName)));
+                    }
+                    break;
                 }
-                break;
-#else
+#endif // DJV_MMAP
                 // Fall through...
-#endif
             case WRITE:
             {
 #if defined(DJV_WINDOWS)
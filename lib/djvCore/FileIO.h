@@ -134,6 +134,28 @@ namespace djv
             //! - Error
             void seek(quint64);
 
+            //! Get whether files opened for reading are memory-mapped.
+            bool hasMmap() const;
+
+            //! Set whether files opened for reading are memory-mapped. This must
+            //! be set before the file is opened. Disabling memory-mapping is
+            //! cheaper when only a small part of the file is read, like an
+            //! image header.
+            void setMmap(bool);
+
+            //! Set the range of the file that is memory-mapped when it is opened
+            //! for reading. This must be set before the file is opened. The
+            //! offset is rounded down to mmapAlignment() and file positions
+            //! are still relative to the start of the file. Mapping only part
+            //! of a large file is cheaper when one image is read from a file
+            //! that contains many. A size of zero maps the whole file. Opening
+            //! the file throws an error if the offset is at or past the end of
+            //! the file.
+            void setMmapRange(quint64 offset, quint64 size);
+
+            //! Get the alignment of memory-map offsets.
+            static quint64 mmapAlignment();
+
             //! Get whether endian conversion is performed when using the data
             //! functions.
             bool endian() const;
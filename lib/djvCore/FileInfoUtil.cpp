@@ -460,42 +460,34 @@ namespace djv
             return out;
         }
 
-        void FileInfoUtil::filter(
-            FileInfoList &      items,
-            int                 filter,
-            const QString &     filterText,
-            const QStringList & glob)
+        namespace
         {
-            //DJV_DEBUG("FileInfoUtil::filter");
-            //DJV_DEBUG_PRINT("filter = " << filter);
-            //DJV_DEBUG_PRINT("filterText = " << filterText);
-            //DJV_DEBUG_PRINT("glob = " << glob);
-
-            int i = 0;
-            for (int j = 0; j < items.count(); ++j)
+            bool isFilterValid(
+                const FileInfo &    item,
+                int                 filter,
+                const QString &     filterText,
+                const QStringList & glob)
             {
-                const QString name = items[j].fileName(-1, false);
+                const QString name = item.fileName(-1, false);
                 //DJV_DEBUG_PRINT("name = " << name);
-
-                bool valid = true;
-                const FileInfo::TYPE type = items[j].type();
-                if ((filter & FILTER_FILES) &&
+                const FileInfo::TYPE type = item.type();
+                if ((filter & FileInfoUtil::FILTER_FILES) &&
                     (FileInfo::FILE == type || FileInfo::SEQUENCE == type))
                 {
-                    valid = false;
+                    return false;
                 }
-                if ((filter & FILTER_DIRECTORIES) && FileInfo::DIRECTORY == type)
+                if ((filter & FileInfoUtil::FILTER_DIRECTORIES) && FileInfo::DIRECTORY == type)
                 {
-                    valid = false;
+                    return false;
                 }
-                if ((filter & FILTER_HIDDEN) && items[j].isDotFile())
+                if ((filter & FileInfoUtil::FILTER_HIDDEN) && item.isDotFile())
                 {
-                    valid = false;
+                    return false;
                 }
                 if (filterText.length() > 0)
                 {
                     if (!name.contains(filterText, Qt::CaseInsensitive))
-                        valid = false;
+                        return false;
                 }
                 if (glob.count())
                 {
@@ -509,9 +501,29 @@ namespace djv
                     }
                     if (glob.count() == k)
                     {
-                        valid = false;
+                        return false;
                     }
                 }
+                return true;
+            }
+
+        } // namespace
+
+        void FileInfoUtil::filter(
+            FileInfoList &      items,
+            int                 filter,
+            const QString &     filterText,
+            const QStringList & glob)
+        {
+            //DJV_DEBUG("FileInfoUtil::filter");
+            //DJV_DEBUG_PRINT("filter = " << filter);
+            //DJV_DEBUG_PRINT("filterText = " << filterText);
+            //DJV_DEBUG_PRINT("glob = " << glob);
+
+            int i = 0;
+            for (int j = 0; j < items.count(); ++j)
+            {
+                const bool valid = isFilterValid(items[j], filter, filterText, glob);
                 //DJV_DEBUG_PRINT("valid = " << valid);
                 if (valid)
                 {
@@ -526,6 +538,24 @@ namespace djv
             items.resize(i);
         }
 
+        void FileInfoUtil::filter(
+            const FileInfoList & items,
+            QVector<int> &       indices,
+            int                  filter,
+            const QString &      filterText,
+            const QStringList &  glob)
+        {
+            int i = 0;
+            for (int j = 0; j < indices.count(); ++j)
+            {
+                if (isFilterValid(items[indices[j]], filter, filterText, glob))
+                {
+                    indices[i++] = indices[j];
+                }
+            }
+            indices.resize(i);
+        }
+
         const QStringList & FileInfoUtil::sortLabels()
         {
             static const QStringList data = QStringList() <<
@@ -637,6 +667,45 @@ namespace djv
             qSort(items.begin(), items.end(), compare);
         }
 
+        void FileInfoUtil::sort(
+            const FileInfoList & items,
+            QVector<int> &       indices,
+            SORT                 sort,
+            bool                 reverse)
+        {
+            typedef bool (Compare)(const FileInfo &, const FileInfo &);
+            Compare * compare = 0;
+            switch (sort)
+            {
+            case SORT_NAME:
+                compare = reverse ? compareNameReverse : compareName;
+                break;
+            case SORT_TYPE:
+                compare = reverse ? compareTypeReverse : compareType;
+                break;
+            case SORT_SIZE:
+                compare = reverse ? compareSizeReverse : compareSize;
+                break;
+            case SORT_USER:
+                compare = reverse ? compareUserReverse : compareUser;
+                break;
+            case SORT_PERMISSIONS:
+                compare = reverse ? comparePermissionsReverse : comparePermissions;
+                break;
+            case SORT_TIME:
+                compare = reverse ? compareTimeReverse : compareTime;
+                break;
+            default: break;
+            }
+            std::sort(
+                indices.begin(),
+                indices.end(),
+                [&items, compare](int a, int b)
+            {
+                return compare(items[a], items[b]);
+            });
+        }
+
         void FileInfoUtil::sortDirsFirst(FileInfoList & in)
         {
             FileInfoList dirs, files;
@@ -657,6 +726,17 @@ namespace djv
             in += files;
         }
 
+        void FileInfoUtil::sortDirsFirst(const FileInfoList & items, QVector<int> & indices)
+        {
+            std::stable_partition(
+                indices.begin(),
+                indices.end(),
+                [&items](int i)
+            {
+                return items[i].type() == FileInfo::DIRECTORY;
+            });
+        }
+
         void FileInfoUtil::recent(
             const FileInfo & fileInfo,
             FileInfoList &   list,
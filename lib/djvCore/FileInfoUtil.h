@@ -95,6 +95,15 @@ namespace djv
                 const QString &     filterText = QString(),
                 const QStringList & glob = QStringList());
 
+            //! Filter a list of indices into a list of files. The files are
+            //! not modified.
+            static void filter(
+                const FileInfoList & items,
+                QVector<int> &       indices,
+                int                  filter,
+                const QString &      filterText = QString(),
+                const QStringList &  glob = QStringList());
+
             //! This enumeration provides file sorting.
             enum SORT
             {
@@ -118,9 +127,20 @@ namespace djv
                 SORT,
                 bool reverse = false);
 
+            //! Sort a list of indices into a list of files. The files are not
+            //! modified.
+            static void sort(
+                const FileInfoList & items,
+                QVector<int> &       indices,
+                SORT,
+                bool                 reverse = false);
+
             //! Sort the list so directories are first.
             static void sortDirsFirst(FileInfoList &);
 
+            //! Sort a list of indices so directories are first.
+            static void sortDirsFirst(const FileInfoList & items, QVector<int> & indices);
+
             //! The maximum number of recent files.
             static const int recentMax = 10;
 
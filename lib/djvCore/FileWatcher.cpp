@@ -0,0 +1,265 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCore/FileWatcher.h>
+
+#include <djvCore/FileInfoUtil.h>
+
+#include <QMap>
+#include <QSet>
+
+#if defined(DJV_LINUX)
+#include <QSocketNotifier>
+
+#include <sys/inotify.h>
+#include <unistd.h>
+#else // DJV_LINUX
+#include <QFileSystemWatcher>
+#endif // DJV_LINUX
+
+namespace djv
+{
+    namespace Core
+    {
+        struct FileWatcher::Private
+        {
+            QStringList directories;
+#if defined(DJV_LINUX)
+            int fd = -1;
+            QScopedPointer<QSocketNotifier> notifier;
+            QMap<int, QString> watches;
+            QSet<QString> created;
+#else // DJV_LINUX
+            QScopedPointer<QFileSystemWatcher> watcher;
+#endif // DJV_LINUX
+        };
+
+        FileWatcher::FileWatcher(QObject * parent) :
+            QObject(parent),
+            _p(new Private)
+        {
+#if defined(DJV_LINUX)
+            _p->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if (_p->fd != -1)
+            {
+                _p->notifier.reset(new QSocketNotifier(_p->fd, QSocketNotifier::Read));
+                connect(
+                    _p->notifier.data(),
+                    SIGNAL(activated(int)),
+                    SLOT(notifierCallback()));
+            }
+#else // DJV_LINUX
+            _p->watcher.reset(new QFileSystemWatcher);
+            connect(
+                _p->watcher.data(),
+                SIGNAL(directoryChanged(const QString &)),
+                SIGNAL(directoryChanged(const QString &)));
+#endif // DJV_LINUX
+        }
+
+        FileWatcher::~FileWatcher()
+        {
+            clear();
+#if defined(DJV_LINUX)
+            _p->notifier.reset();
+            if (_p->fd != -1)
+            {
+                ::close(_p->fd);
+            }
+#endif // DJV_LINUX
+        }
+
+        bool FileWatcher::hasFileEvents()
+        {
+#if defined(DJV_LINUX)
+            return true;
+#else // DJV_LINUX
+            return false;
+#endif // DJV_LINUX
+        }
+
+        QStringList FileWatcher::directories() const
+        {
+            return _p->directories;
+        }
+
+        void FileWatcher::addDirectory(const QString & in)
+        {
+            //DJV_DEBUG("FileWatcher::addDirectory");
+            //DJV_DEBUG_PRINT("in = " << in);
+            const QString directory = FileInfoUtil::fixPath(in);
+            if (directory.isEmpty() || _p->directories.contains(directory))
+                return;
+#if defined(DJV_LINUX)
+            if (-1 == _p->fd)
+                return;
+            const int wd = inotify_add_watch(
+                _p->fd,
+                directory.toUtf8().data(),
+                IN_CREATE | IN_CLOSE_WRITE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO);
+            if (-1 == wd)
+                return;
+            _p->watches[wd] = directory;
+#else // DJV_LINUX
+            if (!_p->watcher->addPath(directory))
+                return;
+#endif // DJV_LINUX
+            _p->directories.append(directory);
+        }
+
+        void FileWatcher::removeDirectory(const QString & in)
+        {
+            const QString directory = FileInfoUtil::fixPath(in);
+            if (!_p->directories.removeOne(directory))
+                return;
+#if defined(DJV_LINUX)
+            const int wd = _p->watches.key(directory, -1);
+            if (wd != -1)
+            {
+                inotify_rm_watch(_p->fd, wd);
+                _p->watches.remove(wd);
+            }
+            QSet<QString>::iterator i = _p->created.begin();
+            while (i != _p->created.end())
+            {
+                if (i->startsWith(directory))
+                {
+                    i = _p->created.erase(i);
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+#else // DJV_LINUX
+            _p->watcher->removePath(directory);
+#endif // DJV_LINUX
+        }
+
+        void FileWatcher::clear()
+        {
+            const QStringList directories = _p->directories;
+            Q_FOREACH(const QString & directory, directories)
+            {
+                removeDirectory(directory);
+            }
+        }
+
+        void FileWatcher::notifierCallback()
+        {
+#if defined(DJV_LINUX)
+            //DJV_DEBUG("FileWatcher::notifierCallback");
+            QStringList changed;
+            alignas(struct inotify_event) char buf[4096];
+            while (true)
+            {
+                const ssize_t size = ::read(_p->fd, buf, sizeof(buf));
+                if (size <= 0)
+                    break;
+                for (const char * p = buf; p < buf + size;)
+                {
+                    const struct inotify_event * event = reinterpret_cast<const struct inotify_event *>(p);
+                    p += sizeof(struct inotify_event) + event->len;
+                    if (event->mask & IN_Q_OVERFLOW)
+                    {
+                        // Events were dropped, so every directory has to be
+                        // read again.
+                        Q_FOREACH(const QString & directory, _p->directories)
+                        {
+                            if (!changed.contains(directory))
+                            {
+                                changed.append(directory);
+                            }
+                        }
+                        continue;
+                    }
+                    const auto i = _p->watches.find(event->wd);
+                    if (i == _p->watches.end())
+                        continue;
+                    const QString directory = i.value();
+                    if (event->mask & IN_IGNORED)
+                    {
+                        // The directory was removed.
+                        _p->watches.erase(i);
+                        _p->directories.removeOne(directory);
+                        continue;
+                    }
+                    if (!event->len)
+                        continue;
+                    const QString fileName = directory + QString::fromUtf8(event->name);
+                    //DJV_DEBUG_PRINT("fileName = " << fileName);
+                    //DJV_DEBUG_PRINT("mask = " << event->mask);
+                    if (event->mask & IN_CREATE)
+                    {
+                        // Wait for regular files to be closed before reporting them.
+                        if (event->mask & IN_ISDIR)
+                        {
+                            Q_EMIT fileCreated(fileName);
+                        }
+                        else
+                        {
+                            _p->created.insert(fileName);
+                        }
+                    }
+                    else if (event->mask & IN_CLOSE_WRITE)
+                    {
+                        if (_p->created.remove(fileName))
+                        {
+                            Q_EMIT fileCreated(fileName);
+                        }
+                        else
+                        {
+                            Q_EMIT fileModified(fileName);
+                        }
+                    }
+                    else if (event->mask & IN_MOVED_TO)
+                    {
+                        _p->created.remove(fileName);
+                        Q_EMIT fileCreated(fileName);
+                    }
+                    else if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+                    {
+                        _p->created.remove(fileName);
+                        Q_EMIT fileRemoved(fileName);
+                    }
+                    if (!changed.contains(directory))
+                    {
+                        changed.append(directory);
+                    }
+                }
+            }
+            Q_FOREACH(const QString & directory, changed)
+            {
+                Q_EMIT directoryChanged(directory);
+            }
+#endif // DJV_LINUX
+        }
+
+    } // namespace Core
+} // namespace djv
@@ -0,0 +1,101 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvCore/Util.h>
+
+#include <QObject>
+#include <QStringList>
+
+#include <memory>
+
+namespace djv
+{
+    namespace Core
+    {
+        //! This class provides a watcher for changes to the files in a list of
+        //! directories.
+        //!
+        //! On Linux the watcher uses inotify and reports individual files as
+        //! they are created, modified, and removed. On other platforms only
+        //! the directoryChanged() signal is emitted.
+        class FileWatcher : public QObject
+        {
+            Q_OBJECT
+
+        public:
+            explicit FileWatcher(QObject * parent = nullptr);
+            ~FileWatcher() override;
+
+            //! Get whether individual file events are reported.
+            static bool hasFileEvents();
+
+            //! Get the list of watched directories.
+            QStringList directories() const;
+
+        public Q_SLOTS:
+            //! Add a directory to watch.
+            void addDirectory(const QString &);
+
+            //! Remove a watched directory.
+            void removeDirectory(const QString &);
+
+            //! Remove all of the watched directories.
+            void clear();
+
+        Q_SIGNALS:
+            //! This signal is emitted when a file is created. For regular files
+            //! the signal is emitted when the file is closed after writing, so
+            //! the file is complete.
+            void fileCreated(const QString &);
+
+            //! This signal is emitted when an existing file is re-written.
+            void fileModified(const QString &);
+
+            //! This signal is emitted when a file is removed.
+            void fileRemoved(const QString &);
+
+            //! This signal is emitted when the contents of a directory change.
+            //! If the kernel event queue overflows it is emitted for every
+            //! watched directory, since the file signals may be incomplete.
+            void directoryChanged(const QString &);
+
+        private Q_SLOTS:
+            void notifierCallback();
+
+        private:
+            DJV_PRIVATE_COPY(FileWatcher);
+
+            struct Private;
+            std::unique_ptr<Private> _p;
+        };
+
+    } // namespace Core
+} // namespace djv
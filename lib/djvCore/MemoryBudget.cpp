@@ -0,0 +1,477 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCore/MemoryBudget.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/DebugLog.h>
+#include <djvCore/Memory.h>
+
+#include <QCoreApplication>
+#include <QFile>
+
+#if defined(DJV_WINDOWS)
+#include <windows.h>
+#elif defined(DJV_OSX)
+#include <sys/sysctl.h>
+#include <sys/types.h>
+#else // DJV_WINDOWS
+#include <unistd.h>
+#endif // DJV_WINDOWS
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace
+        {
+            //! \todo Should these be configurable?
+            const int   pressureTimeout = 1000;
+            const float systemFraction  = .75f;
+            const float cgroupFraction  = .9f;
+
+            quint64 automaticBudget(bool cgroupAware)
+            {
+                quint64 out = static_cast<quint64>(MemoryBudget::systemMemory() * systemFraction);
+                if (cgroupAware)
+                {
+                    const quint64 limit = static_cast<quint64>(MemoryBudget::cgroupLimit() * cgroupFraction);
+                    if (limit && (!out || limit < out))
+                    {
+                        out = limit;
+                    }
+                }
+                return out;
+            }
+
+#if defined(DJV_LINUX)
+            quint64 readCgroupLimit(const QString & fileName)
+            {
+                QFile file(fileName);
+                if (file.open(QIODevice::ReadOnly))
+                {
+                    // Version 2 uses "max" for no limit and version 1 uses a
+                    // very large number.
+                    bool ok = false;
+                    const quint64 value = QString(file.readAll()).trimmed().toULongLong(&ok);
+                    if (ok && value < (static_cast<quint64>(1) << 62))
+                    {
+                        return value;
+                    }
+                }
+                return 0;
+            }
+
+            quint64 minLimit(quint64 a, quint64 b)
+            {
+                return !a ? b : (!b ? a : std::min(a, b));
+            }
+
+            // Find the smallest limit of the given cgroup and its parents.
+            quint64 cgroupTreeLimit(const QString & root, QString path, const QString & fileName)
+            {
+                quint64 out = 0;
+                while (!path.isEmpty())
+                {
+                    out = minLimit(out, readCgroupLimit(root + path + "/" + fileName));
+                    const int i = path.lastIndexOf('/');
+                    path = i > 0 ? path.left(i) : QString();
+                }
+                return minLimit(out, readCgroupLimit(root + "/" + fileName));
+            }
+#endif // DJV_LINUX
+
+        } // namespace
+
+        struct MemoryBudget::Private
+        {
+            struct Client
+            {
+                QString          name;
+                PRIORITY         priority = static_cast<PRIORITY>(0);
+                PressureCallback callback;
+                quint64          bytes = 0;
+            };
+
+            QPointer<DebugLog>    debugLog;
+            mutable std::mutex    mutex;
+            std::map<int, Client> clients;
+            int                   clientId = 0;
+            quint64               budget = 0;
+            quint64               automaticBudget = 0;
+            bool                  cgroupAware = true;
+            bool                  overBudget = false;
+            std::atomic<bool>     pressurePending;
+        };
+
+        MemoryBudget::MemoryBudget(const QPointer<DebugLog> & debugLog, QObject * parent) :
+            QObject(parent),
+            _p(new Private)
+        {
+            //DJV_DEBUG("MemoryBudget::MemoryBudget");
+            _p->debugLog = debugLog;
+            _p->automaticBudget = automaticBudget(_p->cgroupAware);
+            _p->pressurePending = false;
+            startTimer(pressureTimeout);
+            if (_p->debugLog)
+            {
+                DJV_LOG(_p->debugLog, "djv::Core::MemoryBudget", info());
+            }
+        }
+
+        MemoryBudget::~MemoryBudget()
+        {}
+
+        const QStringList & MemoryBudget::priorityLabels()
+        {
+            static const QStringList data = QStringList() <<
+                qApp->translate("djv::Core::MemoryBudget", "Low") <<
+                qApp->translate("djv::Core::MemoryBudget", "Normal") <<
+                qApp->translate("djv::Core::MemoryBudget", "High");
+            DJV_ASSERT(data.count() == PRIORITY_COUNT);
+            return data;
+        }
+
+        int MemoryBudget::addClient(
+            const QString &          name,
+            PRIORITY                 priority,
+            const PressureCallback & callback)
+        {
+            int id = 0;
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                id = ++_p->clientId;
+                Private::Client client;
+                client.name = name;
+                client.priority = priority;
+                client.callback = callback;
+                _p->clients[id] = client;
+            }
+            if (_p->debugLog)
+            {
+                DJV_LOG(_p->debugLog, "djv::Core::MemoryBudget",
+                    QString("Add client: %1 (%2)").arg(name).arg(priorityLabels()[priority]));
+            }
+            return id;
+        }
+
+        void MemoryBudget::removeClient(int id)
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            _p->clients.erase(id);
+        }
+
+        void MemoryBudget::setUsage(int id, quint64 bytes)
+        {
+            bool over = false;
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                const auto i = _p->clients.find(id);
+                if (i == _p->clients.end())
+                    return;
+                i->second.bytes = bytes;
+                quint64 total = 0;
+                for (const auto & j : _p->clients)
+                {
+                    total += j.second.bytes;
+                }
+                const quint64 budget = _p->budget ? _p->budget : _p->automaticBudget;
+                over = budget && total > budget;
+            }
+
+            // The pressure callbacks are queued so that they are called from the
+            // thread that owns the budget and not from inside the client.
+            if (over && !_p->pressurePending.exchange(true))
+            {
+                QMetaObject::invokeMethod(this, "checkPressure", Qt::QueuedConnection);
+            }
+        }
+
+        quint64 MemoryBudget::clientUsage(int id) const
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            const auto i = _p->clients.find(id);
+            return i != _p->clients.end() ? i->second.bytes : 0;
+        }
+
+        quint64 MemoryBudget::usage() const
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            quint64 out = 0;
+            for (const auto & i : _p->clients)
+            {
+                out += i.second.bytes;
+            }
+            return out;
+        }
+
+        quint64 MemoryBudget::priorityUsage(PRIORITY priority) const
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            quint64 out = 0;
+            for (const auto & i : _p->clients)
+            {
+                if (priority == i.second.priority)
+                {
+                    out += i.second.bytes;
+                }
+            }
+            return out;
+        }
+
+        quint64 MemoryBudget::budget() const
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            return _p->budget ? _p->budget : _p->automaticBudget;
+        }
+
+        bool MemoryBudget::isCgroupAware() const
+        {
+            return _p->cgroupAware;
+        }
+
+        QString MemoryBudget::info() const
+        {
+            QStringList clients;
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                for (const auto & i : _p->clients)
+                {
+                    clients += qApp->translate("djv::Core::MemoryBudget", "    %1 (%2): %3").
+                        arg(i.second.name).
+                        arg(priorityLabels()[i.second.priority]).
+                        arg(Memory::sizeLabel(i.second.bytes));
+                }
+            }
+            const quint64 cgroupLimit = MemoryBudget::cgroupLimit();
+            QString out = qApp->translate("djv::Core::MemoryBudget",
+                "Memory budget: %1, usage: %2, resident: %3, system: %4, cgroup limit: %5").
+                arg(Memory::sizeLabel(budget())).
+                arg(Memory::sizeLabel(usage())).
+                arg(Memory::sizeLabel(residentMemory())).
+                arg(Memory::sizeLabel(systemMemory())).
+                arg(cgroupLimit ?
+                    Memory::sizeLabel(cgroupLimit) :
+                    qApp->translate("djv::Core::MemoryBudget", "none"));
+            if (clients.count())
+            {
+                out += "\n" + clients.join("\n");
+            }
+            return out;
+        }
+
+        quint64 MemoryBudget::systemMemory()
+        {
+            quint64 out = 0;
+#if defined(DJV_WINDOWS)
+            MEMORYSTATUSEX status;
+            status.dwLength = sizeof(status);
+            if (GlobalMemoryStatusEx(&status))
+            {
+                out = status.ullTotalPhys;
+            }
+#elif defined(DJV_OSX)
+            int mib[2] = { CTL_HW, HW_MEMSIZE };
+            uint64_t value = 0;
+            size_t size = sizeof(value);
+            if (0 == sysctl(mib, 2, &value, &size, 0, 0))
+            {
+                out = value;
+            }
+#else // DJV_WINDOWS
+            const long pages = sysconf(_SC_PHYS_PAGES);
+            const long pageSize = sysconf(_SC_PAGE_SIZE);
+            if (pages > 0 && pageSize > 0)
+            {
+                out = static_cast<quint64>(pages) * static_cast<quint64>(pageSize);
+            }
+#endif // DJV_WINDOWS
+            return out;
+        }
+
+        quint64 MemoryBudget::residentMemory()
+        {
+            quint64 out = 0;
+#if defined(DJV_LINUX)
+            QFile file("/proc/self/statm");
+            if (file.open(QIODevice::ReadOnly))
+            {
+                const QStringList pieces = QString(file.readAll()).split(' ', QString::SkipEmptyParts);
+                const long pageSize = sysconf(_SC_PAGE_SIZE);
+                if (pieces.count() > 1 && pageSize > 0)
+                {
+                    out = pieces[1].toULongLong() * static_cast<quint64>(pageSize);
+                }
+            }
+#endif // DJV_LINUX
+            return out;
+        }
+
+        quint64 MemoryBudget::cgroupLimit()
+        {
+            quint64 out = 0;
+#if defined(DJV_LINUX)
+            QFile file("/proc/self/cgroup");
+            if (file.open(QIODevice::ReadOnly))
+            {
+                // Each line is "hierarchy:controllers:path"; version 2 uses an
+                // empty list of controllers.
+                Q_FOREACH(const QString & line, QString(file.readAll()).split('\n', QString::SkipEmptyParts))
+                {
+                    const QStringList pieces = line.split(':');
+                    if (pieces.count() < 3)
+                        continue;
+                    const QString path = pieces.mid(2).join(":").trimmed();
+                    if (pieces[1].isEmpty())
+                    {
+                        out = minLimit(out, cgroupTreeLimit("/sys/fs/cgroup", path, "memory.max"));
+                    }
+                    else if (pieces[1].split(',').contains("memory"))
+                    {
+                        out = minLimit(out, cgroupTreeLimit("/sys/fs/cgroup/memory", path, "memory.limit_in_bytes"));
+                    }
+                }
+            }
+#endif // DJV_LINUX
+            return out;
+        }
+
+        void MemoryBudget::setBudget(quint64 bytes)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                if (bytes == _p->budget)
+                    return;
+                _p->budget = bytes;
+            }
+            if (_p->debugLog)
+            {
+                DJV_LOG(_p->debugLog, "djv::Core::MemoryBudget", info());
+            }
+            checkPressure();
+            Q_EMIT budgetChanged(budget());
+        }
+
+        void MemoryBudget::setCgroupAware(bool value)
+        {
+            if (value == _p->cgroupAware)
+                return;
+            const quint64 budget = automaticBudget(value);
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                _p->cgroupAware = value;
+                _p->automaticBudget = budget;
+            }
+            if (_p->debugLog)
+            {
+                DJV_LOG(_p->debugLog, "djv::Core::MemoryBudget", info());
+            }
+            checkPressure();
+            Q_EMIT budgetChanged(this->budget());
+        }
+
+        void MemoryBudget::checkPressure()
+        {
+            //DJV_DEBUG("MemoryBudget::checkPressure");
+            _p->pressurePending = false;
+            const quint64 budget = this->budget();
+            const quint64 usage = std::max(this->usage(), residentMemory());
+            //DJV_DEBUG_PRINT("budget = " << budget);
+            //DJV_DEBUG_PRINT("usage = " << usage);
+            if (!budget || usage <= budget)
+            {
+                _p->overBudget = false;
+                return;
+            }
+
+            // Copy the callbacks so they can be called without holding the lock,
+            // the clients will update their usage while releasing memory.
+            std::vector<Private::Client> clients;
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                for (const auto & i : _p->clients)
+                {
+                    if (i.second.callback)
+                    {
+                        clients.push_back(i.second);
+                    }
+                }
+            }
+            std::stable_sort(
+                clients.begin(),
+                clients.end(),
+                [](const Private::Client & a, const Private::Client & b)
+            {
+                return a.priority < b.priority;
+            });
+
+            const quint64 requested = usage - budget;
+            quint64 released = 0;
+            QStringList releasedLabels;
+            for (const auto & client : clients)
+            {
+                if (released >= requested)
+                    break;
+                const quint64 bytes = client.callback(requested - released);
+                if (bytes)
+                {
+                    released += bytes;
+                    releasedLabels += QString("%1 = %2").arg(client.name).arg(Memory::sizeLabel(bytes));
+                }
+            }
+            // Only log the first time nothing could be released so a process
+            // that stays over budget does not flood the log.
+            if (_p->debugLog && (released || !_p->overBudget))
+            {
+                DJV_LOG(_p->debugLog, "djv::Core::MemoryBudget",
+                    QString("Memory pressure: requested = %1, released = %2 (%3)").
+                    arg(Memory::sizeLabel(requested)).
+                    arg(Memory::sizeLabel(released)).
+                    arg(releasedLabels.join(", ")));
+                DJV_LOG(_p->debugLog, "djv::Core::MemoryBudget", info());
+            }
+            _p->overBudget = true;
+            Q_EMIT pressure(requested, released);
+        }
+
+        void MemoryBudget::timerEvent(QTimerEvent *)
+        {
+            // Poll so that memory that is not registered (for example image I/O
+            // temporaries) is also noticed.
+            checkPressure();
+        }
+
+    } // namespace Core
+} // namespace djv
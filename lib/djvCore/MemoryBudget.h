@@ -0,0 +1,159 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvCore/Util.h>
+
+#include <QObject>
+#include <QPointer>
+#include <QStringList>
+
+#include <functional>
+#include <memory>
+
+namespace djv
+{
+    namespace Core
+    {
+        class DebugLog;
+
+        //! This class provides a process-wide memory budget.
+        //!
+        //! Caches and large buffers register as clients and report how many
+        //! bytes they are using. When the usage goes over the budget the
+        //! clients are asked to release memory, starting with the lowest
+        //! priority. The usage is the larger of the registered byte counts and
+        //! the resident size of the process, so unregistered temporaries also
+        //! count against the budget.
+        //!
+        //! The byte counts may be set from any thread, the pressure callbacks
+        //! are always called from the thread that owns the budget.
+        class MemoryBudget : public QObject
+        {
+            Q_OBJECT
+
+        public:
+            explicit MemoryBudget(const QPointer<DebugLog> & = QPointer<DebugLog>(), QObject * parent = nullptr);
+            ~MemoryBudget() override;
+
+            //! This enumeration provides the client priorities. Lower priority
+            //! clients are asked to release memory first.
+            enum PRIORITY
+            {
+                PRIORITY_LOW,    //!< Caches that are cheap to rebuild
+                PRIORITY_NORMAL, //!< Caches that are expensive to rebuild
+                PRIORITY_HIGH,   //!< Buffers that are in use
+
+                PRIORITY_COUNT
+            };
+            Q_ENUM(PRIORITY);
+
+            //! Get the priority labels.
+            static const QStringList & priorityLabels();
+
+            //! This typedef provides a callback that is asked to release memory.
+            //! The argument is the number of bytes requested and the return value
+            //! is the number of bytes released.
+            typedef std::function<quint64(quint64)> PressureCallback;
+
+            //! Register a client and return its ID.
+            int addClient(
+                const QString &          name,
+                PRIORITY                 priority,
+                const PressureCallback & callback = nullptr);
+
+            //! Unregister a client.
+            void removeClient(int id);
+
+            //! Set the number of bytes used by a client.
+            void setUsage(int id, quint64);
+
+            //! Get the number of bytes used by a client.
+            quint64 clientUsage(int id) const;
+
+            //! Get the number of bytes used by all of the clients.
+            quint64 usage() const;
+
+            //! Get the number of bytes used by the clients with the given priority.
+            quint64 priorityUsage(PRIORITY) const;
+
+            //! Get the budget in bytes. This is either the budget that has been
+            //! set or, if that is zero, a budget derived from the system memory
+            //! and the cgroup memory limit.
+            quint64 budget() const;
+
+            //! Get whether the cgroup memory limit is used.
+            bool isCgroupAware() const;
+
+            //! Get the accounting information.
+            QString info() const;
+
+            //! Get the amount of physical memory in bytes.
+            static quint64 systemMemory();
+
+            //! Get the resident size of the process in bytes, or zero if it is
+            //! not available on this platform.
+            static quint64 residentMemory();
+
+            //! Get the cgroup memory limit in bytes, or zero if there is no limit.
+            //! Only Linux supports cgroups.
+            static quint64 cgroupLimit();
+
+        public Q_SLOTS:
+            //! Set the budget in bytes. Zero means the budget is derived
+            //! automatically.
+            void setBudget(quint64);
+
+            //! Set whether the cgroup memory limit is used.
+            void setCgroupAware(bool);
+
+            //! Ask the clients to release memory if the usage is over budget.
+            void checkPressure();
+
+        Q_SIGNALS:
+            //! This signal is emitted when the budget is changed.
+            void budgetChanged(quint64);
+
+            //! This signal is emitted when the clients have been asked to release
+            //! memory.
+            void pressure(quint64 requested, quint64 released);
+
+        protected:
+            void timerEvent(QTimerEvent *) override;
+
+        private:
+            DJV_PRIVATE_COPY(MemoryBudget);
+
+            struct Private;
+            std::unique_ptr<Private> _p;
+        };
+
+    } // namespace Core
+} // namespace djv
@@ -36,11 +36,15 @@
 #include <djvCore/Error.h>
 #include <djvCore/ErrorUtil.h>
 #include <djvCore/FileInfoUtil.h>
+#include <djvCore/Timer.h>
 
 #include <QCoreApplication>
+#include <QDateTime>
 #include <QDir>
+#include <QFileInfo>
 #include <QMap>
-#include <QPair>
+#include <QSettings>
+#include <QStandardPaths>
 #include <QStringList>
 
 #if defined(DJV_WINDOWS)
@@ -50,6 +54,7 @@
 #endif // DJV_WINDOWS
 
 #include <algorithm>
+#include <mutex>
 #if ! defined(DJV_WINDOWS)
 #include <dlfcn.h>
 #endif
@@ -139,17 +144,185 @@ namespace djv
 
         } // namespace
 
+        namespace
+        {
+            //! \todo Should the location of the plugin index be configurable?
+            //!
+            //! Each application has its own index since the built-in plugins
+            //! are stamped with the application file, otherwise running the
+            //! applications alternately would make every run re-index them.
+            QString indexFileName(const QString & pluginEntry)
+            {
+                return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) +
+                    "/djv/" + pluginEntry + "_" +
+                    QFileInfo(QCoreApplication::applicationFilePath()).completeBaseName() + ".ini";
+            }
+
+            QString fileStamp(const QFileInfo & fileInfo)
+            {
+                return QString("%1:%2").
+                    arg(fileInfo.lastModified().toMSecsSinceEpoch()).
+                    arg(fileInfo.size());
+            }
+
+            // Built-in plugins are indexed by the version and the application
+            // modification time.
+            QString builtinStamp()
+            {
+                return QString("%1:%2").
+                    arg(DJV_VERSION).
+                    arg(fileStamp(QFileInfo(QCoreApplication::applicationFilePath())));
+            }
+
+            const QString builtinKey = "builtin:";
+
+        } // namespace
+
         struct PluginFactory::Private
         {
             Private(const QPointer<CoreContext> & context) :
                 context(context)
             {}
 
-            QString pluginPrefix;
+            struct Entry
+            {
+                QString fileName;
+                std::function<Plugin *(void)> create;
+                QString indexKey;
+                Plugin * plugin = nullptr;
+                Handle * handle = nullptr;
+                PluginIndexData data;
+                bool indexed = false;
+                bool failed = false;
+            };
+
+            struct IndexItem
+            {
+                QString stamp;
+                QString name;
+                PluginIndexData data;
+            };
+
             QString pluginEntry;
-            typedef QPair<Plugin *, Handle *> Pair;
-            QMap<QString, Pair> plugins;
+            QMap<QString, Entry> plugins;
+            QString indexFileName;
+            QMap<QString, IndexItem> indexPrev;
+            QMap<QString, IndexItem> index;
+            bool indexChanged = false;
+            std::recursive_mutex mutex;
             QPointer<CoreContext> context;
+
+            Plugin * open(const QString & fileName, Handle *& handle)
+            {
+                DJV_LOG(context->debugLog(), "djv::Core::PluginFactory",
+                    QString("Loading plugin: \"%1\"...").arg(fileName));
+                QScopedPointer<Handle> _handle(new Handle);
+                try
+                {
+                    _handle->open(fileName);
+                }
+                catch (const QString & error)
+                {
+                    DJV_LOG(context->debugLog(),
+                        "djv::Core::PluginFactory",
+                        errorLabels()[ERROR_OPEN].
+                        arg(QDir::toNativeSeparators(fileName)).
+                        arg(error));
+                    return nullptr;
+                }
+                djvCorePluginEntry * entry = (djvCorePluginEntry *)_handle->fnc(pluginEntry);
+                if (!entry)
+                {
+                    DJV_LOG(context->debugLog(), "djv::Core::PluginFactory",
+                        "No plugin entry point");
+                    return nullptr;
+                }
+                QScopedPointer<Plugin> plugin;
+                try
+                {
+                    plugin.reset(entry(context));
+                }
+                catch (const Error & error)
+                {
+                    DJV_LOG(context->debugLog(), "djv::Core::PluginFactory",
+                        ErrorUtil::format(error).join("\n"));
+                    plugin.reset();
+                }
+                if (!plugin.data())
+                {
+                    DJV_LOG(context->debugLog(), "djv::Core::PluginFactory",
+                        errorLabels()[ERROR_LOAD].
+                        arg(QDir::toNativeSeparators(fileName)));
+                    return nullptr;
+                }
+                handle = _handle.take();
+                return plugin.take();
+            }
+
+            bool init(Plugin * plugin)
+            {
+                try
+                {
+                    plugin->initPlugin();
+                }
+                catch (const Error & error)
+                {
+                    DJV_LOG(context->debugLog(), "djv::Core::PluginFactory",
+                        ErrorUtil::format(error).join("\n"));
+                    plugin->releasePlugin();
+                    return false;
+                }
+                return true;
+            }
+
+            void indexRead()
+            {
+                QSettings settings(indexFileName, QSettings::IniFormat);
+                const int size = settings.beginReadArray("plugins");
+                for (int i = 0; i < size; ++i)
+                {
+                    settings.setArrayIndex(i);
+                    IndexItem item;
+                    const QString key = settings.value("key").toString();
+                    item.stamp = settings.value("stamp").toString();
+                    item.name = settings.value("name").toString();
+                    settings.beginGroup("data");
+                    Q_FOREACH(const QString & dataKey, settings.childKeys())
+                    {
+                        item.data[dataKey] = settings.value(dataKey).toStringList();
+                    }
+                    settings.endGroup();
+                    index[key] = item;
+                }
+                settings.endArray();
+            }
+
+            void indexWrite()
+            {
+                QDir().mkpath(QFileInfo(indexFileName).absolutePath());
+                QSettings settings(indexFileName, QSettings::IniFormat);
+                settings.clear();
+                settings.beginWriteArray("plugins");
+                int i = 0;
+                for (auto j = index.begin(); j != index.end(); ++j, ++i)
+                {
+                    settings.setArrayIndex(i);
+                    settings.setValue("key", j.key());
+                    settings.setValue("stamp", j.value().stamp);
+                    settings.setValue("name", j.value().name);
+                    settings.beginGroup("data");
+                    for (auto k = j.value().data.begin(); k != j.value().data.end(); ++k)
+                    {
+                        settings.setValue(k.key(), k.value());
+                    }
+                    settings.endGroup();
+                }
+                settings.endArray();
+                settings.sync();
+                indexChanged = false;
+                DJV_LOG(context->debugLog(), "djv::Core::PluginFactory",
+                    QString("Wrote plugin index: \"%1\"").arg(QDir::toNativeSeparators(indexFileName)));
+            }
         };
 
         PluginFactory::PluginFactory(
@@ -168,6 +341,17 @@ namespace djv
             //DJV_DEBUG_PRINT("plugin prefix = " << pluginPrefix);
             //DJV_DEBUG_PRINT("plugin suffix = " << pluginSuffix);
 
+            Timer timer;
+            _p->pluginEntry = pluginEntry;
+
+            // Read the plugin index.
+            _p->indexFileName = indexFileName(pluginEntry);
+            DJV_LOG(context->debugLog(), "djv::Core::PluginFactory",
+                QString("Reading plugin index: \"%1\"").arg(QDir::toNativeSeparators(_p->indexFileName)));
+            _p->indexRead();
+            _p->indexPrev = _p->index;
+            _p->index.clear();
+
             //! \todo Hard-coded OS specific shared library file extensions.
             QStringList glob;
 #if defined(DJV_WINDOWS)
@@ -205,142 +389,281 @@ namespace djv
                 }
             }
 
-            // Load plugins.
+            // Add the plugins. Plugins that are in the index are not loaded until
+            // they are needed, other plugins are loaded now so they can be added
+            // to the index.
             //DJV_DEBUG_PRINT("fileInfoList = " << fileInfoList.count());
+            int indexed = 0;
+            int loaded = 0;
             Q_FOREACH(const FileInfo & fileInfo, fileInfoList)
             {
-                // Open.
-                //DJV_DEBUG_PRINT("loading = " << fileInfo);
-                DJV_LOG(context->debugLog(), "djv::Core::PluginFactory",
-                    QString("Loading plugin: \"%1\"...").arg(fileInfo));
-                QScopedPointer<Handle> handle(new Handle);
-                try
-                {
-                    handle->open(fileInfo);
-                }
-                catch (const QString & error)
-                {
-                    DJV_LOG(context->debugLog(),
-                        "djv::Core::PluginFactory",
-                        errorLabels()[ERROR_OPEN].
-                        arg(QDir::toNativeSeparators(fileInfo)).
-                        arg(error));
-                    continue;
-                }
-                djvCorePluginEntry * entry = (djvCorePluginEntry *)handle->fnc(pluginEntry);
-                if (!entry)
+                const QString fileName = QFileInfo(fileInfo).absoluteFilePath();
+                const QString stamp = fileStamp(QFileInfo(fileName));
+                Private::Entry entry;
+                entry.fileName = fileName;
+                entry.indexKey = fileName;
+                Private::IndexItem item;
+                item.stamp = stamp;
+                const auto i = _p->indexPrev.find(fileName);
+                if (i != _p->indexPrev.end() && i.value().stamp == stamp)
                 {
-                    DJV_LOG(context->debugLog(), "djv::Core::PluginFactory",
-                        "No plugin entry point");
-                    continue;
+                    item = i.value();
+                    entry.data = item.data;
+                    entry.indexed = true;
+                    ++indexed;
                 }
-                QScopedPointer<Plugin> plugin;
-                try
+                else
                 {
-                    plugin.reset(entry(_p->context));
+                    _p->indexChanged = true;
+                    Handle * handle = nullptr;
+                    if (Plugin * plugin = _p->open(fileName, handle))
+                    {
+                        if (_p->init(plugin))
+                        {
+                            item.name = plugin->pluginName();
+                            entry.plugin = plugin;
+                            entry.handle = handle;
+                            ++loaded;
+                        }
+                        else
+                        {
+                            delete plugin;
+                            delete handle;
+                        }
+                    }
                 }
-                catch (const Error & error)
-                {
-                    DJV_LOG(context->debugLog(), "djv::Core::PluginFactory",
-                        ErrorUtil::format(error).join("\n"));
 
-                    plugin.reset();
-                }
-                if (!plugin.data())
-                {
-                    DJV_LOG(context->debugLog(), "djv::Core::PluginFactory",
-                        errorLabels()[ERROR_LOAD].
-                        arg(QDir::toNativeSeparators(fileInfo)));
+                // Plugins that cannot be loaded are kept in the index with an
+                // empty name so they are not tried again until they change.
+                _p->index[fileName] = item;
+                if (item.name.isEmpty())
                     continue;
-                }
-                //DJV_DEBUG_PRINT("name = " << plugin->pluginName());
+
+                //DJV_DEBUG_PRINT("name = " << item.name);
                 DJV_LOG(context->debugLog(), "djv::Core::PluginFactory",
-                    QString("Plugin name: \"%1\"").arg(plugin->pluginName()));
+                    QString("Plugin name: \"%1\"").arg(item.name));
 
                 // Check for duplicates.
-                if (_p->plugins.contains(plugin->pluginName()))
+                if (_p->plugins.contains(item.name))
                 {
                     //DJV_DEBUG_PRINT("duplicate");
                     DJV_LOG(context->debugLog(), "djv::Core::PluginFactory",
                         "Duplicate plugin, discarding");
-                    plugin.reset();
-                    continue;
-                }
-
-                // Initialize.
-                try
-                {
-                    plugin->initPlugin();
-                }
-                catch (const Error & error)
-                {
-                    DJV_LOG(context->debugLog(), "djv::Core::PluginFactory",
-                        ErrorUtil::format(error).join("\n"));
-                    plugin->releasePlugin();
-                    plugin.reset();
+                    if (entry.plugin)
+                    {
+                        entry.plugin->releasePlugin();
+                        delete entry.plugin;
+                        delete entry.handle;
+                    }
                     continue;
                 }
 
-                // Add.
-                Plugin * p = plugin.take();
-                Handle * h = handle.take();
-                _p->plugins[p->pluginName()] = Private::Pair(p, h);
+                _p->plugins[item.name] = entry;
             }
 
+            timer.check();
             DJV_LOG(context->debugLog(), "djv::Core::PluginFactory",
-                QString("Plugins loaded: %1").arg(_p->plugins.count()));
+                QString("Plugins found: %1 (indexed: %2, loaded: %3, time: %4 seconds)").
+                arg(_p->plugins.count()).
+                arg(indexed).
+                arg(loaded).
+                arg(timer.seconds()));
         }
 
         PluginFactory::~PluginFactory()
         {
             //DJV_DEBUG("PluginFactory::~PluginFactory");
-            Q_FOREACH(Private::Pair pair, _p->plugins)
+            Q_FOREACH(const Private::Entry & entry, _p->plugins)
             {
-                pair.first->releasePlugin();
-                delete pair.first;
-                delete pair.second;
+                if (entry.plugin)
+                {
+                    entry.plugin->releasePlugin();
+                    delete entry.plugin;
+                }
+                delete entry.handle;
             }
         }
 
         QList<Plugin *> PluginFactory::plugins() const
         {
             QList<Plugin *> list;
-            Q_FOREACH(Private::Pair pair, _p->plugins)
+            Q_FOREACH(const QString & name, names())
             {
-                list += pair.first;
+                if (Plugin * plugin = _load(name))
+                {
+                    list += plugin;
+                }
             }
             return list;
         }
 
         Plugin * PluginFactory::plugin(const QString & name) const
         {
-            return _p->plugins.contains(name) ? _p->plugins[name].first : 0;
+            return _load(name);
+        }
+
+        bool PluginFactory::isLoaded(const QString & name) const
+        {
+            std::unique_lock<std::recursive_mutex> lock(_p->mutex);
+            const auto i = _p->plugins.find(name);
+            return i != _p->plugins.end() && i.value().plugin;
         }
 
         QStringList PluginFactory::names() const
         {
+            std::unique_lock<std::recursive_mutex> lock(_p->mutex);
             QStringList out;
-            Q_FOREACH(QString name, _p->plugins.keys())
+            for (auto i = _p->plugins.begin(); i != _p->plugins.end(); ++i)
             {
-                out += name;
+                if (!i.value().failed)
+                {
+                    out += i.key();
+                }
             }
             return out;
         }
 
+        PluginIndexData PluginFactory::indexData(const QString & name) const
+        {
+            std::unique_lock<std::recursive_mutex> lock(_p->mutex);
+            const auto i = _p->plugins.find(name);
+            return i != _p->plugins.end() ? i.value().data : PluginIndexData();
+        }
+
         void PluginFactory::addPlugin(Plugin * in)
         {
             //DJV_DEBUG("PluginFactory::addPlugin");
-            try
+            std::unique_lock<std::recursive_mutex> lock(_p->mutex);
+            if (_p->init(in))
+            {
+                Private::Entry entry;
+                entry.plugin = in;
+                entry.data = pluginIndexData(in);
+                entry.indexed = true;
+                _p->plugins[in->pluginName()] = entry;
+                pluginLoaded(in);
+            }
+        }
+
+        void PluginFactory::addPlugin(const QString & name, const std::function<Plugin *(void)> & create)
+        {
+            //DJV_DEBUG("PluginFactory::addPlugin");
+            std::unique_lock<std::recursive_mutex> lock(_p->mutex);
+            Private::Entry entry;
+            entry.create = create;
+            entry.indexKey = builtinKey + name;
+            Private::IndexItem item;
+            item.stamp = builtinStamp();
+            item.name = name;
+            const auto i = _p->indexPrev.find(entry.indexKey);
+            if (i != _p->indexPrev.end() && i.value().stamp == item.stamp)
+            {
+                entry.data = i.value().data;
+                entry.indexed = true;
+                _p->plugins[name] = entry;
+                _p->index[entry.indexKey] = i.value();
+            }
+            else
+            {
+                // Create the plugin now so it can be added to the index. The
+                // index is written by indexSave().
+                _p->plugins[name] = entry;
+                if (Plugin * plugin = _load(name))
+                {
+                    item.data = pluginIndexData(plugin);
+                    _p->plugins[name].data = item.data;
+                    _p->plugins[name].indexed = true;
+                    _p->index[entry.indexKey] = item;
+                    _p->indexChanged = true;
+                }
+            }
+        }
+
+        void PluginFactory::indexSave()
+        {
+            std::unique_lock<std::recursive_mutex> lock(_p->mutex);
+            if (_p->indexChanged || _p->index.keys() != _p->indexPrev.keys())
+            {
+                _p->indexWrite();
+                _p->indexPrev = _p->index;
+            }
+        }
+
+        PluginIndexData PluginFactory::pluginIndexData(Plugin *) const
+        {
+            return PluginIndexData();
+        }
+
+        void PluginFactory::pluginLoaded(Plugin *)
+        {}
+
+        void PluginFactory::indexUpdate()
+        {
+            std::unique_lock<std::recursive_mutex> lock(_p->mutex);
+            for (auto i = _p->plugins.begin(); i != _p->plugins.end(); ++i)
+            {
+                Private::Entry & entry = i.value();
+                if (entry.plugin && !entry.indexed)
+                {
+                    entry.data = pluginIndexData(entry.plugin);
+                    entry.indexed = true;
+                    if (!entry.indexKey.isEmpty())
+                    {
+                        _p->index[entry.indexKey].data = entry.data;
+                        _p->indexChanged = true;
+                    }
+                }
+            }
+        }
+
+        Plugin * PluginFactory::_load(const QString & name) const
+        {
+            std::unique_lock<std::recursive_mutex> lock(_p->mutex);
+            const auto i = _p->plugins.find(name);
+            if (i == _p->plugins.end())
+                return nullptr;
+            Private::Entry & entry = i.value();
+            if (entry.plugin || entry.failed)
+                return entry.plugin;
+            //DJV_DEBUG("PluginFactory::_load");
+            //DJV_DEBUG_PRINT("name = " << name);
+            Timer timer;
+            Plugin * plugin = nullptr;
+            Handle * handle = nullptr;
+            if (entry.create)
+            {
+                try
+                {
+                    plugin = entry.create();
+                }
+                catch (const Error & error)
+                {
+                    DJV_LOG(_p->context->debugLog(), "djv::Core::PluginFactory",
+                        ErrorUtil::format(error).join("\n"));
+                }
+            }
+            else
+            {
+                plugin = _p->open(entry.fileName, handle);
+            }
+            if (plugin && !_p->init(plugin))
             {
-                in->initPlugin();
-                _p->plugins[in->pluginName()] = Private::Pair(in, nullptr);
+                delete plugin;
+                plugin = nullptr;
             }
-            catch (const Error & error)
+            if (!plugin)
             {
-                DJV_LOG(_p->context->debugLog(), "djv::Core::PluginFactory",
-                    ErrorUtil::format(error).join("\n"));
-                in->releasePlugin();
+                delete handle;
+                entry.failed = true;
+                return nullptr;
             }
+            entry.plugin = plugin;
+            entry.handle = handle;
+            const_cast<PluginFactory *>(this)->pluginLoaded(plugin);
+            timer.check();
+            DJV_LOG(_p->context->debugLog(), "djv::Core::PluginFactory",
+                QString("Loaded plugin: \"%1\" (%2 seconds)").arg(name).arg(timer.seconds()));
+            return plugin;
         }
 
         const QStringList & PluginFactory::errorLabels()
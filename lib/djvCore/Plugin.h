@@ -32,10 +32,13 @@
 #include <djvCore/Error.h>
 #include <djvCore/Util.h>
 
+#include <QMap>
 #include <QObject>
 #include <QPointer>
 #include <QString>
+#include <QStringList>
 
+#include <functional>
 #include <memory>
 
 #if defined DJV_WINDOWS
@@ -77,7 +80,16 @@ namespace djv
             std::unique_ptr<Private> _p;
         };
 
+        //! This typedef provides plugin index data. The index data is cached on
+        //! disk so that plugins can be found without being loaded.
+        typedef QMap<QString, QStringList> PluginIndexData;
+
         //! This class provides the base functionality for plugin factories.
+        //!
+        //! Plugins are loaded lazily. The factory keeps an index of the available
+        //! plugins which is cached on disk and keyed by the plugin file
+        //! modification times, and plugins are only opened and initialized the
+        //! first time they are requested.
         class PluginFactory : public QObject
         {
             Q_OBJECT
@@ -92,18 +104,31 @@ namespace djv
                 QObject * parent = nullptr);
             virtual ~PluginFactory() = 0;
 
-            //! Get the list of plugins.
+            //! Get the list of plugins. Note that this loads all of the plugins.
             QList<Plugin *> plugins() const;
 
-            //! Get a plugin by name.
+            //! Get a plugin by name, loading it if necessary.
             Plugin * plugin(const QString &) const;
 
+            //! Get whether a plugin has been loaded.
+            bool isLoaded(const QString &) const;
+
             //! Get the list of plugin names.
             QStringList names() const;
 
+            //! Get the index data for a plugin.
+            PluginIndexData indexData(const QString &) const;
+
             //! Add a plugin.
             virtual void addPlugin(Plugin *);
 
+            //! Add a plugin that is created the first time it is requested.
+            virtual void addPlugin(const QString & name, const std::function<Plugin *(void)> &);
+
+            //! Write the plugin index if it has changed. This should be called
+            //! once after all of the plugins have been added.
+            void indexSave();
+
             //! This enumeration provides error codes.
             enum ERROR
             {
@@ -116,7 +141,22 @@ namespace djv
             //! Get the error code labels.
             static const QStringList & errorLabels();
 
+        protected:
+            //! Get the index data for a plugin. The default implementation
+            //! returns empty data.
+            virtual PluginIndexData pluginIndexData(Plugin *) const;
+
+            //! This function is called when a plugin is loaded.
+            virtual void pluginLoaded(Plugin *);
+
+            //! Update the index data of the plugins that have been loaded but not
+            //! yet indexed. This should be called by derived classes at the end
+            //! of their constructor.
+            void indexUpdate();
+
         private:
+            Plugin * _load(const QString &) const;
+
             DJV_PRIVATE_COPY(PluginFactory);
 
             struct Private;
@@ -37,6 +37,8 @@
 
 #include <QCoreApplication>
 
+#include <algorithm>
+
 namespace djv
 {
     namespace Core
@@ -102,6 +104,26 @@ namespace djv
             qSort(frames.begin(), frames.end(), compare);
         }
 
+        int Sequence::insertFrame(qint64 frame)
+        {
+            const auto i = std::lower_bound(frames.begin(), frames.end(), frame);
+            if (i != frames.end() && *i == frame)
+                return -1;
+            const int index = static_cast<int>(i - frames.begin());
+            frames.insert(index, frame);
+            return index;
+        }
+
+        int Sequence::removeFrame(qint64 frame)
+        {
+            const int index = frames.indexOf(frame);
+            if (index != -1)
+            {
+                frames.remove(index);
+            }
+            return index;
+        }
+
         qint64 Sequence::findClosest(qint64 frame, const FrameList & frames)
         {
             const int count = frames.count();
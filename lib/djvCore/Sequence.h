@@ -67,6 +67,14 @@ namespace djv
             //! Sort the frame numbers in a sequence.
             void sort();
 
+            //! Insert a frame number into a sorted sequence. Returns the index of
+            //! the new frame, or -1 if the frame is already in the sequence.
+            int insertFrame(qint64);
+
+            //! Remove a frame number from a sequence. Returns the index of the
+            //! removed frame, or -1 if the frame is not in the sequence.
+            int removeFrame(qint64);
+
             //! Find the closest frame in a sequence.
             static qint64 findClosest(qint64, const FrameList &);
 
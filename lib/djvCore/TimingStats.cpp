@@ -0,0 +1,151 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCore/TimingStats.h>
+
+#include <djvCore/Math.h>
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace
+        {
+            struct Sample
+            {
+                float   seconds   = 0.f;
+                quint64 byteCount = 0;
+            };
+
+        } // namespace
+
+        struct TimingStats::Private
+        {
+            size_t              windowSize = 0;
+            std::vector<Sample> samples;
+            size_t              next = 0;
+            mutable std::mutex  mutex;
+        };
+
+        TimingStats::TimingStats(size_t windowSize) :
+            _p(new Private)
+        {
+            _p->windowSize = std::max(windowSize, static_cast<size_t>(1));
+            _p->samples.reserve(_p->windowSize);
+        }
+
+        TimingStats::~TimingStats()
+        {}
+
+        size_t TimingStats::windowSize() const
+        {
+            return _p->windowSize;
+        }
+
+        void TimingStats::add(float seconds, quint64 byteCount)
+        {
+            Sample sample;
+            sample.seconds = seconds;
+            sample.byteCount = byteCount;
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            if (_p->samples.size() < _p->windowSize)
+            {
+                _p->samples.push_back(sample);
+            }
+            else
+            {
+                _p->samples[_p->next] = sample;
+            }
+            _p->next = (_p->next + 1) % _p->windowSize;
+        }
+
+        TimingStats::Summary TimingStats::summary() const
+        {
+            std::vector<float> seconds;
+            quint64 byteCount = 0;
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                seconds.reserve(_p->samples.size());
+                for (const auto & i : _p->samples)
+                {
+                    seconds.push_back(i.seconds);
+                    byteCount += i.byteCount;
+                }
+            }
+            Summary out;
+            out.count = seconds.size();
+            if (out.count)
+            {
+                double sum = 0.0;
+                for (const auto i : seconds)
+                {
+                    sum += i;
+                }
+                out.mean = static_cast<float>(sum / out.count);
+                out.max = *std::max_element(seconds.begin(), seconds.end());
+                const size_t p95 = Math::min(out.count * 95 / 100, out.count - 1);
+                std::nth_element(seconds.begin(), seconds.begin() + p95, seconds.end());
+                out.p95 = seconds[p95];
+                if (sum > 0.0)
+                {
+                    out.bytesPerSecond = static_cast<float>(byteCount / sum);
+                }
+            }
+            return out;
+        }
+
+        void TimingStats::reset()
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            _p->samples.clear();
+            _p->next = 0;
+        }
+
+    } // namespace Core
+
+    bool operator == (const Core::TimingStats::Summary & a, const Core::TimingStats::Summary & b)
+    {
+        return
+            a.count == b.count &&
+            Core::Math::fuzzyCompare(a.mean, b.mean) &&
+            Core::Math::fuzzyCompare(a.p95, b.p95) &&
+            Core::Math::fuzzyCompare(a.max, b.max) &&
+            Core::Math::fuzzyCompare(a.bytesPerSecond, b.bytesPerSecond);
+    }
+
+    bool operator != (const Core::TimingStats::Summary & a, const Core::TimingStats::Summary & b)
+    {
+        return !(a == b);
+    }
+
+} // namespace djv
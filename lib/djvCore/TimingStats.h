@@ -0,0 +1,87 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvCore/Util.h>
+
+#include <QtGlobal>
+
+#include <memory>
+
+namespace djv
+{
+    namespace Core
+    {
+        //! This class provides rolling timing statistics.
+        //!
+        //! Samples are kept in a fixed size window, the oldest samples are
+        //! replaced as new samples are added. Samples may be added from any
+        //! thread.
+        class TimingStats
+        {
+        public:
+            explicit TimingStats(size_t windowSize = 120);
+            ~TimingStats();
+
+            //! This struct provides a summary of the samples in the window.
+            struct Summary
+            {
+                size_t count          = 0;
+                float  mean           = 0.f;
+                float  p95            = 0.f;
+                float  max            = 0.f;
+                float  bytesPerSecond = 0.f;
+            };
+
+            //! Get the window size.
+            size_t windowSize() const;
+
+            //! Add a sample. The byte count is the amount of data processed, it
+            //! is used for the throughput.
+            void add(float seconds, quint64 byteCount = 0);
+
+            //! Get a summary of the samples.
+            Summary summary() const;
+
+            //! Remove all of the samples.
+            void reset();
+
+        private:
+            DJV_PRIVATE_COPY(TimingStats);
+
+            struct Private;
+            std::unique_ptr<Private> _p;
+        };
+
+    } // namespace Core
+
+    DJV_COMPARISON_OPERATOR(Core::TimingStats::Summary);
+
+} // namespace djv
@@ -0,0 +1,294 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCore/Trace.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Error.h>
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace
+        {
+            struct Event
+            {
+                const char * name;
+                const char * category;
+                qint64       start;
+                qint64       duration;
+            };
+
+            //! The events are stored in fixed size chunks. Only the owning
+            //! thread appends events, the count and next pointer are atomic so
+            //! the events can be read from another thread while recording.
+            struct Chunk
+            {
+                static const size_t size = 4096;
+
+                Event                events[size];
+                std::atomic<size_t>  count;
+                std::atomic<Chunk *> next;
+            };
+
+            //! The maximum number of chunks per thread, about 32MB of events.
+            const size_t chunkMax = 256;
+
+            struct Buffer
+            {
+                Buffer(int thread) :
+                    thread(thread)
+                {
+                    head = tail = newChunk();
+                }
+
+                ~Buffer()
+                {
+                    Chunk * chunk = head;
+                    while (chunk)
+                    {
+                        Chunk * next = chunk->next.load();
+                        delete chunk;
+                        chunk = next;
+                    }
+                }
+
+                static Chunk * newChunk()
+                {
+                    Chunk * out = new Chunk;
+                    out->count.store(0);
+                    out->next.store(nullptr);
+                    return out;
+                }
+
+                int     thread     = 0;
+                Chunk * head       = nullptr;
+                Chunk * tail       = nullptr;
+                size_t  chunkCount = 1;
+            };
+
+            //! The buffers live for the lifetime of the process so that events
+            //! from threads that have finished can still be written.
+            struct Registry
+            {
+                std::mutex                           mutex;
+                std::vector<std::unique_ptr<Buffer>> buffers;
+                QString                              fileName;
+                std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+            };
+
+            Registry & registry()
+            {
+                static Registry * registry = new Registry;
+                return *registry;
+            }
+
+            thread_local Buffer * threadBuffer = nullptr;
+
+            Buffer * currentBuffer()
+            {
+                if (!threadBuffer)
+                {
+                    Registry & r = registry();
+                    std::lock_guard<std::mutex> lock(r.mutex);
+                    r.buffers.push_back(std::unique_ptr<Buffer>(
+                        new Buffer(static_cast<int>(r.buffers.size()))));
+                    threadBuffer = r.buffers.back().get();
+                }
+                return threadBuffer;
+            }
+
+            void jsonString(QByteArray & out, const char * in)
+            {
+                out += '"';
+                for (const char * p = in; p && *p; ++p)
+                {
+                    switch (*p)
+                    {
+                    case '"':  out += "\\\""; break;
+                    case '\\': out += "\\\\"; break;
+                    default:   out += *p;     break;
+                    }
+                }
+                out += '"';
+            }
+
+        } // namespace
+
+        std::atomic<bool> Trace::_enabled(false);
+
+        void Trace::setEnabled(bool value)
+        {
+            // Initialize the time origin before any events are recorded.
+            registry();
+            _enabled.store(value);
+        }
+
+        QString Trace::fileName()
+        {
+            Registry & r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            return r.fileName;
+        }
+
+        void Trace::setFileName(const QString & value)
+        {
+            Registry & r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            r.fileName = value;
+        }
+
+        qint64 Trace::timestamp()
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - registry().t0).count();
+        }
+
+        void Trace::addEvent(
+            const char * name,
+            const char * category,
+            qint64       start,
+            qint64       duration)
+        {
+            Buffer * buffer = currentBuffer();
+            Chunk * chunk = buffer->tail;
+            size_t count = chunk->count.load(std::memory_order_relaxed);
+            if (Chunk::size == count)
+            {
+                if (buffer->chunkCount >= chunkMax)
+                    return;
+                Chunk * next = Buffer::newChunk();
+                chunk->next.store(next, std::memory_order_release);
+                buffer->tail = chunk = next;
+                ++buffer->chunkCount;
+                count = 0;
+            }
+            Event & event = chunk->events[count];
+            event.name = name;
+            event.category = category;
+            event.start = start;
+            event.duration = duration;
+            chunk->count.store(count + 1, std::memory_order_release);
+        }
+
+        quint64 Trace::eventCount()
+        {
+            quint64 out = 0;
+            Registry & r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            for (const auto & buffer : r.buffers)
+            {
+                for (Chunk * chunk = buffer->head; chunk; chunk = chunk->next.load(std::memory_order_acquire))
+                {
+                    out += chunk->count.load(std::memory_order_acquire);
+                }
+            }
+            return out;
+        }
+
+        void Trace::write(const QString & fileName)
+        {
+            //DJV_DEBUG("Trace::write");
+            //DJV_DEBUG_PRINT("fileName = " << fileName);
+            QFile file(fileName);
+            if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+            {
+                throw Error(
+                    "djv::Core::Trace",
+                    errorLabels()[ERROR_OPEN].arg(QDir::toNativeSeparators(fileName)));
+            }
+            QByteArray data;
+            data += "{\"traceEvents\":[\n";
+            data += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":";
+            jsonString(data, QCoreApplication::applicationName().toUtf8().data());
+            data += "}}";
+            Registry & r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            for (const auto & buffer : r.buffers)
+            {
+                data += QString(
+                    ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%1,\"args\":{\"name\":\"Thread %1\"}}").
+                    arg(buffer->thread).toUtf8();
+                for (Chunk * chunk = buffer->head; chunk; chunk = chunk->next.load(std::memory_order_acquire))
+                {
+                    const size_t count = chunk->count.load(std::memory_order_acquire);
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        const Event & event = chunk->events[i];
+                        data += ",\n{\"name\":";
+                        jsonString(data, event.name);
+                        data += ",\"cat\":";
+                        jsonString(data, event.category);
+                        data += QString(",\"ph\":\"X\",\"ts\":%1,\"dur\":%2,\"pid\":1,\"tid\":%3}").
+                            arg(event.start).
+                            arg(event.duration).
+                            arg(buffer->thread).toUtf8();
+                    }
+                    if (data.size() > 1024 * 1024)
+                    {
+                        if (file.write(data) != data.size())
+                        {
+                            throw Error(
+                                "djv::Core::Trace",
+                                errorLabels()[ERROR_WRITE].arg(QDir::toNativeSeparators(fileName)));
+                        }
+                        data.clear();
+                    }
+                }
+            }
+            data += "\n],\"displayTimeUnit\":\"ms\"}\n";
+            if (file.write(data) != data.size())
+            {
+                throw Error(
+                    "djv::Core::Trace",
+                    errorLabels()[ERROR_WRITE].arg(QDir::toNativeSeparators(fileName)));
+            }
+        }
+
+        const QStringList & Trace::errorLabels()
+        {
+            static const QStringList data = QStringList() <<
+                qApp->translate("djv::Core::Trace", "Cannot open trace file: \"%1\"") <<
+                qApp->translate("djv::Core::Trace", "Cannot write trace file: \"%1\"");
+            DJV_ASSERT(data.count() == ERROR_COUNT);
+            return data;
+        }
+
+    } // namespace Core
+} // namespace djv
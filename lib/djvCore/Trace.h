@@ -0,0 +1,126 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvCore/Util.h>
+
+#include <QStringList>
+
+#include <atomic>
+
+namespace djv
+{
+    namespace Core
+    {
+        //! This class provides tracing for performance analysis.
+        //!
+        //! Trace events are recorded with scoped zones (see DJV_TRACE) into
+        //! per-thread buffers without locking, and written out in the Chrome
+        //! trace event format which can be viewed with chrome://tracing or
+        //! Perfetto. When tracing is disabled a zone costs one branch.
+        //!
+        //! Event names and categories must be string literals, only the
+        //! pointers are stored.
+        class Trace
+        {
+        public:
+            //! Get whether tracing is enabled.
+            static inline bool isEnabled();
+
+            //! Set whether tracing is enabled.
+            static void setEnabled(bool);
+
+            //! Get the file name the trace is written to on exit.
+            static QString fileName();
+
+            //! Set the file name the trace is written to on exit.
+            static void setFileName(const QString &);
+
+            //! Get the current time in microseconds.
+            static qint64 timestamp();
+
+            //! Add an event for the current thread.
+            static void addEvent(
+                const char * name,
+                const char * category,
+                qint64       start,
+                qint64       duration);
+
+            //! Get the number of events that have been recorded.
+            static quint64 eventCount();
+
+            //! Write the events in the Chrome trace event format.
+            //!
+            //! Throws:
+            //! - Core::Error
+            static void write(const QString & fileName);
+
+            //! This enumeration provides error codes.
+            enum ERROR
+            {
+                ERROR_OPEN,
+                ERROR_WRITE,
+
+                ERROR_COUNT
+            };
+
+            //! Get the error code labels.
+            static const QStringList & errorLabels();
+
+        private:
+            static std::atomic<bool> _enabled;
+        };
+
+        //! This class provides a scoped trace zone.
+        class TraceZone
+        {
+        public:
+            inline TraceZone(const char * name, const char * category);
+            inline ~TraceZone();
+
+        private:
+            DJV_PRIVATE_COPY(TraceZone);
+
+            const char * _name;
+            const char * _category;
+            qint64       _start = -1;
+        };
+
+    } // namespace Core
+} // namespace djv
+
+#define DJV_TRACE_CONCAT2(a, b) a##b
+#define DJV_TRACE_CONCAT(a, b) DJV_TRACE_CONCAT2(a, b)
+
+//! Add a trace zone for the current scope.
+#define DJV_TRACE(name, category) \
+    djv::Core::TraceZone DJV_TRACE_CONCAT(djvTraceZone, __LINE__)(name, category)
+
+#include <djvCore/TraceInline.h>
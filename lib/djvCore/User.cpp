@@ -38,6 +38,8 @@
 #include <unistd.h>
 #endif
 
+#include <vector>
+
 namespace djv
 {
     namespace Core
@@ -63,10 +65,14 @@ namespace djv
         {
             QString out;
 #if ! defined(DJV_WINDOWS)
-            struct passwd * buf = ::getpwuid(value);
-            if (buf)
+            // Use the reentrant version since this may be called from
+            // multiple threads when sorting directory listings.
+            struct passwd pwd;
+            struct passwd * result = nullptr;
+            std::vector<char> buf(16384);
+            if (0 == ::getpwuid_r(value, &pwd, buf.data(), buf.size(), &result) && result)
             {
-                out = buf->pw_name;
+                out = result->pw_name;
             }
 #endif // ! DJV_WINDOWS
             return out;
@@ -80,7 +80,7 @@ namespace djv
             zero(film.slate, 200);
         }
 
-        void CineonHeader::load(Core::FileIO & io, ImageIOInfo & info, bool & filmPrint)
+        void CineonHeader::load(Core::FileIO & io, ImageIOInfo & info, bool & filmPrint, bool tags)
         {
             //DJV_DEBUG("CineonHeader::load");
 
@@ -202,6 +202,72 @@ namespace djv
 
             filmPrint = DESCRIPTOR_R_FILM_PRINT == image.channel[0].descriptor[1];
 
+            // Image tags.
+            if (tags)
+            {
+                this->tags(info);
+            }
+
+            debug();
+        }
+
+        bool CineonHeader::loadLayout(Core::FileIO & io, const CineonHeader & layout)
+        {
+            //DJV_DEBUG("CineonHeader::loadLayout");
+
+            // Read.
+            io.get(&file, sizeof(File));
+            if (file.magic != layout.file.magic)
+            {
+                io.setPos(0);
+                return false;
+            }
+            io.get(&image, sizeof(Image));
+            io.get(&source, sizeof(Source));
+            io.get(&film, sizeof(Film));
+            if (magic[1] == file.magic)
+            {
+                io.setEndian(true);
+                endian();
+            }
+
+            // Compare the fields that determine the layout of the image data.
+            bool equal =
+                file.imageOffset == layout.file.imageOffset &&
+                image.orient == layout.image.orient &&
+                image.channels == layout.image.channels &&
+                image.interleave == layout.image.interleave &&
+                image.packing == layout.image.packing &&
+                image.linePadding == layout.image.linePadding &&
+                image.channelPadding == layout.image.channelPadding;
+            for (int i = 0; equal && i < image.channels && i < 8; ++i)
+            {
+                const Image::Channel & a = image.channel[i];
+                const Image::Channel & b = layout.image.channel[i];
+                equal =
+                    a.descriptor[0] == b.descriptor[0] &&
+                    a.descriptor[1] == b.descriptor[1] &&
+                    a.bitDepth == b.bitDepth &&
+                    a.size[0] == b.size[0] &&
+                    a.size[1] == b.size[1];
+            }
+            if (!equal)
+            {
+                io.setEndian(false);
+                io.setPos(0);
+                return false;
+            }
+
+            // End.
+            if (file.imageOffset)
+            {
+                io.setPos(file.imageOffset);
+            }
+            return true;
+        }
+
+        void CineonHeader::tags(ImageIOInfo & info) const
+        {
             // File image tags.
             const QStringList & tags = ImageTags::tagLabels();
             const QStringList & cineonTags = Cineon::tagLabels();
@@ -279,8 +345,6 @@ namespace djv
                 info.tags[cineonTags[Cineon::TAG_FILM_SLATE]] =
                     toString(film.slate, 200);
             }
-
-            debug();
         }
 
         void CineonHeader::save(Core::FileIO & io, const ImageIOInfo & info, Cineon::COLOR_PROFILE colorProfile)
@@ -164,7 +164,20 @@ namespace djv
             //!
             //! Throws:
             //! - Core::Error
-            void load(Core::FileIO &, ImageIOInfo &, bool & filmPrint);
+            void load(Core::FileIO &, ImageIOInfo &, bool & filmPrint, bool tags = true);
+
+            //! Load the header of a file that is expected to have the same
+            //! layout as a previously loaded header. If the fields that
+            //! determine the layout of the image data match, the file is
+            //! positioned at the image data and true is returned. Otherwise the
+            //! file is rewound and load() should be used instead.
+            //!
+            //! Throws:
+            //! - Core::Error
+            bool loadLayout(Core::FileIO &, const CineonHeader & layout);
+
+            //! Get the image tags from the header.
+            void tags(ImageIOInfo &) const;
 
             //! Save the header.
             //!
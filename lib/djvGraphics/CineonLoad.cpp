@@ -36,6 +36,7 @@
 #include <djvCore/Assert.h>
 #include <djvCore/CoreContext.h>
 #include <djvCore/FileIO.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -56,6 +57,7 @@ namespace djv
 
             _file = in;
             Core::FileIO io;
+            io.setMmap(false);
             _open(_file.fileName(_file.sequence().start()), info, io);
             if (Core::FileInfo::SEQUENCE == _file.type())
             {
@@ -67,6 +69,7 @@ namespace djv
         {
             //DJV_DEBUG("CineonLoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE("CineonLoad::read", "ImageIO");
 
             // Open the file.
             const QString fileName =
@@ -74,7 +77,7 @@ namespace djv
             //DJV_DEBUG_PRINT("file name = " << fileName);
             ImageIOInfo info;
             QScopedPointer<Core::FileIO> io(new Core::FileIO);
-            _open(fileName, info, *io);
+            _open(fileName, info, *io, frame.tags);
             image.tags = info.tags;
 
             //! Set the color profile.
@@ -152,18 +155,48 @@ namespace djv
             //DJV_DEBUG_PRINT("image = " << image);
         }
 
+        ImageLoad * CineonLoad::clone() const
+        {
+            auto out = new CineonLoad(_options, context());
+            out->_file = _file;
+            out->_filmPrintLut = _filmPrintLut;
+            out->_header = _header;
+            out->_headerInfo = _headerInfo;
+            out->_headerValid = _headerValid;
+            out->_filmPrint = _filmPrint;
+            return out;
+        }
+
         void CineonLoad::_open(
             const QString & in,
             ImageIOInfo &   info,
-            Core::FileIO &  io)
+            Core::FileIO &  io,
+            bool            tags)
         {
             //DJV_DEBUG("CineonLoad::_open");
             //DJV_DEBUG_PRINT("in = " << in);
             io.open(in, Core::FileIO::READ);
-            info.fileName = in;
-            _filmPrint = false;
+
+            // Frames of a sequence usually share the same layout, so only do
+            // a full parse of the header when it differs from the last one.
             CineonHeader header;
-            header.load(io, info, _filmPrint);
+            if (!_headerValid || !header.loadLayout(io, _header))
+            {
+                //DJV_DEBUG_PRINT("load header");
+                ImageIOInfo headerInfo;
+                bool filmPrint = false;
+                header.load(io, headerInfo, filmPrint, false);
+                _header = header;
+                _headerInfo = headerInfo;
+                _headerValid = true;
+                _filmPrint = filmPrint;
+            }
+            info = _headerInfo;
+            info.fileName = in;
+            if (tags)
+            {
+                header.tags(info);
+            }
             //DJV_DEBUG_PRINT("info = " << info);
             //DJV_DEBUG_PRINT("film print = " << _filmPrint);
         }
@@ -33,6 +33,7 @@
 #include <djvGraphics/OpenGLImage.h>
 
 #include <djvCore/CoreContext.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -76,6 +77,7 @@ namespace djv
             //DJV_DEBUG("CineonSave::write");
             //DJV_DEBUG_PRINT("in = " << in);
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE("CineonSave::write", "ImageIO");
 
             // Set the color profile.
             ColorProfile colorProfile;
@@ -0,0 +1,911 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+#include <djvGraphics/ColorPipeline.h>
+
+#include <djvGraphics/ColorUtil.h>
+#include <djvGraphics/PixelDataUtil.h>
+
+#include <djvCore/Debug.h>
+#include <djvCore/Math.h>
+#include <djvCore/Memory.h>
+#include <djvCore/Trace.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace djv
+{
+    namespace Graphics
+    {
+        namespace
+        {
+            float knee(float x, float f)
+            {
+                return Core::Math::log(x * f + 1.f) / f;
+            }
+
+            float knee2(float x, float y)
+            {
+                float f0 = 0.f, f1 = 1.f;
+                while (knee(x, f1) > y)
+                {
+                    f0 = f1;
+                    f1 = f1 * 2.f;
+                }
+                for (int i = 0; i < 30; ++i)
+                {
+                    const float f2 = (f0 + f1) / 2.f;
+                    if (knee(x, f2) < y)
+                    {
+                        f1 = f2;
+                    }
+                    else
+                    {
+                        f0 = f2;
+                    }
+                }
+                return (f0 + f1) / 2.f;
+            }
+
+            //! This struct provides a lookup table that is sampled the same way
+            //! as the OpenGL lookup table texture (nearest neighbor, clamped to
+            //! the edges).
+            struct Lut
+            {
+                void init(const PixelData & data)
+                {
+                    size = data.w();
+                    channels = data.channels();
+                    values.resize(size * channels);
+                    const Pixel::PIXEL pixel = Pixel::pixel(Pixel::format(data.pixel()), Pixel::F32);
+                    for (int i = 0; i < size; ++i)
+                    {
+                        Pixel::convert(data.data(i, 0), data.pixel(), &values[i * channels], pixel);
+                    }
+                }
+
+                float sample(float value, int channel) const
+                {
+                    const int i = static_cast<int>(Core::Math::clamp(value * size, 0.f, size - 1.f));
+                    return values[i * channels + channel];
+                }
+
+                glm::vec4 operator () (const glm::vec4 & value) const
+                {
+                    glm::vec4 out = value;
+                    switch (channels)
+                    {
+                    case 1:
+                        out[0] = sample(value[0], 0);
+                        out[1] = sample(value[1], 0);
+                        out[2] = sample(value[2], 0);
+                        break;
+                    case 2:
+                        out[0] = sample(value[0], 0);
+                        out[1] = sample(value[1], 0);
+                        out[2] = sample(value[2], 0);
+                        out[3] = sample(value[3], 1);
+                        break;
+                    case 3:
+                        out[0] = sample(value[0], 0);
+                        out[1] = sample(value[1], 1);
+                        out[2] = sample(value[2], 2);
+                        break;
+                    case 4:
+                        out[0] = sample(value[0], 0);
+                        out[1] = sample(value[1], 1);
+                        out[2] = sample(value[2], 2);
+                        out[3] = sample(value[3], 3);
+                        break;
+                    default: break;
+                    }
+                    return out;
+                }
+
+                int                size     = 0;
+                int                channels = 0;
+                std::vector<float> values;
+            };
+
+            //! This struct provides the color pipeline, matching the OpenGL
+            //! image fragment shader.
+            struct Pipeline
+            {
+                Pipeline(const OpenGLImageOptions & options) :
+                    colorProfile(options.colorProfile.type),
+                    displayProfileLut(options.displayProfile.lut.isValid()),
+                    color(options.displayProfile.color != OpenGLImageDisplayProfile().color),
+                    colorMatrix(OpenGLImageColor::colorMatrix(options.displayProfile.color)),
+                    levels(options.displayProfile.levels != OpenGLImageDisplayProfile().levels),
+                    levelsGamma(!Core::Math::fuzzyCompare(options.displayProfile.levels.gamma, 1.f)),
+                    softClip(options.displayProfile.softClip)
+                {
+                    switch (colorProfile)
+                    {
+                    case ColorProfile::GAMMA:
+                        gamma = 1.f / options.colorProfile.gamma;
+                        break;
+                    case ColorProfile::LUT:
+                        lut[0].init(options.colorProfile.lut);
+                        break;
+                    case ColorProfile::EXPOSURE:
+                        exposure.v = Core::Math::pow(2.f, options.colorProfile.exposure.value + 2.47393f);
+                        exposure.d = options.colorProfile.exposure.defog;
+                        exposure.k = Core::Math::pow(2.f, options.colorProfile.exposure.kneeLow);
+                        exposure.f = knee2(
+                            Core::Math::pow(2.f, options.colorProfile.exposure.kneeHigh) - exposure.k,
+                            Core::Math::pow(2.f, 3.5f) - exposure.k);
+                        break;
+                    default: break;
+                    }
+                    if (displayProfileLut)
+                    {
+                        lut[1].init(options.displayProfile.lut);
+                    }
+                    const auto & levelsOptions = options.displayProfile.levels;
+                    levelsIn0  = levelsOptions.inLow;
+                    levelsIn1  = levelsOptions.inHigh - levelsOptions.inLow;
+                    levelsGammaValue = 1.f / levelsOptions.gamma;
+                    levelsOut0 = levelsOptions.outLow;
+                    levelsOut1 = levelsOptions.outHigh - levelsOptions.outLow;
+                }
+
+                glm::vec4 operator () (const glm::vec4 & value) const
+                {
+                    return post(mix(pre(value)));
+                }
+
+                //! Apply the stages before the color matrix. These are applied to
+                //! each channel independently.
+                glm::vec4 pre(glm::vec4 value) const
+                {
+                    // Color profile.
+                    switch (colorProfile)
+                    {
+                    case ColorProfile::GAMMA:
+                        for (int i = 0; i < 3; ++i)
+                        {
+                            if (value[i] >= 0.f)
+                            {
+                                value[i] = Core::Math::pow(value[i], gamma);
+                            }
+                        }
+                        break;
+                    case ColorProfile::LUT:
+                        value = lut[0](value);
+                        break;
+                    case ColorProfile::EXPOSURE:
+                        for (int i = 0; i < 3; ++i)
+                        {
+                            value[i] = Core::Math::max(0.f, value[i] - exposure.d) * exposure.v;
+                            if (value[i] > exposure.k)
+                            {
+                                value[i] = exposure.k + knee(value[i] - exposure.k, exposure.f);
+                            }
+                            value[i] *= .332f;
+                        }
+                        break;
+                    default: break;
+                    }
+
+                    // Display profile.
+                    if (displayProfileLut)
+                    {
+                        value = lut[1](value);
+                    }
+                    return value;
+                }
+
+                //! Apply the color matrix. This is the only stage that mixes the
+                //! channels.
+                glm::vec4 mix(glm::vec4 value) const
+                {
+                    if (color)
+                    {
+                        const float alpha = value[3];
+                        value[3] = 1.f;
+                        value = value * colorMatrix;
+                        value[3] = alpha;
+                    }
+                    return value;
+                }
+
+                //! Get whether there are stages after the color matrix.
+                bool isPost() const
+                {
+                    return levels || softClip != 0.f;
+                }
+
+                //! Apply the stages after the color matrix. These are applied to
+                //! each channel independently.
+                glm::vec4 post(glm::vec4 value) const
+                {
+                    for (int i = 0; i < 3; ++i)
+                    {
+                        if (levels)
+                        {
+                            float tmp = (value[i] - levelsIn0) / levelsIn1;
+                            if (levelsGamma && tmp >= 0.f)
+                            {
+                                tmp = Core::Math::pow(tmp, levelsGammaValue);
+                            }
+                            value[i] = tmp * levelsOut1 + levelsOut0;
+                        }
+                        if (softClip != 0.f)
+                        {
+                            value[i] = Core::Math::softClip(value[i], softClip);
+                        }
+                    }
+                    return value;
+                }
+
+                ColorProfile::PROFILE colorProfile;
+                float                 gamma = 1.f;
+                struct
+                {
+                    float v = 0.f, d = 0.f, k = 0.f, f = 0.f;
+                }                     exposure;
+                Lut                   lut[2];
+                bool                  displayProfileLut;
+                bool                  color;
+                glm::mat4x4           colorMatrix;
+                bool                  levels;
+                bool                  levelsGamma;
+                float                 levelsIn0 = 0.f;
+                float                 levelsIn1 = 1.f;
+                float                 levelsGammaValue = 1.f;
+                float                 levelsOut0 = 0.f;
+                float                 levelsOut1 = 1.f;
+                float                 softClip;
+            };
+
+            template<typename T>
+            inline T quantize(float);
+
+            template<>
+            inline Pixel::U8_T quantize<Pixel::U8_T>(float value)
+            {
+                return Pixel::f32ToU8(value);
+            }
+
+            template<>
+            inline Pixel::U16_T quantize<Pixel::U16_T>(float value)
+            {
+                return Pixel::f32ToU16(value);
+            }
+
+            //! This struct provides transformed and filtered sampling of pixel
+            //! data, matching the geometry of OpenGLImage::draw().
+            struct Sampler
+            {
+                Sampler(const PixelData & data, const OpenGLImageOptions & options) :
+                    data(data),
+                    w(data.w()),
+                    h(data.h()),
+                    pixel(data.pixel()),
+                    format(Pixel::format(data.pixel())),
+                    floatPixel(Pixel::pixel(Pixel::format(data.pixel()), Pixel::F32)),
+                    bgr(data.info().bgr),
+                    mirror(
+                        data.info().mirror.x != options.xform.mirror.x,
+                        data.info().mirror.y != options.xform.mirror.y)
+                {
+                    if (!w || !h)
+                        return;
+
+                    // Choose the filter the same way as OpenGLImage::draw().
+                    const int proxyScale =
+                        options.proxyScale ?
+                        PixelDataUtil::proxyScale(data.info().proxy) :
+                        1;
+                    const glm::ivec2 scale(
+                        Core::Math::ceil(options.xform.scale.x * w * proxyScale),
+                        Core::Math::ceil(options.xform.scale.y * h * proxyScale));
+                    filter =
+                        data.info().size == scale ? OpenGLImageFilter::NEAREST :
+                        (scale.x * scale.y < w * h ? options.filter.min : options.filter.mag);
+
+                    // The windowed filters scale the image before it is
+                    // transformed.
+                    OpenGLImageXform xform = options.xform;
+                    switch (filter)
+                    {
+                    case OpenGLImageFilter::NEAREST:
+                    case OpenGLImageFilter::LINEAR:
+                        size = glm::vec2(w * proxyScale, h * proxyScale);
+                        break;
+                    default:
+                        size = glm::vec2(scale);
+                        xform.scale = glm::vec2(1.f, 1.f);
+                        support = OpenGLImageFilter::kernelSupport(filter);
+                        for (int i = 0; i < 2; ++i)
+                        {
+                            const float s = size[i] / static_cast<float>(data.info().size[i]);
+                            kernelScale[i] = s < 1.f ? s : 1.f;
+                            radius[i] = support / kernelScale[i];
+                        }
+                        break;
+                    }
+                    inverse = glm::inverse(OpenGLImageXform::xformMatrix(xform));
+
+                    // Byte swapping is done per channel, except for the packed
+                    // pixel types.
+                    swap = data.info().endian != Core::Memory::endian() && Pixel::channelByteCount(pixel) > 1;
+                    wordSize = Pixel::RGB_U10 == pixel ? Pixel::byteCount(pixel) : Pixel::channelByteCount(pixel);
+                    words = Pixel::byteCount(pixel) / wordSize;
+                }
+
+                //! Get a pixel converted to the pipeline channels.
+                glm::vec4 fetch(int x, int y) const
+                {
+                    const quint8 * p = data.data(
+                        Core::Math::clamp(x, 0, w - 1),
+                        Core::Math::clamp(y, 0, h - 1));
+                    quint8 tmp[Pixel::channelsMax * 4];
+                    if (swap)
+                    {
+                        Core::Memory::convertEndian(p, tmp, words, wordSize);
+                        p = tmp;
+                    }
+                    float f[Pixel::channelsMax] = { 0.f, 0.f, 0.f, 0.f };
+                    Pixel::convert(p, pixel, f, floatPixel);
+                    switch (format)
+                    {
+                    case Pixel::L:   return glm::vec4(f[0], f[0], f[0], 1.f);
+                    case Pixel::LA:  return glm::vec4(f[0], f[0], f[0], f[1]);
+                    case Pixel::RGB: return bgr ? glm::vec4(f[2], f[1], f[0], 1.f) : glm::vec4(f[0], f[1], f[2], 1.f);
+                    default: break;
+                    }
+                    return bgr ? glm::vec4(f[2], f[1], f[0], f[3]) : glm::vec4(f[0], f[1], f[2], f[3]);
+                }
+
+                //! Sample the pixel data at the given output position. This
+                //! returns false if the position is outside of the image.
+                bool operator () (const glm::vec2 & position, glm::vec4 & out) const
+                {
+                    if (!w || !h)
+                        return false;
+                    const glm::vec4 p = inverse * glm::vec4(position.x, position.y, 0.f, 1.f);
+                    if (p.x < 0.f || p.x >= size.x || p.y < 0.f || p.y >= size.y)
+                        return false;
+
+                    // Convert to texel coordinates.
+                    float u = p.x / size.x;
+                    float v = p.y / size.y;
+                    if (mirror.x)
+                    {
+                        u = 1.f - u;
+                    }
+                    if (mirror.y)
+                    {
+                        v = 1.f - v;
+                    }
+                    const float tx = u * w - .5f;
+                    const float ty = v * h - .5f;
+                    switch (filter)
+                    {
+                    case OpenGLImageFilter::NEAREST:
+                        out = fetch(Core::Math::floor(tx + .5f), Core::Math::floor(ty + .5f));
+                        break;
+                    case OpenGLImageFilter::LINEAR:
+                    {
+                        const int x0 = Core::Math::floor(tx);
+                        const int y0 = Core::Math::floor(ty);
+                        const float fx = tx - x0;
+                        const float fy = ty - y0;
+                        out =
+                            (fetch(x0, y0)     * (1.f - fx) + fetch(x0 + 1, y0)     * fx) * (1.f - fy) +
+                            (fetch(x0, y0 + 1) * (1.f - fx) + fetch(x0 + 1, y0 + 1) * fx) * fy;
+                        break;
+                    }
+                    default:
+                    {
+                        const int x0 = Core::Math::ceil(tx - radius.x);
+                        const int x1 = Core::Math::floor(tx + radius.x);
+                        const int y0 = Core::Math::ceil(ty - radius.y);
+                        const int y1 = Core::Math::floor(ty + radius.y);
+                        glm::vec4 sum(0.f, 0.f, 0.f, 0.f);
+                        float weightSum = 0.f;
+                        for (int y = y0; y <= y1; ++y)
+                        {
+                            const float wy = OpenGLImageFilter::kernel(filter, (ty - y) * kernelScale.y);
+                            if (0.f == wy)
+                                continue;
+                            for (int x = x0; x <= x1; ++x)
+                            {
+                                const float weight = wy * OpenGLImageFilter::kernel(filter, (tx - x) * kernelScale.x);
+                                sum += fetch(x, y) * weight;
+                                weightSum += weight;
+                            }
+                        }
+                        out = weightSum != 0.f ? sum / weightSum : fetch(Core::Math::floor(tx + .5f), Core::Math::floor(ty + .5f));
+                        break;
+                    }
+                    }
+                    return true;
+                }
+
+                const PixelData &         data;
+                int                       w;
+                int                       h;
+                Pixel::PIXEL              pixel;
+                Pixel::FORMAT             format;
+                Pixel::PIXEL              floatPixel;
+                bool                      bgr;
+                bool                      swap     = false;
+                int                       wordSize = 1;
+                int                       words    = 0;
+                PixelDataInfo::Mirror     mirror;
+                OpenGLImageFilter::FILTER filter   = OpenGLImageFilter::NEAREST;
+                glm::mat4x4               inverse;
+                glm::vec2                 size     = glm::vec2(0.f, 0.f);
+                float                     support  = 0.f;
+                glm::vec2                 kernelScale = glm::vec2(1.f, 1.f);
+                glm::vec2                 radius   = glm::vec2(0.f, 0.f);
+            };
+
+            //! The minimum number of pixels given to each thread.
+            const int threadPixelsMin = 65536;
+
+            //! Split the scanlines of an image between threads.
+            template<typename F>
+            void splitScanlines(int w, int h, const F & work)
+            {
+                const int threads = Core::Math::clamp(
+                    static_cast<int>(static_cast<qint64>(w) * h / threadPixelsMin),
+                    1,
+                    std::max(static_cast<int>(std::thread::hardware_concurrency()), 1));
+                //DJV_DEBUG_PRINT("threads = " << threads);
+                std::vector<std::thread> workers;
+                for (int i = 1; i < threads; ++i)
+                {
+                    workers.push_back(std::thread(work, h * i / threads, h * (i + 1) / threads));
+                }
+                work(0, h / threads);
+                for (auto & i : workers)
+                {
+                    i.join();
+                }
+            }
+
+        } // namespace
+
+        struct ColorPipeline::Private
+        {
+            bool                        baked   = false;
+            Pixel::PIXEL                input   = static_cast<Pixel::PIXEL>(0);
+            Pixel::PIXEL                output  = static_cast<Pixel::PIXEL>(0);
+            ColorProfile                colorProfile;
+            OpenGLImageDisplayProfile   displayProfile;
+            OpenGLImageOptions::CHANNEL channel = OpenGLImageOptions::CHANNEL_DEFAULT;
+
+            //! The pipeline channel for each output channel.
+            int outputChannels[Pixel::channelsMax] = { 0, 0, 0, 0 };
+
+            //! The input channel for each pipeline channel, or -1 if the value
+            //! is opaque.
+            int inputChannels[Pixel::channelsMax] = { 0, 0, 0, 0 };
+
+            //! The 1D lookup tables for each pipeline channel, indexed by the
+            //! input code value and holding output code values.
+            std::vector<quint16> lut1D[Pixel::channelsMax];
+
+            //! When the color channels are mixed, the lookup tables for the
+            //! stages before the color matrix, indexed by the input code value
+            //! and holding floating point values. The color matrix and the
+            //! stages after it are applied to each pixel.
+            bool                      isMixed = false;
+            std::vector<float>        preLut[3];
+            std::unique_ptr<Pipeline> pipeline;
+
+            template<typename IN_T, typename OUT_T>
+            void process(
+                const PixelData &             input,
+                PixelData &                   output,
+                const PixelDataInfo::Mirror & mirror,
+                int                           y0,
+                int                           y1) const;
+        };
+
+        template<typename IN_T, typename OUT_T>
+        void ColorPipeline::Private::process(
+            const PixelData &             input,
+            PixelData &                   output,
+            const PixelDataInfo::Mirror & mirror,
+            int                           y0,
+            int                           y1) const
+        {
+            const int w = output.w();
+            const int h = output.h();
+            const int inChannels  = input.channels();
+            const int outChannels = output.channels();
+            const int inMax = Pixel::max(this->input);
+
+            // Resolve the lookups for each output channel.
+            const quint16 * tables[Pixel::channelsMax];
+            int             offsets[Pixel::channelsMax];
+            bool            mixed[Pixel::channelsMax];
+            bool            mixedAny = false;
+            for (int c = 0; c < outChannels; ++c)
+            {
+                const int channel = outputChannels[c];
+                tables[c] = lut1D[channel].data();
+                offsets[c] = inputChannels[channel];
+                mixed[c] = isMixed && channel < 3;
+                mixedAny |= mixed[c];
+            }
+            const int inStride = mirror.x ? -inChannels : inChannels;
+            const bool post = isMixed && pipeline->isPost();
+            for (int y = y0; y < y1; ++y)
+            {
+                const IN_T * inP = reinterpret_cast<const IN_T *>(
+                    input.data(mirror.x ? (w - 1) : 0, mirror.y ? (h - 1 - y) : y));
+                OUT_T * outP = reinterpret_cast<OUT_T *>(output.data(0, y));
+                for (int x = 0; x < w; ++x, inP += inStride, outP += outChannels)
+                {
+                    glm::vec4 rgb(0.f, 0.f, 0.f, 1.f);
+                    if (mixedAny)
+                    {
+                        rgb = pipeline->mix(glm::vec4(
+                            preLut[0][inP[inputChannels[0]]],
+                            preLut[1][inP[inputChannels[1]]],
+                            preLut[2][inP[inputChannels[2]]],
+                            1.f));
+                        if (post)
+                        {
+                            rgb = pipeline->post(rgb);
+                        }
+                    }
+                    for (int c = 0; c < outChannels; ++c)
+                    {
+                        // Opaque channels are looked up with the maximum code value.
+                        outP[c] =
+                            mixed[c] ? quantize<OUT_T>(rgb[outputChannels[c]]) :
+                            static_cast<OUT_T>(tables[c][offsets[c] >= 0 ? inP[offsets[c]] : inMax]);
+                    }
+                }
+            }
+        }
+
+        ColorPipeline::ColorPipeline() :
+            _p(new Private)
+        {}
+
+        ColorPipeline::~ColorPipeline()
+        {}
+
+        bool ColorPipeline::isSupported(
+            const PixelDataInfo &      input,
+            const PixelDataInfo &      output,
+            const OpenGLImageOptions & options)
+        {
+            const Pixel::TYPE inType  = Pixel::type(input.pixel);
+            const Pixel::TYPE outType = Pixel::type(output.pixel);
+            return
+                (Pixel::U8 == inType || Pixel::U16 == inType) &&
+                (Pixel::U8 == outType || Pixel::U16 == outType) &&
+                input.size == output.size &&
+                !input.bgr && !output.bgr &&
+                input.endian == Core::Memory::endian() &&
+                output.endian == Core::Memory::endian() &&
+                (!options.proxyScale || PixelDataInfo::PROXY_NONE == input.proxy) &&
+                glm::vec2(0.f, 0.f) == options.xform.position &&
+                glm::vec2(1.f, 1.f) == options.xform.scale &&
+                0.f == options.xform.rotate &&
+                (options.colorProfile.type != ColorProfile::LUT || options.colorProfile.lut.isValid());
+        }
+
+        void ColorPipeline::bake(
+            Pixel::PIXEL               input,
+            Pixel::PIXEL               output,
+            const OpenGLImageOptions & options)
+        {
+            if (_p->baked &&
+                input == _p->input &&
+                output == _p->output &&
+                options.colorProfile == _p->colorProfile &&
+                options.displayProfile == _p->displayProfile &&
+                options.channel == _p->channel)
+                return;
+            //DJV_DEBUG("ColorPipeline::bake");
+            //DJV_DEBUG_PRINT("input = " << input);
+            //DJV_DEBUG_PRINT("output = " << output);
+            DJV_TRACE("ColorPipeline::bake", "Pixel");
+            _p->baked          = true;
+            _p->input          = input;
+            _p->output         = output;
+            _p->colorProfile   = options.colorProfile;
+            _p->displayProfile = options.displayProfile;
+            _p->channel        = options.channel;
+
+            // Map the input channels to the pipeline channels, the same as the
+            // shader input swizzle.
+            const Pixel::FORMAT inFormat = Pixel::format(input);
+            for (int c = 0; c < Pixel::channelsMax; ++c)
+            {
+                switch (inFormat)
+                {
+                case Pixel::L:  _p->inputChannels[c] = c < 3 ? 0 : -1; break;
+                case Pixel::LA: _p->inputChannels[c] = c < 3 ? 0 :  1; break;
+                case Pixel::RGB: _p->inputChannels[c] = c < 3 ? c : -1; break;
+                default:        _p->inputChannels[c] = c; break;
+                }
+            }
+
+            // Map the pipeline channels to the output channels, the same as the
+            // shader channel selection and output swizzle.
+            const Pixel::FORMAT outFormat = Pixel::format(output);
+            for (int c = 0; c < Pixel::channelsMax; ++c)
+            {
+                _p->outputChannels[c] =
+                    options.channel ? (options.channel - 1) :
+                    (Pixel::LA == outFormat && 1 == c ? 3 : c);
+            }
+
+            // The saturation is the only adjustment that mixes the channels. It
+            // has no effect when the input is luminance or when only the alpha
+            // channel is displayed.
+            _p->pipeline.reset(new Pipeline(options));
+            const Pipeline & pipeline = *_p->pipeline;
+            _p->isMixed =
+                !Core::Math::fuzzyCompare(options.displayProfile.color.saturation, 1.f) &&
+                inFormat != Pixel::L &&
+                inFormat != Pixel::LA &&
+                options.channel != OpenGLImageOptions::CHANNEL_ALPHA;
+
+            // Bake the 1D lookup tables.
+            const int inMax = Pixel::max(input);
+            const bool outU8 = Pixel::U8 == Pixel::type(output);
+            for (int c = 0; c < Pixel::channelsMax; ++c)
+            {
+                _p->lut1D[c].resize(inMax + 1);
+            }
+            for (int i = 0; i <= inMax; ++i)
+            {
+                const glm::vec4 value = pipeline(glm::vec4(i / static_cast<float>(inMax)));
+                for (int c = 0; c < Pixel::channelsMax; ++c)
+                {
+                    _p->lut1D[c][i] = outU8 ? Pixel::f32ToU8(value[c]) : Pixel::f32ToU16(value[c]);
+                }
+            }
+
+            // Bake the lookup tables for the stages before the color matrix.
+            // The stages are non-linear, so they are looked up for each input
+            // code value instead of being interpolated.
+            for (int c = 0; c < 3; ++c)
+            {
+                if (_p->isMixed)
+                {
+                    _p->preLut[c].resize(inMax + 1);
+                }
+                else
+                {
+                    std::vector<float>().swap(_p->preLut[c]);
+                }
+            }
+            if (_p->isMixed)
+            {
+                for (int i = 0; i <= inMax; ++i)
+                {
+                    const glm::vec4 value = pipeline.pre(glm::vec4(i / static_cast<float>(inMax)));
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        _p->preLut[c][i] = value[c];
+                    }
+                }
+            }
+        }
+
+        bool ColorPipeline::isMixed() const
+        {
+            return _p->isMixed;
+        }
+
+        void ColorPipeline::process(
+            const PixelData &          input,
+            PixelData &                output,
+            const OpenGLImageOptions & options)
+        {
+            //DJV_DEBUG("ColorPipeline::process");
+            //DJV_DEBUG_PRINT("input = " << input);
+            //DJV_DEBUG_PRINT("output = " << output);
+            DJV_TRACE("ColorPipeline::process", "Pixel");
+            bake(input.pixel(), output.pixel(), options);
+
+            // The mirroring is combined the same way as OpenGLImage::copy().
+            const PixelDataInfo::Mirror mirror(
+                input.info().mirror.x != (options.xform.mirror.x != output.info().mirror.x),
+                input.info().mirror.y != (options.xform.mirror.y != output.info().mirror.y));
+
+            const bool inU8  = Pixel::U8 == Pixel::type(input.pixel());
+            const bool outU8 = Pixel::U8 == Pixel::type(output.pixel());
+            const Private * p = _p.get();
+            auto work = [p, &input, &output, &mirror, inU8, outU8](int y0, int y1)
+            {
+                if (inU8 && outU8)
+                {
+                    p->process<Pixel::U8_T, Pixel::U8_T>(input, output, mirror, y0, y1);
+                }
+                else if (inU8)
+                {
+                    p->process<Pixel::U8_T, Pixel::U16_T>(input, output, mirror, y0, y1);
+                }
+                else if (outU8)
+                {
+                    p->process<Pixel::U16_T, Pixel::U8_T>(input, output, mirror, y0, y1);
+                }
+                else
+                {
+                    p->process<Pixel::U16_T, Pixel::U16_T>(input, output, mirror, y0, y1);
+                }
+            };
+
+            // Split the scanlines between threads.
+            splitScanlines(output.w(), output.h(), work);
+        }
+
+        void ColorPipeline::sample(
+            const PixelData &          input,
+            PixelData &                output,
+            const OpenGLImageOptions & options)
+        {
+            //DJV_DEBUG("ColorPipeline::sample");
+            //DJV_DEBUG_PRINT("input = " << input);
+            //DJV_DEBUG_PRINT("output = " << output);
+            DJV_TRACE("ColorPipeline::sample", "Pixel");
+
+            // The mirroring is combined the same way as OpenGLImage::copy().
+            OpenGLImageOptions _options = options;
+            if (output.info().mirror.x)
+            {
+                _options.xform.mirror.x = !_options.xform.mirror.x;
+            }
+            if (output.info().mirror.y)
+            {
+                _options.xform.mirror.y = !_options.xform.mirror.y;
+            }
+            if (ColorProfile::LUT == _options.colorProfile.type && !_options.colorProfile.lut.isValid())
+            {
+                _options.colorProfile.type = ColorProfile::RAW;
+            }
+            const Sampler sampler(input, _options);
+            const Pipeline pipeline(_options);
+
+            // Map the pipeline channels to the output channels, the same as
+            // ColorPipeline::bake().
+            const PixelDataInfo & info = output.info();
+            const Pixel::FORMAT outFormat = Pixel::format(info.pixel);
+            const int outChannels = Pixel::channels(info.pixel);
+            int outputChannels[Pixel::channelsMax] = { 0, 0, 0, 0 };
+            int backgroundChannels[Pixel::channelsMax] = { 0, 0, 0, 0 };
+            for (int c = 0; c < outChannels; ++c)
+            {
+                const int channel = info.bgr && c < 3 && outChannels >= 3 ? (2 - c) : c;
+                backgroundChannels[c] = Pixel::LA == outFormat && 1 == c ? 3 : channel;
+                outputChannels[c] = options.channel ? (options.channel - 1) : backgroundChannels[c];
+            }
+
+            // The background is the same as the OpenGL clear color.
+            Color background(Pixel::RGB_F32);
+            ColorUtil::convert(options.background, background);
+            bool alpha = false;
+            switch (Pixel::format(input.pixel()))
+            {
+            case Pixel::L:
+            case Pixel::RGB: alpha = Pixel::LA == outFormat || Pixel::RGBA == outFormat; break;
+            default: break;
+            }
+            const glm::vec4 backgroundValue(
+                background.f32(0),
+                background.f32(1),
+                background.f32(2),
+                alpha ? 1.f : 0.f);
+
+            const Pixel::PIXEL floatPixel = Pixel::pixel(outFormat, Pixel::F32);
+            const bool swap = info.endian != Core::Memory::endian() && Pixel::channelByteCount(info.pixel) > 1;
+            auto work = [&](int y0, int y1)
+            {
+                const int w = output.w();
+                std::vector<float> scanline(w * outChannels);
+                for (int y = y0; y < y1; ++y)
+                {
+                    float * p = scanline.data();
+                    for (int x = 0; x < w; ++x, p += outChannels)
+                    {
+                        glm::vec4 value;
+                        if (sampler(glm::vec2(x + .5f, y + .5f), value))
+                        {
+                            value = pipeline(value);
+                            for (int c = 0; c < outChannels; ++c)
+                            {
+                                p[c] = value[outputChannels[c]];
+                            }
+                        }
+                        else
+                        {
+                            for (int c = 0; c < outChannels; ++c)
+                            {
+                                p[c] = backgroundValue[backgroundChannels[c]];
+                            }
+                        }
+                    }
+                    Pixel::convert(scanline.data(), floatPixel, output.data(0, y), info.pixel, w);
+                    if (swap)
+                    {
+                        const int wordSize =
+                            Pixel::RGB_U10 == info.pixel ?
+                            Pixel::byteCount(info.pixel) :
+                            Pixel::channelByteCount(info.pixel);
+                        Core::Memory::convertEndian(
+                            output.data(0, y),
+                            static_cast<quint64>(w) * Pixel::byteCount(info.pixel) / wordSize,
+                            wordSize);
+                    }
+                }
+            };
+            splitScanlines(output.w(), output.h(), work);
+        }
+
+        void ColorPipeline::average(
+            const PixelData &          input,
+            const glm::ivec2 &         size,
+            Color &                    output,
+            const OpenGLImageOptions & options)
+        {
+            //DJV_DEBUG("ColorPipeline::average");
+            //DJV_DEBUG_PRINT("input = " << input);
+            //DJV_DEBUG_PRINT("size = " << size);
+            DJV_TRACE("ColorPipeline::average", "Pixel");
+            const Pixel::PIXEL floatPixel = Pixel::pixel(Pixel::format(output.pixel()), Pixel::F32);
+            PixelData tmp(PixelDataInfo(size, floatPixel));
+            sample(input, tmp, options);
+            const int channels = Pixel::channels(floatPixel);
+            const int count = tmp.w() * tmp.h();
+            float accum[Pixel::channelsMax] = { 0.f, 0.f, 0.f, 0.f };
+            for (int y = 0; y < tmp.h(); ++y)
+            {
+                const Pixel::F32_T * p = reinterpret_cast<const Pixel::F32_T *>(tmp.data(0, y));
+                for (int x = 0; x < tmp.w(); ++x, p += channels)
+                {
+                    for (int c = 0; c < channels; ++c)
+                    {
+                        accum[c] += p[c];
+                    }
+                }
+            }
+            for (int c = 0; c < channels && count > 0; ++c)
+            {
+                accum[c] /= count;
+            }
+            Pixel::convert(accum, floatPixel, output.data(), output.pixel());
+        }
+
+    } // namespace Graphics
+} // namespace djv
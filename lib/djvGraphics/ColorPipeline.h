@@ -0,0 +1,109 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <djvGraphics/OpenGLImage.h>
+
+#include <memory>
+
+namespace djv
+{
+    namespace Graphics
+    {
+        //! This class provides a CPU implementation of the OpenGL image color
+        //! pipeline for integer pixel data.
+        //!
+        //! The color profile, display profile, and channel options are baked
+        //! into lookup tables indexed by the input code values. When the
+        //! saturation mixes the channels, the stages before the color matrix
+        //! are baked into per-channel tables and the color matrix and the
+        //! stages after it are applied to each pixel, so the non-linear stages
+        //! are never interpolated. The tables are only baked again when the
+        //! options or pixel types change.
+        class ColorPipeline
+        {
+        public:
+            ColorPipeline();
+            ~ColorPipeline();
+
+            //! Get whether pixel data can be processed. This requires integer
+            //! pixel types with the same dimensions and no transform other than
+            //! mirroring.
+            static bool isSupported(
+                const PixelDataInfo &      input,
+                const PixelDataInfo &      output,
+                const OpenGLImageOptions & options);
+
+            //! Bake the lookup tables. This does nothing if the tables are
+            //! already baked for the given pixel types and options.
+            void bake(
+                Pixel::PIXEL               input,
+                Pixel::PIXEL               output,
+                const OpenGLImageOptions & options);
+
+            //! Get whether the baked lookup tables mix the color channels.
+            bool isMixed() const;
+
+            //! Process pixel data. The pixel data must be supported, see
+            //! isSupported().
+            void process(
+                const PixelData &          input,
+                PixelData &                output,
+                const OpenGLImageOptions & options = OpenGLImageOptions());
+
+            //! Sample pixel data. This applies the transform, filter, color
+            //! profile, display profile, and channel options the same way as
+            //! OpenGLImage::copy(), but only for the output pixels, so a small
+            //! region can be sampled without a round trip through the GPU. Any
+            //! pixel types are supported.
+            //!
+            //! The windowed filters are applied before the color profile
+            //! instead of between the color and display profiles.
+            static void sample(
+                const PixelData &          input,
+                PixelData &                output,
+                const OpenGLImageOptions & options = OpenGLImageOptions());
+
+            //! Sample the average color of a region of pixel data, see
+            //! sample(). The color is returned in the pixel type of the output.
+            static void average(
+                const PixelData &          input,
+                const glm::ivec2 &         size,
+                Color &                    output,
+                const OpenGLImageOptions & options = OpenGLImageOptions());
+
+        private:
+            DJV_PRIVATE_COPY(ColorPipeline);
+
+            struct Private;
+            std::unique_ptr<Private> _p;
+        };
+
+    } // namespace Graphics
+} // namespace djv
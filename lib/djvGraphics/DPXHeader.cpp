@@ -75,7 +75,7 @@ namespace djv
             Core::Memory::fill<quint8>(0xff, &tv, sizeof(Tv));
         }
 
-        void DPXHeader::load(Core::FileIO & io, ImageIOInfo & info, bool & filmPrint)
+        void DPXHeader::load(Core::FileIO & io, ImageIOInfo & info, bool & filmPrint, bool tags)
         {
             //DJV_DEBUG("DPXHeader::load");
             //DJV_DEBUG_PRINT("file = " << io.fileName());
@@ -240,6 +240,76 @@ namespace djv
 
             filmPrint = TRANSFER_FILM_PRINT == image.elem[0].transfer;
 
+            // Image tags.
+            if (tags)
+            {
+                this->tags(info);
+            }
+
+            // End.
+            debug();
+            if (file.imageOffset)
+            {
+                io.setPos(file.imageOffset);
+            }
+        }
+
+        bool DPXHeader::loadLayout(Core::FileIO & io, const DPXHeader & layout)
+        {
+            //DJV_DEBUG("DPXHeader::loadLayout");
+            //DJV_DEBUG_PRINT("file = " << io.fileName());
+
+            // Read.
+            io.get(&file, sizeof(File));
+            if (file.magic != layout.file.magic)
+            {
+                io.setPos(0);
+                return false;
+            }
+            io.get(&image, sizeof(Image));
+            io.get(&source, sizeof(Source));
+            io.get(&film, sizeof(Film));
+            io.get(&tv, sizeof(Tv));
+            const Core::Memory::ENDIAN fileEndian = 0 == memcmp(&file.magic, magic[0], 4) ?
+                Core::Memory::MSB :
+                Core::Memory::LSB;
+            if (fileEndian != Core::Memory::endian())
+            {
+                io.setEndian(true);
+                endian();
+            }
+
+            // Compare the fields that determine the layout of the image data.
+            const Image::Elem & a = image.elem[0];
+            const Image::Elem & b = layout.image.elem[0];
+            if (file.imageOffset != layout.file.imageOffset ||
+                image.orient != layout.image.orient ||
+                image.elemSize != layout.image.elemSize ||
+                image.size[0] != layout.image.size[0] ||
+                image.size[1] != layout.image.size[1] ||
+                a.descriptor != b.descriptor ||
+                a.transfer != b.transfer ||
+                a.bitDepth != b.bitDepth ||
+                a.packing != b.packing ||
+                a.encoding != b.encoding ||
+                a.dataOffset != b.dataOffset ||
+                a.linePadding != b.linePadding)
+            {
+                io.setEndian(false);
+                io.setPos(0);
+                return false;
+            }
+
+            // End.
+            if (file.imageOffset)
+            {
+                io.setPos(file.imageOffset);
+            }
+            return true;
+        }
+
+        void DPXHeader::tags(ImageIOInfo & info) const
+        {
             // File image tags.
             const QStringList & tags = ImageTags::tagLabels();
             const QStringList & dpxTags = DPX::tagLabels();
@@ -401,13 +471,6 @@ namespace djv
             if (isValid(&tv.integrationTimes))
                 info.tags[dpxTags[DPX::TAG_TV_INTEGRATION_TIMES]] =
                 QString::number(tv.integrationTimes);
-
-            // End.
-            debug();
-            if (file.imageOffset)
-            {
-                io.setPos(file.imageOffset);
-            }
         }
 
         void DPXHeader::save(
@@ -267,7 +267,22 @@ namespace djv
             //!
             //! Throws:
             //! - Core::Error
-            void load(Core::FileIO &, ImageIOInfo &, bool & filmPrint);
+            void load(Core::FileIO &, ImageIOInfo &, bool & filmPrint, bool tags = true);
+
+            //! Load the header of a file that is expected to have the same
+            //! layout as a previously loaded header, for example the next frame
+            //! of a sequence. Only the fields that determine the layout of the
+            //! image data are checked. If they match, the file is positioned at
+            //! the image data and the information from the previous header can
+            //! be reused. Otherwise the file is rewound and false is returned,
+            //! and load() should be used instead.
+            //!
+            //! Throws:
+            //! - Core::Error
+            bool loadLayout(Core::FileIO &, const DPXHeader & layout);
+
+            //! Get the image tags from the header.
+            void tags(ImageIOInfo &) const;
 
             //! Save the header.
             //!
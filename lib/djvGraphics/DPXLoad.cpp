@@ -35,6 +35,7 @@
 
 #include <djvCore/Assert.h>
 #include <djvCore/CoreContext.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -54,6 +55,7 @@ namespace djv
             //DJV_DEBUG_PRINT("in = " << in);
             _file = in;
             Core::FileIO io;
+            io.setMmap(false);
             _open(_file.fileName(_file.sequence().start()), info, io);
             if (Core::FileInfo::SEQUENCE == _file.type())
             {
@@ -61,15 +63,36 @@ namespace djv
             }
         }
 
-        void DPXLoad::_open(const QString & in, ImageIOInfo & info, Core::FileIO & io)
+        void DPXLoad::_open(
+            const QString & in,
+            ImageIOInfo &   info,
+            Core::FileIO &  io,
+            bool            tags)
         {
             //DJV_DEBUG("DPXLoad::_open");
             //DJV_DEBUG_PRINT("in = " << in);
             io.open(in, Core::FileIO::READ);
-            info.fileName = in;
-            _filmPrint = false;
+
+            // Frames of a sequence usually share the same layout, so only do
+            // a full parse of the header when it differs from the last one.
             DPXHeader header;
-            header.load(io, info, _filmPrint);
+            if (!_headerValid || !header.loadLayout(io, _header))
+            {
+                //DJV_DEBUG_PRINT("load header");
+                ImageIOInfo headerInfo;
+                bool filmPrint = false;
+                header.load(io, headerInfo, filmPrint, false);
+                _header = header;
+                _headerInfo = headerInfo;
+                _headerValid = true;
+                _filmPrint = filmPrint;
+            }
+            info = _headerInfo;
+            info.fileName = in;
+            if (tags)
+            {
+                header.tags(info);
+            }
             //DJV_DEBUG_PRINT("info = " << info);
             //DJV_DEBUG_PRINT("film print = " << _filmPrint);
         }
@@ -78,6 +101,7 @@ namespace djv
         {
             //DJV_DEBUG("DPXLoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE("DPXLoad::read", "ImageIO");
 
             // Open the file.
             const QString fileName =
@@ -85,7 +109,7 @@ namespace djv
             //DJV_DEBUG_PRINT("file name = " << fileName);
             ImageIOInfo info;
             QScopedPointer<Core::FileIO> io(new Core::FileIO);
-            _open(fileName, info, *io);
+            _open(fileName, info, *io, frame.tags);
             image.tags = info.tags;
 
             // Set the color profile.
@@ -162,5 +186,17 @@ namespace djv
             //DJV_DEBUG_PRINT("image = " << image);
         }
 
+        ImageLoad * DPXLoad::clone() const
+        {
+            auto out = new DPXLoad(_options, context());
+            out->_file = _file;
+            out->_filmPrintLut = _filmPrintLut;
+            out->_header = _header;
+            out->_headerInfo = _headerInfo;
+            out->_headerValid = _headerValid;
+            out->_filmPrint = _filmPrint;
+            return out;
+        }
+
     } // namespace Graphics
 } // namespace djv
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <djvGraphics/DPX.h>
+#include <djvGraphics/DPXHeader.h>
 #include <djvGraphics/ImageIO.h>
 
 #include <djvCore/FileInfo.h>
@@ -47,14 +48,18 @@ namespace djv
 
             void open(const Core::FileInfo &, ImageIOInfo &) override;
             void read(Image &, const ImageIOFrameInfo &) override;
+            ImageLoad * clone() const override;
 
         private:
-            void _open(const QString &, ImageIOInfo &, Core::FileIO &);
+            void _open(const QString &, ImageIOInfo &, Core::FileIO &, bool tags = true);
 
             DPX::Options   _options;
             bool           _filmPrint = false;
             PixelData      _filmPrintLut;
             Core::FileInfo _file;
+            DPXHeader      _header;
+            ImageIOInfo    _headerInfo;
+            bool           _headerValid = false;
             PixelData      _tmp;
         };
 
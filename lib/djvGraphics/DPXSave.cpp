@@ -32,6 +32,7 @@
 #include <djvGraphics/OpenGLImage.h>
 
 #include <djvCore/CoreContext.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -101,6 +102,7 @@ namespace djv
         {
             //DJV_DEBUG("DPXSave::write");
             //DJV_DEBUG_PRINT("in = " << in);
+            DJV_TRACE("DPXSave::write", "ImageIO");
 
             // Set the color profile.
             ColorProfile colorProfile;
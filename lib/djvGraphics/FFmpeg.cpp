@@ -94,7 +94,8 @@ namespace djv
 
         FFmpeg::Options::Options() :
             format(MPEG4),
-            quality(HIGH)
+            quality(HIGH),
+            threads(0)
         {}
 
         const QString FFmpeg::staticName = "FFmpeg";
@@ -139,7 +140,8 @@ namespace djv
         {
             static const QStringList data = QStringList() <<
                 qApp->translate("djv::Graphics::FFmpeg", "Format") <<
-                qApp->translate("djv::Graphics::FFmpeg", "Quality");
+                qApp->translate("djv::Graphics::FFmpeg", "Quality") <<
+                qApp->translate("djv::Graphics::FFmpeg", "Threads");
             DJV_ASSERT(data.count() == OPTIONS_COUNT);
             return data;
         }
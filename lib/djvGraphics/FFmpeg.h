@@ -43,6 +43,7 @@ extern "C"
 #include <libavcodec/avcodec.h>
 #include <libavformat/avformat.h>
 #include <libavutil/dict.h>
+#include <libavutil/pixdesc.h>
 #include <libswscale/swscale.h>
 
 } // extern "C"
@@ -90,6 +91,7 @@ namespace djv
             {
                 OPTIONS_FORMAT,
                 OPTIONS_QUALITY,
+                OPTIONS_THREADS,
 
                 OPTIONS_COUNT
             };
@@ -142,6 +144,7 @@ namespace djv
 
                 FORMAT  format;
                 QUALITY quality;
+                int     threads;
             };
         };
 
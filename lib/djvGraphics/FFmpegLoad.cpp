@@ -35,6 +35,7 @@
 #include <djvCore/CoreContext.h>
 #include <djvCore/Debug.h>
 #include <djvCore/FileIOUtil.h>
+#include <djvCore/Trace.h>
 
 #include <QCoreApplication>
 
@@ -65,46 +66,12 @@ namespace djv
             close();
 
             // Open the file.
-            int r = avformat_open_input(
-                &_avFormatContext,
-                in.fileName().toUtf8().data(),
-                0,
-                0);
-            if (r < 0)
-            {
-                throw Core::Error(
-                    FFmpeg::staticName,
-                    FFmpeg::toString(r));
-            }
-            r = avformat_find_stream_info(_avFormatContext, 0);
-            if (r < 0)
-            {
-                throw Core::Error(
-                    FFmpeg::staticName,
-                    FFmpeg::toString(r));
-            }
+            _openFormat(in);
             av_dump_format(_avFormatContext, 0, in.fileName().toUtf8().data(), 0);
 
-            // Find the first video stream.
-            for (unsigned int i = 0; i < _avFormatContext->nb_streams; ++i)
-            {
-                if (_avFormatContext->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO)
-                {
-                    _avVideoStream = i;
-
-                    break;
-                }
-            }
-            //DJV_DEBUG_PRINT("video stream = " << _avVideoStream);
-            if (-1 == _avVideoStream)
-            {
-                throw Core::Error(
-                    FFmpeg::staticName,
-                    qApp->translate("djv::Graphics::FFmpegLoad", "Cannot find video stream"));
-            }
-
             // Find the codec for the video stream.
             AVStream * avStream = _avFormatContext->streams[_avVideoStream];
+            int r = 0;
             AVCodecParameters * avCodecParameters = avStream->codecpar;
             AVCodec * avCodec = avcodec_find_decoder(avCodecParameters->codec_id);
             if (!avCodec)
@@ -159,32 +126,9 @@ namespace djv
             _info.size = glm::ivec2(_avCodecParameters->width, _avCodecParameters->height);
             _info.pixel = Pixel::RGBA_U8;
             _info.mirror.y = true;
-            int64_t duration = 0;
-            if (avStream->duration != AV_NOPTS_VALUE)
-            {
-                duration = av_rescale_q(
-                    avStream->duration,
-                    avStream->time_base,
-                    FFmpeg::timeBaseQ());
-            }
-            else if (_avFormatContext->duration != AV_NOPTS_VALUE)
-            {
-                duration = _avFormatContext->duration;
-            }
             const Core::Speed speed(avStream->r_frame_rate.num, avStream->r_frame_rate.den);
-            //DJV_DEBUG_PRINT("duration = " << static_cast<qint64>(duration));
             //DJV_DEBUG_PRINT("speed = " << speed);
-            int64_t nbFrames = 0;
-            if (avStream->nb_frames != 0)
-            {
-                nbFrames = avStream->nb_frames;
-            }
-            else
-            {
-                nbFrames =
-                    duration / static_cast<float>(AV_TIME_BASE) *
-                    Core::Speed::speedToFloat(speed);
-            }
+            int64_t nbFrames = _frameCount(speed);
             if (!nbFrames)
             {
                 //DJV_DEBUG_PRINT("count frames");
@@ -213,6 +157,7 @@ namespace djv
         {
             //DJV_DEBUG("FFmpegLoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE("FFmpegLoad::read", "ImageIO");
 
             image.colorProfile = ColorProfile();
             image.tags = ImageTags();
@@ -278,6 +223,35 @@ namespace djv
             }
         }
 
+        void FFmpegLoad::probe(const Core::FileInfo & in, ImageIOInfo & info)
+        {
+            //DJV_DEBUG("FFmpegLoad::probe");
+            //DJV_DEBUG_PRINT("in = " << in);
+
+            close();
+
+            // Only the container and stream information is needed, the codec
+            // and the software scaler are not initialized.
+            _openFormat(in);
+            const AVStream * avStream = _avFormatContext->streams[_avVideoStream];
+            const Core::Speed speed(avStream->r_frame_rate.num, avStream->r_frame_rate.den);
+            const int64_t nbFrames = _frameCount(speed);
+            if (!nbFrames)
+            {
+                // The frames need to be counted by decoding the file.
+                open(in, info);
+                close();
+                return;
+            }
+            info = ImageIOInfo();
+            info.fileName = in;
+            info.size = glm::ivec2(avStream->codecpar->width, avStream->codecpar->height);
+            info.pixel = Pixel::RGBA_U8;
+            info.mirror.y = true;
+            info.sequence = Core::Sequence(0, nbFrames - 1, 0, speed);
+            close();
+        }
+
         void FFmpegLoad::close()
         {
             //DJV_DEBUG("FFmpegLoad::close");    
@@ -363,5 +337,75 @@ namespace djv
             return finished;
         }
 
+        void FFmpegLoad::_openFormat(const Core::FileInfo & in)
+        {
+            int r = avformat_open_input(
+                &_avFormatContext,
+                in.fileName().toUtf8().data(),
+                0,
+                0);
+            if (r < 0)
+            {
+                throw Core::Error(
+                    FFmpeg::staticName,
+                    FFmpeg::toString(r));
+            }
+            r = avformat_find_stream_info(_avFormatContext, 0);
+            if (r < 0)
+            {
+                throw Core::Error(
+                    FFmpeg::staticName,
+                    FFmpeg::toString(r));
+            }
+
+            // Find the first video stream.
+            for (unsigned int i = 0; i < _avFormatContext->nb_streams; ++i)
+            {
+                if (_avFormatContext->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO)
+                {
+                    _avVideoStream = i;
+
+                    break;
+                }
+            }
+            //DJV_DEBUG_PRINT("video stream = " << _avVideoStream);
+            if (-1 == _avVideoStream)
+            {
+                throw Core::Error(
+                    FFmpeg::staticName,
+                    qApp->translate("djv::Graphics::FFmpegLoad", "Cannot find video stream"));
+            }
+        }
+
+        int64_t FFmpegLoad::_frameCount(const Core::Speed & speed) const
+        {
+            const AVStream * avStream = _avFormatContext->streams[_avVideoStream];
+            int64_t duration = 0;
+            if (avStream->duration != AV_NOPTS_VALUE)
+            {
+                duration = av_rescale_q(
+                    avStream->duration,
+                    avStream->time_base,
+                    FFmpeg::timeBaseQ());
+            }
+            else if (_avFormatContext->duration != AV_NOPTS_VALUE)
+            {
+                duration = _avFormatContext->duration;
+            }
+            //DJV_DEBUG_PRINT("duration = " << static_cast<qint64>(duration));
+            int64_t out = 0;
+            if (avStream->nb_frames != 0)
+            {
+                out = avStream->nb_frames;
+            }
+            else
+            {
+                out =
+                    duration / static_cast<float>(AV_TIME_BASE) *
+                    Core::Speed::speedToFloat(speed);
+            }
+            return out;
+        }
+
     } // namespace Graphics
 } // namespace djv
@@ -46,11 +46,14 @@ namespace djv
             virtual ~FFmpegLoad();
 
             void open(const Core::FileInfo &, ImageIOInfo &) override;
+            void probe(const Core::FileInfo &, ImageIOInfo &) override;
             void read(Image &, const ImageIOFrameInfo &) override;
             void close() override;
 
         private:
             bool readFrame(int64_t & pts);
+            void _openFormat(const Core::FileInfo &);
+            int64_t _frameCount(const Core::Speed &) const;
 
             ImageIOInfo _info;
             int _frame = 0;
@@ -142,6 +142,10 @@ namespace djv
             {
                 out << _options.quality;
             }
+            else if (0 == in.compare(list[FFmpeg::OPTIONS_THREADS], Qt::CaseInsensitive))
+            {
+                out << _options.threads;
+            }
             return out;
         }
 
@@ -170,6 +174,16 @@ namespace djv
                         Q_EMIT optionChanged(in);
                     }
                 }
+                else if (0 == in.compare(list[FFmpeg::OPTIONS_THREADS], Qt::CaseInsensitive))
+                {
+                    int threads = 0;
+                    data >> threads;
+                    if (threads != _options.threads)
+                    {
+                        _options.threads = threads;
+                        Q_EMIT optionChanged(in);
+                    }
+                }
             }
             catch (QString)
             {
@@ -200,6 +214,10 @@ namespace djv
                     {
                         in >> _options.quality;
                     }
+                    else if (qApp->translate("djv::Graphics::FFmpegPlugin", "-ffmpeg_threads") == arg)
+                    {
+                        in >> _options.threads;
+                    }
                     else
                     {
                         tmp << arg;
@@ -229,11 +247,15 @@ namespace djv
                 "    -ffmpeg_quality (value)\n"
                 "        Set the quality used when saving FFmpeg movies: %3. "
                 "Default = %4.\n"
+                "    -ffmpeg_threads (value)\n"
+                "        Set the number of threads used when saving FFmpeg movies, "
+                "or 0 to use all of the processors. Default = %5.\n"
             ).
                 arg(FFmpeg::formatLabels().join(", ")).
                 arg(formatLabel.join(", ")).
                 arg(FFmpeg::qualityLabels().join(", ")).
-                arg(qualityLabel.join(", "));
+                arg(qualityLabel.join(", ")).
+                arg(_options.threads);
         }
 
         ImageLoad * FFmpegPlugin::createLoad() const
@@ -32,9 +32,15 @@
 #include <djvGraphics/OpenGLImage.h>
 
 #include <djvCore/CoreContext.h>
+#include <djvCore/Math.h>
+#include <djvCore/Memory.h>
+#include <djvCore/Trace.h>
 
 #include <QCoreApplication>
 
+#include <algorithm>
+#include <atomic>
+
 #include <stdio.h>
 
 namespace djv
@@ -47,7 +53,14 @@ namespace djv
         {}
 
         FFmpegSave::~FFmpegSave()
-        {}
+        {
+            try
+            {
+                close();
+            }
+            catch (const Core::Error &)
+            {}
+        }
         
         void FFmpegSave::open(const Core::FileInfo & fileInfo, const ImageIOInfo & info)
         {
@@ -193,6 +206,13 @@ namespace djv
                 avCodecContext->global_quality = FF_QP2LAMBDA * avQScale;
             }
 
+            // A thread count of zero lets FFmpeg pick the number of threads.
+            avCodecContext->thread_count = _options.threads;
+            avCodecContext->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+            _threads = _options.threads > 0 ?
+                _options.threads :
+                Core::Math::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+
             int r = avcodec_open2(avCodecContext, avCodec, dictionary());
             if (r < 0)
             {
@@ -241,147 +261,165 @@ namespace djv
             _info.pixel = pixel;
             _info.bgr = info.bgr;
 
-            // Initialize the buffers.
+            // Initialize the buffers. There is one frame being converted, one
+            // waiting to be encoded, and one being encoded.
             _image.set(_info);
+            for (int i = 0; i < 3; ++i)
+            {
+                AVFrame * avFrame = av_frame_alloc();
+                _avFrames.push_back(avFrame);
+                avFrame->width = info.size.x;
+                avFrame->height = info.size.y;
+                avFrame->format = avCodecContext->pix_fmt;
+                r = av_frame_get_buffer(avFrame, 32);
+                if (r < 0)
+                {
+                    throw Core::Error(
+                        FFmpeg::staticName,
+                        FFmpeg::toString(r));
+                }
+                _encodeFree.push_back(avFrame);
+            }
 
-            _avFrame = av_frame_alloc();
-            _avFrame->width = info.size.x;
-            _avFrame->height = info.size.y;
-            _avFrame->format = avCodecContext->pix_fmt;
-
-            _avFrameBuf = (uint8_t *)av_malloc(
-                avpicture_get_size(
-                    avCodecContext->pix_fmt,
-                    avCodecContext->width,
-                    avCodecContext->height));
+            // Initialize the software scaler.
+            _initSws(_avFrameRgbPixel);
 
-            avpicture_fill(
-                (AVPicture *)_avFrame,
-                _avFrameBuf,
-                avCodecContext->pix_fmt,
-                avCodecContext->width,
-                avCodecContext->height);
+            // Start the encoder thread.
+            _encodeThread = std::thread([this]
+            {
+                bool running = true;
+                while (running)
+                {
+                    AVFrame * avFrame = nullptr;
+                    bool error = false;
+                    {
+                        std::unique_lock<std::mutex> lock(_encodeMutex);
+                        _encodeCV.wait(lock, [this] { return _encodeQueue.size(); });
+                        avFrame = _encodeQueue.front();
+                        _encodeQueue.pop_front();
+                        error = _encodeError.count();
+                    }
 
-            _avFrameRgb = av_frame_alloc();
+                    // A null frame flushes the encoder and stops the thread.
+                    running = avFrame != nullptr;
+                    if (!error)
+                    {
+                        try
+                        {
+                            _encode(avFrame);
+                        }
+                        catch (const Core::Error & otherError)
+                        {
+                            std::unique_lock<std::mutex> lock(_encodeMutex);
+                            _encodeError = otherError;
+                        }
+                    }
+                    if (avFrame)
+                    {
+                        std::unique_lock<std::mutex> lock(_encodeMutex);
+                        _encodeFree.push_back(avFrame);
+                    }
+                    _encodeCV.notify_all();
+                }
+            });
+        }
 
-            // Initialize the software scaler.
-            _swsContext = sws_getContext(
-                info.size.x,
-                info.size.y,
-                _avFrameRgbPixel,
-                avCodecContext->width,
-                avCodecContext->height,
-                avCodecContext->pix_fmt,
-                SWS_BILINEAR,
-                0,
-                0,
-                0);
-            if (!_swsContext)
+        namespace
+        {
+            //! Get the FFmpeg pixel format that can be converted directly from
+            //! the given image, or AV_PIX_FMT_NONE if the image needs to be
+            //! converted with OpenGL first.
+            AVPixelFormat avPixelFormat(const PixelDataInfo & in, const glm::ivec2 & size)
             {
-                throw Core::Error(
-                    FFmpeg::staticName,
-                    qApp->translate("djv::Graphics::FFmpegSave", "Cannot create software scaler"));
+                if (in.size != size ||
+                    in.proxy ||
+                    in.mirror.x ||
+                    in.mirror.y ||
+                    in.endian != Core::Memory::endian())
+                {
+                    return AV_PIX_FMT_NONE;
+                }
+                switch (in.pixel)
+                {
+                case Pixel::L_U8:     return AV_PIX_FMT_GRAY8;
+                case Pixel::L_U16:    return AV_PIX_FMT_GRAY16;
+                case Pixel::RGB_U8:   return in.bgr ? AV_PIX_FMT_BGR24  : AV_PIX_FMT_RGB24;
+                case Pixel::RGBA_U8:  return in.bgr ? AV_PIX_FMT_BGRA   : AV_PIX_FMT_RGBA;
+                case Pixel::RGB_U16:  return in.bgr ? AV_PIX_FMT_BGR48  : AV_PIX_FMT_RGB48;
+                case Pixel::RGBA_U16: return in.bgr ? AV_PIX_FMT_BGRA64 : AV_PIX_FMT_RGBA64;
+                default: break;
+                }
+                return AV_PIX_FMT_NONE;
             }
-        }
+
+        } // namespace
 
         void FFmpegSave::write(const Image & in, const ImageIOFrameInfo & frame)
         {
             //DJV_DEBUG("FFmpegSave::write");
             //DJV_DEBUG_PRINT("in = " << in);
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE("FFmpegSave::write", "ImageIO");
 
-            // Convert the image if necessary.
-            const PixelData * p = &in;
-            if (in.info() != _info)
+            // Get a free frame, waiting for the encoder if necessary.
+            AVFrame * avFrame = nullptr;
             {
-                //DJV_DEBUG_PRINT("convert = " << _image);
-                _image.zero();
-                OpenGLImage().copy(in, _image);
-                p = &_image;
+                std::unique_lock<std::mutex> lock(_encodeMutex);
+                _encodeCV.wait(lock, [this] { return _encodeFree.size() || _encodeError.count(); });
+                if (_encodeError.count())
+                {
+                    throw _encodeError;
+                }
+                avFrame = _encodeFree.back();
+                _encodeFree.pop_back();
             }
 
-            // Encode the image.
-            avpicture_fill(
-                (AVPicture *)_avFrameRgb,
-                p->data(),
-                _avFrameRgbPixel,
-                p->w(),
-                p->h());
-
-            quint64 scanlineByteCount = p->scanlineByteCount();
-            quint64 dataByteCount = p->dataByteCount();
-            const uint8_t * const data[] =
+            try
             {
-                p->data() + dataByteCount - scanlineByteCount,
-                p->data() + dataByteCount - scanlineByteCount,
-                p->data() + dataByteCount - scanlineByteCount,
-                p->data() + dataByteCount - scanlineByteCount
-            };
-            const int lineSize[] =
-            {
-                -static_cast<int>(scanlineByteCount),
-                -static_cast<int>(scanlineByteCount),
-                -static_cast<int>(scanlineByteCount),
-                -static_cast<int>(scanlineByteCount)
-            };
-            sws_scale(
-                _swsContext,
-                //(uint8_t const * const *)_avFrameRgb->data,
-                //_avFrameRgb->linesize,
-                data,
-                lineSize,
-                0,
-                p->h(),
-                _avFrame->data,
-                _avFrame->linesize);
+                // The encoder may still hold a reference to the frame data.
+                int r = av_frame_make_writable(avFrame);
+                if (r < 0)
+                {
+                    throw Core::Error(
+                        FFmpeg::staticName,
+                        FFmpeg::toString(r));
+                }
 
-            AVCodecContext * avCodecContext = _avStream->codec;
-            FFmpeg::Packet packet;
-            packet().data = nullptr;
-            packet().size = 0;
-            _avFrame->pts = _frame++;
-            _avFrame->quality = avCodecContext->global_quality;
-
-            int finished = 0;
-            int r = avcodec_encode_video2(
-                avCodecContext,
-                &packet(),
-                _avFrame,
-                &finished);
-            if (r < 0)
+                // Convert the image. Common pixel types are converted directly,
+                // anything else is converted with OpenGL first.
+                const PixelData * p = &in;
+                AVPixelFormat avPixel = avPixelFormat(in.info(), _info.size);
+                if (AV_PIX_FMT_NONE == avPixel)
+                {
+                    //DJV_DEBUG_PRINT("convert = " << _image);
+                    _image.zero();
+                    OpenGLImage().copy(in, _image);
+                    p = &_image;
+                    avPixel = _avFrameRgbPixel;
+                }
+                if (avPixel != _swsPixel)
+                {
+                    _initSws(avPixel);
+                }
+                _convert(*p, avFrame);
+                avFrame->pts = _frame++;
+                avFrame->quality = _avStream->codec->global_quality;
+            }
+            catch (const Core::Error &)
             {
-                throw Core::Error(
-                    FFmpeg::staticName,
-                    FFmpeg::toString(r));
+                {
+                    std::unique_lock<std::mutex> lock(_encodeMutex);
+                    _encodeFree.push_back(avFrame);
+                }
+                throw;
             }
-            //DJV_DEBUG_PRINT("finished = " << finished);
-            //DJV_DEBUG_PRINT("size = " << packet().size);
-            //DJV_DEBUG_PRINT("pts = " << static_cast<qint64>(packet().pts));
-            //DJV_DEBUG_PRINT("dts = " << static_cast<qint64>(packet().dts));
-            //DJV_DEBUG_PRINT("duration = " << static_cast<qint64>(packet().duration));
-
-            // Write the image.
-            packet().pts = av_rescale_q(
-                packet().pts,
-                avCodecContext->time_base,
-                _avStream->time_base);
-            packet().dts = av_rescale_q(
-                packet().dts,
-                avCodecContext->time_base,
-                _avStream->time_base);
-            packet().duration = av_rescale_q(
-                packet().duration,
-                avCodecContext->time_base,
-                _avStream->time_base);
-            packet().stream_index = _avStream->index;
-
-            r = av_interleaved_write_frame(_avFormatContext, &packet());
-            if (r < 0)
+
+            // Queue the frame for encoding.
             {
-                throw Core::Error(
-                    FFmpeg::staticName,
-                    FFmpeg::toString(r));
+                std::unique_lock<std::mutex> lock(_encodeMutex);
+                _encodeQueue.push_back(avFrame);
             }
+            _encodeCV.notify_all();
         }
 
         void FFmpegSave::close()
@@ -390,45 +428,49 @@ namespace djv
 
             Core::Error error;
             int r = 0;
-            if (_avFormatContext)
+            if (_encodeThread.joinable())
+            {
+                {
+                    std::unique_lock<std::mutex> lock(_encodeMutex);
+                    _encodeQueue.push_back(nullptr);
+                }
+                _encodeCV.notify_all();
+                _encodeThread.join();
+                error = _encodeError;
+                _encodeError = Core::Error();
+            }
+            if (_avFormatContext && !error.count())
             {
                 r = av_interleaved_write_frame(_avFormatContext, 0);
                 if (r < 0)
                 {
-                    throw Core::Error(
+                    error = Core::Error(
                         FFmpeg::staticName,
                         FFmpeg::toString(r));
                 }
                 //DJV_DEBUG_PRINT("frames = " << static_cast<qint64>(_avStream->nb_frames));
                 //DJV_DEBUG_PRINT("write trailer");
                 r = av_write_trailer(_avFormatContext);
-                if (r < 0)
+                if (r < 0 && !error.count())
                 {
-                    throw Core::Error(
+                    error = Core::Error(
                         FFmpeg::staticName,
                         FFmpeg::toString(r));
                 }
             }
-            if (_swsContext)
-            {
-                sws_freeContext(_swsContext);
-                _swsContext = nullptr;
-            }
-            if (_avFrameRgb)
-            {
-                av_frame_free(&_avFrameRgb);
-                _avFrameRgb = nullptr;
-            }
-            if (_avFrameBuf)
+            for (auto swsContext : _swsContexts)
             {
-                av_free(_avFrameBuf);
-                _avFrameBuf = nullptr;
+                sws_freeContext(swsContext);
             }
-            if (_avFrame)
+            _swsContexts.clear();
+            _swsPixel = AV_PIX_FMT_NONE;
+            for (auto avFrame : _avFrames)
             {
-                av_frame_free(&_avFrame);
-                _avFrame = nullptr;
+                av_frame_free(&avFrame);
             }
+            _avFrames.clear();
+            _encodeQueue.clear();
+            _encodeFree.clear();
             if (_avIoContext)
             {
                 avio_close(_avIoContext);
@@ -438,6 +480,7 @@ namespace djv
             {
                 avformat_free_context(_avFormatContext);
                 _avFormatContext = nullptr;
+                _avStream = nullptr;
             }
             if (error.count())
             {
@@ -445,5 +488,162 @@ namespace djv
             }
         }
 
+        void FFmpegSave::_initSws(AVPixelFormat avPixel)
+        {
+            //DJV_DEBUG("FFmpegSave::_initSws");
+            //DJV_DEBUG_PRINT("av pixel = " << avPixel);
+            for (auto swsContext : _swsContexts)
+            {
+                sws_freeContext(swsContext);
+            }
+            _swsContexts.clear();
+            _swsPixel = AV_PIX_FMT_NONE;
+
+            // Split the image into horizontal bands that are converted in
+            // parallel, each with its own scaler. Formats with vertical chroma
+            // subsampling are converted in a single band, since each scaler
+            // filters the chroma only within its own band and that would leave
+            // seams at the band edges.
+            const AVCodecContext * avCodecContext = _avStream->codec;
+            const int w = _info.size.x;
+            const int h = _info.size.y;
+            int chromaShiftX = 0;
+            int chromaShiftY = 0;
+            av_pix_fmt_get_chroma_sub_sample(avCodecContext->pix_fmt, &chromaShiftX, &chromaShiftY);
+            const int bands = chromaShiftY > 0 ?
+                1 :
+                Core::Math::clamp(_threads, 1, Core::Math::max(h / 16, 1));
+            _swsBandHeight = (h + bands - 1) / bands;
+            for (int y = 0; y < h; y += _swsBandHeight)
+            {
+                const int bandHeight = std::min(_swsBandHeight, h - y);
+                SwsContext * swsContext = sws_getContext(
+                    w,
+                    bandHeight,
+                    avPixel,
+                    w,
+                    bandHeight,
+                    avCodecContext->pix_fmt,
+                    SWS_BILINEAR,
+                    0,
+                    0,
+                    0);
+                if (!swsContext)
+                {
+                    throw Core::Error(
+                        FFmpeg::staticName,
+                        qApp->translate("djv::Graphics::FFmpegSave", "Cannot create software scaler"));
+                }
+                _swsContexts.push_back(swsContext);
+            }
+            _swsPixel = avPixel;
+        }
+
+        void FFmpegSave::_convert(const PixelData & in, AVFrame * avFrame)
+        {
+            DJV_TRACE("FFmpegSave::convert", "ImageIO");
+            const int h = in.h();
+            const int scanlineByteCount = static_cast<int>(in.scanlineByteCount());
+            int chromaShiftX = 0;
+            int chromaShiftY = 0;
+            av_pix_fmt_get_chroma_sub_sample(
+                static_cast<AVPixelFormat>(avFrame->format),
+                &chromaShiftX,
+                &chromaShiftY);
+
+            // The image is stored bottom to top, so each band starts at the
+            // top scanline and uses a negative stride.
+            const int count = static_cast<int>(_swsContexts.size());
+            std::atomic<int> next(0);
+            auto work = [this, &in, avFrame, h, scanlineByteCount, chromaShiftY, count, &next]
+            {
+                for (int i = next++; i < count; i = next++)
+                {
+                    const int y = i * _swsBandHeight;
+                    const int bandHeight = std::min(_swsBandHeight, h - y);
+                    const uint8_t * p = in.data(0, h - 1 - y);
+                    const uint8_t * const src[] = { p, p, p, p };
+                    const int srcLineSize[] =
+                    {
+                        -scanlineByteCount,
+                        -scanlineByteCount,
+                        -scanlineByteCount,
+                        -scanlineByteCount
+                    };
+                    uint8_t * dst[4] = { nullptr, nullptr, nullptr, nullptr };
+                    for (int plane = 0; plane < 4 && avFrame->data[plane]; ++plane)
+                    {
+                        const int planeY = (1 == plane || 2 == plane) ? (y >> chromaShiftY) : y;
+                        dst[plane] = avFrame->data[plane] + planeY * avFrame->linesize[plane];
+                    }
+                    sws_scale(
+                        _swsContexts[i],
+                        src,
+                        srcLineSize,
+                        0,
+                        bandHeight,
+                        dst,
+                        avFrame->linesize);
+                }
+            };
+            std::vector<std::thread> threads;
+            const int threadCount = Core::Math::clamp(_threads, 1, count);
+            for (int i = 1; i < threadCount; ++i)
+            {
+                threads.push_back(std::thread(work));
+            }
+            work();
+            for (auto & thread : threads)
+            {
+                thread.join();
+            }
+        }
+
+        void FFmpegSave::_encode(AVFrame * avFrame)
+        {
+            DJV_TRACE("FFmpegSave::encode", "ImageIO");
+            AVCodecContext * avCodecContext = _avStream->codec;
+            int r = avcodec_send_frame(avCodecContext, avFrame);
+            if (r < 0)
+            {
+                throw Core::Error(
+                    FFmpeg::staticName,
+                    FFmpeg::toString(r));
+            }
+            for (;;)
+            {
+                FFmpeg::Packet packet;
+                packet().data = nullptr;
+                packet().size = 0;
+                r = avcodec_receive_packet(avCodecContext, &packet());
+                if (AVERROR(EAGAIN) == r || AVERROR_EOF == r)
+                {
+                    break;
+                }
+                if (r < 0)
+                {
+                    throw Core::Error(
+                        FFmpeg::staticName,
+                        FFmpeg::toString(r));
+                }
+                //DJV_DEBUG_PRINT("size = " << packet().size);
+                //DJV_DEBUG_PRINT("pts = " << static_cast<qint64>(packet().pts));
+
+                // Write the packet.
+                av_packet_rescale_ts(
+                    &packet(),
+                    avCodecContext->time_base,
+                    _avStream->time_base);
+                packet().stream_index = _avStream->index;
+                r = av_interleaved_write_frame(_avFormatContext, &packet());
+                if (r < 0)
+                {
+                    throw Core::Error(
+                        FFmpeg::staticName,
+                        FFmpeg::toString(r));
+                }
+            }
+        }
+
     } // namespace Graphics
 } // namespace djv
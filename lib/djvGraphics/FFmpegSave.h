@@ -33,13 +33,24 @@
 #include <djvGraphics/Image.h>
 #include <djvGraphics/ImageIO.h>
 
+#include <djvCore/Error.h>
 #include <djvCore/FileInfo.h>
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 namespace djv
 {
     namespace Graphics
     {
         //! This class provides a FFmpeg saver.
+        //!
+        //! Saving is pipelined: write() converts the image to the codec pixel
+        //! format on multiple threads and queues it, while a separate thread
+        //! encodes the queued frames and writes the packets.
         class FFmpegSave : public ImageSave
         {
         public:
@@ -51,19 +62,31 @@ namespace djv
             void close() override;
 
         private:
+            void _initSws(AVPixelFormat);
+            void _convert(const PixelData &, AVFrame *);
+            void _encode(AVFrame *);
+
             FFmpeg::Options _options;
             PixelDataInfo _info;
             Image _image;
             int _frame = 0;
+            int _threads = 1;
 
             AVFormatContext * _avFormatContext = nullptr;
             AVStream * _avStream = nullptr;
             AVIOContext * _avIoContext = nullptr;
-            AVFrame * _avFrame = nullptr;
-            uint8_t * _avFrameBuf = nullptr;
-            AVFrame * _avFrameRgb = nullptr;
+            std::vector<AVFrame *> _avFrames;
             AVPixelFormat _avFrameRgbPixel = static_cast<AVPixelFormat>(0);
-            SwsContext * _swsContext = nullptr;
+            AVPixelFormat _swsPixel = AV_PIX_FMT_NONE;
+            std::vector<SwsContext *> _swsContexts;
+            int _swsBandHeight = 0;
+
+            std::thread _encodeThread;
+            std::mutex _encodeMutex;
+            std::condition_variable _encodeCV;
+            std::deque<AVFrame *> _encodeQueue;
+            std::vector<AVFrame *> _encodeFree;
+            Core::Error _encodeError;
         };
 
     } // namespace Graphics
@@ -37,8 +37,10 @@
 #include <djvGraphics/ImageIO.h>
 #include <djvGraphics/LUTPlugin.h>
 #include <djvGraphics/OpenGLImage.h>
+#include <djvGraphics/PIC.h>
 #include <djvGraphics/PICPlugin.h>
 #include <djvGraphics/PPMPlugin.h>
+#include <djvGraphics/ReviewCachePlugin.h>
 #include <djvGraphics/TargaPlugin.h>
 #include <djvGraphics/RLAPlugin.h>
 #include <djvGraphics/SGIPlugin.h>
@@ -60,6 +62,7 @@
 
 #include <djvCore/DebugLog.h>
 #include <djvCore/Error.h>
+#include <djvCore/Timer.h>
 
 #include <QCoreApplication>
 #include <QMetaType>
@@ -84,6 +87,10 @@ namespace djv
         };
 
         GraphicsContext::GraphicsContext(int & argc, char ** argv, QObject * parent) :
+            GraphicsContext(argc, argv, OPENGL_INIT_NOW, parent)
+        {}
+
+        GraphicsContext::GraphicsContext(int & argc, char ** argv, OPENGL_INIT openGLInit, QObject * parent) :
             Core::CoreContext(argc, argv, parent),
             _p(new Private)
         {
@@ -94,91 +101,54 @@ namespace djv
             qRegisterMetaType<ImageIOInfo>("djv::Graphics::ImageIOInfo");
 
             // Create the default OpenGL context.
-            DJV_LOG(debugLog(), "djv::Graphics::GraphicsContext", "Creating the default OpenGL context...");
-
-            QSurfaceFormat defaultFormat;
-            defaultFormat.setRenderableType(QSurfaceFormat::OpenGL);
-            defaultFormat.setMajorVersion(4);
-            defaultFormat.setMinorVersion(1);
-            defaultFormat.setProfile(QSurfaceFormat::CoreProfile);
-            //! \todo Document this environment variable.
-            if (Core::System::env("DJV_OPENGL_DEBUG").size())
+            Core::Timer timer;
+            if (OPENGL_INIT_NOW == openGLInit)
             {
-                defaultFormat.setOption(QSurfaceFormat::DebugContext);
+                _initOpenGL();
             }
-            QSurfaceFormat::setDefaultFormat(defaultFormat);
-
-            _p->offscreenSurface.reset(new QOffscreenSurface);
-            QSurfaceFormat surfaceFormat = QSurfaceFormat::defaultFormat();
-            surfaceFormat.setSwapBehavior(QSurfaceFormat::SingleBuffer);
-            surfaceFormat.setSamples(1);
-            _p->offscreenSurface->setFormat(surfaceFormat);
-            _p->offscreenSurface->create();
-            _p->openGLContext.reset(new QOpenGLContext);
-            _p->openGLContext->setFormat(surfaceFormat);
-            if (!_p->openGLContext->create())
+            else
             {
-                throw Core::Error(
-                    "djv::Graphics::GraphicsContext",
-                    qApp->translate("djv::Graphics::GraphicsContext", "Cannot create OpenGL context, found version %1.%2").
-                    arg(_p->openGLContext->format().majorVersion()).arg(_p->openGLContext->format().minorVersion()));
+                DJV_LOG(debugLog(), "djv::Graphics::GraphicsContext", "Deferring the default OpenGL context");
             }
-            _p->openGLContext->makeCurrent(_p->offscreenSurface.data());
-            DJV_LOG(debugLog(), "djv::Graphics::GraphicsContext",
-                QString("OpenGL context valid = %1").arg(_p->openGLContext->isValid()));
+            timer.check();
             DJV_LOG(debugLog(), "djv::Graphics::GraphicsContext",
-                QString("OpenGL version = %1.%2").
-                arg(_p->openGLContext->format().majorVersion()).
-                arg(_p->openGLContext->format().minorVersion()));
-            if (!_p->openGLContext->versionFunctions<QOpenGLFunctions_3_3_Core>())
-            {
-                throw Core::Error(
-                    "djv::Graphics::GraphicsContext",
-                    qApp->translate("djv::Graphics::GraphicsContext", "Cannot find OpenGL 3.3 functions, found version %1.%2").
-                    arg(_p->openGLContext->format().majorVersion()).arg(_p->openGLContext->format().minorVersion()));
-            }
-
-            _p->openGLDebugLogger.reset(new QOpenGLDebugLogger);
-            connect(
-                _p->openGLDebugLogger.data(),
-                &QOpenGLDebugLogger::messageLogged,
-                this,
-                &GraphicsContext::debugLogMessage);
-            if (_p->openGLContext->format().testOption(QSurfaceFormat::DebugContext))
-            {
-                _p->openGLDebugLogger->initialize();
-                _p->openGLDebugLogger->startLogging();
-            }
+                QString("Startup timing: OpenGL = %1 seconds").arg(timer.seconds()));
 
-            //! Create the image I/O plugins.
+            //! Create the image I/O plugins. The built-in plugins are added to
+            //! the plugin index and only created when they are first needed.
             DJV_LOG(debugLog(), "djv::Graphics::GraphicsContext", "Loading image I/O plugins...");
-
+            timer.start();
             _p->imageIOFactory.reset(new ImageIOFactory(this));
-            _p->imageIOFactory->addPlugin(new CineonPlugin(this));
-            _p->imageIOFactory->addPlugin(new DPXPlugin(this));
-            _p->imageIOFactory->addPlugin(new IFFPlugin(this));
-            _p->imageIOFactory->addPlugin(new IFLPlugin(this));
-            _p->imageIOFactory->addPlugin(new LUTPlugin(this));
-            _p->imageIOFactory->addPlugin(new PICPlugin(this));
-            _p->imageIOFactory->addPlugin(new PPMPlugin(this));
-            _p->imageIOFactory->addPlugin(new RLAPlugin(this));
-            _p->imageIOFactory->addPlugin(new SGIPlugin(this));
-            _p->imageIOFactory->addPlugin(new TargaPlugin(this));
+            _p->imageIOFactory->addPlugin(Cineon::staticName, [this] { return new CineonPlugin(this); });
+            _p->imageIOFactory->addPlugin(DPX::staticName, [this] { return new DPXPlugin(this); });
+            _p->imageIOFactory->addPlugin(IFF::staticName, [this] { return new IFFPlugin(this); });
+            _p->imageIOFactory->addPlugin(IFL::staticName, [this] { return new IFLPlugin(this); });
+            _p->imageIOFactory->addPlugin(LUT::staticName, [this] { return new LUTPlugin(this); });
+            _p->imageIOFactory->addPlugin(PIC::staticName, [this] { return new PICPlugin(this); });
+            _p->imageIOFactory->addPlugin(PPM::staticName, [this] { return new PPMPlugin(this); });
+            _p->imageIOFactory->addPlugin(ReviewCache::staticName, [this] { return new ReviewCachePlugin(this); });
+            _p->imageIOFactory->addPlugin(RLA::staticName, [this] { return new RLAPlugin(this); });
+            _p->imageIOFactory->addPlugin(SGI::staticName, [this] { return new SGIPlugin(this); });
+            _p->imageIOFactory->addPlugin(Targa::staticName, [this] { return new TargaPlugin(this); });
 #if defined(JPEG_FOUND)
-            _p->imageIOFactory->addPlugin(new JPEGPlugin(this));
+            _p->imageIOFactory->addPlugin(JPEG::staticName, [this] { return new JPEGPlugin(this); });
 #endif // JPEG_FOUND
 #if defined(PNG_FOUND)
-            _p->imageIOFactory->addPlugin(new PNGPlugin(this));
+            _p->imageIOFactory->addPlugin(PNG::staticName, [this] { return new PNGPlugin(this); });
 #endif // PNG_FOUND
 #if defined(TIFF_FOUND)
-            _p->imageIOFactory->addPlugin(new TIFFPlugin(this));
+            _p->imageIOFactory->addPlugin(TIFF::staticName, [this] { return new TIFFPlugin(this); });
 #endif // TIFF_FOUND
 #if defined(OPENEXR_FOUND)
-            _p->imageIOFactory->addPlugin(new OpenEXRPlugin(this));
+            _p->imageIOFactory->addPlugin(OpenEXR::staticName, [this] { return new OpenEXRPlugin(this); });
 #endif // OPENEXR_FOUND
 #if defined(FFMPEG_FOUND)
-            _p->imageIOFactory->addPlugin(new FFmpegPlugin(this));
+            _p->imageIOFactory->addPlugin(FFmpeg::staticName, [this] { return new FFmpegPlugin(this); });
 #endif // FFMPEG_FOUND
+            _p->imageIOFactory->indexSave();
+            timer.check();
+            DJV_LOG(debugLog(), "djv::Graphics::GraphicsContext",
+                QString("Startup timing: image I/O plugins = %1 seconds").arg(timer.seconds()));
 
             DJV_LOG(debugLog(), "djv::Graphics::GraphicsContext", "Information:");
             DJV_LOG(debugLog(), "djv::Graphics::GraphicsContext", info());
@@ -201,11 +171,24 @@ namespace djv
 
         QOpenGLContext * GraphicsContext::openGLContext() const
         {
+            if (!_p->openGLContext)
+            {
+                const_cast<GraphicsContext *>(this)->_initOpenGL();
+            }
             return _p->openGLContext.data();
         }
 
+        bool GraphicsContext::isOpenGLInitialized() const
+        {
+            return !_p->openGLContext.isNull();
+        }
+
         void GraphicsContext::makeGLContextCurrent()
         {
+            if (!_p->openGLContext)
+            {
+                _initOpenGL();
+            }
             _p->openGLContext->makeCurrent(_p->offscreenSurface.data());
         }
 
@@ -216,20 +199,26 @@ namespace djv
                 "\n"
                 "OpenGL\n"
                 "\n"
-                "    Version: %2.%3\n"
-                "    Render filter: %4, %5\n"
+                "    Version: %2\n"
+                "    Render filter: %3, %4\n"
                 "\n"
                 "Image I/O\n"
                 "\n"
-                "    Plugins: %6\n");
+                "    Plugins: %5\n");
+            QString versionLabel = qApp->translate("djv::Graphics::GraphicsContext", "Not initialized");
+            if (_p->openGLContext)
+            {
+                versionLabel = QString("%1.%2").
+                    arg(_p->openGLContext->format().majorVersion()).
+                    arg(_p->openGLContext->format().minorVersion());
+            }
             QStringList filterMinLabel;
             filterMinLabel << OpenGLImageFilter::filter().min;
             QStringList filterMagLabel;
             filterMagLabel << OpenGLImageFilter::filter().mag;
             return QString(label).
                 arg(Core::CoreContext::info()).
-                arg(_p->openGLContext->format().majorVersion()).
-                arg(_p->openGLContext->format().minorVersion()).
+                arg(versionLabel).
                 arg(filterMinLabel.join(", ")).
                 arg(filterMagLabel.join(", ")).
                 arg(_p->imageIOFactory->names().join(", "));
@@ -243,10 +232,16 @@ namespace djv
             if (!Core::CoreContext::commandLineParse(in))
                 return false;
 
-            Q_FOREACH(Core::Plugin * plugin, _p->imageIOFactory->plugins())
+            // Only load the plugins that have options on the command line.
+            Q_FOREACH(const QString & name, _p->imageIOFactory->names())
             {
-                ImageIO * io = static_cast<ImageIO *>(plugin);
-                io->commandLine(in);
+                if (_p->imageIOFactory->hasCommandLineOptions(name, in))
+                {
+                    if (ImageIO * io = static_cast<ImageIO *>(_p->imageIOFactory->plugin(name)))
+                    {
+                        io->commandLine(in);
+                    }
+                }
             }
 
             QStringList tmp;
@@ -322,6 +317,66 @@ namespace djv
                 arg(Core::CoreContext::commandLineHelp());
         }
 
+        void GraphicsContext::_initOpenGL()
+        {
+            //DJV_DEBUG("GraphicsContext::_initOpenGL");
+            DJV_LOG(debugLog(), "djv::Graphics::GraphicsContext", "Creating the default OpenGL context...");
+
+            QSurfaceFormat defaultFormat;
+            defaultFormat.setRenderableType(QSurfaceFormat::OpenGL);
+            defaultFormat.setMajorVersion(4);
+            defaultFormat.setMinorVersion(1);
+            defaultFormat.setProfile(QSurfaceFormat::CoreProfile);
+            //! \todo Document this environment variable.
+            if (Core::System::env("DJV_OPENGL_DEBUG").size())
+            {
+                defaultFormat.setOption(QSurfaceFormat::DebugContext);
+            }
+            QSurfaceFormat::setDefaultFormat(defaultFormat);
+
+            _p->offscreenSurface.reset(new QOffscreenSurface);
+            QSurfaceFormat surfaceFormat = QSurfaceFormat::defaultFormat();
+            surfaceFormat.setSwapBehavior(QSurfaceFormat::SingleBuffer);
+            surfaceFormat.setSamples(1);
+            _p->offscreenSurface->setFormat(surfaceFormat);
+            _p->offscreenSurface->create();
+            _p->openGLContext.reset(new QOpenGLContext);
+            _p->openGLContext->setFormat(surfaceFormat);
+            if (!_p->openGLContext->create())
+            {
+                throw Core::Error(
+                    "djv::Graphics::GraphicsContext",
+                    qApp->translate("djv::Graphics::GraphicsContext", "Cannot create OpenGL context, found version %1.%2").
+                    arg(_p->openGLContext->format().majorVersion()).arg(_p->openGLContext->format().minorVersion()));
+            }
+            _p->openGLContext->makeCurrent(_p->offscreenSurface.data());
+            DJV_LOG(debugLog(), "djv::Graphics::GraphicsContext",
+                QString("OpenGL context valid = %1").arg(_p->openGLContext->isValid()));
+            DJV_LOG(debugLog(), "djv::Graphics::GraphicsContext",
+                QString("OpenGL version = %1.%2").
+                arg(_p->openGLContext->format().majorVersion()).
+                arg(_p->openGLContext->format().minorVersion()));
+            if (!_p->openGLContext->versionFunctions<QOpenGLFunctions_3_3_Core>())
+            {
+                throw Core::Error(
+                    "djv::Graphics::GraphicsContext",
+                    qApp->translate("djv::Graphics::GraphicsContext", "Cannot find OpenGL 3.3 functions, found version %1.%2").
+                    arg(_p->openGLContext->format().majorVersion()).arg(_p->openGLContext->format().minorVersion()));
+            }
+
+            _p->openGLDebugLogger.reset(new QOpenGLDebugLogger);
+            connect(
+                _p->openGLDebugLogger.data(),
+                &QOpenGLDebugLogger::messageLogged,
+                this,
+                &GraphicsContext::debugLogMessage);
+            if (_p->openGLContext->format().testOption(QSurfaceFormat::DebugContext))
+            {
+                _p->openGLDebugLogger->initialize();
+                _p->openGLDebugLogger->startLogging();
+            }
+        }
+
         void GraphicsContext::debugLogMessage(const QOpenGLDebugMessage & message)
         {
             DJV_LOG(debugLog(), "djv::Graphics::GraphicsContext", message.message());
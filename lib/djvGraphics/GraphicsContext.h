@@ -41,19 +41,44 @@ namespace djv
         class ImageIOFactory;
 
         //! This class provides global functionality for the library.
+        //!
+        //! The default OpenGL context may be created when the context is created,
+        //! or deferred until it is first needed. Deferring the OpenGL context
+        //! allows applications that don't process pixels, like djv_info and
+        //! djv_ls, to run without a display.
         class GraphicsContext : public Core::CoreContext
         {
         public:
+            //! This enumeration provides the OpenGL initialization modes.
+            enum OPENGL_INIT
+            {
+                OPENGL_INIT_NOW,     //!< Create the OpenGL context immediately
+                OPENGL_INIT_DEFERRED //!< Create the OpenGL context when first needed
+            };
+
             explicit GraphicsContext(int & argc, char ** argv, QObject * parent = nullptr);
+            GraphicsContext(int & argc, char ** argv, OPENGL_INIT, QObject * parent = nullptr);
             ~GraphicsContext() override;
 
-            //! Get the image I/O factory.    
+            //! Get the image I/O factory. Image loading does not require the
+            //! OpenGL context.
             ImageIOFactory * imageIOFactory() const;
 
-            //! Get the default OpenGL context.
+            //! Get the default OpenGL context. This creates the context if it
+            //! has been deferred.
+            //!
+            //! Throws:
+            //! - Core::Error
             QOpenGLContext * openGLContext() const;
 
-            //! Make the default OpenGL context current.
+            //! Get whether the default OpenGL context has been created.
+            bool isOpenGLInitialized() const;
+
+            //! Make the default OpenGL context current. This creates the context
+            //! if it has been deferred.
+            //!
+            //! Throws:
+            //! - Core::Error
             void makeGLContextCurrent();
 
             QString info() const override;
@@ -66,6 +91,8 @@ namespace djv
             void debugLogMessage(const QOpenGLDebugMessage &);
 
         private:
+            void _initOpenGL();
+
             struct Private;
             std::unique_ptr<Private> _p;
         };
@@ -34,6 +34,7 @@
 #include <djvGraphics/PixelDataUtil.h>
 
 #include <djvCore/CoreContext.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -54,6 +55,7 @@ namespace djv
             _file = in;
 
             Core::FileIO io;
+            io.setMmap(false);
 
             _open(_file.fileName(_file.sequence().start()), info, io);
 
@@ -67,6 +69,7 @@ namespace djv
         {
             //DJV_DEBUG("IFFLoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE("IFFLoad::read", "ImageIO");
 
             image.colorProfile = ColorProfile();
             image.tags = ImageTags();
@@ -493,6 +496,13 @@ namespace djv
             //DJV_DEBUG_PRINT("image = " << image);
         }
 
+        ImageLoad * IFFLoad::clone() const
+        {
+            auto out = new IFFLoad(context());
+            out->_file = _file;
+            return out;
+        }
+
         void IFFLoad::_open(const Core::FileInfo & in, ImageIOInfo & info, Core::FileIO & io)
         {
             //DJV_DEBUG("IFFLoad::_open");
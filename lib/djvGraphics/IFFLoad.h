@@ -50,6 +50,7 @@ namespace djv
 
             void open(const Core::FileInfo &, ImageIOInfo &) override;
             void read(Image &, const ImageIOFrameInfo &) override;
+            ImageLoad * clone() const override;
 
         private:
             void _open(const Core::FileInfo &, ImageIOInfo &, Core::FileIO &);
@@ -33,6 +33,7 @@
 #include <djvGraphics/OpenGLImage.h>
 
 #include <djvCore/CoreContext.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -89,6 +90,7 @@ namespace djv
         {
             //DJV_DEBUG("djvIFFSave::write");
             //DJV_DEBUG_PRINT("in = " << in);
+            DJV_TRACE("IFFSave::write", "ImageIO");
 
             // Open the file.
             Core::FileIO io;
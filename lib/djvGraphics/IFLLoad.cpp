@@ -37,6 +37,7 @@
 #include <djvCore/Error.h>
 #include <djvCore/FileIOUtil.h>
 #include <djvCore/FileInfoUtil.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -102,6 +103,7 @@ namespace djv
         {
             //DJV_DEBUG("IFLLoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE("IFLLoad::read", "ImageIO");
             image.colorProfile = ColorProfile();
             image.tags = ImageTags();
             QString fileName;
@@ -125,5 +127,12 @@ namespace djv
             load->read(image, ImageIOFrameInfo(-1, frame.layer, frame.proxy));
         }
 
+        ImageLoad * IFLLoad::clone() const
+        {
+            auto out = new IFLLoad(context());
+            out->_list = _list;
+            return out;
+        }
+
     } // namespace Graphics
 } // namespace djv
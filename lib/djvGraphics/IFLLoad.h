@@ -45,6 +45,7 @@ namespace djv
 
             void open(const Core::FileInfo &, ImageIOInfo &) override;
             void read(Image &, const ImageIOFrameInfo &) override;
+            ImageLoad * clone() const override;
 
         private:
             QStringList _list;
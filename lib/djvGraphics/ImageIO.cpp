@@ -36,13 +36,19 @@
 #include <djvCore/DebugLog.h>
 #include <djvCore/Error.h>
 #include <djvCore/FileInfo.h>
+#include <djvCore/Trace.h>
 
 #include <QCoreApplication>
 #include <QDir>
 #include <QMap>
+#include <QOpenGLContext>
 #include <QPointer>
+#include <QSet>
 
 #include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 namespace djv
 {
@@ -113,6 +119,17 @@ namespace djv
         ImageLoad::~ImageLoad()
         {}
 
+        void ImageLoad::probe(const Core::FileInfo & fileInfo, ImageIOInfo & info)
+        {
+            open(fileInfo, info);
+            close();
+        }
+
+        ImageLoad * ImageLoad::clone() const
+        {
+            return nullptr;
+        }
+
         void ImageLoad::close()
         {}
 
@@ -138,6 +155,11 @@ namespace djv
         void ImageSave::close()
         {}
 
+        bool ImageSave::hasFrame(const ImageIOFrameInfo &) const
+        {
+            return false;
+        }
+
         const QPointer<Core::CoreContext> & ImageSave::context() const
         {
             return _p->context;
@@ -183,6 +205,11 @@ namespace djv
             return QString();
         }
 
+        QString ImageIO::commandLinePrefix() const
+        {
+            return "-" + pluginName().toLower() + "_";
+        }
+
         ImageLoad * ImageIO::createLoad() const
         {
             return 0;
@@ -205,14 +232,25 @@ namespace djv
             return data;
         }
 
+        namespace
+        {
+            const QString extensionsIndexKey = "extensions";
+            const QString sequenceIndexKey = "sequence";
+            const QString commandLinePrefixIndexKey = "commandLinePrefix";
+
+        } // namespace
+
         struct ImageIOFactory::Private
         {
-            // This map is used to lookup an image I/O plugin by it's name.
-            QMap<QString, ImageIO *> nameMap;
+            // This map is used to lookup an image I/O plugin name by it's lower
+            // case name.
+            QMap<QString, QString> nameMap;
+
+            // This map is used to lookup an image I/O plugin name for a given
+            // file extension.
+            QMap<QString, QString> extensionMap;
 
-            // This map is used to lookup an image I/O plugin for a given file
-            // extension.
-            QMap<QString, ImageIO *> extensionMap;
+            QPointer<Core::CoreContext> context;
         };
 
         ImageIOFactory::ImageIOFactory(
@@ -223,12 +261,14 @@ namespace djv
             _p(new Private)
         {
             //DJV_DEBUG("ImageIOFactory::ImageIOFactory");
-            const QList<Core::Plugin *> & plugins = this->plugins();
-            Q_FOREACH(Core::Plugin * plugin, plugins)
+            _p->context = context;
+            indexUpdate();
+            Q_FOREACH(const QString & name, names())
             {
-                if (ImageIO * imageIO = dynamic_cast<ImageIO *>(plugin))
+                _addIndex(name, indexData(name));
+                if (isLoaded(name))
                 {
-                    _addPlugin(imageIO);
+                    pluginLoaded(plugin(name));
                 }
             }
         }
@@ -242,13 +282,11 @@ namespace djv
             const QString & name,
             const QString & option) const
         {
-            const QString nameLower = name.toLower();
-            if (_p->nameMap.contains(nameLower))
+            if (ImageIO * imageIO = _plugin(name))
             {
                 //DJV_DEBUG("ImageIOFactory::option");
                 //DJV_DEBUG_PRINT("name   = " << name);
                 //DJV_DEBUG_PRINT("option = " << option);
-                ImageIO * imageIO = _p->nameMap[nameLower];
                 return imageIO->option(option);
             }
             return QStringList();
@@ -259,30 +297,46 @@ namespace djv
             const QString & option,
             QStringList &   data)
         {
-            const QString nameLower = name.toLower();
-            if (_p->nameMap.contains(nameLower))
+            if (ImageIO * imageIO = _plugin(name))
             {
                 //DJV_DEBUG("djvImageIOFactory::setOption");
                 //DJV_DEBUG_PRINT("name   = " << name);
                 //DJV_DEBUG_PRINT("option = " << option);
                 //DJV_DEBUG_PRINT("data   = " << data);
-                ImageIO * imageIO = _p->nameMap[nameLower];
                 return imageIO->setOption(option, data);
             }
             return false;
         }
 
+        bool ImageIOFactory::hasCommandLineOptions(const QString & name, const QStringList & in) const
+        {
+            const QStringList prefix = indexData(name)[commandLinePrefixIndexKey];
+            if (!prefix.count() || prefix[0].isEmpty())
+                return true;
+            Q_FOREACH(const QString & arg, in)
+            {
+                if (arg.startsWith(prefix[0]))
+                    return true;
+            }
+            return false;
+        }
+
+        bool ImageIOFactory::isExtension(const Core::FileInfo & fileInfo) const
+        {
+            return _p->extensionMap.contains(fileInfo.extension().toLower());
+        }
+
         ImageLoad * ImageIOFactory::load(
             const Core::FileInfo & fileInfo,
             ImageIOInfo &          imageIOInfo) const
         {
             //DJV_DEBUG("ImageIOFactory::load");
             //DJV_DEBUG_PRINT("fileInfo = " << fileInfo);
+            DJV_TRACE("ImageIOFactory::load", "ImageIO");
             //DJV_LOG("ImageIOFactory", QString("Loading: \"%1\"...").arg(fileInfo));
             const QString extensionLower = fileInfo.extension().toLower();
-            if (_p->extensionMap.contains(extensionLower))
+            if (ImageIO * imageIO = _p->extensionMap.contains(extensionLower) ? _plugin(_p->extensionMap[extensionLower]) : nullptr)
             {
-                ImageIO * imageIO = _p->extensionMap[extensionLower];
                 //DJV_LOG("ImageIOFactory", QString("Using plugin: \"%1\"").arg(imageIO->pluginName()));
                 if (ImageLoad * imageLoad = imageIO->createLoad())
                 {
@@ -303,12 +357,102 @@ namespace djv
             return 0;
         }
 
+        ImageIOInfo ImageIOFactory::probe(const Core::FileInfo & fileInfo) const
+        {
+            //DJV_DEBUG("ImageIOFactory::probe");
+            //DJV_DEBUG_PRINT("fileInfo = " << fileInfo);
+            DJV_TRACE("ImageIOFactory::probe", "ImageIO");
+            const QString extensionLower = fileInfo.extension().toLower();
+            if (ImageIO * imageIO = _p->extensionMap.contains(extensionLower) ? _plugin(_p->extensionMap[extensionLower]) : nullptr)
+            {
+                std::unique_ptr<ImageLoad> imageLoad(imageIO->createLoad());
+                if (imageLoad)
+                {
+                    ImageIOInfo out;
+                    imageLoad->probe(fileInfo, out);
+                    return out;
+                }
+            }
+            throw Core::Error(
+                "djv::Graphics::ImageIOFactory",
+                qApp->translate("djv::Graphics::ImageIOFactory", "Unrecognized image: %1").
+                arg(QDir::toNativeSeparators(fileInfo)));
+            return ImageIOInfo();
+        }
+
+        QVector<ImageIOProbe> ImageIOFactory::probe(const Core::FileInfoList & fileInfoList, int threads) const
+        {
+            //DJV_DEBUG("ImageIOFactory::probe");
+            //DJV_DEBUG_PRINT("fileInfoList = " << fileInfoList.count());
+            const int count = fileInfoList.count();
+            QVector<ImageIOProbe> out(count);
+
+            // Load the plugins from this thread before starting the workers.
+            QSet<QString> extensions;
+            for (int i = 0; i < count; ++i)
+            {
+                out[i].fileInfo = fileInfoList[i];
+                const QString extensionLower = fileInfoList[i].extension().toLower();
+                if (!extensions.contains(extensionLower))
+                {
+                    extensions.insert(extensionLower);
+                    if (_p->extensionMap.contains(extensionLower))
+                    {
+                        _plugin(_p->extensionMap[extensionLower]);
+                    }
+                }
+            }
+
+            // Each worker takes the next unprobed image until the list is
+            // exhausted.
+            if (threads <= 0)
+            {
+                threads = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+            }
+            threads = std::min(threads, count);
+            ImageIOProbe * data = out.data();
+            std::atomic<int> next(0);
+            auto work = [this, data, count, &next]
+            {
+                int i = next++;
+                while (i < count)
+                {
+                    try
+                    {
+                        data[i].info = probe(data[i].fileInfo);
+                        data[i].valid = true;
+                    }
+                    catch (const Core::Error & error)
+                    {
+                        data[i].error = error;
+                    }
+                    catch (const std::exception & error)
+                    {
+                        data[i].error = Core::Error("djv::Graphics::ImageIOFactory", error.what());
+                    }
+                    i = next++;
+                }
+            };
+            std::vector<std::thread> workers;
+            for (int i = 1; i < threads; ++i)
+            {
+                workers.push_back(std::thread(work));
+            }
+            work();
+            for (auto & worker : workers)
+            {
+                worker.join();
+            }
+            return out;
+        }
+
         ImageSave * ImageIOFactory::save(
             const Core::FileInfo & fileInfo,
             const ImageIOInfo & imageIOInfo) const
         {
             //DJV_DEBUG("ImageIOFactory::save");
             //DJV_DEBUG_PRINT("fileInfo = " << fileInfo);
+            DJV_TRACE("ImageIOFactory::save", "ImageIO");
             //DJV_DEBUG_PRINT("imageIOInfo = " << imageIOInfp);
             //DJV_LOG("ImageIOFactory", QString("Saving: \"%1\"").arg(fileInfo));
             //QStringList tmp;
@@ -318,12 +462,20 @@ namespace djv
             //tmp << imageIOInfo.pixel;
             //DJV_LOG("ImageIOFactory", QString("Pixel: %1").arg(tmp.join(", ")));
             const QString extensionLower = fileInfo.extension().toLower();
-            if (_p->extensionMap.contains(extensionLower))
+            if (ImageIO * imageIO = _p->extensionMap.contains(extensionLower) ? _plugin(_p->extensionMap[extensionLower]) : nullptr)
             {
-                ImageIO * imageIO = _p->extensionMap[extensionLower];
                 //DJV_LOG("ImageIOFactory", QString("Using plugin: \"%1\"").arg(imageIO->pluginName()));
                 if (ImageSave * imageSave = imageIO->createSave())
                 {
+                    // Savers convert images with OpenGL, so make sure there is
+                    // a current context when the default one has been deferred.
+                    if (!QOpenGLContext::currentContext())
+                    {
+                        if (auto graphicsContext = dynamic_cast<GraphicsContext *>(_p->context.data()))
+                        {
+                            graphicsContext->makeGLContextCurrent();
+                        }
+                    }
                     imageSave->open(fileInfo, imageIOInfo);
                     return imageSave;
                 }
@@ -346,9 +498,43 @@ namespace djv
         void ImageIOFactory::addPlugin(Core::Plugin * plugin)
         {
             Core::PluginFactory::addPlugin(plugin);
+            _addIndex(plugin->pluginName(), indexData(plugin->pluginName()));
+        }
+
+        void ImageIOFactory::addPlugin(const QString & name, const std::function<Core::Plugin *(void)> & create)
+        {
+            Core::PluginFactory::addPlugin(name, create);
+            _addIndex(name, indexData(name));
+        }
+
+        Core::PluginIndexData ImageIOFactory::pluginIndexData(Core::Plugin * plugin) const
+        {
+            Core::PluginIndexData out;
             if (ImageIO * imageIO = dynamic_cast<ImageIO *>(plugin))
             {
-                _addPlugin(imageIO);
+                out[extensionsIndexKey] = imageIO->extensions();
+                out[sequenceIndexKey] = QStringList() << QString::number(imageIO->isSequence());
+                out[commandLinePrefixIndexKey] = QStringList() << imageIO->commandLinePrefix();
+            }
+            return out;
+        }
+
+        void ImageIOFactory::pluginLoaded(Core::Plugin * plugin)
+        {
+            if (ImageIO * imageIO = dynamic_cast<ImageIO *>(plugin))
+            {
+                // Plugins may be loaded on demand from other threads.
+                if (imageIO->thread() != thread())
+                {
+                    imageIO->moveToThread(thread());
+                }
+
+                // This callback listens to option changes in the image I/O
+                // plugins.
+                connect(
+                    imageIO,
+                    SIGNAL(optionChanged(const QString &)),
+                    SLOT(pluginOptionCallback(const QString &)));
             }
         }
 
@@ -357,12 +543,25 @@ namespace djv
             Q_EMIT optionChanged();
         }
 
-        void ImageIOFactory::_addPlugin(ImageIO * plugin)
+        ImageIO * ImageIOFactory::_plugin(const QString & name) const
+        {
+            const QString nameLower = name.toLower();
+            if (_p->nameMap.contains(nameLower))
+            {
+                return dynamic_cast<ImageIO *>(plugin(_p->nameMap[nameLower]));
+            }
+            return nullptr;
+        }
+
+        void ImageIOFactory::_addIndex(const QString & name, const Core::PluginIndexData & data)
         {
+            const QStringList & extensions = data[extensionsIndexKey];
+
             // Register file sequence extensions.
-            if (plugin->isSequence())
+            const QStringList & sequence = data[sequenceIndexKey];
+            if (sequence.count() && sequence[0].toInt())
             {
-                Q_FOREACH(const QString & extension, plugin->extensions())
+                Q_FOREACH(const QString & extension, extensions)
                 {
                     Core::FileInfo::sequenceExtensions.insert(extension.toLower());
                     Core::FileInfo::sequenceExtensions.insert(extension.toUpper());
@@ -370,18 +569,11 @@ namespace djv
             }
 
             // Setup internal maps.
-            _p->nameMap[plugin->pluginName().toLower()] = plugin;
-            Q_FOREACH(const QString & extension, plugin->extensions())
+            _p->nameMap[name.toLower()] = name;
+            Q_FOREACH(const QString & extension, extensions)
             {
-                _p->extensionMap[extension.toLower()] = plugin;
+                _p->extensionMap[extension.toLower()] = name;
             }
-
-            // This callback listens to option changes in the image I/O
-            // plugins.
-            connect(
-                plugin,
-                SIGNAL(optionChanged(const QString &)),
-                SLOT(pluginOptionCallback(const QString &)));
         }
 
     } // namespace Graphics
@@ -411,7 +603,8 @@ namespace djv
         return
             a.frame == b.frame &&
             a.layer == b.layer &&
-            a.proxy == b.proxy;
+            a.proxy == b.proxy &&
+            a.tags == b.tags;
     }
 
     bool operator != (const Graphics::ImageIOFrameInfo & a, const Graphics::ImageIOFrameInfo & b)
@@ -32,6 +32,8 @@
 #include <djvGraphics/ImageTags.h>
 #include <djvGraphics/PixelData.h>
 
+#include <djvCore/Error.h>
+#include <djvCore/FileInfo.h>
 #include <djvCore/Plugin.h>
 #include <djvCore/Sequence.h>
 #include <djvCore/System.h>
@@ -51,7 +53,6 @@ namespace djv
     namespace Core
     {
         class CoreContext;
-        class FileInfo;
 
     } // namespace Core
 
@@ -109,11 +110,33 @@ namespace djv
 
             //! The proxy scale.
             PixelDataInfo::PROXY proxy = PixelDataInfo::PROXY_NONE;
+
+            //! Whether to load the image tags. Loaders may skip parsing the
+            //! tags when they are not needed.
+            bool tags = true;
+        };
+
+        //! This struct provides the result of probing an image.
+        struct ImageIOProbe
+        {
+            //! The file that was probed.
+            Core::FileInfo fileInfo;
+
+            //! The image information.
+            ImageIOInfo info;
+
+            //! Whether the image was probed successfully.
+            bool valid = false;
+
+            //! The error when the image could not be probed.
+            Core::Error error;
         };
 
         //! This class provides the base functionality for image loading.
         //!
-        //! Note that image loaders may be run in a separate thread.
+        //! Note that image loaders may be run in a separate thread. A single
+        //! loader must only be used by one thread at a time; to read frames
+        //! concurrently, give each thread its own loader from clone().
         class ImageLoad
         {
         public:
@@ -126,12 +149,27 @@ namespace djv
             //! - Core::Error
             virtual void open(const Core::FileInfo &, ImageIOInfo &) = 0;
 
+            //! Get the image information without preparing the image for
+            //! loading. Implementations should only read the data needed for the
+            //! information. The default implementation calls open() and close().
+            //!
+            //! Throws:
+            //! - Core::Error
+            virtual void probe(const Core::FileInfo &, ImageIOInfo &);
+
             //! Load an image.
             //!
             //! Throws:
             //! - Core::Error
             virtual void read(Image &, const ImageIOFrameInfo & = ImageIOFrameInfo()) = 0;
 
+            //! Create a new loader for the image that was opened. The clone
+            //! shares the information from open() but has its own decoding
+            //! state, so it can read frames in parallel with this loader. The
+            //! clone does not need to be opened. The default implementation
+            //! returns nullptr for loaders that cannot read concurrently.
+            virtual ImageLoad * clone() const;
+
             //! Close the image.
             //!
             //! Throws:
@@ -171,6 +209,10 @@ namespace djv
             //! - Core::Error
             virtual void close();
 
+            //! Get whether a frame has already been written, for savers that
+            //! can resume an interrupted write.
+            virtual bool hasFrame(const ImageIOFrameInfo &) const;
+
             //! Get the context.
             const QPointer<Core::CoreContext> & context() const;
 
@@ -212,6 +254,12 @@ namespace djv
             //! Get the command line help.
             virtual QString commandLineHelp() const;
 
+            //! Get the prefix of the command line options. This is stored in the
+            //! plugin index so that plugins are only loaded for parsing the
+            //! command line when they have options present. The default prefix is
+            //! "-" followed by the lower case plugin name and "_".
+            virtual QString commandLinePrefix() const;
+
             //! Get an image loader.
             virtual ImageLoad * createLoad() const;
 
@@ -256,12 +304,31 @@ namespace djv
             //! Set a plugin option.
             bool setOption(const QString & name, const QString &, QStringList &);
 
+            //! Get whether a plugin has options on the command line. This uses
+            //! the plugin index and does not load the plugin.
+            bool hasCommandLineOptions(const QString & name, const QStringList &) const;
+
+            //! Get whether a file has an extension that is supported by a plugin.
+            //! This uses the plugin index and does not load the plugin.
+            bool isExtension(const Core::FileInfo &) const;
+
             //! Open an image for loading.
             //!
             //! Throws:
             //! - Core::Error
             ImageLoad * load(const Core::FileInfo &, ImageIOInfo &) const;
 
+            //! Get the information for an image without opening it for loading.
+            //!
+            //! Throws:
+            //! - Core::Error
+            ImageIOInfo probe(const Core::FileInfo &) const;
+
+            //! Get the information for a list of images using a pool of threads.
+            //! The results are returned in the same order as the input. If the
+            //! thread count is zero the number of hardware threads is used.
+            QVector<ImageIOProbe> probe(const Core::FileInfoList &, int threads = 0) const;
+
             //! Open an image for saving.
             //!
             //! Throws:
@@ -280,18 +347,24 @@ namespace djv
             static const QStringList & errorLabels();
 
             void addPlugin(Core::Plugin *) override;
+            void addPlugin(const QString & name, const std::function<Core::Plugin *(void)> &) override;
 
         Q_SIGNALS:
             //! This signal is emitted when a plugin option is changed.
             void optionChanged();
 
+        protected:
+            Core::PluginIndexData pluginIndexData(Core::Plugin *) const override;
+            void pluginLoaded(Core::Plugin *) override;
+
         private Q_SLOTS:
             void pluginOptionCallback(const QString &);
 
         private:
             DJV_PRIVATE_COPY(ImageIOFactory);
 
-            void _addPlugin(ImageIO *);
+            ImageIO * _plugin(const QString &) const;
+            void _addIndex(const QString & name, const Core::PluginIndexData &);
 
             struct Private;
             std::unique_ptr<Private> _p;
@@ -34,6 +34,9 @@
 
 #include <djvCore/CoreContext.h>
 #include <djvCore/Error.h>
+#include <djvCore/Trace.h>
+
+#include <algorithm>
 
 namespace djv
 {
@@ -64,21 +67,20 @@ namespace djv
         namespace
         {
 
-            bool jpegScanline(
+            //! The maximum number of scanlines to read at once.
+            const int scanlineBatch = 16;
+
+            int jpegScanlines(
                 jpeg_decompress_struct * jpeg,
-                quint8 *                 out,
+                JSAMPROW *               rows,
+                int                      count,
                 JPEGErrorStruct *        error)
             {
                 if (::setjmp(error->jump))
                 {
-                    return false;
+                    return 0;
                 }
-                JSAMPROW p[] = { (JSAMPLE *)(out) };
-                if (!jpeg_read_scanlines(jpeg, p, 1))
-                {
-                    return false;
-                }
-                return true;
+                return static_cast<int>(jpeg_read_scanlines(jpeg, rows, count));
             }
 
             bool jpegEnd(
@@ -99,6 +101,7 @@ namespace djv
         {
             //DJV_DEBUG("JPEGLoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE("JPEGLoad::read", "ImageIO");
 
             image.colorProfile = ColorProfile();
             image.tags = ImageTags();
@@ -108,39 +111,45 @@ namespace djv
                 _file.fileName(frame.frame != -1 ? frame.frame : _file.sequence().start());
             //DJV_DEBUG_PRINT("file name = " << fileName);
             ImageIOInfo info;
-            _open(fileName, info);
+            _open(fileName, info, frame.proxy, frame.tags);
             image.tags = info.tags;
 
-            // Read the file.
-            PixelData * data = frame.proxy ? &_tmp : &image;
-            data->set(info);
-            for (int y = 0; y < info.size.y; ++y)
+            // Read the file. The proxy scale is applied by libjpeg in the DCT
+            // domain, so the image is decoded directly at the proxy size.
+            image.set(info);
+            const int h = info.size.y;
+            JSAMPROW rows[scanlineBatch];
+            int y = 0;
+            while (y < h)
             {
-                if (!jpegScanline(
-                    &_jpeg,
-                    data->data(0, data->h() - 1 - y),
-                    &_jpegError))
+                const int count = std::min(scanlineBatch, h - y);
+                for (int i = 0; i < count; ++i)
+                {
+                    rows[i] = (JSAMPLE *)(image.data(0, h - 1 - (y + i)));
+                }
+                const int read = jpegScanlines(&_jpeg, rows, count, &_jpegError);
+                if (!read)
                 {
                     throw Core::Error(JPEG::staticName, _jpegError.msg);
                 }
+                y += read;
             }
             if (!jpegEnd(&_jpeg, &_jpegError))
             {
                 throw Core::Error(JPEG::staticName, _jpegError.msg);
             }
 
-            if (frame.proxy)
-            {
-                info.size = PixelDataUtil::proxyScale(info.size, frame.proxy);
-                info.proxy = frame.proxy;
-                image.set(info);
-                PixelDataUtil::proxyScale(_tmp, image, frame.proxy);
-            }
-
             //DJV_DEBUG_PRINT("image = " << image);
             close();
         }
 
+        ImageLoad * JPEGLoad::clone() const
+        {
+            auto out = new JPEGLoad(context());
+            out->_file = _file;
+            return out;
+        }
+
         void JPEGLoad::close()
         {
             if (_jpegInit)
@@ -173,6 +182,8 @@ namespace djv
             bool jpegOpen(
                 FILE *                   f,
                 jpeg_decompress_struct * jpeg,
+                int                      scale,
+                bool                     markers,
                 JPEGErrorStruct *        error)
             {
                 if (::setjmp(error->jump))
@@ -180,11 +191,16 @@ namespace djv
                     return false;
                 }
                 jpeg_stdio_src(jpeg, f);
-                jpeg_save_markers(jpeg, JPEG_COM, 0xFFFF);
+                if (markers)
+                {
+                    jpeg_save_markers(jpeg, JPEG_COM, 0xFFFF);
+                }
                 if (!jpeg_read_header(jpeg, static_cast<boolean>(1)))
                 {
                     return false;
                 }
+                jpeg->scale_num = 1;
+                jpeg->scale_denom = scale;
                 if (!jpeg_start_decompress(jpeg))
                 {
                     return false;
@@ -194,7 +210,11 @@ namespace djv
 
         } // namespace
 
-        void JPEGLoad::_open(const QString & in, ImageIOInfo & info)
+        void JPEGLoad::_open(
+            const QString &      in,
+            ImageIOInfo &        info,
+            PixelDataInfo::PROXY proxy,
+            bool                 tags)
         {
             //DJV_DEBUG("JPEGLoad::_open");
             //DJV_DEBUG_PRINT("in = " << in);
@@ -224,7 +244,7 @@ namespace djv
                     JPEG::staticName,
                     ImageIO::errorLabels()[ImageIO::ERROR_OPEN]);
             }
-            if (!jpegOpen(_f, &_jpeg, &_jpegError))
+            if (!jpegOpen(_f, &_jpeg, PixelDataUtil::proxyScale(proxy), tags, &_jpegError))
             {
                 throw Core::Error(JPEG::staticName, _jpegError.msg);
             }
@@ -232,6 +252,7 @@ namespace djv
             // Information.
             info.fileName = in;
             info.size = glm::ivec2(_jpeg.output_width, _jpeg.output_height);
+            info.proxy = proxy;
             if (!Pixel::pixel(_jpeg.out_color_components, 8, Pixel::INTEGER, info.pixel))
             {
                 throw Core::Error(
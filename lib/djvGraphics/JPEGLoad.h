@@ -47,17 +47,21 @@ namespace djv
 
             void open(const Core::FileInfo &, ImageIOInfo &) override;
             void read(Image &, const ImageIOFrameInfo &) override;
+            ImageLoad * clone() const override;
             void close()  override;
 
         private:
-            void _open(const QString &, ImageIOInfo &);
+            void _open(
+                const QString &,
+                ImageIOInfo &,
+                PixelDataInfo::PROXY = PixelDataInfo::PROXY_NONE,
+                bool tags = true);
 
             Core::FileInfo         _file;
             FILE *                 _f = nullptr;
             jpeg_decompress_struct _jpeg;
             bool                   _jpegInit = false;
             JPEGErrorStruct        _jpegError;
-            PixelData              _tmp;
         };
 
     } // namespace Graphics
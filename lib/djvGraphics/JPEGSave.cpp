@@ -34,6 +34,7 @@
 #include <djvCore/CoreContext.h>
 #include <djvCore/Error.h>
 #include <djvCore/StringUtil.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -112,6 +113,7 @@ namespace djv
         {
             //DJV_DEBUG("JPEGSave::write");
             //DJV_DEBUG_PRINT("in = " << in);
+            DJV_TRACE("JPEGSave::write", "ImageIO");
 
             // Open the file.
             const QString fileName = _file.fileName(frame.frame);
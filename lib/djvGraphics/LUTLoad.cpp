@@ -35,6 +35,7 @@
 #include <djvCore/CoreContext.h>
 #include <djvCore/FileIO.h>
 #include <djvCore/ListUtil.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -65,6 +66,7 @@ namespace djv
         {
             //DJV_DEBUG("LUTLoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE("LUTLoad::read", "ImageIO");
 
             image.colorProfile = ColorProfile();
             image.tags = ImageTags();
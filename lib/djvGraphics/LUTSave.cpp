@@ -34,6 +34,7 @@
 #include <djvCore/CoreContext.h>
 #include <djvCore/FileIO.h>
 #include <djvCore/ListUtil.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -75,6 +76,7 @@ namespace djv
             //DJV_DEBUG("LUTSave::write");
             //DJV_DEBUG_PRINT("in = " << in);
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE("LUTSave::write", "ImageIO");
 
             // Open the file.
             const QString fileName = _file.fileName(frame.frame);
@@ -36,6 +36,7 @@
 #include <djvCore/BoxUtil.h>
 #include <djvCore/CoreContext.h>
 #include <djvCore/Error.h>
+#include <djvCore/Trace.h>
 
 #include <ImfChannelList.h>
 #include <ImfHeader.h>
@@ -75,6 +76,7 @@ namespace djv
         {
             //DJV_DEBUG("OpenEXRLoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE("OpenEXRLoad::read", "ImageIO");
             try
             {
                 // Open the file.
@@ -222,6 +224,13 @@ namespace djv
             close();
         }
 
+        ImageLoad * OpenEXRLoad::clone() const
+        {
+            auto out = new OpenEXRLoad(_options, context());
+            out->_file = _file;
+            return out;
+        }
+
         void OpenEXRLoad::close()
         {
             delete _f;
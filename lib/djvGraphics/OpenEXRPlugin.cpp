@@ -358,6 +358,11 @@ namespace djv
                 ;
         }
 
+        QString OpenEXRPlugin::commandLinePrefix() const
+        {
+            return "-exr_";
+        }
+
         ImageLoad * OpenEXRPlugin::createLoad() const
         {
             return new OpenEXRLoad(_options, context());
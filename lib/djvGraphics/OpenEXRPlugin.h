@@ -71,6 +71,7 @@ namespace djv
 
             void commandLine(QStringList &) override;
             QString commandLineHelp() const override;
+            QString commandLinePrefix() const override;
 
             ImageLoad * createLoad() const override;
             ImageSave * createSave() const override;
@@ -33,6 +33,7 @@
 
 #include <djvCore/CoreContext.h>
 #include <djvCore/Error.h>
+#include <djvCore/Trace.h>
 
 #include <ImfChannelList.h>
 #include <ImfCompressionAttribute.h>
@@ -89,6 +90,7 @@ namespace djv
         {
             //DJV_DEBUG("OpenEXRSave::write");
             //DJV_DEBUG_PRINT("in = " << in);
+            DJV_TRACE("OpenEXRSave::write", "ImageIO");
 
             try
             {
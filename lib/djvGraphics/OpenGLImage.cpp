@@ -38,6 +38,7 @@
 
 #include <djvCore/Debug.h>
 #include <djvCore/Error.h>
+#include <djvCore/Trace.h>
 
 #include <QCoreApplication>
 #include <QPixmap>
@@ -235,6 +236,21 @@ namespace djv
         OpenGLImage::~OpenGLImage()
         {}
 
+        float OpenGLImage::uploadTime() const
+        {
+            return _p->uploadTime;
+        }
+
+        quint64 OpenGLImage::uploadByteCount() const
+        {
+            return _p->uploadByteCount;
+        }
+
+        float OpenGLImage::drawTime() const
+        {
+            return _p->drawTime;
+        }
+
         namespace
         {
             bool initAlpha(const Pixel::PIXEL & input, const Pixel::PIXEL & output)
@@ -266,6 +282,16 @@ namespace djv
             //DJV_DEBUG_PRINT("input = " << input);
             //DJV_DEBUG_PRINT("output = " << output);
             //DJV_DEBUG_PRINT("scale = " << options.xform.scale);
+            DJV_TRACE("OpenGLImage::copy", "OpenGL");
+
+            // Integer pixel data that is not transformed can be processed on
+            // the CPU with lookup tables, which avoids the round trip through
+            // the GPU.
+            if (ColorPipeline::isSupported(input.info(), output.info(), options))
+            {
+                _p->colorPipeline.process(input, output, options);
+                return;
+            }
 
             auto glFuncs = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_3_3_Core>();
 
@@ -349,6 +375,7 @@ namespace djv
         {
             //DJV_DEBUG("average");
             //DJV_DEBUG_PRINT("in = " << in);
+            DJV_TRACE("OpenGLImage::average", "OpenGL");
 
             out.setPixel(in.pixel());
 
@@ -452,6 +479,7 @@ namespace djv
             //DJV_DEBUG("histogram");
             //DJV_DEBUG_PRINT("in = " << in);
             //DJV_DEBUG_PRINT("size = " << size);
+            DJV_TRACE("OpenGLImage::histogram", "OpenGL");
 
             // Create the output data using a pixel type of U16.
             Pixel::PIXEL pixel = static_cast<Pixel::PIXEL>(0);
@@ -657,6 +685,7 @@ namespace djv
         {
             //DJV_DEBUG("PixmapUtil::toQt");
             //DJV_DEBUG_PRINT("pixelData = " << pixelData);
+            DJV_TRACE("OpenGLImage::toQt", "OpenGL");
 
             // Convert the pixel data to an 8-bit format.
             const int w = pixelData.w();
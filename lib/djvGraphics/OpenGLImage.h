@@ -54,6 +54,7 @@ namespace djv
         class OpenGLOffscreenBuffer;
         class OpenGLTexture;
         class OpenGLShader;
+        class TilePyramid;
 
         //! This struct provides OpenGL image transform options.
         struct OpenGLImageXform
@@ -144,6 +145,13 @@ namespace djv
             //! Convert an image filter to OpenGL.
             static GLenum toGl(FILTER);
 
+            //! Evaluate the kernel of an image filter. The nearest and linear
+            //! filters use the box kernel.
+            static float kernel(FILTER, float);
+
+            //! Get the support radius of an image filter kernel.
+            static float kernelSupport(FILTER);
+
             //! Get the default image filter.
             static OpenGLImageFilter filterDefault();
 
@@ -196,6 +204,10 @@ namespace djv
             ~OpenGLImageMesh();
 
             void setSize(const glm::ivec2&, const PixelDataInfo::Mirror & mirror = PixelDataInfo::Mirror(), int proxyScale = 1);
+
+            //! Set the mesh to a rectangle with the given texture coordinates.
+            //! The texture coordinates may be flipped for mirroring.
+            void setArea(const Core::Box2f & position, const Core::Box2f & textureCoords);
             void draw();
 
         private:
@@ -220,6 +232,32 @@ namespace djv
                 const OpenGLImageOptions & options = OpenGLImageOptions(),
                 Pixel::FORMAT              outputFormat = Pixel::RGBA);
 
+            //! Draw a tile pyramid. Only the tiles of the level that matches the
+            //! scale and that intersect the view are uploaded and drawn, and the
+            //! uploaded tiles are cached between calls. The levels are already
+            //! filtered so the windowed filters are replaced with linear
+            //! filtering.
+            //!
+            //! Throws:
+            //! - Core::Error
+            void draw(
+                const TilePyramid &        pyramid,
+                const glm::mat4x4&         viewMatrix,
+                const OpenGLImageOptions & options = OpenGLImageOptions(),
+                Pixel::FORMAT              outputFormat = Pixel::RGBA);
+
+            //! Get the time in seconds spent uploading the texture in the last
+            //! call to draw().
+            float uploadTime() const;
+
+            //! Get the number of bytes uploaded in the last call to draw().
+            quint64 uploadByteCount() const;
+
+            //! Get the time in seconds spent in the last call to draw(), not
+            //! including the texture upload. This is the time to submit the
+            //! commands, the GPU may finish drawing later.
+            float drawTime() const;
+
             //! Copy pixel data.
             //!
             //! Throws:
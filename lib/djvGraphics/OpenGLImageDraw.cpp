@@ -35,15 +35,20 @@
 #include <djvGraphics/OpenGLShader.h>
 #include <djvGraphics/OpenGLTexture.h>
 #include <djvGraphics/PixelDataUtil.h>
+#include <djvGraphics/TilePyramid.h>
 
 #include <djvCore/Debug.h>
 #include <djvCore/Error.h>
+#include <djvCore/Timer.h>
+#include <djvCore/Trace.h>
 #include <djvCore/Vector.h>
 
 #include <QCoreApplication>
 
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <limits>
+
 namespace djv
 {
     namespace Graphics
@@ -56,8 +61,32 @@ namespace djv
             size_t vertexSize = 8 + 8;
             GLuint vbo = 0;
             GLuint vao = 0;
+
+            void setVertices(const glm::vec2 * p, const glm::vec2 * uv);
         };
 
+        void OpenGLImageMesh::Private::setVertices(const glm::vec2 * p, const glm::vec2 * uv)
+        {
+            std::vector<uint8_t> vertices(6 * vertexSize);
+            uint8_t* verticesP = vertices.data();
+            for (size_t i = 0; i < 6; ++i)
+            {
+                float* pf = reinterpret_cast<float*>(verticesP);
+                pf[0] = p[i].x;
+                pf[1] = p[i].y;
+                verticesP += 8;
+
+                pf = reinterpret_cast<float*>(verticesP);
+                pf[0] = uv[i].x;
+                pf[1] = uv[i].y;
+                verticesP += 8;
+            }
+
+            auto glFuncs = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_3_3_Core>();
+            glFuncs->glBindBuffer(GL_ARRAY_BUFFER, vbo);
+            glFuncs->glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizei>(6 * vertexSize), vertices.data());
+        }
+
         OpenGLImageMesh::OpenGLImageMesh() :
             _p(new Private)
         {
@@ -125,24 +154,44 @@ namespace djv
                 glm::vec2(u[0], v[0])
             };
 
-            std::vector<uint8_t> vertices(6 * _p->vertexSize);
-            uint8_t* verticesP = vertices.data();
-            for (size_t i = 0; i < 6; ++i)
+            _p->setVertices(p, uv);
+        }
+
+        void OpenGLImageMesh::setArea(const Core::Box2f & position, const Core::Box2f & textureCoords)
+        {
+            //DJV_DEBUG("OpenGLImageMesh::setArea");
+            //DJV_DEBUG_PRINT("position = " << position);
+            //DJV_DEBUG_PRINT("texture coords = " << textureCoords);
+
+            // Invalidate the size so that the next call to setSize() updates
+            // the vertices.
+            _p->size = glm::ivec2(-1, -1);
+
+            const glm::vec2 p0 = position.position;
+            const glm::vec2 p1 = position.position + position.size;
+            const glm::vec2 p[] =
             {
-                float* pf = reinterpret_cast<float*>(verticesP);
-                pf[0] = p[i].x;
-                pf[1] = p[i].y;
-                verticesP += 8;
+                glm::vec2(p0.x, p0.y),
+                glm::vec2(p1.x, p0.y),
+                glm::vec2(p1.x, p1.y),
 
-                pf = reinterpret_cast<float*>(verticesP);
-                pf[0] = uv[i].x;
-                pf[1] = uv[i].y;
-                verticesP += 8;
-            }
+                glm::vec2(p1.x, p1.y),
+                glm::vec2(p0.x, p1.y),
+                glm::vec2(p0.x, p0.y)
+            };
+            const glm::vec2 uv0 = textureCoords.position;
+            const glm::vec2 uv1 = textureCoords.position + textureCoords.size;
+            const glm::vec2 uv[] =
+            {
+                glm::vec2(uv0.x, uv0.y),
+                glm::vec2(uv1.x, uv0.y),
+                glm::vec2(uv1.x, uv1.y),
 
-            auto glFuncs = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_3_3_Core>();
-            glFuncs->glBindBuffer(GL_ARRAY_BUFFER, _p->vbo);
-            glFuncs->glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizei>(6 * _p->vertexSize), vertices.data());
+                glm::vec2(uv1.x, uv1.y),
+                glm::vec2(uv0.x, uv1.y),
+                glm::vec2(uv0.x, uv0.y)
+            };
+            _p->setVertices(p, uv);
         }
 
         void OpenGLImageMesh::draw()
@@ -412,6 +461,16 @@ namespace djv
 
         } // namespace
 
+        float OpenGLImageFilter::kernel(FILTER filter, float t)
+        {
+            return (*filterFnc(filter))(t);
+        }
+
+        float OpenGLImageFilter::kernelSupport(FILTER filter)
+        {
+            return filterSupport(filter);
+        }
+
         namespace
         {
             const QString sourceVertex =
@@ -504,7 +563,7 @@ namespace djv
                 "    value[0] = texture(lut, vec2(value[0], 0.0))[0];\n"
                 "    value[1] = texture(lut, vec2(value[1], 0.0))[1];\n"
                 "    value[2] = texture(lut, vec2(value[2], 0.0))[2];\n"
-                "    value[3] = texture(lut, vec2(value[2], 0.0))[3];\n"
+                "    value[3] = texture(lut, vec2(value[3], 0.0))[3];\n"
                 "    return value;\n"
                 "}\n"
                 "\n"
@@ -912,9 +971,14 @@ namespace djv
             //DJV_DEBUG("OpenGLImage::draw");
             //DJV_DEBUG_PRINT("data = " << data);
             //DJV_DEBUG_PRINT("color profile = " << options.colorProfile);
+            DJV_TRACE("OpenGLImage::draw", "OpenGL");
 
             auto glFuncs = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_3_3_Core>();
 
+            Core::Timer drawTimer;
+            drawTimer.start();
+            Core::Timer uploadTimer;
+
             const PixelDataInfo & info = data.info();
             const int proxyScale =
                 options.proxyScale ?
@@ -1033,7 +1097,9 @@ namespace djv
                 // Draw.
                 glFuncs->glActiveTexture(GL_TEXTURE0);
                 _p->shader->setUniform("inTexture", 0);
+                uploadTimer.start();
                 _p->texture->copy(data);
+                uploadTimer.check();
                 _p->shader->setUniform("transform.mvp", viewMatrix * OpenGLImageXform::xformMatrix(options.xform));
                 _p->mesh->setSize(info.size, mirror, proxyScale);
                 _p->mesh->draw();
@@ -1061,7 +1127,9 @@ namespace djv
                     colorProfileInit(options, *(_p->scaleXShader), *(_p->lutColorProfile));
                     glFuncs->glActiveTexture(GL_TEXTURE0);
                     _p->scaleXShader->setUniform("inTexture", 0);
+                    uploadTimer.start();
                     _p->texture->copy(data);
+                    uploadTimer.check();
                     _p->texture->bind();
                     glFuncs->glActiveTexture(GL_TEXTURE1);
                     _p->scaleXShader->setUniform("inScaleContrib", 1);
@@ -1098,6 +1166,232 @@ namespace djv
             break;
             default: break;
             }
+            drawTimer.check();
+            _p->uploadTime = uploadTimer.seconds();
+            _p->uploadByteCount = data.dataByteCount();
+            _p->drawTime = drawTimer.seconds() - _p->uploadTime;
+        }
+
+        namespace
+        {
+            //! The maximum number of tile textures that are cached.
+            const size_t tileCacheMax = 128;
+
+        } // namespace
+
+        void OpenGLImage::draw(
+            const TilePyramid &        pyramid,
+            const glm::mat4x4&         viewMatrix,
+            const OpenGLImageOptions & options,
+            Pixel::FORMAT              outputFormat)
+        {
+            //DJV_DEBUG("OpenGLImage::draw");
+            //DJV_DEBUG_PRINT("pyramid = " << pyramid.info());
+            DJV_TRACE("OpenGLImage::draw", "OpenGL");
+
+            auto glFuncs = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_3_3_Core>();
+
+            Core::Timer drawTimer;
+            drawTimer.start();
+            Core::Timer uploadTimer;
+            float uploadTime = 0.f;
+            quint64 uploadByteCount = 0;
+
+            const int levelsReady = pyramid.levelsReady();
+            if (!levelsReady)
+            {
+                _p->uploadTime = 0.f;
+                _p->uploadByteCount = 0;
+                _p->drawTime = 0.f;
+                return;
+            }
+            if (pyramid.id() != _p->tilePyramidId)
+            {
+                _p->tiles.clear();
+                _p->tilePyramidId = pyramid.id();
+            }
+
+            // Choose the level. The coarser levels may still be building in
+            // the background, in which case the finest available is used.
+            const PixelDataInfo & info = pyramid.info();
+            const int proxyScale =
+                options.proxyScale ?
+                PixelDataUtil::proxyScale(info.proxy) :
+                1;
+            const float scale = Core::Math::max(
+                Core::Math::abs(options.xform.scale.x),
+                Core::Math::abs(options.xform.scale.y)) * proxyScale;
+            const int level = Core::Math::min(pyramid.level(scale), levelsReady - 1);
+            const glm::ivec2 levelSize = pyramid.levelSize(level);
+            const glm::vec2 levelScale(
+                info.size.x * proxyScale / static_cast<float>(levelSize.x),
+                info.size.y * proxyScale / static_cast<float>(levelSize.y));
+            //DJV_DEBUG_PRINT("level = " << level);
+            //DJV_DEBUG_PRINT("level size = " << levelSize);
+
+            // Choose the filter the same way as draw().
+            const glm::vec2 tileScale = options.xform.scale * levelScale;
+            OpenGLImageFilter::FILTER filter =
+                Core::Math::fuzzyCompare(tileScale.x, 1.f) && Core::Math::fuzzyCompare(tileScale.y, 1.f) ?
+                OpenGLImageFilter::NEAREST :
+                (tileScale.x * tileScale.y < 1.f ? options.filter.min : options.filter.mag);
+            if (filter != OpenGLImageFilter::NEAREST)
+            {
+                filter = OpenGLImageFilter::LINEAR;
+            }
+            const GLenum glFilter = OpenGLImageFilter::toGl(filter);
+
+            // Initialize.
+            if (!_p->tileShader)
+            {
+                _p->tileShader.reset(new OpenGLShader);
+                _p->tileMesh.reset(new OpenGLImageMesh);
+            }
+            if (!_p->tileInit ||
+                _p->tilePixel != info.pixel ||
+                _p->tileOutputFormat != outputFormat ||
+                _p->tileOptions.colorProfile != options.colorProfile ||
+                _p->tileOptions.displayProfile != options.displayProfile ||
+                _p->tileOptions.channel != options.channel)
+            {
+                _p->tileInit = true;
+                _p->tilePixel = info.pixel;
+                _p->tileOutputFormat = outputFormat;
+                _p->tileOptions = options;
+                _p->tileShader->init(
+                    sourceVertex,
+                    sourceFragment(
+                        Pixel::format(info.pixel),
+                        outputFormat,
+                        options.colorProfile,
+                        options.displayProfile,
+                        options.channel,
+                        false,
+                        0,
+                        false));
+            }
+            _p->tileShader->bind();
+            colorProfileInit(options, *(_p->tileShader), *(_p->lutColorProfile));
+            displayProfileInit(options, *(_p->tileShader), *(_p->lutDisplayProfile));
+            glFuncs->glActiveTexture(GL_TEXTURE0);
+            _p->tileShader->setUniform("inTexture", 0);
+
+            // Find the tiles that intersect the view by transforming the
+            // corners of the view into the level.
+            const PixelDataInfo::Mirror mirror(
+                info.mirror.x != options.xform.mirror.x,
+                info.mirror.y != options.xform.mirror.y);
+            const glm::mat4x4 m =
+                viewMatrix *
+                OpenGLImageXform::xformMatrix(options.xform) *
+                glm::scale(glm::mat4x4(1.f), glm::vec3(levelScale.x, levelScale.y, 1.f));
+            const glm::mat4x4 inverse = glm::inverse(m);
+            glm::vec2 viewMin( std::numeric_limits<float>::max());
+            glm::vec2 viewMax(-std::numeric_limits<float>::max());
+            const glm::vec2 corners[] =
+            {
+                glm::vec2(-1.f, -1.f),
+                glm::vec2( 1.f, -1.f),
+                glm::vec2( 1.f,  1.f),
+                glm::vec2(-1.f,  1.f)
+            };
+            for (const auto & corner : corners)
+            {
+                const glm::vec4 p = inverse * glm::vec4(corner.x, corner.y, 0.f, 1.f);
+                const glm::vec2 q(
+                    mirror.x ? (levelSize.x - p.x) : p.x,
+                    mirror.y ? (levelSize.y - p.y) : p.y);
+                viewMin = glm::min(viewMin, q);
+                viewMax = glm::max(viewMax, q);
+            }
+            const glm::ivec2 tileCount = pyramid.tileCount(level);
+            const glm::ivec2 tile0(
+                Core::Math::clamp(Core::Math::floor(viewMin.x / TilePyramid::tileSize), 0, tileCount.x - 1),
+                Core::Math::clamp(Core::Math::floor(viewMin.y / TilePyramid::tileSize), 0, tileCount.y - 1));
+            const glm::ivec2 tile1(
+                Core::Math::clamp(Core::Math::floor(viewMax.x / TilePyramid::tileSize), 0, tileCount.x - 1),
+                Core::Math::clamp(Core::Math::floor(viewMax.y / TilePyramid::tileSize), 0, tileCount.y - 1));
+            //DJV_DEBUG_PRINT("tiles = " << tile0 << " " << tile1);
+
+            // Draw the tiles, uploading the ones that are not cached.
+            ++_p->tileFrame;
+            _p->tileShader->setUniform("transform.mvp", m);
+            for (int y = tile0.y; y <= tile1.y; ++y)
+            {
+                for (int x = tile0.x; x <= tile1.x; ++x)
+                {
+                    OpenGLImageTileKey key;
+                    key.level = level;
+                    key.tile = glm::ivec2(x, y);
+                    OpenGLImageTile & tile = _p->tiles[key];
+                    if (!tile.texture)
+                    {
+                        pyramid.tile(level, key.tile, _p->tileData);
+                        tile.texture.reset(new OpenGLTexture);
+                        tile.texture->init(_p->tileData.info(), GL_TEXTURE_2D, GL_NEAREST, GL_NEAREST);
+                        uploadTimer.start();
+                        // Tiles are only uploaded once, so they are copied
+                        // directly instead of through the pixel buffers.
+                        tile.texture->copy(_p->tileData, Core::Box2i(_p->tileData.size()));
+                        uploadTimer.check();
+                        uploadTime += uploadTimer.seconds();
+                        uploadByteCount += _p->tileData.dataByteCount();
+                    }
+                    tile.frame = _p->tileFrame;
+                    tile.texture->bind();
+                    glFuncs->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, glFilter);
+                    glFuncs->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, glFilter);
+
+                    // Skip the border with the texture coordinates.
+                    const Core::Box2i area = pyramid.tileArea(level, key.tile);
+                    const glm::vec2 textureSize(area.size + TilePyramid::tileBorder * 2);
+                    Core::Box2f position(
+                        static_cast<float>(mirror.x ? (levelSize.x - area.x - area.w) : area.x),
+                        static_cast<float>(mirror.y ? (levelSize.y - area.y - area.h) : area.y),
+                        static_cast<float>(area.w),
+                        static_cast<float>(area.h));
+                    Core::Box2f textureCoords(
+                        TilePyramid::tileBorder / textureSize.x,
+                        TilePyramid::tileBorder / textureSize.y,
+                        area.w / textureSize.x,
+                        area.h / textureSize.y);
+                    if (mirror.x)
+                    {
+                        textureCoords.x += textureCoords.w;
+                        textureCoords.w = -textureCoords.w;
+                    }
+                    if (mirror.y)
+                    {
+                        textureCoords.y += textureCoords.h;
+                        textureCoords.h = -textureCoords.h;
+                    }
+                    _p->tileMesh->setArea(position, textureCoords);
+                    _p->tileMesh->draw();
+                }
+            }
+
+            // Remove the least recently used tiles from the cache.
+            while (_p->tiles.size() > tileCacheMax)
+            {
+                auto oldest = _p->tiles.end();
+                for (auto i = _p->tiles.begin(); i != _p->tiles.end(); ++i)
+                {
+                    if (i->second.frame != _p->tileFrame &&
+                        (oldest == _p->tiles.end() || i->second.frame < oldest->second.frame))
+                    {
+                        oldest = i;
+                    }
+                }
+                if (oldest == _p->tiles.end())
+                    break;
+                _p->tiles.erase(oldest);
+            }
+            //DJV_DEBUG_PRINT("tiles cached = " << _p->tiles.size());
+
+            drawTimer.check();
+            _p->uploadTime = uploadTime;
+            _p->uploadByteCount = uploadByteCount;
+            _p->drawTime = drawTimer.seconds() - uploadTime;
         }
 
     } // namespace Graphics
@@ -29,12 +29,37 @@
 
 #pragma once
 
+#include <djvGraphics/ColorPipeline.h>
 #include <djvGraphics/OpenGLImage.h>
 
+#include <map>
+
 namespace djv
 {
     namespace Graphics
     {
+        //! This struct provides a key for the tile texture cache.
+        struct OpenGLImageTileKey
+        {
+            int        level = 0;
+            glm::ivec2 tile  = glm::ivec2(0, 0);
+
+            inline bool operator < (const OpenGLImageTileKey & other) const
+            {
+                return
+                    level < other.level ||
+                    (level == other.level && (tile.y < other.tile.y ||
+                    (tile.y == other.tile.y && tile.x < other.tile.x)));
+            }
+        };
+
+        //! This struct provides a tile texture cache entry.
+        struct OpenGLImageTile
+        {
+            std::unique_ptr<OpenGLTexture> texture;
+            quint64                        frame = 0;
+        };
+
         struct OpenGLImage::Private
         {
             bool init = false;
@@ -50,6 +75,22 @@ namespace djv
             std::unique_ptr<OpenGLLUT> lutDisplayProfile;
             std::unique_ptr<OpenGLImageMesh> mesh;
             std::unique_ptr<OpenGLOffscreenBuffer> buffer;
+            ColorPipeline colorPipeline;
+
+            //! The tile pyramid drawing state.
+            bool tileInit = false;
+            Pixel::PIXEL tilePixel = static_cast<Pixel::PIXEL>(0);
+            Pixel::FORMAT tileOutputFormat = static_cast<Pixel::FORMAT>(0);
+            OpenGLImageOptions tileOptions;
+            std::unique_ptr<OpenGLShader> tileShader;
+            std::unique_ptr<OpenGLImageMesh> tileMesh;
+            quint64 tilePyramidId = 0;
+            quint64 tileFrame = 0;
+            std::map<OpenGLImageTileKey, OpenGLImageTile> tiles;
+            PixelData tileData;
+            float uploadTime = 0.f;
+            quint64 uploadByteCount = 0;
+            float drawTime = 0.f;
         };
 
     } // namespace Graphics
@@ -36,18 +36,88 @@
 
 #include <QCoreApplication>
 
+#include <algorithm>
+#include <vector>
+
+#include <string.h>
+
+#if !defined(GL_MAP_PERSISTENT_BIT)
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif // GL_MAP_PERSISTENT_BIT
+#if !defined(GL_MAP_COHERENT_BIT)
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif // GL_MAP_COHERENT_BIT
+
 namespace djv
 {
     namespace Graphics
     {
+        namespace
+        {
+            typedef void (QOPENGLF_APIENTRYP BufferStorage)(GLenum, GLsizeiptr, const void *, GLbitfield);
+
+            //! The time in nanoseconds to wait for a fence before checking
+            //! again.
+            const GLuint64 fenceTimeout = 1000000000;
+
+            //! This struct provides a pixel buffer.
+            struct Buffer
+            {
+                GLuint   pbo        = 0;
+                GLsync   fence      = 0;
+                quint8 * mapped     = nullptr;
+                bool     persistent = false;
+            };
+
+            //! Create a pixel buffer, persistently mapped if possible.
+            void initBuffer(Buffer & buffer, quint64 size)
+            {
+                auto context = QOpenGLContext::currentContext();
+                auto glFuncs = context->versionFunctions<QOpenGLFunctions_3_3_Core>();
+                BufferStorage bufferStorage =
+                    context->hasExtension("GL_ARB_buffer_storage") ?
+                    reinterpret_cast<BufferStorage>(context->getProcAddress("glBufferStorage")) :
+                    nullptr;
+                const GLbitfield persistentFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+                glFuncs->glGenBuffers(1, &buffer.pbo);
+                glFuncs->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.pbo);
+                if (bufferStorage)
+                {
+                    bufferStorage(GL_PIXEL_UNPACK_BUFFER, size, 0, persistentFlags);
+                    buffer.mapped = reinterpret_cast<quint8 *>(glFuncs->glMapBufferRange(
+                        GL_PIXEL_UNPACK_BUFFER, 0, size, persistentFlags));
+                    buffer.persistent = buffer.mapped != nullptr;
+                    if (!buffer.persistent)
+                    {
+                        // The storage of the buffer is immutable, so create
+                        // another one.
+                        glFuncs->glDeleteBuffers(1, &buffer.pbo);
+                        glFuncs->glGenBuffers(1, &buffer.pbo);
+                        glFuncs->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.pbo);
+                    }
+                }
+                if (!buffer.persistent)
+                {
+                    glFuncs->glBufferData(GL_PIXEL_UNPACK_BUFFER, size, 0, GL_STREAM_DRAW);
+                }
+                glFuncs->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            }
+
+        } // namespace
+
+        const int OpenGLTexture::bufferCount = 3;
+
         struct OpenGLTexture::Private
         {
-            PixelDataInfo info;
-            GLenum        target = GL_NONE;
-            GLenum        min = GL_NONE;
-            GLenum        mag = GL_NONE;
-            GLuint        id = 0;
-            GLuint        pbo = 0;
+            PixelDataInfo       info;
+            GLenum              target = GL_NONE;
+            GLenum              min = GL_NONE;
+            GLenum              mag = GL_NONE;
+            GLuint              id = 0;
+            quint64             bufferSize = 0;
+            std::vector<Buffer> buffers;
+            int                 bufferIndex = 0;
+            int                 mappedIndex = -1;
         };
 
         OpenGLTexture::OpenGLTexture() :
@@ -103,10 +173,10 @@ namespace djv
                 OpenGL::format(_p->info.pixel, _p->info.bgr),
                 OpenGL::type(_p->info.pixel),
                 0);
-            glFuncs->glGenBuffers(1, &_p->pbo);
-            glFuncs->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _p->pbo);
-            glFuncs->glBufferData(GL_PIXEL_UNPACK_BUFFER, PixelDataUtil::dataByteCount(info), 0, GL_STREAM_DRAW);
-            glFuncs->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+            // The pixel buffers are created as they are needed.
+            _p->bufferSize = PixelDataUtil::dataByteCount(info);
+            _p->buffers.resize(bufferCount);
         }
 
         void OpenGLTexture::init(
@@ -123,28 +193,12 @@ namespace djv
         {
             //DJV_DEBUG("OpenGLTexture::copy");
             //DJV_DEBUG_PRINT("in = " << in);
-            auto glFuncs = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_3_3_Core>();
-            const PixelDataInfo & info = in.info();
-            glFuncs->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _p->pbo);
-            glFuncs->glBufferSubData(GL_PIXEL_UNPACK_BUFFER, 0, PixelDataUtil::dataByteCount(info), in.data());
-            bind();
-            OpenGLImage::stateUnpack(in.info());
-            GLenum format = OpenGL::format(info.pixel, info.bgr);
-            GLenum type = OpenGL::type(info.pixel);
-            //DJV_DEBUG_PRINT("target = " << _target);
-            //DJV_DEBUG_PRINT("format = " << format);
-            //DJV_DEBUG_PRINT("type = " << type);
-            glFuncs->glTexSubImage2D(
-                _p->target,
-                0,
-                0,
-                0,
-                info.size.x,
-                info.size.y,
-                format,
-                type,
-                0);
-            glFuncs->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            // The copy into the pixel buffer happens here on the calling thread,
+            // immediately before the transfer, so only the buffer allocations
+            // are saved and the copy is not overlapped with the upload.
+            quint8 * p = mapBuffer();
+            memcpy(p, in.data(), std::min(PixelDataUtil::dataByteCount(in.info()), _p->bufferSize));
+            copyBuffer();
         }
 
         void OpenGLTexture::copy(const PixelData & in, const Core::Box2i & area)
@@ -154,8 +208,6 @@ namespace djv
             //DJV_DEBUG_PRINT("area = " << area);
             auto glFuncs = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_3_3_Core>();
             const PixelDataInfo & info = in.info();
-            glFuncs->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _p->pbo);
-            glFuncs->glBufferSubData(GL_PIXEL_UNPACK_BUFFER, 0, PixelDataUtil::dataByteCount(info), in.data());
             bind();
             glm::ivec2 position = area.position;
             if (info.mirror.x)
@@ -166,7 +218,11 @@ namespace djv
             {
                 position.y = info.size.y - area.position.y - area.size.y;
             }
+
+            // The area is copied directly from the pixel data since it is only
+            // part of the pixel buffer.
             OpenGLImage::stateUnpack(in.info(), position);
+            glFuncs->glPixelStorei(GL_UNPACK_ROW_LENGTH, info.size.x);
             glFuncs->glTexSubImage2D(
                 _p->target,
                 0,
@@ -176,8 +232,8 @@ namespace djv
                 area.size.y,
                 OpenGL::format(info.pixel, info.bgr),
                 OpenGL::type(info.pixel),
-                0);
-            glFuncs->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                in.data());
+            glFuncs->glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
         }
 
         void OpenGLTexture::copy(const glm::ivec2 & in)
@@ -197,6 +253,98 @@ namespace djv
                 in.y);
         }
 
+        quint8 * OpenGLTexture::mapBuffer()
+        {
+            if (_p->buffers.empty())
+            {
+                throw Core::Error(
+                    "djv::Graphics::OpenGLTexture",
+                    qApp->translate("djv::Graphics::OpenGLTexture", "Cannot map pixel buffer"));
+            }
+            auto glFuncs = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_3_3_Core>();
+            Buffer & buffer = _p->buffers[_p->bufferIndex];
+            if (!buffer.pbo)
+            {
+                initBuffer(buffer, _p->bufferSize);
+            }
+
+            // Wait for the GPU to finish reading from the buffer.
+            if (buffer.fence)
+            {
+                GLenum result = GL_TIMEOUT_EXPIRED;
+                while (GL_TIMEOUT_EXPIRED == result)
+                {
+                    result = glFuncs->glClientWaitSync(buffer.fence, GL_SYNC_FLUSH_COMMANDS_BIT, fenceTimeout);
+                }
+                glFuncs->glDeleteSync(buffer.fence);
+                buffer.fence = 0;
+            }
+
+            if (!buffer.persistent)
+            {
+                glFuncs->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.pbo);
+                buffer.mapped = reinterpret_cast<quint8 *>(glFuncs->glMapBufferRange(
+                    GL_PIXEL_UNPACK_BUFFER,
+                    0,
+                    _p->bufferSize,
+                    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+                glFuncs->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            }
+            if (!buffer.mapped)
+            {
+                throw Core::Error(
+                    "djv::Graphics::OpenGLTexture",
+                    qApp->translate("djv::Graphics::OpenGLTexture", "Cannot map pixel buffer"));
+            }
+            _p->mappedIndex = _p->bufferIndex;
+            return buffer.mapped;
+        }
+
+        void OpenGLTexture::copyBuffer()
+        {
+            if (_p->mappedIndex < 0)
+                return;
+            auto glFuncs = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_3_3_Core>();
+            Buffer & buffer = _p->buffers[_p->mappedIndex];
+            glFuncs->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.pbo);
+            if (!buffer.persistent)
+            {
+                glFuncs->glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+                buffer.mapped = nullptr;
+            }
+            bind();
+            OpenGLImage::stateUnpack(_p->info);
+            GLenum format = OpenGL::format(_p->info.pixel, _p->info.bgr);
+            GLenum type = OpenGL::type(_p->info.pixel);
+            //DJV_DEBUG_PRINT("target = " << _target);
+            //DJV_DEBUG_PRINT("format = " << format);
+            //DJV_DEBUG_PRINT("type = " << type);
+            glFuncs->glTexSubImage2D(
+                _p->target,
+                0,
+                0,
+                0,
+                _p->info.size.x,
+                _p->info.size.y,
+                format,
+                type,
+                0);
+            buffer.fence = glFuncs->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            glFuncs->glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            _p->bufferIndex = (_p->mappedIndex + 1) % bufferCount;
+            _p->mappedIndex = -1;
+        }
+
+        int OpenGLTexture::bufferIndex() const
+        {
+            return _p->bufferIndex;
+        }
+
+        bool OpenGLTexture::isPersistent() const
+        {
+            return !_p->buffers.empty() && _p->buffers[_p->bufferIndex].persistent;
+        }
+
         void OpenGLTexture::bind()
         {
             //DJV_DEBUG("OpenGLTexture::bind");
@@ -237,11 +385,20 @@ namespace djv
                 glFuncs->glDeleteTextures(1, &_p->id);
                 _p->id = 0;
             }
-            if (_p->pbo)
+            for (auto & buffer : _p->buffers)
             {
-                glFuncs->glDeleteBuffers(1, &_p->pbo);
-                _p->pbo = 0;
+                if (buffer.fence)
+                {
+                    glFuncs->glDeleteSync(buffer.fence);
+                }
+                if (buffer.pbo)
+                {
+                    glFuncs->glDeleteBuffers(1, &buffer.pbo);
+                }
             }
+            _p->buffers.clear();
+            _p->bufferIndex = 0;
+            _p->mappedIndex = -1;
         }
 
     } // namespace Graphics
@@ -39,12 +39,26 @@ namespace djv
     namespace Graphics
     {
         //! This class proivides an OpenGL texture.
+        //!
+        //! Pixel data is uploaded through a ring of pixel buffers. Each buffer
+        //! is guarded by a fence and is only reused once the GPU has finished
+        //! reading from it. The buffers are persistently mapped when the OpenGL
+        //! implementation supports it (GL_ARB_buffer_storage).
+        //!
+        //! Note that this only reuses the pixel buffers, it does not stream the
+        //! pixel data: copy() fills the buffer on the calling thread right
+        //! before the transfer, so the copy is still serialized with the
+        //! upload. Filling the buffers ahead of time from the threads that load
+        //! the images is not implemented.
         class OpenGLTexture
         {
         public:
             OpenGLTexture();
             ~OpenGLTexture();
 
+            //! The number of pixel buffers in the ring.
+            static const int bufferCount;
+
             //! Initialize the texture.
             //!
             //! Throws:
@@ -83,7 +97,8 @@ namespace djv
             //! Bind the texture.
             void bind();
 
-            //! Copy pixel data to the texture.
+            //! Copy pixel data to the texture. The pixel data is copied into the
+            //! next pixel buffer on the calling thread and then transferred.
             void copy(const PixelData &);
 
             //! Copy pixel data to the texture.
@@ -92,6 +107,23 @@ namespace djv
             //! Copy the current read buffer to the texture.
             void copy(const glm::ivec2 &);
 
+            //! Get a pointer to the next pixel buffer, waiting for the GPU to
+            //! finish reading from it if necessary. The buffer is the size of the
+            //! texture pixel data and is copied to the texture by copyBuffer().
+            //!
+            //! Throws:
+            //! - Core::Error
+            quint8 * mapBuffer();
+
+            //! Copy the pixel buffer returned by mapBuffer() to the texture.
+            void copyBuffer();
+
+            //! Get the index of the next pixel buffer in the ring.
+            int bufferIndex() const;
+
+            //! Get whether the pixel buffers are persistently mapped.
+            bool isPersistent() const;
+
         private:
             void del();
 
@@ -34,6 +34,7 @@
 
 #include <djvCore/CoreContext.h>
 #include <djvCore/FileIO.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -52,6 +53,7 @@ namespace djv
             //DJV_DEBUG_PRINT("in = " << in);
             _file = in;
             Core::FileIO io;
+            io.setMmap(false);
             _open(_file.fileName(_file.sequence().start()), info, io);
             if (Core::FileInfo::SEQUENCE == _file.type())
             {
@@ -63,6 +65,7 @@ namespace djv
         {
             //DJV_DEBUG("PICLoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE("PICLoad::read", "ImageIO");
 
             image.colorProfile = ColorProfile();
             image.tags = ImageTags();
@@ -203,6 +206,13 @@ namespace djv
             //DJV_DEBUG_PRINT("image = " << image);
         }
 
+        ImageLoad * PICLoad::clone() const
+        {
+            auto out = new PICLoad(context());
+            out->_file = _file;
+            return out;
+        }
+
         namespace
         {
             struct Header
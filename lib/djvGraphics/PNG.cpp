@@ -29,8 +29,12 @@
 
 #include <djvGraphics/PNG.h>
 
+#include <djvCore/Assert.h>
 #include <djvCore/CoreContext.h>
 #include <djvCore/DebugLog.h>
+#include <djvCore/Error.h>
+
+#include <QCoreApplication>
 
 using namespace djv;
 
@@ -40,7 +44,47 @@ namespace djv
     {
         const QString PNG::staticName = "PNG";
 
+        const QStringList & PNG::filterLabels()
+        {
+            static const QStringList data = QStringList() <<
+                qApp->translate("djv::Graphics::PNG", "None") <<
+                qApp->translate("djv::Graphics::PNG", "Sub") <<
+                qApp->translate("djv::Graphics::PNG", "Up") <<
+                qApp->translate("djv::Graphics::PNG", "Average") <<
+                qApp->translate("djv::Graphics::PNG", "Paeth") <<
+                qApp->translate("djv::Graphics::PNG", "Adaptive");
+            DJV_ASSERT(data.count() == FILTER_COUNT);
+            return data;
+        }
+
+        const QStringList & PNG::strategyLabels()
+        {
+            static const QStringList data = QStringList() <<
+                qApp->translate("djv::Graphics::PNG", "Default") <<
+                qApp->translate("djv::Graphics::PNG", "Filtered") <<
+                qApp->translate("djv::Graphics::PNG", "Huffman") <<
+                qApp->translate("djv::Graphics::PNG", "RLE") <<
+                qApp->translate("djv::Graphics::PNG", "Fixed");
+            DJV_ASSERT(data.count() == STRATEGY_COUNT);
+            return data;
+        }
+
+        const QStringList & PNG::optionsLabels()
+        {
+            static const QStringList data = QStringList() <<
+                qApp->translate("djv::Graphics::PNG", "Compression Level") <<
+                qApp->translate("djv::Graphics::PNG", "Filter") <<
+                qApp->translate("djv::Graphics::PNG", "Strategy") <<
+                qApp->translate("djv::Graphics::PNG", "Threads");
+            DJV_ASSERT(data.count() == OPTIONS_COUNT);
+            return data;
+        }
+
     } // namespace Graphics
+
+    _DJV_STRING_OPERATOR_LABEL(Graphics::PNG::FILTER, Graphics::PNG::filterLabels())
+    _DJV_STRING_OPERATOR_LABEL(Graphics::PNG::STRATEGY, Graphics::PNG::strategyLabels())
+
 } // namespace djv
 
 extern "C"
@@ -48,7 +48,64 @@ namespace djv
         //! This struct provides PNG utilities.
         struct PNG
         {
+            //! The plugin name.
             static const QString staticName;
+
+            //! This enumeration provides the scanline filters.
+            enum FILTER
+            {
+                FILTER_NONE,
+                FILTER_SUB,
+                FILTER_UP,
+                FILTER_AVERAGE,
+                FILTER_PAETH,
+                FILTER_ADAPTIVE,
+
+                FILTER_COUNT
+            };
+
+            //! Get the filter labels.
+            static const QStringList & filterLabels();
+
+            //! This enumeration provides the zlib compression strategies.
+            enum STRATEGY
+            {
+                STRATEGY_DEFAULT,
+                STRATEGY_FILTERED,
+                STRATEGY_HUFFMAN,
+                STRATEGY_RLE,
+                STRATEGY_FIXED,
+
+                STRATEGY_COUNT
+            };
+
+            //! Get the strategy labels.
+            static const QStringList & strategyLabels();
+
+            //! This enumeration provides the options.
+            enum OPTIONS
+            {
+                COMPRESSION_LEVEL_OPTION,
+                FILTER_OPTION,
+                STRATEGY_OPTION,
+                THREADS_OPTION,
+
+                OPTIONS_COUNT
+            };
+
+            //! Get option labels.
+            static const QStringList & optionsLabels();
+
+            //! This struct provides options. The defaults match libpng. A thread
+            //! count of zero uses all of the available cores, and a thread count
+            //! of one always uses the serial libpng encoder.
+            struct Options
+            {
+                int      compressionLevel = 6;
+                FILTER   filter           = FILTER_ADAPTIVE;
+                STRATEGY strategy         = STRATEGY_FILTERED;
+                int      threads          = 0;
+            };
         };
 
         //! This struct provides libpng error handling.
@@ -59,6 +116,10 @@ namespace djv
         };
 
     } // namespace Graphics
+
+    DJV_STRING_OPERATOR(Graphics::PNG::FILTER);
+    DJV_STRING_OPERATOR(Graphics::PNG::STRATEGY);
+
 } // namespace djv
 
 extern "C"
@@ -35,6 +35,7 @@
 #include <djvCore/CoreContext.h>
 #include <djvCore/Error.h>
 #include <djvCore/StringUtil.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -91,6 +92,7 @@ namespace djv
         {
             //DJV_DEBUG("PNGLoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE("PNGLoad::read", "ImageIO");
 
             image.colorProfile = ColorProfile();
             image.tags = ImageTags();
@@ -131,6 +133,13 @@ namespace djv
             close();
         }
 
+        ImageLoad * PNGLoad::clone() const
+        {
+            auto out = new PNGLoad(context());
+            out->_file = _file;
+            return out;
+        }
+
         void PNGLoad::close()
         {
             if (_png || _pngInfo || _pngInfoEnd)
@@ -32,7 +32,11 @@
 #include <djvGraphics/PNGLoad.h>
 #include <djvGraphics/PNGSave.h>
 
+#include <djvCore/Assert.h>
 #include <djvCore/CoreContext.h>
+#include <djvCore/Error.h>
+
+#include <QCoreApplication>
 
 namespace djv
 {
@@ -52,6 +56,158 @@ namespace djv
             return QStringList() << ".png";
         }
 
+        QStringList PNGPlugin::option(const QString & in) const
+        {
+            QStringList out;
+            if (0 == in.compare(options()[PNG::COMPRESSION_LEVEL_OPTION], Qt::CaseInsensitive))
+            {
+                out << _options.compressionLevel;
+            }
+            else if (0 == in.compare(options()[PNG::FILTER_OPTION], Qt::CaseInsensitive))
+            {
+                out << _options.filter;
+            }
+            else if (0 == in.compare(options()[PNG::STRATEGY_OPTION], Qt::CaseInsensitive))
+            {
+                out << _options.strategy;
+            }
+            else if (0 == in.compare(options()[PNG::THREADS_OPTION], Qt::CaseInsensitive))
+            {
+                out << _options.threads;
+            }
+            return out;
+        }
+
+        bool PNGPlugin::setOption(const QString & in, QStringList & data)
+        {
+            try
+            {
+                if (0 == in.compare(options()[PNG::COMPRESSION_LEVEL_OPTION], Qt::CaseInsensitive))
+                {
+                    int compressionLevel = 0;
+                    data >> compressionLevel;
+                    if (compressionLevel != _options.compressionLevel)
+                    {
+                        _options.compressionLevel = compressionLevel;
+                        Q_EMIT optionChanged(in);
+                    }
+                }
+                else if (0 == in.compare(options()[PNG::FILTER_OPTION], Qt::CaseInsensitive))
+                {
+                    PNG::FILTER filter = static_cast<PNG::FILTER>(0);
+                    data >> filter;
+                    if (filter != _options.filter)
+                    {
+                        _options.filter = filter;
+                        Q_EMIT optionChanged(in);
+                    }
+                }
+                else if (0 == in.compare(options()[PNG::STRATEGY_OPTION], Qt::CaseInsensitive))
+                {
+                    PNG::STRATEGY strategy = static_cast<PNG::STRATEGY>(0);
+                    data >> strategy;
+                    if (strategy != _options.strategy)
+                    {
+                        _options.strategy = strategy;
+                        Q_EMIT optionChanged(in);
+                    }
+                }
+                else if (0 == in.compare(options()[PNG::THREADS_OPTION], Qt::CaseInsensitive))
+                {
+                    int threads = 0;
+                    data >> threads;
+                    if (threads != _options.threads)
+                    {
+                        _options.threads = threads;
+                        Q_EMIT optionChanged(in);
+                    }
+                }
+            }
+            catch (const QString &)
+            {
+                return false;
+            }
+            return true;
+        }
+
+        QStringList PNGPlugin::options() const
+        {
+            return PNG::optionsLabels();
+        }
+
+        void PNGPlugin::commandLine(QStringList & in)
+        {
+            QStringList tmp;
+            QString     arg;
+            try
+            {
+                while (!in.isEmpty())
+                {
+                    in >> arg;
+                    if (qApp->translate("djv::Graphics::PNGPlugin", "-png_compression_level") == arg)
+                    {
+                        in >> _options.compressionLevel;
+                    }
+                    else if (qApp->translate("djv::Graphics::PNGPlugin", "-png_filter") == arg)
+                    {
+                        in >> _options.filter;
+                    }
+                    else if (qApp->translate("djv::Graphics::PNGPlugin", "-png_strategy") == arg)
+                    {
+                        in >> _options.strategy;
+                    }
+                    else if (qApp->translate("djv::Graphics::PNGPlugin", "-png_threads") == arg)
+                    {
+                        in >> _options.threads;
+                    }
+                    else
+                    {
+                        tmp << arg;
+                    }
+                }
+            }
+            catch (const QString &)
+            {
+                throw arg;
+            }
+            in = tmp;
+        }
+
+        QString PNGPlugin::commandLineHelp() const
+        {
+            QStringList compressionLevelLabel;
+            compressionLevelLabel << _options.compressionLevel;
+            QStringList filterLabel;
+            filterLabel << _options.filter;
+            QStringList strategyLabel;
+            strategyLabel << _options.strategy;
+            QStringList threadsLabel;
+            threadsLabel << _options.threads;
+            return qApp->translate("djv::Graphics::PNGPlugin",
+                "\n"
+                "PNG Options\n"
+                "\n"
+                "    -png_compression_level (value)\n"
+                "        Set the zlib compression level (0-9) used when saving PNG images. "
+                "Default = %1.\n"
+                "    -png_filter (value)\n"
+                "        Set the scanline filter used when saving PNG images: %2. "
+                "Default = %3.\n"
+                "    -png_strategy (value)\n"
+                "        Set the zlib compression strategy used when saving PNG images: %4. "
+                "Default = %5.\n"
+                "    -png_threads (value)\n"
+                "        Set the number of threads used to compress large PNG images. "
+                "A value of zero uses all of the available cores, and a value of one "
+                "disables parallel compression. Default = %6.\n").
+                arg(compressionLevelLabel.join(", ")).
+                arg(PNG::filterLabels().join(", ")).
+                arg(filterLabel.join(", ")).
+                arg(PNG::strategyLabels().join(", ")).
+                arg(strategyLabel.join(", ")).
+                arg(threadsLabel.join(", "));
+        }
+
         ImageLoad * PNGPlugin::createLoad() const
         {
             return new PNGLoad(context());
@@ -59,7 +215,7 @@ namespace djv
 
         ImageSave * PNGPlugin::createSave() const
         {
-            return new PNGSave(context());
+            return new PNGSave(_options, context());
         }
 
     } // namespace Graphics
@@ -48,6 +48,8 @@ namespace djv
         //! Supported features:
         //!
         //! - 8-bit, 16-bit, Luminance, RGB, RGBA
+        //! - Compression level, filter, and strategy
+        //! - Parallel compression of large images
         class PNGPlugin : public ImageIO
         {
         public:
@@ -56,8 +58,18 @@ namespace djv
             QString pluginName() const override;
             QStringList extensions() const override;
 
+            QStringList option(const QString &) const override;
+            bool setOption(const QString &, QStringList &) override;
+            QStringList options() const override;
+
+            void commandLine(QStringList &) override;
+            QString commandLineHelp() const override;
+
             ImageLoad * createLoad() const override;
             ImageSave * createSave() const override;
+
+        private:
+            PNG::Options _options;
         };
 
     } // namespace Graphics
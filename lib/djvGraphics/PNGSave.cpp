@@ -33,15 +33,26 @@
 
 #include <djvCore/CoreContext.h>
 #include <djvCore/Error.h>
+#include <djvCore/Math.h>
 #include <djvCore/Memory.h>
 #include <djvCore/StringUtil.h>
+#include <djvCore/Trace.h>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
 
 namespace djv
 {
     namespace Graphics
     {
-        PNGSave::PNGSave(const QPointer<Core::CoreContext> & context) :
-            ImageSave(context)
+        PNGSave::PNGSave(const PNG::Options & options, const QPointer<Core::CoreContext> & context) :
+            ImageSave(context),
+            _options(options)
         {
             _pngError.context = context;
         }
@@ -77,6 +88,264 @@ namespace djv
 
         namespace
         {
+            //! The number of uncompressed bytes in each block when compressing
+            //! in parallel.
+            const size_t blockByteCount = 256 * 1024;
+
+            //! The size of the deflate window.
+            const size_t windowByteCount = 32 * 1024;
+
+            int pngFilters(PNG::FILTER in)
+            {
+                static const int data[] =
+                {
+                    PNG_FILTER_NONE,
+                    PNG_FILTER_SUB,
+                    PNG_FILTER_UP,
+                    PNG_FILTER_AVG,
+                    PNG_FILTER_PAETH,
+                    PNG_ALL_FILTERS
+                };
+                return data[in];
+            }
+
+            int zlibStrategy(PNG::STRATEGY in)
+            {
+                static const int data[] =
+                {
+                    Z_DEFAULT_STRATEGY,
+                    Z_FILTERED,
+                    Z_HUFFMAN_ONLY,
+                    Z_RLE,
+                    Z_FIXED
+                };
+                return data[in];
+            }
+
+            inline int paeth(int a, int b, int c)
+            {
+                const int p = a + b - c;
+                const int pa = abs(p - a);
+                const int pb = abs(p - b);
+                const int pc = abs(p - c);
+                if (pa <= pb && pa <= pc)
+                    return a;
+                if (pb <= pc)
+                    return b;
+                return c;
+            }
+
+            //! Apply a PNG filter to a scanline. The output starts with the
+            //! filter type byte.
+            void filterScanline(
+                int            filter,
+                const quint8 * in,
+                const quint8 * prev,
+                int            size,
+                int            bpp,
+                quint8 *       out)
+            {
+                *out++ = static_cast<quint8>(filter);
+                const int left = std::min(bpp, size);
+                switch (filter)
+                {
+                case PNG_FILTER_VALUE_NONE:
+                    memcpy(out, in, size);
+                    break;
+                case PNG_FILTER_VALUE_SUB:
+                    memcpy(out, in, left);
+                    for (int i = left; i < size; ++i)
+                    {
+                        out[i] = static_cast<quint8>(in[i] - in[i - bpp]);
+                    }
+                    break;
+                case PNG_FILTER_VALUE_UP:
+                    for (int i = 0; i < size; ++i)
+                    {
+                        out[i] = static_cast<quint8>(in[i] - prev[i]);
+                    }
+                    break;
+                case PNG_FILTER_VALUE_AVG:
+                    for (int i = 0; i < left; ++i)
+                    {
+                        out[i] = static_cast<quint8>(in[i] - (prev[i] >> 1));
+                    }
+                    for (int i = left; i < size; ++i)
+                    {
+                        out[i] = static_cast<quint8>(in[i] - ((in[i - bpp] + prev[i]) >> 1));
+                    }
+                    break;
+                case PNG_FILTER_VALUE_PAETH:
+                    for (int i = 0; i < left; ++i)
+                    {
+                        out[i] = static_cast<quint8>(in[i] - prev[i]);
+                    }
+                    for (int i = left; i < size; ++i)
+                    {
+                        out[i] = static_cast<quint8>(in[i] - paeth(in[i - bpp], prev[i], prev[i - bpp]));
+                    }
+                    break;
+                }
+            }
+
+            //! Get the sum of the absolute values of a filtered scanline. This
+            //! is the same heuristic libpng uses to choose adaptive filters.
+            quint64 filterSum(const quint8 * in, int size)
+            {
+                quint64 out = 0;
+                for (int i = 0; i < size; ++i)
+                {
+                    out += in[i] < 128 ? in[i] : 256 - in[i];
+                }
+                return out;
+            }
+
+            //! Copy a scanline in PNG order, from the top of the image, and
+            //! convert it to big endian if necessary.
+            void pngScanlineCopy(const PixelData & data, int y, bool swap, quint8 * out)
+            {
+                const quint8 * p = data.data(0, data.h() - 1 - y);
+                const int size = static_cast<int>(data.scanlineByteCount());
+                if (swap)
+                {
+                    Core::Memory::convertEndian(p, out, size / 2, 2);
+                }
+                else
+                {
+                    memcpy(out, p, size);
+                }
+            }
+
+            //! Filter a block of scanlines into the PNG byte stream.
+            void filterBlock(
+                const PixelData & data,
+                int               y,
+                int               rows,
+                PNG::FILTER       filter,
+                bool              swap,
+                quint8 *          out)
+            {
+                const int size = static_cast<int>(data.scanlineByteCount());
+                const int bpp = static_cast<int>(data.pixelByteCount());
+                std::vector<quint8> prev(size, 0);
+                std::vector<quint8> cur(size);
+                std::vector<quint8> tmp(size + 1);
+                if (y > 0)
+                {
+                    pngScanlineCopy(data, y - 1, swap, prev.data());
+                }
+                for (int i = 0; i < rows; ++i, out += size + 1)
+                {
+                    pngScanlineCopy(data, y + i, swap, cur.data());
+                    if (PNG::FILTER_ADAPTIVE == filter)
+                    {
+                        quint64 min = 0;
+                        for (int j = PNG_FILTER_VALUE_NONE; j <= PNG_FILTER_VALUE_PAETH; ++j)
+                        {
+                            filterScanline(j, cur.data(), prev.data(), size, bpp, tmp.data());
+                            const quint64 sum = filterSum(tmp.data() + 1, size);
+                            if (PNG_FILTER_VALUE_NONE == j || sum < min)
+                            {
+                                memcpy(out, tmp.data(), size + 1);
+                                min = sum;
+                            }
+                        }
+                    }
+                    else
+                    {
+                        // The filter enumeration matches the PNG filter types.
+                        filterScanline(filter, cur.data(), prev.data(), size, bpp, out);
+                    }
+                    std::swap(prev, cur);
+                }
+            }
+
+            //! Compress a block of the filtered byte stream as raw deflate
+            //! data. The preceding bytes are used as the dictionary so that
+            //! matches can span blocks as they would in a single stream. Every
+            //! block except the last ends on a full flush boundary so that the
+            //! blocks can be concatenated.
+            bool deflateBlock(
+                const quint8 *        in,
+                size_t                size,
+                const quint8 *        dictionary,
+                size_t                dictionarySize,
+                int                   level,
+                int                   strategy,
+                bool                  last,
+                std::vector<quint8> & out)
+            {
+                z_stream z;
+                memset(&z, 0, sizeof(z_stream));
+                if (deflateInit2(&z, level, Z_DEFLATED, -15, 8, strategy) != Z_OK)
+                    return false;
+                bool r = true;
+                if (dictionarySize &&
+                    deflateSetDictionary(&z, dictionary, static_cast<uInt>(dictionarySize)) != Z_OK)
+                {
+                    r = false;
+                }
+                if (r)
+                {
+                    // Leave room for the flush markers which are not included
+                    // in the bound.
+                    out.resize(deflateBound(&z, static_cast<uLong>(size)) + 64);
+                    z.next_in = const_cast<Bytef *>(in);
+                    z.avail_in = static_cast<uInt>(size);
+                    z.next_out = out.data();
+                    z.avail_out = static_cast<uInt>(out.size());
+                    const int result = deflate(&z, last ? Z_FINISH : Z_FULL_FLUSH);
+                    r = last ?
+                        (Z_STREAM_END == result) :
+                        (Z_OK == result && 0 == z.avail_in && z.avail_out > 0);
+                    out.resize(z.total_out);
+                }
+                deflateEnd(&z);
+                return r;
+            }
+
+            //! Get the zlib stream header, the same as zlib would write for the
+            //! given settings.
+            void zlibHeader(int level, int strategy, quint8 * out)
+            {
+                int flags = 0;
+                if (strategy >= Z_HUFFMAN_ONLY || level < 2)
+                    flags = 0;
+                else if (level < 6)
+                    flags = 1;
+                else if (6 == level)
+                    flags = 2;
+                else
+                    flags = 3;
+                int header = (0x78 << 8) | (flags << 6);
+                header += 31 - (header % 31);
+                out[0] = static_cast<quint8>(header >> 8);
+                out[1] = static_cast<quint8>(header & 0xff);
+            }
+
+            template<typename T>
+            void runThreads(int threads, T work)
+            {
+                std::vector<std::thread> workers;
+                for (int i = 1; i < threads; ++i)
+                {
+                    workers.push_back(std::thread(work));
+                }
+                work();
+                for (auto & i : workers)
+                {
+                    i.join();
+                }
+            }
+
+            bool pngChunk(png_structp png, const char * name, const quint8 * in, size_t size)
+            {
+                if (setjmp(png_jmpbuf(png)))
+                    return false;
+                png_write_chunk(png, reinterpret_cast<png_const_bytep>(name), in, size);
+                return true;
+            }
+
             bool pngScanline(png_structp png, const quint8 * in)
             {
                 if (setjmp(png_jmpbuf(png)))
@@ -99,6 +368,7 @@ namespace djv
         {
             //DJV_DEBUG("PNGSave::write");
             //DJV_DEBUG_PRINT("in = " << in);
+            DJV_TRACE("PNGSave::write", "ImageIO");
 
             // Open the file.
             const QString fileName = _file.fileName(frame.frame);
@@ -118,16 +388,130 @@ namespace djv
 
             // Write the file.
             const int h = p->h();
-            for (int y = 0; y < h; ++y)
+            const size_t scanlineSize = p->scanlineByteCount() + 1;
+            const int rowsPerBlock = std::max(static_cast<int>(blockByteCount / scanlineSize), 1);
+            const int blocks = (h + rowsPerBlock - 1) / rowsPerBlock;
+            const int threads = Core::Math::clamp(
+                _options.threads > 0 ?
+                _options.threads :
+                static_cast<int>(std::thread::hardware_concurrency()),
+                1,
+                blocks);
+            //DJV_DEBUG_PRINT("threads = " << threads);
+            if (threads > 1)
             {
-                if (!pngScanline(_png, p->data(0, h - 1 - y)))
+                // Filter the scanlines in parallel.
+                std::vector<quint8> filtered(h * scanlineSize);
+                const PNG::FILTER filter = _options.filter;
+                const bool swap =
+                    Pixel::bitDepth(_info.pixel) >= 16 &&
+                    Core::Memory::LSB == Core::Memory::endian();
+                std::atomic<int> next(0);
+                runThreads(threads, [p, h, blocks, rowsPerBlock, scanlineSize, filter, swap, &filtered, &next]
+                {
+                    int i = next++;
+                    while (i < blocks)
+                    {
+                        const int y = i * rowsPerBlock;
+                        filterBlock(
+                            *p,
+                            y,
+                            std::min(rowsPerBlock, h - y),
+                            filter,
+                            swap,
+                            filtered.data() + y * scanlineSize);
+                        i = next++;
+                    }
+                });
+
+                // Deflate the blocks in parallel.
+                std::vector<std::vector<quint8> > compressed(blocks);
+                std::vector<uLong> adlers(blocks);
+                std::atomic<bool> error(false);
+                const int level = Core::Math::clamp(_options.compressionLevel, 0, 9);
+                const int strategy = zlibStrategy(_options.strategy);
+                next = 0;
+                runThreads(threads, [h, blocks, rowsPerBlock, scanlineSize, level, strategy,
+                    &filtered, &compressed, &adlers, &next, &error]
+                {
+                    int i = next++;
+                    while (i < blocks)
+                    {
+                        const int y = i * rowsPerBlock;
+                        const size_t offset = y * scanlineSize;
+                        const size_t size = std::min(rowsPerBlock, h - y) * scanlineSize;
+                        const size_t dictionarySize = std::min(offset, windowByteCount);
+                        const quint8 * data = filtered.data() + offset;
+                        if (!deflateBlock(
+                            data,
+                            size,
+                            data - dictionarySize,
+                            dictionarySize,
+                            level,
+                            strategy,
+                            blocks - 1 == i,
+                            compressed[i]))
+                        {
+                            error = true;
+                        }
+                        adlers[i] = adler32(adler32(0, Z_NULL, 0), data, static_cast<uInt>(size));
+                        i = next++;
+                    }
+                });
+                if (error)
+                {
+                    throw Core::Error(
+                        PNG::staticName,
+                        ImageIO::errorLabels()[ImageIO::ERROR_WRITE]);
+                }
+
+                // Add the zlib header and checksum, and write the blocks as
+                // IDAT chunks.
+                quint8 header[2];
+                zlibHeader(level, strategy, header);
+                compressed.front().insert(compressed.front().begin(), header, header + 2);
+                uLong adler = adler32(0, Z_NULL, 0);
+                for (int i = 0; i < blocks; ++i)
+                {
+                    const int y = i * rowsPerBlock;
+                    adler = adler32_combine(
+                        adler,
+                        adlers[i],
+                        static_cast<z_off_t>(std::min(rowsPerBlock, h - y) * scanlineSize));
+                }
+                const quint8 trailer[] =
+                {
+                    static_cast<quint8>(adler >> 24),
+                    static_cast<quint8>(adler >> 16),
+                    static_cast<quint8>(adler >> 8),
+                    static_cast<quint8>(adler)
+                };
+                compressed.back().insert(compressed.back().end(), trailer, trailer + 4);
+                for (int i = 0; i < blocks; ++i)
+                {
+                    if (!pngChunk(_png, "IDAT", compressed[i].data(), compressed[i].size()))
+                    {
+                        throw Core::Error(PNG::staticName, _pngError.msg);
+                    }
+                }
+                if (!pngChunk(_png, "IEND", nullptr, 0))
                 {
                     throw Core::Error(PNG::staticName, _pngError.msg);
                 }
             }
-            if (!pngEnd(_png, _pngInfo))
+            else
             {
-                throw Core::Error(PNG::staticName, _pngError.msg);
+                for (int y = 0; y < h; ++y)
+                {
+                    if (!pngScanline(_png, p->data(0, h - 1 - y)))
+                    {
+                        throw Core::Error(PNG::staticName, _pngError.msg);
+                    }
+                }
+                if (!pngEnd(_png, _pngInfo))
+                {
+                    throw Core::Error(PNG::staticName, _pngError.msg);
+                }
             }
 
             close();
@@ -153,10 +537,11 @@ namespace djv
         namespace
         {
             bool pngOpen(
-                FILE *              f,
-                png_structp         png,
-                png_infop *         pngInfo,
-                const ImageIOInfo & info)
+                FILE *               f,
+                png_structp          png,
+                png_infop *          pngInfo,
+                const ImageIOInfo &  info,
+                const PNG::Options & options)
             {
                 if (setjmp(png_jmpbuf(png)))
                 {
@@ -199,6 +584,9 @@ namespace djv
                     PNG_INTERLACE_NONE,
                     PNG_COMPRESSION_TYPE_DEFAULT,
                     PNG_FILTER_TYPE_DEFAULT);
+                png_set_compression_level(png, Core::Math::clamp(options.compressionLevel, 0, 9));
+                png_set_filter(png, PNG_FILTER_TYPE_BASE, pngFilters(options.filter));
+                png_set_compression_strategy(png, zlibStrategy(options.strategy));
                 png_write_info(png, *pngInfo);
                 return true;
             }
@@ -237,7 +625,7 @@ namespace djv
                     PNG::staticName,
                     ImageIO::errorLabels()[ImageIO::ERROR_OPEN]);
             }
-            if (!pngOpen(_f, _png, &_pngInfo, info))
+            if (!pngOpen(_f, _png, &_pngInfo, info, _options))
             {
                 throw Core::Error(PNG::staticName, _pngError.msg);
             }
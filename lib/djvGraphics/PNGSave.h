@@ -40,10 +40,14 @@ namespace djv
     namespace Graphics
     {
         //! This class provides a PNG saver.
+        //!
+        //! Large images are compressed in parallel: the scanlines are filtered
+        //! and deflated in independent blocks which are joined on full flush
+        //! boundaries into a single zlib stream.
         class PNGSave : public ImageSave
         {
         public:
-            explicit PNGSave(const QPointer<Core::CoreContext> &);
+            PNGSave(const PNG::Options &, const QPointer<Core::CoreContext> &);
             ~PNGSave() override;
 
             void open(const Core::FileInfo &, const ImageIOInfo &) override;
@@ -53,6 +57,7 @@ namespace djv
         private:
             void _open(const QString &, const ImageIOInfo &);
 
+            PNG::Options   _options;
             Core::FileInfo _file;
             FILE *         _f = nullptr;
             png_structp    _png = nullptr;
@@ -34,6 +34,7 @@
 
 #include <djvCore/CoreContext.h>
 #include <djvCore/FileIOUtil.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -53,6 +54,7 @@ namespace djv
             //DJV_DEBUG_PRINT("type = " << in.type());
             _file = in;
             Core::FileIO io;
+            io.setMmap(false);
             _open(in.fileName(in.sequence().start()), info, io);
             if (Core::FileInfo::SEQUENCE == _file.type())
             {
@@ -64,6 +66,7 @@ namespace djv
         {
             //DJV_DEBUG("PPMLoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE("PPMLoad::read", "ImageIO");
             image.colorProfile = ColorProfile();
             image.tags = ImageTags();
 
@@ -136,6 +139,13 @@ namespace djv
             //DJV_DEBUG_PRINT("image = " << image);
         }
 
+        ImageLoad * PPMLoad::clone() const
+        {
+            auto out = new PPMLoad(context());
+            out->_file = _file;
+            return out;
+        }
+
         void PPMLoad::_open(const QString & in, ImageIOInfo & info, Core::FileIO & io)
         {
             //DJV_DEBUG("PPMLoad::_open");
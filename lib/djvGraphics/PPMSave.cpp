@@ -32,6 +32,7 @@
 #include <djvGraphics/OpenGLImage.h>
 
 #include <djvCore/CoreContext.h>
+#include <djvCore/Trace.h>
 
 #include <stdio.h>
 
@@ -105,6 +106,7 @@ namespace djv
             //DJV_DEBUG_PRINT("in = " << in);
             //DJV_DEBUG_PRINT("type = " << _type);
             //DJV_DEBUG_PRINT("data = " << _data);
+            DJV_TRACE("PPMSave::write", "ImageIO");
 
             // Open the file.
             Core::FileIO io;
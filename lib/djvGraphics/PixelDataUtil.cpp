@@ -30,6 +30,11 @@
 #include <djvGraphics/PixelDataUtil.h>
 
 #include <djvCore/Assert.h>
+#include <djvCore/Trace.h>
+
+#include <algorithm>
+
+#include <string.h>
 
 namespace djv
 {
@@ -57,6 +62,7 @@ namespace djv
             //DJV_DEBUG_PRINT("in = " << in);
             //DJV_DEBUG_PRINT("out = " << out);
             //DJV_DEBUG_PRINT("proxy = " << proxy);
+            DJV_TRACE("PixelDataUtil::proxyScale", "Pixel");
 
             const int  w = out.w();
             const int  h = out.h();
@@ -159,13 +165,172 @@ namespace djv
                 Core::Math::ceil(in.size.y / static_cast<float>(scale)));
         }
 
+        PixelDataInfo::PROXY PixelDataUtil::proxyFit(const glm::ivec2 & in, const glm::ivec2 & size)
+        {
+            PixelDataInfo::PROXY out = PixelDataInfo::PROXY_NONE;
+            for (int i = 1; i < PixelDataInfo::PROXY_COUNT; ++i)
+            {
+                const PixelDataInfo::PROXY proxy = static_cast<PixelDataInfo::PROXY>(i);
+                const glm::ivec2 proxySize = proxyScale(in, proxy);
+                if (proxySize.x < size.x || proxySize.y < size.y)
+                {
+                    break;
+                }
+                out = proxy;
+            }
+            return out;
+        }
+
+        namespace
+        {
+            inline quint8 planarSwap(quint8 in)
+            {
+                return in;
+            }
+
+            inline quint16 planarSwap(quint16 in)
+            {
+                return static_cast<quint16>((in >> 8) | (in << 8));
+            }
+
+            inline quint32 planarSwap(quint32 in)
+            {
+                return
+                    (in >> 24) |
+                    ((in >> 8) & 0xff00) |
+                    ((in << 8) & 0xff0000) |
+                    (in << 24);
+            }
+
+            //! Interleave a scanline with a fixed channel count and byte width
+            //! so that the compiler can unroll and vectorize the loop.
+            template<typename T, int C, bool SWAP>
+            void interleaveScanline(
+                const quint8 * in,
+                quint64        channelStride,
+                quint8 *       out,
+                int            size,
+                int            proxyScale)
+            {
+                const quint8 * inP[C];
+                for (int c = 0; c < C; ++c)
+                {
+                    inP[c] = in + c * channelStride;
+                }
+                const quint64 inc = sizeof(T) * proxyScale;
+                T * outP = reinterpret_cast<T *>(out);
+                for (int x = 0; x < size; ++x, outP += C)
+                {
+                    for (int c = 0; c < C; ++c)
+                    {
+                        T value;
+                        memcpy(&value, inP[c] + x * inc, sizeof(T));
+                        outP[c] = SWAP ? planarSwap(value) : value;
+                    }
+                }
+            }
+
+            //! De-interleave a scanline with a fixed channel count and byte
+            //! width.
+            template<typename T, int C, bool SWAP>
+            void deinterleaveScanline(
+                const quint8 * in,
+                quint8 *       out,
+                quint64        channelStride,
+                int            size)
+            {
+                const T * inP = reinterpret_cast<const T *>(in);
+                quint8 * outP[C];
+                for (int c = 0; c < C; ++c)
+                {
+                    outP[c] = out + c * channelStride;
+                }
+                for (int x = 0; x < size; ++x, inP += C)
+                {
+                    for (int c = 0; c < C; ++c)
+                    {
+                        const T value = SWAP ? planarSwap(inP[c]) : inP[c];
+                        memcpy(outP[c] + x * sizeof(T), &value, sizeof(T));
+                    }
+                }
+            }
+
+            typedef void(*InterleaveKernel)(const quint8 *, quint64, quint8 *, int, int);
+            typedef void(*DeinterleaveKernel)(const quint8 *, quint8 *, quint64, int);
+
+            template<typename T, bool SWAP>
+            InterleaveKernel interleaveKernels(int channels)
+            {
+                static const InterleaveKernel data[] =
+                {
+                    interleaveScanline<T, 1, SWAP>,
+                    interleaveScanline<T, 2, SWAP>,
+                    interleaveScanline<T, 3, SWAP>,
+                    interleaveScanline<T, 4, SWAP>
+                };
+                return data[channels - 1];
+            }
+
+            template<typename T, bool SWAP>
+            DeinterleaveKernel deinterleaveKernels(int channels)
+            {
+                static const DeinterleaveKernel data[] =
+                {
+                    deinterleaveScanline<T, 1, SWAP>,
+                    deinterleaveScanline<T, 2, SWAP>,
+                    deinterleaveScanline<T, 3, SWAP>,
+                    deinterleaveScanline<T, 4, SWAP>
+                };
+                return data[channels - 1];
+            }
+
+            InterleaveKernel interleaveKernel(Pixel::PIXEL pixel, bool endian)
+            {
+                const int channels = Pixel::channels(pixel);
+                switch (Pixel::channelByteCount(pixel))
+                {
+                case 1: return interleaveKernels<quint8, false>(channels);
+                case 2:
+                    return endian ?
+                        interleaveKernels<quint16, true>(channels) :
+                        interleaveKernels<quint16, false>(channels);
+                case 4:
+                    return endian ?
+                        interleaveKernels<quint32, true>(channels) :
+                        interleaveKernels<quint32, false>(channels);
+                default: break;
+                }
+                return nullptr;
+            }
+
+            DeinterleaveKernel deinterleaveKernel(Pixel::PIXEL pixel, bool endian)
+            {
+                const int channels = Pixel::channels(pixel);
+                switch (Pixel::channelByteCount(pixel))
+                {
+                case 1: return deinterleaveKernels<quint8, false>(channels);
+                case 2:
+                    return endian ?
+                        deinterleaveKernels<quint16, true>(channels) :
+                        deinterleaveKernels<quint16, false>(channels);
+                case 4:
+                    return endian ?
+                        deinterleaveKernels<quint32, true>(channels) :
+                        deinterleaveKernels<quint32, false>(channels);
+                default: break;
+                }
+                return nullptr;
+            }
+
+        } // namespace
+
         void PixelDataUtil::planarInterleave(
             const PixelData &    in,
             PixelData &          out,
             PixelDataInfo::PROXY proxy)
         {
-            DJV_ASSERT(in.pixel() == out.pixel());
             DJV_ASSERT(in.pixel() != Pixel::RGB_U10);
+            DJV_ASSERT(Pixel::channels(in.pixel()) == Pixel::channels(out.pixel()));
 
             //DJV_DEBUG("PixelDataUtil::planarInterleave");
             //DJV_DEBUG_PRINT("in = " << in);
@@ -175,34 +340,55 @@ namespace djv
             const int     w = out.w();
             const int     h = out.h();
             const int     proxyScale = PixelDataUtil::proxyScale(proxy);
-            const int     channels = out.channels();
-            const quint64 pixelByteCount = out.pixelByteCount();
-            const int     channelByteCount = Pixel::channelByteCount(out.pixel());
-            for (int c = 0; c < channels; ++c)
+            const quint64 inScanlineByteCount = in.w() * Pixel::channelByteCount(in.pixel());
+            const quint64 channelStride = in.h() * inScanlineByteCount;
+            const InterleaveKernel kernel = interleaveKernel(in.pixel(), false);
+            std::vector<quint8> tmp;
+            if (in.pixel() != out.pixel())
             {
-                for (int y = 0; y < h; ++y)
+                tmp.resize(w * Pixel::byteCount(in.pixel()));
+            }
+            for (int y = 0; y < h; ++y)
+            {
+                const quint8 * inP = in.data() + y * proxyScale * inScanlineByteCount;
+                if (tmp.empty())
                 {
-                    const quint8 * inP = in.data() + (c * in.h() + y * proxyScale) *
-                        in.w() * channelByteCount;
-                    quint8 * outP = out.data(0, y) + c * channelByteCount;
-                    for (
-                        int x = 0;
-                        x < w;
-                        ++x, inP += channelByteCount * proxyScale,
-                        outP += pixelByteCount)
-                    {
-                        switch (channelByteCount)
-                        {
-                        case 4: outP[3] = inP[3];
-                        case 3: outP[2] = inP[2];
-                        case 2: outP[1] = inP[1];
-                        case 1: outP[0] = inP[0];
-                        }
-                    }
+                    kernel(inP, channelStride, out.data(0, y), w, proxyScale);
+                }
+                else
+                {
+                    kernel(inP, channelStride, tmp.data(), w, proxyScale);
+                    Pixel::convert(tmp.data(), in.pixel(), out.data(0, y), out.pixel(), w);
                 }
             }
         }
 
+        void PixelDataUtil::planarInterleave(
+            const quint8 *       in,
+            quint64              channelStride,
+            Pixel::PIXEL         inPixel,
+            quint8 *             out,
+            Pixel::PIXEL         outPixel,
+            int                  size,
+            PixelDataInfo::PROXY proxy,
+            bool                 endian)
+        {
+            DJV_ASSERT(inPixel != Pixel::RGB_U10);
+            DJV_ASSERT(Pixel::channels(inPixel) == Pixel::channels(outPixel));
+            const InterleaveKernel kernel = interleaveKernel(inPixel, endian);
+            const int proxyScale = PixelDataUtil::proxyScale(proxy);
+            if (inPixel == outPixel)
+            {
+                kernel(in, channelStride, out, size, proxyScale);
+            }
+            else
+            {
+                std::vector<quint8> tmp(size * Pixel::byteCount(inPixel));
+                kernel(in, channelStride, tmp.data(), size, proxyScale);
+                Pixel::convert(tmp.data(), inPixel, out, outPixel, size);
+            }
+        }
+
         void PixelDataUtil::planarDeinterleave(const PixelData & in, PixelData & out)
         {
             DJV_ASSERT(in.pixel() == out.pixel());
@@ -214,30 +400,283 @@ namespace djv
 
             const int     w = out.w();
             const int     h = out.h();
-            const int     channels = out.channels();
-            const quint64 pixelByteCount = out.pixelByteCount();
-            const int     channelByteCount = Pixel::channelByteCount(out.pixel());
-            for (int c = 0; c < channels; ++c)
+            const quint64 scanlineByteCount = w * Pixel::channelByteCount(out.pixel());
+            const DeinterleaveKernel kernel = deinterleaveKernel(in.pixel(), false);
+            for (int y = 0; y < h; ++y)
+            {
+                kernel(in.data(0, y), out.data() + y * scanlineByteCount, h * scanlineByteCount, w);
+            }
+        }
+
+        void PixelDataUtil::planarDeinterleave(
+            const quint8 * in,
+            Pixel::PIXEL   pixel,
+            quint8 *       out,
+            quint64        channelStride,
+            int            size,
+            bool           endian)
+        {
+            DJV_ASSERT(pixel != Pixel::RGB_U10);
+            deinterleaveKernel(pixel, endian)(in, out, channelStride, size);
+        }
+
+        namespace
+        {
+            const int     lzHashBits    = 16;
+            const int     lzMinMatch    = 4;
+            const int     lzLastLiterals = 5;
+            const int     lzMatchMargin = 12;
+            const quint64 lzMaxOffset   = 65535;
+
+            inline quint32 lzRead32(const quint8 * p)
+            {
+                quint32 out;
+                memcpy(&out, p, 4);
+                return out;
+            }
+
+            inline quint32 lzHash(quint32 value)
+            {
+                return (value * 2654435761U) >> (32 - lzHashBits);
+            }
+
+            inline void lzWriteLength(quint64 length, std::vector<quint8> & out)
             {
-                for (int y = 0; y < h; ++y)
+                for (; length >= 255; length -= 255)
                 {
-                    const quint8 * inP = in.data(0, y) + c * channelByteCount;
-                    quint8 * outP = out.data() + (c * h + y) * w * channelByteCount;
-                    for (
-                        int x = 0;
-                        x < w;
-                        ++x, inP += pixelByteCount, outP += channelByteCount)
+                    out.push_back(255);
+                }
+                out.push_back(static_cast<quint8>(length));
+            }
+
+            inline bool lzReadLength(const quint8 *& p, const quint8 * end, quint64 & length)
+            {
+                quint8 value = 0;
+                do
+                {
+                    if (p >= end)
+                        return false;
+                    value = *p++;
+                    length += value;
+                } while (255 == value);
+                return true;
+            }
+
+            // Write a sequence of literals followed by an optional match. The
+            // layout follows the LZ4 block format: a token with the literal and
+            // match lengths, the literals, and a 16-bit match offset.
+            void lzWriteSequence(
+                const quint8 *        literals,
+                quint64               literalCount,
+                quint64               offset,
+                quint64               matchLength,
+                std::vector<quint8> & out)
+            {
+                const size_t tokenIndex = out.size();
+                out.push_back(0);
+                quint8 token = 0;
+                if (literalCount >= 15)
+                {
+                    token = 15 << 4;
+                    lzWriteLength(literalCount - 15, out);
+                }
+                else
+                {
+                    token = static_cast<quint8>(literalCount << 4);
+                }
+                out.insert(out.end(), literals, literals + literalCount);
+                if (matchLength)
+                {
+                    out.push_back(static_cast<quint8>(offset & 0xff));
+                    out.push_back(static_cast<quint8>(offset >> 8));
+                    const quint64 length = matchLength - lzMinMatch;
+                    if (length >= 15)
+                    {
+                        token |= 15;
+                        lzWriteLength(length - 15, out);
+                    }
+                    else
+                    {
+                        token |= static_cast<quint8>(length);
+                    }
+                }
+                out[tokenIndex] = token;
+            }
+
+            void lzCompress(const quint8 * in, quint64 size, std::vector<quint8> & out)
+            {
+                const quint8 * const end = in + size;
+                const quint8 * const matchEnd = end - lzLastLiterals;
+                const quint8 * anchor = in;
+                const quint8 * p = in;
+                if (size > static_cast<quint64>(lzMatchMargin))
+                {
+                    // The table stores positions plus one so that zero means empty.
+                    std::vector<quint64> table(1 << lzHashBits, 0);
+                    const quint8 * const matchLimit = end - lzMatchMargin;
+                    int misses = 0;
+                    while (p < matchLimit)
+                    {
+                        const quint32 value = lzRead32(p);
+                        quint64 & entry = table[lzHash(value)];
+                        const quint8 * match = entry ? in + entry - 1 : nullptr;
+                        entry = static_cast<quint64>(p - in) + 1;
+                        if (match &&
+                            static_cast<quint64>(p - match) <= lzMaxOffset &&
+                            lzRead32(match) == value)
+                        {
+                            const quint8 * q = p + lzMinMatch;
+                            const quint8 * r = match + lzMinMatch;
+                            while (q < matchEnd && *q == *r)
+                            {
+                                ++q;
+                                ++r;
+                            }
+                            lzWriteSequence(anchor, p - anchor, p - match, q - p, out);
+                            p = anchor = q;
+                            misses = 0;
+                        }
+                        else
+                        {
+                            // Skip ahead faster through data that does not compress.
+                            p += 1 + (misses++ >> 6);
+                        }
+                    }
+                }
+                lzWriteSequence(anchor, end - anchor, 0, 0, out);
+            }
+
+            bool lzDecompress(const quint8 * in, quint64 size, quint8 * out, quint64 outSize)
+            {
+                const quint8 * p = in;
+                const quint8 * const end = in + size;
+                quint8 * o = out;
+                quint8 * const outEnd = out + outSize;
+                while (p < end)
+                {
+                    const quint8 token = *p++;
+                    quint64 literalCount = token >> 4;
+                    if (15 == literalCount && !lzReadLength(p, end, literalCount))
+                        return false;
+                    if (literalCount > static_cast<quint64>(end - p) ||
+                        literalCount > static_cast<quint64>(outEnd - o))
+                        return false;
+                    memcpy(o, p, literalCount);
+                    p += literalCount;
+                    o += literalCount;
+                    if (p == end)
+                        break;
+                    if (end - p < 2)
+                        return false;
+                    const quint64 offset = p[0] | (p[1] << 8);
+                    p += 2;
+                    if (!offset || offset > static_cast<quint64>(o - out))
+                        return false;
+                    quint64 matchLength = token & 15;
+                    if (15 == matchLength && !lzReadLength(p, end, matchLength))
+                        return false;
+                    matchLength += lzMinMatch;
+                    if (matchLength > static_cast<quint64>(outEnd - o))
+                        return false;
+                    if (offset >= matchLength)
                     {
-                        switch (channelByteCount)
+                        memcpy(o, o - offset, matchLength);
+                        o += matchLength;
+                    }
+                    else
+                    {
+                        // Overlapping matches repeat the previous bytes with a
+                        // period of the offset, so copy in doubling chunks.
+                        quint64 distance = offset;
+                        while (matchLength)
                         {
-                        case 4: outP[3] = inP[3];
-                        case 3: outP[2] = inP[2];
-                        case 2: outP[1] = inP[1];
-                        case 1: outP[0] = inP[0];
+                            const quint64 count = std::min(distance, matchLength);
+                            memcpy(o, o - distance, count);
+                            o += count;
+                            matchLength -= count;
+                            distance *= 2;
                         }
                     }
                 }
+                return o == outEnd;
             }
+
+            // Split the bytes of each word into planes and store the difference
+            // between neighboring bytes in each plane.
+            void shuffleDelta(const quint8 * in, quint64 size, int wordSize, quint8 * out)
+            {
+                const quint64 count = size / wordSize;
+                for (int i = 0; i < wordSize; ++i)
+                {
+                    const quint8 * inP = in + i;
+                    quint8 * outP = out + i * count;
+                    quint8 previous = 0;
+                    for (quint64 j = 0; j < count; ++j, inP += wordSize)
+                    {
+                        const quint8 value = *inP;
+                        outP[j] = value - previous;
+                        previous = value;
+                    }
+                }
+                const quint64 tail = count * wordSize;
+                memcpy(out + tail, in + tail, size - tail);
+            }
+
+            void unshuffleDelta(const quint8 * in, quint64 size, int wordSize, quint8 * out)
+            {
+                const quint64 count = size / wordSize;
+                for (int i = 0; i < wordSize; ++i)
+                {
+                    const quint8 * inP = in + i * count;
+                    quint8 * outP = out + i;
+                    quint8 previous = 0;
+                    for (quint64 j = 0; j < count; ++j, outP += wordSize)
+                    {
+                        previous += inP[j];
+                        *outP = previous;
+                    }
+                }
+                const quint64 tail = count * wordSize;
+                memcpy(out + tail, in + tail, size - tail);
+            }
+
+            const int compressHeaderSize = 9;
+
+        } // namespace
+
+        void PixelDataUtil::compress(const PixelData & in, std::vector<quint8> & out)
+        {
+            //DJV_DEBUG("PixelDataUtil::compress");
+            //DJV_DEBUG_PRINT("in = " << in);
+            const quint64 size = in.dataByteCount();
+            const int wordSize = std::max(1, static_cast<int>(in.pixelByteCount()));
+            std::vector<quint8> tmp(size);
+            shuffleDelta(in.data(), size, wordSize, tmp.data());
+            out.clear();
+            out.reserve(compressHeaderSize + size / 4);
+            out.resize(compressHeaderSize);
+            memcpy(out.data(), &size, 8);
+            out[8] = static_cast<quint8>(wordSize);
+            lzCompress(tmp.data(), size, out);
+            out.shrink_to_fit();
+            //DJV_DEBUG_PRINT("out = " << out.size());
+        }
+
+        bool PixelDataUtil::decompress(const std::vector<quint8> & in, PixelData & out)
+        {
+            //DJV_DEBUG("PixelDataUtil::decompress");
+            if (in.size() < compressHeaderSize)
+                return false;
+            quint64 size = 0;
+            memcpy(&size, in.data(), 8);
+            const int wordSize = in[8];
+            if (size != out.dataByteCount() || !wordSize)
+                return false;
+            std::vector<quint8> tmp(size);
+            if (!lzDecompress(in.data() + compressHeaderSize, in.size() - compressHeaderSize, tmp.data(), size))
+                return false;
+            unshuffleDelta(tmp.data(), size, wordSize, out.data());
+            return true;
         }
 
         void PixelDataUtil::gradient(PixelData & out)
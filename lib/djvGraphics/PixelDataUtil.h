@@ -63,15 +63,57 @@ namespace djv
             //! Calculate the size of a proxy scale.
             static Core::Box2i proxyScale(const Core::Box2i &, PixelDataInfo::PROXY);
 
-            //! Interleave pixel data channels.
+            //! Get the smallest proxy scale that still covers the given size.
+            static PixelDataInfo::PROXY proxyFit(const glm::ivec2 & in, const glm::ivec2 & size);
+
+            //! Interleave pixel data channels. The input is decimated by the
+            //! proxy scale and converted to the output pixel type in the same
+            //! pass.
             static void planarInterleave(
                 const PixelData &,
                 PixelData &,
                 PixelDataInfo::PROXY = PixelDataInfo::PROXY_NONE);
 
+            //! Interleave a scanline of planar channels, which are separated by
+            //! the given number of bytes. The input is decimated by the proxy
+            //! scale, converted from the opposite endian if requested, and
+            //! converted to the output pixel type in the same pass. The size
+            //! is the number of output pixels.
+            static void planarInterleave(
+                const quint8 *       in,
+                quint64              channelStride,
+                Pixel::PIXEL         inPixel,
+                quint8 *             out,
+                Pixel::PIXEL         outPixel,
+                int                  size,
+                PixelDataInfo::PROXY = PixelDataInfo::PROXY_NONE,
+                bool                 endian = false);
+
             //! De-interleave pixel data channels.
             static void planarDeinterleave(const PixelData &, PixelData &);
 
+            //! De-interleave a scanline into planar channels, which are
+            //! separated by the given number of bytes, converting to the
+            //! opposite endian if requested.
+            static void planarDeinterleave(
+                const quint8 * in,
+                Pixel::PIXEL   pixel,
+                quint8 *       out,
+                quint64        channelStride,
+                int            size,
+                bool           endian = false);
+
+            //! Losslessly compress pixel data for storage in memory. The bytes of
+            //! each pixel are shuffled into planes and delta encoded, which turns
+            //! smooth image regions into runs, and then compressed with an LZ77
+            //! byte codec using the LZ4 block layout.
+            static void compress(const PixelData &, std::vector<quint8> &);
+
+            //! Decompress pixel data that was compressed with compress(). The
+            //! output must already be allocated with the original information.
+            //! Returns false if the compressed data is not valid.
+            static bool decompress(const std::vector<quint8> &, PixelData &);
+
             //! Create a linear gradient.
             static void gradient(PixelData &);
         };
@@ -33,6 +33,9 @@
 #include <djvGraphics/PixelDataUtil.h>
 
 #include <djvCore/CoreContext.h>
+#include <djvCore/Trace.h>
+
+#include <string.h>
 
 namespace djv
 {
@@ -51,6 +54,7 @@ namespace djv
             //DJV_DEBUG_PRINT("in = " << in);
             _file = in;
             Core::FileIO io;
+            io.setMmap(false);
             _open(_file.fileName(_file.sequence().start()), info, io);
             if (Core::FileInfo::SEQUENCE == _file.type())
             {
@@ -62,6 +66,7 @@ namespace djv
         {
             //DJV_DEBUG("RLALoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE("RLALoad::read", "ImageIO");
             image.colorProfile = ColorProfile();
             image.tags = ImageTags();
 
@@ -80,20 +85,24 @@ namespace djv
             }
             PixelDataInfo _info = info[frame.layer];
 
-            // Read the file.
+            // Read the file. When reading a proxy only the scanlines that are
+            // needed are decoded, and they are decimated as they are read.
             io.readAhead();
-            PixelData * p = frame.proxy ? &_tmp : &image;
-            p->set(_info);
             const int w = _info.size.x;
-            const int h = _info.size.y;
             const int channels = Pixel::channels(_info.pixel);
             const int bytes = Pixel::channelByteCount(_info.pixel);
+            const int proxyScale = PixelDataUtil::proxyScale(frame.proxy);
+            const quint64 pixelByteCount = channels * bytes;
             //DJV_DEBUG_PRINT("channels = " << channels);
             //DJV_DEBUG_PRINT("bytes = " << bytes);
-            quint8 * data_p = p->data();
-            for (int y = 0; y < h; ++y, data_p += w * channels * bytes)
+            _info.size = PixelDataUtil::proxyScale(_info.size, frame.proxy);
+            _info.proxy = frame.proxy;
+            image.set(_info);
+            std::vector<quint8> scanline(frame.proxy ? w * pixelByteCount : 0);
+            for (int y = 0; y < image.h(); ++y)
             {
-                io.setPos(_rleOffset[y]);
+                quint8 * data_p = frame.proxy ? scanline.data() : image.data(0, y);
+                io.setPos(_rleOffset[y * proxyScale]);
                 for (int c = 0; c < channels; ++c)
                 {
                     if (Pixel::F32 == Pixel::type(_info.pixel))
@@ -105,20 +114,26 @@ namespace djv
                         RLA::readRle(io, data_p + c * bytes, w, channels, bytes);
                     }
                 }
-            }
-
-            // Proxy scale the image.
-            if (frame.proxy)
-            {
-                _info.size = PixelDataUtil::proxyScale(_info.size, frame.proxy);
-                _info.proxy = frame.proxy;
-                image.set(_info);
-                PixelDataUtil::proxyScale(_tmp, image, frame.proxy);
+                if (frame.proxy)
+                {
+                    quint8 * outP = image.data(0, y);
+                    for (int x = 0; x < image.w(); ++x, outP += pixelByteCount)
+                    {
+                        memcpy(outP, data_p + x * proxyScale * pixelByteCount, pixelByteCount);
+                    }
+                }
             }
 
             //DJV_DEBUG_PRINT("image = " << image);
         }
 
+        ImageLoad * RLALoad::clone() const
+        {
+            auto out = new RLALoad(context());
+            out->_file = _file;
+            return out;
+        }
+
         namespace
         {
             struct Header
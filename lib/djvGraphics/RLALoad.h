@@ -47,13 +47,13 @@ namespace djv
 
             void open(const Core::FileInfo &, ImageIOInfo &) override;
             void read(Image &, const ImageIOFrameInfo &) override;
+            ImageLoad * clone() const override;
 
         private:
             void _open(const QString &, ImageIOInfo &, Core::FileIO &);
 
             Core::FileInfo      _file;
             std::vector<qint32> _rleOffset;
-            PixelData           _tmp;
         };
 
     } // namespace Graphics
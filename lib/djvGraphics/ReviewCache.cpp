@@ -0,0 +1,250 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvGraphics/ReviewCache.h>
+
+#include <djvGraphics/ImageIO.h>
+#include <djvGraphics/PixelDataUtil.h>
+
+#include <djvCore/Memory.h>
+
+namespace djv
+{
+    namespace Graphics
+    {
+        const QString ReviewCache::staticName = "ReviewCache";
+
+        const quint64 ReviewCache::alignment = 4096;
+
+        const quint64 ReviewCache::indexEntryByteCount = 8;
+
+        namespace
+        {
+            const quint32 magic = 0x31435652;
+            const quint32 version = 1;
+            const quint32 written = 0x4e545257;
+
+            quint64 align(quint64 value)
+            {
+                return (value + ReviewCache::alignment - 1) / ReviewCache::alignment * ReviewCache::alignment;
+            }
+
+            void appendU32(QByteArray & data, quint32 value)
+            {
+                for (int i = 0; i < 4; ++i)
+                {
+                    data.append(static_cast<char>((value >> (i * 8)) & 0xff));
+                }
+            }
+
+            void appendString(QByteArray & data, const QString & value)
+            {
+                const QByteArray utf8 = value.toUtf8();
+                appendU32(data, utf8.size());
+                data.append(utf8);
+            }
+
+            quint32 getU32(Core::FileIO & io)
+            {
+                quint32 out = 0;
+                io.getU32(&out);
+                return out;
+            }
+
+            QString getString(Core::FileIO & io)
+            {
+                const quint32 size = getU32(io);
+                if (size > io.size() - io.pos())
+                {
+                    throw Core::Error(
+                        ReviewCache::staticName,
+                        ImageIO::errorLabels()[ImageIO::ERROR_READ]);
+                }
+                QByteArray utf8(size, 0);
+                io.get(utf8.data(), size);
+                return QString::fromUtf8(utf8);
+            }
+
+            quint32 frameCheck(qint64 frame)
+            {
+                // FNV-1a of the frame number.
+                quint32 out = 2166136261u;
+                const quint64 value = static_cast<quint64>(frame);
+                for (int i = 0; i < 8; ++i)
+                {
+                    out = (out ^ ((value >> (i * 8)) & 0xff)) * 16777619u;
+                }
+                return out;
+            }
+
+        } // namespace
+
+        QByteArray ReviewCache::Header::data()
+        {
+            QByteArray out;
+            appendU32(out, magic);
+            appendU32(out, version);
+            appendU32(out, info.size.x);
+            appendU32(out, info.size.y);
+            appendU32(out, info.pixel);
+            appendU32(out, info.bgr);
+            appendU32(out, info.mirror.x);
+            appendU32(out, info.mirror.y);
+            appendU32(out, info.align);
+            appendU32(out, info.endian);
+            appendU32(out, speed.scale());
+            appendU32(out, speed.duration());
+            appendU32(out, frames.count());
+            appendU32(out, tags.count());
+            for (const auto & frame : frames)
+            {
+                appendU32(out, static_cast<quint64>(frame) & 0xffffffff);
+                appendU32(out, static_cast<quint64>(frame) >> 32);
+            }
+            const QStringList keys = tags.keys();
+            const QStringList values = tags.values();
+            for (int i = 0; i < keys.count(); ++i)
+            {
+                appendString(out, keys[i]);
+                appendString(out, values[i]);
+            }
+            byteCount = out.size();
+            return out;
+        }
+
+        void ReviewCache::Header::load(Core::FileIO & io)
+        {
+            //DJV_DEBUG("ReviewCache::Header::load");
+            io.setEndian(Core::Memory::endian() != Core::Memory::LSB);
+            if (getU32(io) != magic)
+            {
+                throw Core::Error(
+                    staticName,
+                    ImageIO::errorLabels()[ImageIO::ERROR_UNRECOGNIZED]);
+            }
+            if (getU32(io) != version)
+            {
+                throw Core::Error(
+                    staticName,
+                    ImageIO::errorLabels()[ImageIO::ERROR_UNSUPPORTED]);
+            }
+            info.size.x = getU32(io);
+            info.size.y = getU32(io);
+            const quint32 pixel = getU32(io);
+            if (pixel >= Pixel::PIXEL_COUNT)
+            {
+                throw Core::Error(
+                    staticName,
+                    ImageIO::errorLabels()[ImageIO::ERROR_UNSUPPORTED]);
+            }
+            info.pixel = static_cast<Pixel::PIXEL>(pixel);
+            info.bgr = getU32(io) != 0;
+            info.mirror.x = getU32(io) != 0;
+            info.mirror.y = getU32(io) != 0;
+            info.align = getU32(io);
+            info.endian = static_cast<Core::Memory::ENDIAN>(getU32(io));
+            const int scale = getU32(io);
+            const int duration = getU32(io);
+            speed = Core::Speed(scale, duration);
+            const quint32 frameCount = getU32(io);
+            const quint32 tagCount = getU32(io);
+            //DJV_DEBUG_PRINT("info = " << info);
+            //DJV_DEBUG_PRINT("frames = " << frameCount);
+            if (info.align < 1 ||
+                info.endian >= Core::Memory::ENDIAN_COUNT ||
+                static_cast<quint64>(frameCount) * 8 > io.size() - io.pos())
+            {
+                throw Core::Error(
+                    staticName,
+                    ImageIO::errorLabels()[ImageIO::ERROR_READ]);
+            }
+            frames.resize(frameCount);
+            for (quint32 i = 0; i < frameCount; ++i)
+            {
+                const quint64 low = getU32(io);
+                const quint64 high = getU32(io);
+                frames[i] = static_cast<qint64>(low | (high << 32));
+            }
+            tags.clear();
+            for (quint32 i = 0; i < tagCount; ++i)
+            {
+                const QString key = getString(io);
+                tags.add(key, getString(io));
+            }
+            byteCount = io.pos();
+        }
+
+        quint64 ReviewCache::Header::indexOffset() const
+        {
+            return byteCount;
+        }
+
+        quint64 ReviewCache::Header::dataOffset() const
+        {
+            return align(indexOffset() + frames.count() * indexEntryByteCount);
+        }
+
+        quint64 ReviewCache::Header::frameStride() const
+        {
+            return align(PixelDataUtil::dataByteCount(info));
+        }
+
+        quint64 ReviewCache::Header::frameOffset(int index) const
+        {
+            return dataOffset() + index * frameStride();
+        }
+
+        quint64 ReviewCache::Header::fileSize() const
+        {
+            return frameOffset(frames.count());
+        }
+
+        QByteArray ReviewCache::indexEntry(qint64 frame)
+        {
+            QByteArray out;
+            appendU32(out, written);
+            appendU32(out, frameCheck(frame));
+            return out;
+        }
+
+        bool ReviewCache::isWritten(const quint8 * indexEntry, qint64 frame)
+        {
+            quint32 values[2] = { 0, 0 };
+            for (int i = 0; i < 2; ++i)
+            {
+                for (int j = 0; j < 4; ++j)
+                {
+                    values[i] |= static_cast<quint32>(indexEntry[i * 4 + j]) << (j * 8);
+                }
+            }
+            return written == values[0] && frameCheck(frame) == values[1];
+        }
+
+    } // namespace Graphics
+} // namespace djv
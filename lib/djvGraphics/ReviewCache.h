@@ -0,0 +1,115 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvGraphics/ImageTags.h>
+#include <djvGraphics/PixelData.h>
+
+#include <djvCore/FileIO.h>
+#include <djvCore/Sequence.h>
+#include <djvCore/Speed.h>
+
+#include <QByteArray>
+
+namespace djv
+{
+    namespace Graphics
+    {
+        //! This struct provides review cache utilities.
+        //!
+        //! A review cache file stores the frames of a sequence as raw pixel
+        //! data so they can be played back by memory-mapping them without
+        //! decoding or copying. The file contains:
+        //!
+        //! - A header with the image information, speed, frame numbers and
+        //!   image tags
+        //! - A frame index with one entry per frame that is written after the
+        //!   frame data, so an interrupted write can be resumed
+        //! - The frame data, each frame aligned to ReviewCache::alignment
+        //!
+        //! All header and index values are little-endian.
+        struct ReviewCache
+        {
+            //! Plugin name.
+            static const QString staticName;
+
+            //! The alignment of the frame data in bytes.
+            static const quint64 alignment;
+
+            //! The size of a frame index entry in bytes.
+            static const quint64 indexEntryByteCount;
+
+            //! This struct provides the file header.
+            struct Header
+            {
+                PixelDataInfo   info;
+                Core::Speed     speed;
+                Core::FrameList frames;
+                ImageTags       tags;
+
+                //! The size of the header in bytes. This is set by data() and
+                //! load().
+                quint64 byteCount = 0;
+
+                //! Get the header data.
+                QByteArray data();
+
+                //! Load the header. The file may be shorter than fileSize()
+                //! if it was truncated while being written.
+                //!
+                //! Throws:
+                //! - Core::Error
+                void load(Core::FileIO &);
+
+                //! Get the offset of the frame index.
+                quint64 indexOffset() const;
+
+                //! Get the offset of the frame data.
+                quint64 dataOffset() const;
+
+                //! Get the number of bytes between frames.
+                quint64 frameStride() const;
+
+                //! Get the offset of a frame.
+                quint64 frameOffset(int index) const;
+
+                //! Get the file size.
+                quint64 fileSize() const;
+            };
+
+            //! Get the index entry for a written frame.
+            static QByteArray indexEntry(qint64 frame);
+
+            //! Get whether an index entry marks the frame as written.
+            static bool isWritten(const quint8 * indexEntry, qint64 frame);
+        };
+
+    } // namespace Graphics
+} // namespace djv
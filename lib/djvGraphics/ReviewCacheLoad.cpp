@@ -0,0 +1,192 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvGraphics/ReviewCacheLoad.h>
+
+#include <djvGraphics/Image.h>
+#include <djvGraphics/PixelDataUtil.h>
+
+#include <djvCore/CoreContext.h>
+#include <djvCore/Trace.h>
+
+#include <QScopedPointer>
+
+namespace djv
+{
+    namespace Graphics
+    {
+        ReviewCacheLoad::ReviewCacheLoad(const QPointer<Core::CoreContext> & context) :
+            ImageLoad(context)
+        {}
+
+        ReviewCacheLoad::~ReviewCacheLoad()
+        {}
+
+        void ReviewCacheLoad::open(const Core::FileInfo & in, ImageIOInfo & info)
+        {
+            //DJV_DEBUG("ReviewCacheLoad::open");
+            //DJV_DEBUG_PRINT("in = " << in);
+            _fileName = in;
+            Core::FileIO io;
+            io.setMmap(false);
+            io.open(_fileName, Core::FileIO::READ);
+            _header.load(io);
+            if (io.size() < _header.fileSize())
+            {
+                throw Core::Error(
+                    ReviewCache::staticName,
+                    ImageIO::errorLabels()[ImageIO::ERROR_READ]);
+            }
+
+            // Read the frame index.
+            const int frameCount = _header.frames.count();
+            std::vector<quint8> index(frameCount * ReviewCache::indexEntryByteCount);
+            io.setPos(_header.indexOffset());
+            io.get(index.data(), index.size());
+            _frames.clear();
+            _written.resize(frameCount);
+            for (int i = 0; i < frameCount; ++i)
+            {
+                _frames[_header.frames[i]] = i;
+                _written[i] = ReviewCache::isWritten(
+                    index.data() + i * ReviewCache::indexEntryByteCount,
+                    _header.frames[i]);
+            }
+
+            info = ImageIOInfo(_header.info);
+            info.fileName = _fileName;
+            info.tags = _header.tags;
+            info.sequence = Core::Sequence(_header.frames, 0, _header.speed);
+            //DJV_DEBUG_PRINT("info = " << info);
+        }
+
+        void ReviewCacheLoad::read(Image & image, const ImageIOFrameInfo & frame)
+        {
+            //DJV_DEBUG("ReviewCacheLoad::read");
+            //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE("ReviewCacheLoad::read", "ImageIO");
+
+            // Find the frame.
+            int index = 0;
+            if (frame.frame != -1)
+            {
+                const auto i = _frames.find(frame.frame);
+                if (i == _frames.end())
+                {
+                    throw Core::Error(
+                        ReviewCache::staticName,
+                        ImageIO::errorLabels()[ImageIO::ERROR_READ]);
+                }
+                index = i->second;
+            }
+            if (index >= static_cast<int>(_written.size()) || !_isWritten(index))
+            {
+                throw Core::Error(
+                    ReviewCache::staticName,
+                    ImageIO::errorLabels()[ImageIO::ERROR_READ]);
+            }
+            image.tags = _header.tags;
+            image.colorProfile = ColorProfile();
+
+            // Map only the frame data instead of the whole file.
+            PixelDataInfo info = _header.info;
+            info.fileName = _fileName;
+            const quint64 offset = _header.frameOffset(index);
+            const quint64 size = PixelDataUtil::dataByteCount(info);
+            QScopedPointer<Core::FileIO> io(new Core::FileIO);
+            io->setMmapRange(offset, size);
+            io->open(_fileName, Core::FileIO::READ);
+            if (io->size() < offset + size)
+            {
+                throw Core::Error(
+                    ReviewCache::staticName,
+                    ImageIO::errorLabels()[ImageIO::ERROR_READ]);
+            }
+            io->setPos(offset);
+            if (const quint8 * p = io->mmapP())
+            {
+                if (!frame.proxy)
+                {
+                    image.set(info, p, io.take());
+                }
+                else
+                {
+                    const PixelData tmp(info, p, io.take());
+                    info.size = PixelDataUtil::proxyScale(info.size, frame.proxy);
+                    info.proxy = frame.proxy;
+                    image.set(info);
+                    PixelDataUtil::proxyScale(tmp, image, frame.proxy);
+                }
+            }
+            else
+            {
+                PixelData tmp;
+                PixelData * data = frame.proxy ? &tmp : &image;
+                data->set(info);
+                io->get(data->data(), size);
+                if (frame.proxy)
+                {
+                    info.size = PixelDataUtil::proxyScale(info.size, frame.proxy);
+                    info.proxy = frame.proxy;
+                    image.set(info);
+                    PixelDataUtil::proxyScale(tmp, image, frame.proxy);
+                }
+            }
+            //DJV_DEBUG_PRINT("image = " << image);
+        }
+
+        ImageLoad * ReviewCacheLoad::clone() const
+        {
+            auto out = new ReviewCacheLoad(context());
+            out->_fileName = _fileName;
+            out->_header = _header;
+            out->_frames = _frames;
+            out->_written = _written;
+            return out;
+        }
+
+        bool ReviewCacheLoad::_isWritten(int index)
+        {
+            // Frames that were not written when the file was opened are checked
+            // again, the file may still be in the process of being written.
+            if (!_written[index])
+            {
+                Core::FileIO io;
+                io.setMmap(false);
+                io.open(_fileName, Core::FileIO::READ);
+                io.setPos(_header.indexOffset() + index * ReviewCache::indexEntryByteCount);
+                quint8 entry[8];
+                io.get(entry, ReviewCache::indexEntryByteCount);
+                _written[index] = ReviewCache::isWritten(entry, _header.frames[index]);
+            }
+            return _written[index];
+        }
+
+    } // namespace Graphics
+} // namespace djv
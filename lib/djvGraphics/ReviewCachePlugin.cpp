@@ -0,0 +1,69 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvGraphics/ReviewCachePlugin.h>
+
+#include <djvGraphics/ReviewCacheLoad.h>
+#include <djvGraphics/ReviewCacheSave.h>
+
+namespace djv
+{
+    namespace Graphics
+    {
+        ReviewCachePlugin::ReviewCachePlugin(const QPointer<Core::CoreContext> & context) :
+            ImageIO(context)
+        {}
+
+        QString ReviewCachePlugin::pluginName() const
+        {
+            return ReviewCache::staticName;
+        }
+
+        QStringList ReviewCachePlugin::extensions() const
+        {
+            return QStringList() << ".rvc";
+        }
+
+        bool ReviewCachePlugin::isSequence() const
+        {
+            return false;
+        }
+
+        ImageLoad * ReviewCachePlugin::createLoad() const
+        {
+            return new ReviewCacheLoad(context());
+        }
+
+        ImageSave * ReviewCachePlugin::createSave() const
+        {
+            return new ReviewCacheSave(context());
+        }
+
+    } // namespace Graphics
+} // namespace djv
@@ -0,0 +1,235 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvGraphics/ReviewCacheSave.h>
+
+#include <djvGraphics/OpenGLImage.h>
+#include <djvGraphics/PixelDataUtil.h>
+
+#include <djvCore/CoreContext.h>
+#include <djvCore/Trace.h>
+
+#include <QFileInfo>
+
+namespace djv
+{
+    namespace Graphics
+    {
+        ReviewCacheSave::ReviewCacheSave(const QPointer<Core::CoreContext> & context) :
+            ImageSave(context)
+        {}
+
+        ReviewCacheSave::~ReviewCacheSave()
+        {}
+
+        void ReviewCacheSave::open(const Core::FileInfo & in, const ImageIOInfo & info)
+        {
+            //DJV_DEBUG("ReviewCacheSave::open");
+            //DJV_DEBUG_PRINT("in = " << in);
+            //DJV_DEBUG_PRINT("info = " << info);
+
+            _fileName = in;
+            _header = ReviewCache::Header();
+            _header.info = info;
+            _header.info.fileName.clear();
+            _header.info.layerName.clear();
+            _header.info.proxy = PixelDataInfo::PROXY_NONE;
+            _header.speed = info.sequence.speed;
+            _header.frames = info.sequence.frames;
+            if (_header.frames.isEmpty())
+            {
+                _header.frames.append(0);
+            }
+            _header.tags = info.tags;
+            const QByteArray header = _header.data();
+            const int frameCount = _header.frames.count();
+            _frames.clear();
+            for (int i = 0; i < frameCount; ++i)
+            {
+                _frames[_header.frames[i]] = i;
+            }
+            _written = std::vector<bool>(frameCount, false);
+            _image.set(_header.info);
+
+            // Resume writing if the file exists with the same header. Frames
+            // that extend past the end of a truncated file are written again.
+            bool resume = false;
+            std::vector<int> stale;
+            if (QFileInfo(_fileName).exists())
+            {
+                try
+                {
+                    Core::FileIO io;
+                    io.setMmap(false);
+                    io.open(_fileName, Core::FileIO::READ);
+                    ReviewCache::Header tmp;
+                    tmp.load(io);
+                    if (tmp.data() == header)
+                    {
+                        std::vector<quint8> index(frameCount * ReviewCache::indexEntryByteCount);
+                        io.setPos(_header.indexOffset());
+                        io.get(index.data(), index.size());
+                        const quint64 dataByteCount = PixelDataUtil::dataByteCount(_header.info);
+                        for (int i = 0; i < frameCount; ++i)
+                        {
+                            if (ReviewCache::isWritten(
+                                index.data() + i * ReviewCache::indexEntryByteCount,
+                                _header.frames[i]))
+                            {
+                                _written[i] = _header.frameOffset(i) + dataByteCount <= io.size();
+                                if (!_written[i])
+                                {
+                                    stale.push_back(i);
+                                }
+                            }
+                        }
+                        resume = true;
+                    }
+                }
+                catch (const Core::Error &)
+                {}
+            }
+            //DJV_DEBUG_PRINT("resume = " << resume);
+
+            // Open the file. A new file is sized up front, which also zero
+            // fills the frame index, and a truncated file is extended.
+            _file.setFileName(_fileName);
+            if (!_file.open(resume ?
+                QIODevice::ReadWrite :
+                (QIODevice::ReadWrite | QIODevice::Truncate)))
+            {
+                throw Core::Error(
+                    ReviewCache::staticName,
+                    ImageIO::errorLabels()[ImageIO::ERROR_OPEN]);
+            }
+            if (!resume)
+            {
+                if (!_file.resize(_header.fileSize()) ||
+                    _file.write(header) != header.size())
+                {
+                    throw Core::Error(
+                        ReviewCache::staticName,
+                        ImageIO::errorLabels()[ImageIO::ERROR_WRITE]);
+                }
+            }
+            else
+            {
+                if (static_cast<quint64>(_file.size()) < _header.fileSize() &&
+                    !_file.resize(_header.fileSize()))
+                {
+                    throw Core::Error(
+                        ReviewCache::staticName,
+                        ImageIO::errorLabels()[ImageIO::ERROR_WRITE]);
+                }
+
+                // Clear the index entries of the truncated frames so they are
+                // not read before they are written again.
+                const QByteArray entry(static_cast<int>(ReviewCache::indexEntryByteCount), 0);
+                for (const auto i : stale)
+                {
+                    if (!_file.seek(_header.indexOffset() + i * ReviewCache::indexEntryByteCount) ||
+                        _file.write(entry) != entry.size())
+                    {
+                        throw Core::Error(
+                            ReviewCache::staticName,
+                            ImageIO::errorLabels()[ImageIO::ERROR_WRITE]);
+                    }
+                }
+                if (!_file.flush())
+                {
+                    throw Core::Error(
+                        ReviewCache::staticName,
+                        ImageIO::errorLabels()[ImageIO::ERROR_WRITE]);
+                }
+            }
+        }
+
+        void ReviewCacheSave::write(const Image & in, const ImageIOFrameInfo & frame)
+        {
+            //DJV_DEBUG("ReviewCacheSave::write");
+            //DJV_DEBUG_PRINT("in = " << in);
+            //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE("ReviewCacheSave::write", "ImageIO");
+            const int index = _index(frame);
+            if (-1 == index)
+            {
+                throw Core::Error(
+                    ReviewCache::staticName,
+                    ImageIO::errorLabels()[ImageIO::ERROR_WRITE]);
+            }
+
+            // Convert the image.
+            const PixelData * p = &in;
+            if (in.info() != _header.info)
+            {
+                //DJV_DEBUG_PRINT("convert = " << _image);
+                _image.zero();
+                OpenGLImage().copy(in, _image);
+                p = &_image;
+            }
+
+            // Write the frame data and then the index entry, so the frame is
+            // only marked as written once the data is complete.
+            const qint64 size = p->dataByteCount();
+            const QByteArray entry = ReviewCache::indexEntry(_header.frames[index]);
+            if (!_file.seek(_header.frameOffset(index)) ||
+                _file.write(reinterpret_cast<const char *>(p->data()), size) != size ||
+                !_file.flush() ||
+                !_file.seek(_header.indexOffset() + index * ReviewCache::indexEntryByteCount) ||
+                _file.write(entry) != entry.size() ||
+                !_file.flush())
+            {
+                throw Core::Error(
+                    ReviewCache::staticName,
+                    ImageIO::errorLabels()[ImageIO::ERROR_WRITE]);
+            }
+            _written[index] = true;
+        }
+
+        void ReviewCacheSave::close()
+        {
+            _file.close();
+        }
+
+        bool ReviewCacheSave::hasFrame(const ImageIOFrameInfo & frame) const
+        {
+            const int index = _index(frame);
+            return index != -1 && _written[index];
+        }
+
+        int ReviewCacheSave::_index(const ImageIOFrameInfo & frame) const
+        {
+            if (-1 == frame.frame)
+                return 0;
+            const auto i = _frames.find(frame.frame);
+            return i != _frames.end() ? i->second : -1;
+        }
+
+    } // namespace Graphics
+} // namespace djv
@@ -33,6 +33,7 @@
 #include <djvGraphics/PixelDataUtil.h>
 
 #include <djvCore/CoreContext.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -51,6 +52,7 @@ namespace djv
             //DJV_DEBUG_PRINT("in = " << in);
             _file = in;
             Core::FileIO io;
+            io.setMmap(false);
             _open(_file.fileName(_file.sequence().start()), info, io);
             if (Core::FileInfo::SEQUENCE == _file.type())
             {
@@ -62,6 +64,7 @@ namespace djv
         {
             //DJV_DEBUG("SGILoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE("SGILoad::read", "ImageIO");
 
             image.colorProfile = ColorProfile();
             image.tags = ImageTags();
@@ -74,51 +77,63 @@ namespace djv
             Core::FileIO io;
             _open(fileName, info, io);
 
-            // Read the file.
+            // Read the file. The channels are interleaved directly into the
+            // image, decimating and converting the endian in the same pass.
             io.readAhead();
             const quint64 pos = io.pos();
             const quint64 size = io.size() - pos;
+            const int     w = info.size.x;
+            const int     h = info.size.y;
             const int     channels = Pixel::channels(info.pixel);
             const int     bytes = Pixel::channelByteCount(info.pixel);
+            const int     proxyScale = PixelDataUtil::proxyScale(frame.proxy);
+            const quint64 scanlineByteCount = w * bytes;
+            const quint64 dataByteCount = PixelDataUtil::dataByteCount(info);
+            const Pixel::PIXEL pixel = info.pixel;
+            info.size = PixelDataUtil::proxyScale(info.size, frame.proxy);
+            info.proxy = frame.proxy;
+            image.set(info);
             if (!_compression)
             {
-                if (1 == bytes)
+                if (size < dataByteCount)
                 {
-                    const quint8 * p = io.mmapP();
-                    io.seek(PixelDataUtil::dataByteCount(info));
-                    _tmp.set(info, p);
+                    throw Core::Error(
+                        SGI::staticName,
+                        ImageIO::errorLabels()[ImageIO::ERROR_READ]);
                 }
-                else
+                const quint8 * p = io.mmapP();
+                for (int y = 0; y < image.h(); ++y)
                 {
-                    if (size != PixelDataUtil::dataByteCount(info))
-                    {
-                        throw Core::Error(
-                            SGI::staticName,
-                            ImageIO::errorLabels()[ImageIO::ERROR_READ]);
-                    }
-                    _tmp.set(info);
-                    io.get(_tmp.data(), size / bytes, bytes);
+                    PixelDataUtil::planarInterleave(
+                        p + y * proxyScale * scanlineByteCount,
+                        h * scanlineByteCount,
+                        pixel,
+                        image.data(0, y),
+                        pixel,
+                        image.w(),
+                        frame.proxy,
+                        bytes > 1 && io.endian());
                 }
             }
             else
             {
-                _tmp.set(info);
                 std::vector<quint8> tmp(size);
                 io.get(tmp.data(), size / bytes, bytes);
                 const quint8 * inP = tmp.data();
                 const quint8 * end = inP + size;
-                quint8 *       outP = _tmp.data();
-                for (int c = 0; c < channels; ++c)
+
+                // Only the scanlines needed for the proxy are decoded.
+                std::vector<quint8> scanline(channels * scanlineByteCount);
+                for (int y = 0; y < image.h(); ++y)
                 {
-                    //DJV_DEBUG_PRINT("channel = " << c);
-                    for (int y = 0; y < info.size.y; ++y, outP += info.size.x * bytes)
+                    //DJV_DEBUG_PRINT("y = " << y);
+                    for (int c = 0; c < channels; ++c)
                     {
-                        //DJV_DEBUG_PRINT("y = " << y);
                         if (!SGI::readRle(
-                            inP + _rleOffset[y + info.size.y * c] - pos,
+                            inP + _rleOffset[y * proxyScale + h * c] - pos,
                             end,
-                            outP,
-                            info.size.x,
+                            scanline.data() + c * scanlineByteCount,
+                            w,
                             bytes,
                             io.endian()))
                         {
@@ -127,18 +142,27 @@ namespace djv
                                 ImageIO::errorLabels()[ImageIO::ERROR_READ]);
                         }
                     }
+                    PixelDataUtil::planarInterleave(
+                        scanline.data(),
+                        scanlineByteCount,
+                        pixel,
+                        image.data(0, y),
+                        pixel,
+                        image.w(),
+                        frame.proxy);
                 }
             }
 
-            // Interleave the image channels.
-            info.size = PixelDataUtil::proxyScale(info.size, frame.proxy);
-            info.proxy = frame.proxy;
-            image.set(info);
-            PixelDataUtil::planarInterleave(_tmp, image, frame.proxy);
-
             //DJV_DEBUG_PRINT("image = " << image);
         }
 
+        ImageLoad * SGILoad::clone() const
+        {
+            auto out = new SGILoad(context());
+            out->_file = _file;
+            return out;
+        }
+
         void SGILoad::_open(const QString & in, ImageIOInfo & info, Core::FileIO & io)
         {
             //DJV_DEBUG("SGILoad::_open");
@@ -46,6 +46,7 @@ namespace djv
 
             void open(const Core::FileInfo &, ImageIOInfo &) override;
             void read(Image &, const ImageIOFrameInfo &) override;
+            ImageLoad * clone() const override;
 
         private:
             void _open(const QString &, ImageIOInfo &, Core::FileIO &);
@@ -54,7 +55,6 @@ namespace djv
             bool                 _compression = false;
             std::vector<quint32> _rleOffset;
             std::vector<quint32> _rleSize;
-            PixelData            _tmp;
         };
 
     } // namespace Graphics
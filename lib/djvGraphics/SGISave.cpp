@@ -33,6 +33,7 @@
 #include <djvGraphics/PixelDataUtil.h>
 
 #include <djvCore/CoreContext.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -76,6 +77,7 @@ namespace djv
             //DJV_DEBUG("SGISave::write");
             //DJV_DEBUG_PRINT("in = " << in);
             //DJV_DEBUG_PRINT("compression = " << _options.compression);
+            DJV_TRACE("SGISave::write", "ImageIO");
 
             // Open the file.
             const QString fileName = _file.fileName(frame.frame);
@@ -112,13 +114,25 @@ namespace djv
             const int channels = Pixel::channels(_tmp.pixel());
             const int bytes = Pixel::channelByteCount(_tmp.pixel());
 
-            // Deinterleave the image channels.
-            PixelDataUtil::planarDeinterleave(*p, _tmp);
+            // Deinterleave the image channels. When the file is not compressed
+            // the endian is converted in the same pass.
+            const bool endian = !_options.compression && bytes > 1 && io.endian();
+            const quint64 scanlineByteCount = w * bytes;
+            for (int y = 0; y < h; ++y)
+            {
+                PixelDataUtil::planarDeinterleave(
+                    p->data(0, y),
+                    _tmp.pixel(),
+                    _tmp.data() + y * scanlineByteCount,
+                    h * scanlineByteCount,
+                    w,
+                    endian);
+            }
 
             // Write the file.
             if (!_options.compression)
             {
-                io.set(_tmp.data(), _tmp.dataByteCount() / bytes, bytes);
+                io.set(_tmp.data(), _tmp.dataByteCount());
             }
             else
             {
@@ -45,7 +45,9 @@ namespace djv
             static const QStringList data = QStringList() <<
                 qApp->translate("djv::Graphics::TIFF", "None") <<
                 qApp->translate("djv::Graphics::TIFF", "RLE") <<
-                qApp->translate("djv::Graphics::TIFF", "LZW");
+                qApp->translate("djv::Graphics::TIFF", "LZW") <<
+                qApp->translate("djv::Graphics::TIFF", "Deflate") <<
+                qApp->translate("djv::Graphics::TIFF", "ZSTD");
             DJV_ASSERT(data.count() == COMPRESSION_COUNT);
             return data;
         }
@@ -94,7 +96,9 @@ namespace djv
         const QStringList & TIFF::optionsLabels()
         {
             static const QStringList data = QStringList() <<
-                qApp->translate("djv::Graphics::TIFF", "Compression");
+                qApp->translate("djv::Graphics::TIFF", "Compression") <<
+                qApp->translate("djv::Graphics::TIFF", "Predictor") <<
+                qApp->translate("djv::Graphics::TIFF", "Rows Per Strip");
             DJV_ASSERT(data.count() == OPTIONS_COUNT);
             return data;
         }
@@ -50,6 +50,8 @@ namespace djv
                 _COMPRESSION_NONE,
                 _COMPRESSION_RLE,
                 _COMPRESSION_LZW,
+                _COMPRESSION_DEFLATE,
+                _COMPRESSION_ZSTD,
 
                 COMPRESSION_COUNT
             };
@@ -70,6 +72,8 @@ namespace djv
             enum OPTIONS
             {
                 COMPRESSION_OPTION,
+                PREDICTOR_OPTION,
+                ROWS_PER_STRIP_OPTION,
 
                 OPTIONS_COUNT
             };
@@ -80,7 +84,9 @@ namespace djv
             //! This struct provides options.
             struct Options
             {
-                COMPRESSION compression = _COMPRESSION_NONE;
+                COMPRESSION compression  = _COMPRESSION_NONE;
+                bool        predictor    = true;
+                int         rowsPerStrip = 16;
             };
         };
 
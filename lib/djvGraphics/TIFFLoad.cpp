@@ -33,11 +33,96 @@
 #include <djvGraphics/PixelDataUtil.h>
 
 #include <djvCore/CoreContext.h>
+#include <djvCore/Math.h>
+#include <djvCore/Trace.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <string.h>
 
 namespace djv
 {
     namespace Graphics
     {
+        namespace
+        {
+            ::TIFF * tiffOpen(const QString & fileName)
+            {
+#if defined(DJV_WINDOWS)
+                return TIFFOpenW(Core::StringUtil::qToStdWString(fileName).data(), "r");
+#else
+                return TIFFOpen(fileName.toUtf8().data(), "r");
+#endif // DJV_WINDOWS
+            }
+
+            //! This struct provides the information needed to decode the strips
+            //! or tiles of a file.
+            struct Chunks
+            {
+                bool       tiled        = false;
+                int        count        = 0;
+                glm::ivec2 size         = glm::ivec2(0, 0);
+                int        across       = 0;
+                int        rowBytes     = 0;
+                int        pixelBytes   = 0;
+                bool       palette      = false;
+                int        paletteBytes = 0;
+                uint16 **  colormap     = nullptr;
+            };
+
+            //! Decode strips or tiles until there are none left. The data for
+            //! each strip or tile is decoded directly into the pixel data when
+            //! the layout matches, otherwise it is decoded into a temporary
+            //! buffer and copied.
+            bool decode(::TIFF * f, const Chunks & chunks, std::atomic<int> & next, PixelData & data)
+            {
+                const tmsize_t chunkSize = chunks.tiled ? TIFFTileSize(f) : TIFFStripSize(f);
+                std::vector<quint8> tmp;
+                int i = next++;
+                while (i < chunks.count)
+                {
+                    const glm::ivec2 pos = chunks.tiled ?
+                        glm::ivec2((i % chunks.across) * chunks.size.x, (i / chunks.across) * chunks.size.y) :
+                        glm::ivec2(0, i * chunks.size.y);
+                    const int w = std::min(chunks.size.x, data.w() - pos.x);
+                    const int h = std::min(chunks.size.y, data.h() - pos.y);
+                    if (!chunks.tiled && !chunks.palette)
+                    {
+                        if (TIFFReadEncodedStrip(f, i, data.data(0, pos.y), h * data.scanlineByteCount()) == -1)
+                            return false;
+                    }
+                    else
+                    {
+                        tmp.resize(chunkSize);
+                        const tmsize_t size = chunks.tiled ?
+                            TIFFReadEncodedTile(f, i, tmp.data(), chunkSize) :
+                            TIFFReadEncodedStrip(f, i, tmp.data(), chunkSize);
+                        if (-1 == size)
+                            return false;
+                        for (int y = 0; y < h; ++y)
+                        {
+                            quint8 * p = data.data(pos.x, pos.y + y);
+                            memcpy(p, tmp.data() + y * chunks.rowBytes, w * chunks.pixelBytes);
+                            if (chunks.palette)
+                            {
+                                TIFF::paletteLoad(
+                                    p,
+                                    w,
+                                    chunks.paletteBytes,
+                                    chunks.colormap[0], chunks.colormap[1], chunks.colormap[2]);
+                            }
+                        }
+                    }
+                    i = next++;
+                }
+                return true;
+            }
+
+        } // namespace
+
         TIFFLoad::TIFFLoad(const QPointer<Core::CoreContext> & context) :
             ImageLoad(context)
         {}
@@ -63,6 +148,7 @@ namespace djv
         {
             //DJV_DEBUG("TIFFLoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE("TIFFLoad::read", "ImageIO");
 
             image.colorProfile = ColorProfile();
             image.tags = ImageTags();
@@ -78,22 +164,78 @@ namespace djv
             // Read the file.
             PixelData * data = frame.proxy ? &_tmp : &image;
             data->set(info);
-            for (int y = 0; y < info.size.y; ++y)
+            Chunks chunks;
+            chunks.tiled = _tiled;
+            if (_tiled)
+            {
+                uint32 tileWidth = 0;
+                uint32 tileLength = 0;
+                TIFFGetField(_f, TIFFTAG_TILEWIDTH, &tileWidth);
+                TIFFGetField(_f, TIFFTAG_TILELENGTH, &tileLength);
+                chunks.count = TIFFNumberOfTiles(_f);
+                chunks.size = glm::ivec2(tileWidth, tileLength);
+                chunks.across = (info.size.x + tileWidth - 1) / tileWidth;
+                chunks.rowBytes = TIFFTileRowSize(_f);
+            }
+            else
+            {
+                uint32 rowsPerStrip = 0;
+                TIFFGetFieldDefaulted(_f, TIFFTAG_ROWSPERSTRIP, &rowsPerStrip);
+                chunks.count = TIFFNumberOfStrips(_f);
+                chunks.size = glm::ivec2(info.size.x, std::min(rowsPerStrip, static_cast<uint32>(info.size.y)));
+                chunks.rowBytes = TIFFScanlineSize(_f);
+            }
+            chunks.palette = _palette;
+            chunks.paletteBytes = Pixel::channelByteCount(info.pixel);
+            chunks.pixelBytes = _palette ? chunks.paletteBytes : data->pixelByteCount();
+            chunks.colormap = _colormap;
+            //DJV_DEBUG_PRINT("chunks = " << chunks.count);
+            if (!chunks.size.x || !chunks.size.y ||
+                static_cast<quint64>(TIFFScanlineSize(_f)) != info.size.x * chunks.pixelBytes)
             {
-                if (TIFFReadScanline(_f, (tdata_t *)data->data(0, y), y) == -1)
+                throw Core::Error(
+                    TIFF::staticName,
+                    ImageIO::errorLabels()[ImageIO::ERROR_UNSUPPORTED]);
+            }
+
+            // Compressed strips and tiles are decoded in parallel, each thread
+            // with its own handle since libtiff handles are not thread safe.
+            std::atomic<int> next(0);
+            int threads = 1;
+            if (_compression)
+            {
+                threads = Core::Math::clamp(
+                    static_cast<int>(std::thread::hardware_concurrency()),
+                    1,
+                    chunks.count);
+            }
+            //DJV_DEBUG_PRINT("threads = " << threads);
+            std::vector<std::thread> workers;
+            std::vector<char> results(threads, 0);
+            for (int i = 1; i < threads; ++i)
+            {
+                workers.push_back(std::thread([&fileName, &chunks, &next, data, &results, i]
+                {
+                    if (::TIFF * f = tiffOpen(fileName))
+                    {
+                        results[i] = decode(f, chunks, next, *data);
+                        TIFFClose(f);
+                    }
+                }));
+            }
+            results[0] = decode(_f, chunks, next, *data);
+            for (auto & i : workers)
+            {
+                i.join();
+            }
+            for (const auto i : results)
+            {
+                if (!i)
                 {
                     throw Core::Error(
                         TIFF::staticName,
                         ImageIO::errorLabels()[ImageIO::ERROR_READ]);
                 }
-                if (_palette)
-                {
-                    TIFF::paletteLoad(
-                        data->data(0, y),
-                        info.size.x,
-                        Pixel::channelByteCount(info.pixel),
-                        _colormap[0], _colormap[1], _colormap[2]);
-                }
             }
 
             // Proxy scaling.
@@ -110,6 +252,13 @@ namespace djv
             close();
         }
 
+        ImageLoad * TIFFLoad::clone() const
+        {
+            auto out = new TIFFLoad(context());
+            out->_file = _file;
+            return out;
+        }
+
         void TIFFLoad::close()
         {
             if (_f)
@@ -127,11 +276,7 @@ namespace djv
             close();
 
             // Open the file.
-#if defined(DJV_WINDOWS)
-            _f = TIFFOpenW(Core::StringUtil::qToStdWString(in).data(), "r");
-#else
-            _f = TIFFOpen(in.toUtf8().data(), "r");
-#endif // DJV_WINDOWS
+            _f = tiffOpen(in);
             if (!_f)
             {
                 throw Core::Error(
@@ -213,6 +358,7 @@ namespace djv
             info.pixel = pixel;
             _compression = compression != COMPRESSION_NONE;
             _palette = PHOTOMETRIC_PALETTE == photometric;
+            _tiled = TIFFIsTiled(_f) != 0;
             switch (orient)
             {
             case ORIENTATION_TOPLEFT:  info.mirror.y = true;                 break;
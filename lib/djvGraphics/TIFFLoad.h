@@ -47,6 +47,7 @@ namespace djv
 
             void open(const Core::FileInfo &, ImageIOInfo &) override;
             void read(Image &, const ImageIOFrameInfo &)  override;
+            ImageLoad * clone() const override;
             void close() override;
 
         private:
@@ -56,6 +57,7 @@ namespace djv
             ::TIFF *       _f           = nullptr;
             bool           _compression = false;
             bool           _palette     = false;
+            bool           _tiled       = false;
             uint16 *       _colormap[3] = { nullptr, nullptr, nullptr };
             PixelData      _tmp;
         };
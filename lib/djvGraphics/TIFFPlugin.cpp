@@ -71,6 +71,14 @@ namespace djv
             {
                 out << _options.compression;
             }
+            else if (0 == in.compare(options()[TIFF::PREDICTOR_OPTION], Qt::CaseInsensitive))
+            {
+                out << _options.predictor;
+            }
+            else if (0 == in.compare(options()[TIFF::ROWS_PER_STRIP_OPTION], Qt::CaseInsensitive))
+            {
+                out << _options.rowsPerStrip;
+            }
             return out;
         }
 
@@ -88,6 +96,26 @@ namespace djv
                         Q_EMIT optionChanged(in);
                     }
                 }
+                else if (0 == in.compare(options()[TIFF::PREDICTOR_OPTION], Qt::CaseInsensitive))
+                {
+                    bool predictor = false;
+                    data >> predictor;
+                    if (predictor != _options.predictor)
+                    {
+                        _options.predictor = predictor;
+                        Q_EMIT optionChanged(in);
+                    }
+                }
+                else if (0 == in.compare(options()[TIFF::ROWS_PER_STRIP_OPTION], Qt::CaseInsensitive))
+                {
+                    int rowsPerStrip = 0;
+                    data >> rowsPerStrip;
+                    if (rowsPerStrip != _options.rowsPerStrip)
+                    {
+                        _options.rowsPerStrip = rowsPerStrip;
+                        Q_EMIT optionChanged(in);
+                    }
+                }
             }
             catch (const QString &)
             {
@@ -114,6 +142,14 @@ namespace djv
                     {
                         in >> _options.compression;
                     }
+                    else if (qApp->translate("djv::Graphics::TIFFPlugin", "-tiff_predictor") == arg)
+                    {
+                        in >> _options.predictor;
+                    }
+                    else if (qApp->translate("djv::Graphics::TIFFPlugin", "-tiff_rows_per_strip") == arg)
+                    {
+                        in >> _options.rowsPerStrip;
+                    }
                     else
                     {
                         tmp << arg;
@@ -131,15 +167,29 @@ namespace djv
         {
             QStringList compressionLabel;
             compressionLabel << _options.compression;
+            QStringList predictorLabel;
+            predictorLabel << _options.predictor;
+            QStringList rowsPerStripLabel;
+            rowsPerStripLabel << _options.rowsPerStrip;
             return qApp->translate("djv::Graphics::TIFFPlugin",
                 "\n"
                 "TIFF Options\n"
                 "\n"
                 "    -tiff_compression (value)\n"
                 "        Set the file compression used when saving TIFF images: %1. "
-                "Default = %2.\n").
+                "Default = %2.\n"
+                "    -tiff_predictor (value)\n"
+                "        Set whether a predictor is used with LZW, Deflate, and ZSTD "
+                "compression when saving TIFF images: %3. Default = %4.\n"
+                "    -tiff_rows_per_strip (value)\n"
+                "        Set the number of rows in each strip when saving TIFF images. "
+                "Strips are compressed in parallel when using Deflate compression. "
+                "Default = %5.\n").
                 arg(TIFF::compressionLabels().join(", ")).
-                arg(compressionLabel.join(", "));
+                arg(compressionLabel.join(", ")).
+                arg(Core::StringUtil::boolLabels().join(", ")).
+                arg(predictorLabel.join(", ")).
+                arg(rowsPerStripLabel.join(", "));
         }
 
         ImageLoad * TIFFPlugin::createLoad() const
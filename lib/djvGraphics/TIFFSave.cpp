@@ -32,11 +32,106 @@
 #include <djvGraphics/OpenGLImage.h>
 
 #include <djvCore/CoreContext.h>
+#include <djvCore/Math.h>
+#include <djvCore/Memory.h>
+#include <djvCore/Trace.h>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#if !defined(COMPRESSION_ZSTD)
+#define COMPRESSION_ZSTD 50000
+#endif // COMPRESSION_ZSTD
+#if !defined(PREDICTOR_FLOATINGPOINT)
+#define PREDICTOR_FLOATINGPOINT 3
+#endif // PREDICTOR_FLOATINGPOINT
 
 namespace djv
 {
     namespace Graphics
     {
+        namespace
+        {
+            //! Apply the horizontal differencing predictor to a scanline.
+            template<typename T>
+            void horizontalDifference(quint8 * in, int count, int samples)
+            {
+                T * p = reinterpret_cast<T *>(in);
+                for (int i = count - 1; i >= samples; --i)
+                {
+                    p[i] -= p[i - samples];
+                }
+            }
+
+            //! Apply the floating point predictor to a scanline. The bytes of
+            //! each value are split into planes, most significant first, and
+            //! then differenced.
+            void floatingPointDifference(quint8 * in, int size, int samples, int sampleBytes)
+            {
+                const std::vector<quint8> tmp(in, in + size);
+                const int count = size / sampleBytes;
+                const bool lsb = Core::Memory::LSB == Core::Memory::endian();
+                for (int i = 0; i < count; ++i)
+                {
+                    for (int b = 0; b < sampleBytes; ++b)
+                    {
+                        in[(lsb ? (sampleBytes - b - 1) : b) * count + i] = tmp[i * sampleBytes + b];
+                    }
+                }
+                for (int i = size - 1; i >= samples; --i)
+                {
+                    in[i] -= in[i - samples];
+                }
+            }
+
+            //! Compress a strip with Deflate, the same as libtiff would.
+            bool deflateStrip(
+                const PixelData &     data,
+                int                   y,
+                int                   rows,
+                uint16                predictor,
+                std::vector<quint8> & out)
+            {
+                const int rowBytes = static_cast<int>(data.scanlineByteCount());
+                const quint8 * p = data.data(0, y);
+                std::vector<quint8> tmp;
+                if (predictor != PREDICTOR_NONE)
+                {
+                    tmp.assign(p, p + rows * rowBytes);
+                    const int samples = data.channels();
+                    const int sampleBytes = Pixel::channelByteCount(data.pixel());
+                    for (int i = 0; i < rows; ++i)
+                    {
+                        quint8 * row = tmp.data() + i * rowBytes;
+                        if (PREDICTOR_FLOATINGPOINT == predictor)
+                        {
+                            floatingPointDifference(row, rowBytes, samples, sampleBytes);
+                        }
+                        else if (2 == sampleBytes)
+                        {
+                            horizontalDifference<quint16>(row, rowBytes / 2, samples);
+                        }
+                        else
+                        {
+                            horizontalDifference<quint8>(row, rowBytes, samples);
+                        }
+                    }
+                    p = tmp.data();
+                }
+                uLongf size = compressBound(rows * rowBytes);
+                out.resize(size);
+                if (compress2(out.data(), &size, p, rows * rowBytes, Z_DEFAULT_COMPRESSION) != Z_OK)
+                    return false;
+                out.resize(size);
+                return true;
+            }
+
+        } // namespace
+
         TIFFSave::TIFFSave(const TIFF::Options & options, const QPointer<Core::CoreContext> & context) :
             ImageSave(context),
             _options(options)
@@ -77,6 +172,7 @@ namespace djv
         {
             //DJV_DEBUG("TIFFSave::write");
             //DJV_DEBUG_PRINT("in = " << in);
+            DJV_TRACE("TIFFSave::write", "ImageIO");
 
             // Open the file.
             const QString fileName = _file.fileName(frame.frame);
@@ -97,13 +193,65 @@ namespace djv
 
             //! Write the file.
             const int h = p->h();
-            for (int y = 0; y < h; ++y)
+            const int strips = (h + _rowsPerStrip - 1) / _rowsPerStrip;
+            if (TIFF::_COMPRESSION_DEFLATE == _options.compression)
             {
-                if (TIFFWriteScanline(_f, (tdata_t *)p->data(0, y), y) == -1)
+                // Compress the strips in parallel and then write them in order.
+                std::vector<std::vector<quint8> > compressed(strips);
+                std::atomic<int> next(0);
+                std::atomic<bool> error(false);
+                const int rowsPerStrip = _rowsPerStrip;
+                const uint16 predictor = _predictor;
+                auto work = [p, h, strips, rowsPerStrip, predictor, &compressed, &next, &error]
                 {
-                    throw Core::Error(
-                        TIFF::staticName,
-                        ImageIO::errorLabels()[ImageIO::ERROR_WRITE]);
+                    int i = next++;
+                    while (i < strips)
+                    {
+                        const int y = i * rowsPerStrip;
+                        if (!deflateStrip(*p, y, std::min(rowsPerStrip, h - y), predictor, compressed[i]))
+                        {
+                            error = true;
+                        }
+                        i = next++;
+                    }
+                };
+                const int threads = Core::Math::clamp(
+                    static_cast<int>(std::thread::hardware_concurrency()),
+                    1,
+                    strips);
+                std::vector<std::thread> workers;
+                for (int i = 1; i < threads; ++i)
+                {
+                    workers.push_back(std::thread(work));
+                }
+                work();
+                for (auto & i : workers)
+                {
+                    i.join();
+                }
+                for (int i = 0; i < strips; ++i)
+                {
+                    if (error ||
+                        TIFFWriteRawStrip(_f, i, compressed[i].data(), compressed[i].size()) == -1)
+                    {
+                        throw Core::Error(
+                            TIFF::staticName,
+                            ImageIO::errorLabels()[ImageIO::ERROR_WRITE]);
+                    }
+                }
+            }
+            else
+            {
+                for (int i = 0; i < strips; ++i)
+                {
+                    const int y = i * _rowsPerStrip;
+                    const int rows = std::min(_rowsPerStrip, h - y);
+                    if (TIFFWriteEncodedStrip(_f, i, (tdata_t)p->data(0, y), rows * p->scanlineByteCount()) == -1)
+                    {
+                        throw Core::Error(
+                            TIFF::staticName,
+                            ImageIO::errorLabels()[ImageIO::ERROR_WRITE]);
+                    }
                 }
             }
 
@@ -197,8 +345,36 @@ namespace djv
             case TIFF::_COMPRESSION_LZW:
                 compression = COMPRESSION_LZW;
                 break;
+            case TIFF::_COMPRESSION_DEFLATE:
+                compression = COMPRESSION_ADOBE_DEFLATE;
+                break;
+            case TIFF::_COMPRESSION_ZSTD:
+                compression = COMPRESSION_ZSTD;
+                break;
             default: break;
             }
+            if (!TIFFIsCODECConfigured(compression))
+            {
+                throw Core::Error(
+                    TIFF::staticName,
+                    ImageIO::errorLabels()[ImageIO::ERROR_UNSUPPORTED]);
+            }
+            _predictor = PREDICTOR_NONE;
+            if (_options.predictor)
+            {
+                switch (_options.compression)
+                {
+                case TIFF::_COMPRESSION_LZW:
+                case TIFF::_COMPRESSION_DEFLATE:
+                case TIFF::_COMPRESSION_ZSTD:
+                    _predictor = SAMPLEFORMAT_IEEEFP == sampleFormat ?
+                        PREDICTOR_FLOATINGPOINT :
+                        PREDICTOR_HORIZONTAL;
+                    break;
+                default: break;
+                }
+            }
+            _rowsPerStrip = Core::Math::clamp(_options.rowsPerStrip, 1, std::max(_image.h(), 1));
             TIFFSetField(_f, TIFFTAG_IMAGEWIDTH, _image.w());
             TIFFSetField(_f, TIFFTAG_IMAGELENGTH, _image.h());
             TIFFSetField(_f, TIFFTAG_PHOTOMETRIC, photometric);
@@ -208,7 +384,12 @@ namespace djv
             TIFFSetField(_f, TIFFTAG_EXTRASAMPLES, extraSamplesSize, extraSamples);
             TIFFSetField(_f, TIFFTAG_ORIENTATION, ORIENTATION_TOPLEFT);
             TIFFSetField(_f, TIFFTAG_COMPRESSION, compression);
+            if (_predictor != PREDICTOR_NONE)
+            {
+                TIFFSetField(_f, TIFFTAG_PREDICTOR, _predictor);
+            }
             TIFFSetField(_f, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
+            TIFFSetField(_f, TIFFTAG_ROWSPERSTRIP, _rowsPerStrip);
 
             // Set image tags.
             const QStringList & tags = ImageTags::tagLabels();
@@ -58,6 +58,8 @@ namespace djv
             ::TIFF *       _f = nullptr;
             PixelDataInfo  _info;
             Image          _image;
+            int            _rowsPerStrip = 0;
+            uint16         _predictor    = 0;
         };
 
     } // namespace Graphics
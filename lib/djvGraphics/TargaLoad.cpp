@@ -33,6 +33,7 @@
 #include <djvGraphics/PixelDataUtil.h>
 
 #include <djvCore/CoreContext.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -51,6 +52,7 @@ namespace djv
             //DJV_DEBUG_PRINT("in = " << in);
             _file = in;
             Core::FileIO io;
+            io.setMmap(false);
             _open(_file.fileName(_file.sequence().start()), info, io);
             if (Core::FileInfo::SEQUENCE == _file.type())
             {
@@ -62,6 +64,7 @@ namespace djv
         {
             //DJV_DEBUG("TargaLoad::read");
             //DJV_DEBUG_PRINT("frame = " << frame);
+            DJV_TRACE("TargaLoad::read", "ImageIO");
 
             image.colorProfile = ColorProfile();
             image.tags = ImageTags();
@@ -124,6 +127,13 @@ namespace djv
             //DJV_DEBUG_PRINT("image = " << image);
         }
 
+        ImageLoad * TargaLoad::clone() const
+        {
+            auto out = new TargaLoad(context());
+            out->_file = _file;
+            return out;
+        }
+
         void TargaLoad::_open(const QString & in, ImageIOInfo & info, Core::FileIO & io)
         {
             //DJV_DEBUG("djvTargaLoad::_open");
@@ -32,6 +32,7 @@
 #include <djvGraphics/OpenGLImage.h>
 
 #include <djvCore/CoreContext.h>
+#include <djvCore/Trace.h>
 
 namespace djv
 {
@@ -72,6 +73,7 @@ namespace djv
         {
             //DJV_DEBUG("TargaSave::write");
             //DJV_DEBUG_PRINT("in = " << in);
+            DJV_TRACE("TargaSave::write", "ImageIO");
 
             // Open the file.
             const QString fileName = _file.fileName(frame.frame);
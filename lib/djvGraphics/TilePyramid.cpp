@@ -0,0 +1,395 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+#include <djvGraphics/TilePyramid.h>
+
+#include <djvCore/Debug.h>
+#include <djvCore/Math.h>
+#include <djvCore/MemoryBudget.h>
+#include <djvCore/Trace.h>
+
+#include <QCoreApplication>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <string.h>
+
+namespace djv
+{
+    namespace Graphics
+    {
+        namespace
+        {
+            std::atomic<quint64> idCounter(0);
+
+            //! Downsample pixel data by half with a box filter. This returns
+            //! false if the operation was cancelled.
+            bool downsample(const PixelData & in, PixelData & out, const std::atomic<bool> & cancel)
+            {
+                const int w = in.w();
+                const int h = in.h();
+                PixelDataInfo info = in.info();
+                info.size = glm::ivec2((w + 1) / 2, (h + 1) / 2);
+                out.set(info);
+                const Pixel::PIXEL pixel = in.pixel();
+                const Pixel::PIXEL floatPixel = Pixel::pixel(Pixel::format(pixel), Pixel::F32);
+                const int channels = Pixel::channels(pixel);
+                std::vector<float> rows[2] =
+                {
+                    std::vector<float>(w * channels),
+                    std::vector<float>(w * channels)
+                };
+                std::vector<float> outRow(out.w() * channels);
+                for (int y = 0; y < out.h(); ++y)
+                {
+                    if (cancel)
+                        return false;
+                    Pixel::convert(in.data(0, y * 2), pixel, rows[0].data(), floatPixel, w);
+                    Pixel::convert(in.data(0, std::min(y * 2 + 1, h - 1)), pixel, rows[1].data(), floatPixel, w);
+                    float * outP = outRow.data();
+                    for (int x = 0; x < out.w(); ++x, outP += channels)
+                    {
+                        const int x0 = x * 2 * channels;
+                        const int x1 = std::min(x * 2 + 1, w - 1) * channels;
+                        for (int c = 0; c < channels; ++c)
+                        {
+                            outP[c] = (rows[0][x0 + c] + rows[0][x1 + c] + rows[1][x0 + c] + rows[1][x1 + c]) * .25f;
+                        }
+                    }
+                    Pixel::convert(outRow.data(), floatPixel, out.data(0, y), pixel, out.w());
+                }
+                return true;
+            }
+
+        } // namespace
+
+        const int TilePyramid::tileSize   = 512;
+        const int TilePyramid::tileBorder = 1;
+        const int TilePyramid::sizeMin    = 4096;
+
+        struct TilePyramid::Private
+        {
+            //! Get a level. The first level is the pixel data or a copy of it.
+            const PixelData & level(int index) const
+            {
+                return index > 0 ? levels[index] : *data;
+            }
+
+            //! Set the memory budget usage. This may be called from the
+            //! background thread, so the budget is not accessed through the
+            //! QPointer.
+            void usageUpdate()
+            {
+                if (budget)
+                {
+                    budget->setUsage(budgetClient, copyByteCount + levelsByteCount);
+                }
+            }
+
+            quint64                 id = 0;
+            PixelDataInfo           info;
+            const PixelData *       data = nullptr;
+            std::unique_ptr<PixelData> copy;
+            std::vector<PixelData>  levels;
+            std::atomic<int>        levelsReady;
+            std::atomic<bool>       building;
+            std::atomic<bool>       cancel;
+            std::thread             thread;
+            QPointer<Core::MemoryBudget> memoryBudget;
+            Core::MemoryBudget *    budget = nullptr;
+            int                     budgetClient = 0;
+            quint64                 copyByteCount = 0;
+            std::atomic<quint64>    levelsByteCount;
+        };
+
+        TilePyramid::TilePyramid(const QPointer<Core::MemoryBudget> & memoryBudget) :
+            _p(new Private)
+        {
+            _p->levelsReady = 0;
+            _p->building = false;
+            _p->cancel = false;
+            _p->levelsByteCount = 0;
+            _p->memoryBudget = memoryBudget;
+            if (memoryBudget)
+            {
+                _p->budget = memoryBudget.data();
+                _p->budgetClient = memoryBudget->addClient(
+                    qApp->translate("djv::Graphics::TilePyramid", "Image tile pyramid"),
+                    Core::MemoryBudget::PRIORITY_LOW,
+                    [this](quint64)
+                {
+                    return releaseLevels();
+                });
+            }
+        }
+
+        TilePyramid::~TilePyramid()
+        {
+            _p->budget = _p->memoryBudget.data();
+            clear();
+            if (_p->memoryBudget)
+            {
+                _p->memoryBudget->removeClient(_p->budgetClient);
+            }
+        }
+
+        bool TilePyramid::isTiled(const PixelDataInfo & info)
+        {
+            return info.size.x > sizeMin || info.size.y > sizeMin;
+        }
+
+        void TilePyramid::build(const PixelData & data)
+        {
+            //DJV_DEBUG("TilePyramid::build");
+            //DJV_DEBUG_PRINT("data = " << data);
+            DJV_TRACE("TilePyramid::build", "Pixel");
+            clear();
+            _p->id = ++idCounter;
+            int levels = 1;
+            for (glm::ivec2 size = data.size();
+                size.x > tileSize || size.y > tileSize;
+                size = glm::ivec2((size.x + 1) / 2, (size.y + 1) / 2))
+            {
+                ++levels;
+            }
+            //DJV_DEBUG_PRINT("levels = " << levels);
+            _p->levels.resize(levels);
+
+            // The first level references the pixel data. It is only copied when
+            // it needs to be converted to the native endian so that the other
+            // levels can be built from it.
+            PixelDataInfo info = data.info();
+            info.endian = Core::Memory::endian();
+            const Pixel::PIXEL pixel = data.pixel();
+            if (data.info().endian != info.endian && Pixel::channelByteCount(pixel) > 1)
+            {
+                _p->copy.reset(new PixelData(info, data.data()));
+                PixelData & level = *_p->copy;
+                const int wordSize =
+                    Pixel::RGB_U10 == pixel ?
+                    Pixel::byteCount(pixel) :
+                    Pixel::channelByteCount(pixel);
+                for (int y = 0; y < level.h(); ++y)
+                {
+                    Core::Memory::convertEndian(
+                        level.data(0, y),
+                        static_cast<quint64>(level.w()) * Pixel::byteCount(pixel) / wordSize,
+                        wordSize);
+                }
+                _p->data = &level;
+                _p->copyByteCount = level.dataByteCount();
+            }
+            else
+            {
+                _p->data = &data;
+            }
+            _p->info = info;
+            _p->levelsReady = 1;
+            _p->usageUpdate();
+        }
+
+        void TilePyramid::buildLevels()
+        {
+            if (_p->building ||
+                _p->levelsReady <= 0 ||
+                _p->levelsReady >= static_cast<int>(_p->levels.size()))
+                return;
+            //DJV_DEBUG("TilePyramid::buildLevels");
+            wait();
+            _p->building = true;
+            Private * p = _p.get();
+            _p->thread = std::thread([p]
+            {
+                for (size_t i = p->levelsReady; i < p->levels.size(); ++i)
+                {
+                    if (!downsample(p->level(static_cast<int>(i) - 1), p->levels[i], p->cancel))
+                        break;
+                    p->levelsByteCount += p->levels[i].dataByteCount();
+                    p->usageUpdate();
+                    ++p->levelsReady;
+                }
+                p->building = false;
+            });
+        }
+
+        void TilePyramid::clear()
+        {
+            releaseLevels();
+            _p->id = 0;
+            _p->info = PixelDataInfo();
+            _p->data = nullptr;
+            _p->copy.reset();
+            _p->levels.clear();
+            _p->levelsReady = 0;
+            _p->copyByteCount = 0;
+            _p->usageUpdate();
+        }
+
+        quint64 TilePyramid::releaseLevels()
+        {
+            //DJV_DEBUG("TilePyramid::releaseLevels");
+            _p->cancel = true;
+            wait();
+            _p->cancel = false;
+            const quint64 out = _p->levelsByteCount;
+            const size_t levels = _p->levels.size();
+            if (levels > 1)
+            {
+                // Resizing the vector frees the memory of the levels. The first
+                // level is not stored in the vector.
+                _p->levels.resize(1);
+                _p->levels.resize(levels);
+                _p->levelsReady = 1;
+            }
+            _p->levelsByteCount = 0;
+            _p->usageUpdate();
+            return out;
+        }
+
+        void TilePyramid::wait()
+        {
+            if (_p->thread.joinable())
+            {
+                _p->thread.join();
+            }
+        }
+
+        quint64 TilePyramid::id() const
+        {
+            return _p->id;
+        }
+
+        const PixelDataInfo & TilePyramid::info() const
+        {
+            return _p->info;
+        }
+
+        int TilePyramid::levelCount() const
+        {
+            return static_cast<int>(_p->levels.size());
+        }
+
+        int TilePyramid::levelsReady() const
+        {
+            return _p->levelsReady;
+        }
+
+        bool TilePyramid::isBuilding() const
+        {
+            return _p->building;
+        }
+
+        glm::ivec2 TilePyramid::levelSize(int level) const
+        {
+            glm::ivec2 out = _p->info.size;
+            for (int i = 0; i < level; ++i)
+            {
+                out = glm::ivec2((out.x + 1) / 2, (out.y + 1) / 2);
+            }
+            return out;
+        }
+
+        glm::ivec2 TilePyramid::tileCount(int level) const
+        {
+            const glm::ivec2 size = levelSize(level);
+            return glm::ivec2(
+                (size.x + tileSize - 1) / tileSize,
+                (size.y + tileSize - 1) / tileSize);
+        }
+
+        Core::Box2i TilePyramid::tileArea(int level, const glm::ivec2 & tile) const
+        {
+            const glm::ivec2 size = levelSize(level);
+            const glm::ivec2 position = tile * tileSize;
+            return Core::Box2i(
+                position,
+                glm::ivec2(
+                    std::min(tileSize, size.x - position.x),
+                    std::min(tileSize, size.y - position.y)));
+        }
+
+        void TilePyramid::tile(int level, const glm::ivec2 & tile, PixelData & out) const
+        {
+            //DJV_DEBUG("TilePyramid::tile");
+            //DJV_DEBUG_PRINT("level = " << level);
+            //DJV_DEBUG_PRINT("tile = " << tile);
+            const PixelData & data = _p->level(level);
+            const Core::Box2i area = tileArea(level, tile);
+            PixelDataInfo info(area.size + tileBorder * 2, data.pixel());
+            info.bgr = data.info().bgr;
+            if (info != out.info())
+            {
+                out.set(info);
+            }
+
+            // Copy the scanlines, clamping the border to the edges of the level.
+            const int w = data.w();
+            const int h = data.h();
+            const quint64 pixelByteCount = data.pixelByteCount();
+            const int x0 = area.x - tileBorder;
+            const int x1 = area.x + area.w + tileBorder;
+            const int inX0 = std::max(x0, 0);
+            const int inX1 = std::min(x1, w);
+            for (int y = 0; y < info.size.y; ++y)
+            {
+                const quint8 * inP = data.data(0, Core::Math::clamp(area.y - tileBorder + y, 0, h - 1));
+                quint8 * outP = out.data(0, y);
+                for (int x = x0; x < inX0; ++x, outP += pixelByteCount)
+                {
+                    memcpy(outP, inP, pixelByteCount);
+                }
+                memcpy(outP, inP + inX0 * pixelByteCount, (inX1 - inX0) * pixelByteCount);
+                outP += (inX1 - inX0) * pixelByteCount;
+                for (int x = inX1; x < x1; ++x, outP += pixelByteCount)
+                {
+                    memcpy(outP, inP + (w - 1) * pixelByteCount, pixelByteCount);
+                }
+            }
+        }
+
+        int TilePyramid::level(float scale) const
+        {
+            int out = 0;
+            for (; out < levelCount() - 1 && scale <= .5f; ++out)
+            {
+                scale *= 2.f;
+            }
+            return out;
+        }
+
+        bool TilePyramid::hasLevel(float scale) const
+        {
+            const int levelsReady = _p->levelsReady;
+            return levelsReady > 0 && level(scale) - (levelsReady - 1) <= 1;
+        }
+
+    } // namespace Graphics
+} // namespace djv
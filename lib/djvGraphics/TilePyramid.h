@@ -0,0 +1,140 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+#pragma once
+
+#include <djvGraphics/PixelData.h>
+
+#include <djvCore/Box.h>
+#include <djvCore/Util.h>
+
+#include <QPointer>
+
+#include <memory>
+
+namespace djv
+{
+    namespace Core
+    {
+        class MemoryBudget;
+
+    } // namespace Core
+
+    namespace Graphics
+    {
+        //! This class provides a tiled mipmap pyramid of pixel data for drawing
+        //! very large images.
+        //!
+        //! The first level references the pixel data and each following level
+        //! is half the size of the previous one, down to a single tile. The
+        //! following levels are built in a background thread when requested
+        //! and are charged to the memory budget, which may release them. Tiles
+        //! are copied out of the levels as they are needed.
+        class TilePyramid
+        {
+        public:
+            explicit TilePyramid(const QPointer<Core::MemoryBudget> & = QPointer<Core::MemoryBudget>());
+            ~TilePyramid();
+
+            //! The size of the tiles.
+            static const int tileSize;
+
+            //! The number of pixels around each tile that are copied from the
+            //! neighboring tiles, so that tiles can be filtered without seams.
+            static const int tileBorder;
+
+            //! The size above which pixel data should be drawn with tiles.
+            static const int sizeMin;
+
+            //! Get whether pixel data should be drawn with tiles.
+            static bool isTiled(const PixelDataInfo &);
+
+            //! Build the first level of the pyramid. The pixel data is referenced
+            //! and must stay valid until the pyramid is cleared or built again,
+            //! unless it is not in the native endian in which case it is copied.
+            void build(const PixelData &);
+
+            //! Build the remaining levels in the background. This does nothing if
+            //! they are already built or being built.
+            void buildLevels();
+
+            //! Clear the pyramid.
+            void clear();
+
+            //! Release the levels after the first one.
+            quint64 releaseLevels();
+
+            //! Wait for the background thread to finish building the levels.
+            void wait();
+
+            //! Get the unique ID of the current build.
+            quint64 id() const;
+
+            //! Get the pixel data information of the first level.
+            const PixelDataInfo & info() const;
+
+            //! Get the number of levels.
+            int levelCount() const;
+
+            //! Get the number of levels that have been built.
+            int levelsReady() const;
+
+            //! Get whether levels are being built in the background.
+            bool isBuilding() const;
+
+            //! Get the size of a level.
+            glm::ivec2 levelSize(int level) const;
+
+            //! Get the number of tiles in a level.
+            glm::ivec2 tileCount(int level) const;
+
+            //! Get the area of a tile in level pixels, not including the border.
+            Core::Box2i tileArea(int level, const glm::ivec2 & tile) const;
+
+            //! Copy a tile, including the border. The level must have been built,
+            //! see levelsReady().
+            void tile(int level, const glm::ivec2 & tile, PixelData &) const;
+
+            //! Get the level that best matches the given scale.
+            int level(float scale) const;
+
+            //! Get whether a level has been built that is close enough to the
+            //! given scale to be drawn with tiles. When only levels that are
+            //! much larger than the scale are available, drawing the pixel data
+            //! directly uploads less than drawing the tiles.
+            bool hasLevel(float scale) const;
+
+        private:
+            DJV_PRIVATE_COPY(TilePyramid);
+
+            struct Private;
+            std::unique_ptr<Private> _p;
+        };
+
+    } // namespace Graphics
+} // namespace djv
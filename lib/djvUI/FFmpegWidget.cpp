@@ -30,6 +30,7 @@
 #include <djvUI/FFmpegWidget.h>
 
 #include <djvUI/UIContext.h>
+#include <djvUI/IntEdit.h>
 #include <djvUI/PrefsGroupBox.h>
 
 #include <djvGraphics/ImageIO.h>
@@ -59,6 +60,10 @@ namespace djv
             _qualityWidget->addItems(Graphics::FFmpeg::qualityLabels());
             _qualityWidget->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
 
+            _threadsWidget = new IntEdit;
+            _threadsWidget->setRange(0, 256);
+            _threadsWidget->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+
             // Layout the widgets.
             QVBoxLayout * layout = new QVBoxLayout(this);
 
@@ -73,6 +78,9 @@ namespace djv
             formLayout->addRow(
                 qApp->translate("djv::UI::FFmpegWidget", "Quality:"),
                 _qualityWidget);
+            formLayout->addRow(
+                qApp->translate("djv::UI::FFmpegWidget", "Threads:"),
+                _threadsWidget);
             layout->addWidget(prefsGroupBox);
 
             layout->addStretch();
@@ -93,6 +101,10 @@ namespace djv
                 _qualityWidget,
                 SIGNAL(activated(int)),
                 SLOT(qualityCallback(int)));
+            connect(
+                _threadsWidget,
+                SIGNAL(valueChanged(int)),
+                SLOT(threadsCallback(int)));
         }
 
         FFmpegWidget::~FFmpegWidget()
@@ -118,6 +130,9 @@ namespace djv
                 else if (0 == option.compare(plugin()->options()[
                     Graphics::FFmpeg::OPTIONS_QUALITY], Qt::CaseInsensitive))
                     tmp >> _options.quality;
+                else if (0 == option.compare(plugin()->options()[
+                    Graphics::FFmpeg::OPTIONS_THREADS], Qt::CaseInsensitive))
+                    tmp >> _options.threads;
             }
             catch (const QString &)
             {
@@ -137,6 +152,12 @@ namespace djv
             pluginUpdate();
         }
 
+        void FFmpegWidget::threadsCallback(int in)
+        {
+            _options.threads = in;
+            pluginUpdate();
+        }
+
         void FFmpegWidget::pluginUpdate()
         {
             QStringList tmp;
@@ -144,13 +165,16 @@ namespace djv
             plugin()->setOption(plugin()->options()[Graphics::FFmpeg::OPTIONS_FORMAT], tmp);
             tmp << _options.quality;
             plugin()->setOption(plugin()->options()[Graphics::FFmpeg::OPTIONS_QUALITY], tmp);
+            tmp << _options.threads;
+            plugin()->setOption(plugin()->options()[Graphics::FFmpeg::OPTIONS_THREADS], tmp);
         }
 
         void FFmpegWidget::widgetUpdate()
         {
             Core::SignalBlocker signalBlocker(QObjectList() <<
                 _formatWidget <<
-                _qualityWidget);
+                _qualityWidget <<
+                _threadsWidget);
             try
             {
                 QStringList tmp;
@@ -158,12 +182,15 @@ namespace djv
                 tmp >> _options.format;
                 tmp = plugin()->option(plugin()->options()[Graphics::FFmpeg::OPTIONS_QUALITY]);
                 tmp >> _options.quality;
+                tmp = plugin()->option(plugin()->options()[Graphics::FFmpeg::OPTIONS_THREADS]);
+                tmp >> _options.threads;
             }
             catch (QString)
             {
             }
             _formatWidget->setCurrentIndex(_options.format);
             _qualityWidget->setCurrentIndex(_options.quality);
+            _threadsWidget->setValue(_options.threads);
         }
 
         FFmpegWidgetPlugin::FFmpegWidgetPlugin(const QPointer<Core::CoreContext> & context) :
@@ -39,6 +39,8 @@ namespace djv
 {
     namespace UI
     {
+        class IntEdit;
+
         //! This class provides a FFmpeg widget.
         class FFmpegWidget : public ImageIOWidget
         {
@@ -55,6 +57,7 @@ namespace djv
             void pluginCallback(const QString &);
             void formatCallback(int);
             void qualityCallback(int);
+            void threadsCallback(int);
 
             void pluginUpdate();
             void widgetUpdate();
@@ -63,6 +66,7 @@ namespace djv
             Graphics::FFmpeg::Options _options;
             QComboBox * _formatWidget = nullptr;
             QComboBox * _qualityWidget = nullptr;
+            IntEdit * _threadsWidget = nullptr;
         };
 
         //! This class provides a FFmpeg widget plugin.
@@ -32,6 +32,9 @@
 #include <djvUI/FileBrowserPrefs.h>
 
 #include <djvCore/Memory.h>
+#include <djvCore/MemoryBudget.h>
+
+#include <QCoreApplication>
 
 namespace djv
 {
@@ -51,5 +54,79 @@ namespace djv
             thumbnail(thumbnail)
         {}
 
+        struct FileBrowserCache::Private
+        {
+            QPointer<Core::MemoryBudget> memoryBudget;
+            int budgetClient = 0;
+        };
+
+        FileBrowserCache::FileBrowserCache(const QPointer<Core::MemoryBudget> & memoryBudget) :
+            _p(new Private)
+        {
+            _p->memoryBudget = memoryBudget;
+            _p->budgetClient = memoryBudget->addClient(
+                qApp->translate("djv::UI::FileBrowserCache", "File browser thumbnails"),
+                Core::MemoryBudget::PRIORITY_LOW,
+                [this](quint64 bytes)
+            {
+                return release(bytes);
+            });
+        }
+
+        FileBrowserCache::~FileBrowserCache()
+        {
+            if (_p->memoryBudget)
+            {
+                _p->memoryBudget->removeClient(_p->budgetClient);
+            }
+        }
+
+        bool FileBrowserCache::insert(const Core::FileInfo & fileInfo, FileBrowserCacheItem * item, int cost)
+        {
+            const bool out = QCache<Core::FileInfo, FileBrowserCacheItem>::insert(fileInfo, item, cost);
+            usageUpdate();
+            return out;
+        }
+
+        bool FileBrowserCache::remove(const Core::FileInfo & fileInfo)
+        {
+            const bool out = QCache<Core::FileInfo, FileBrowserCacheItem>::remove(fileInfo);
+            usageUpdate();
+            return out;
+        }
+
+        void FileBrowserCache::clear()
+        {
+            QCache<Core::FileInfo, FileBrowserCacheItem>::clear();
+            usageUpdate();
+        }
+
+        void FileBrowserCache::setMaxCost(int cost)
+        {
+            QCache<Core::FileInfo, FileBrowserCacheItem>::setMaxCost(cost);
+            usageUpdate();
+        }
+
+        quint64 FileBrowserCache::release(quint64 bytes)
+        {
+            // Temporarily lowering the maximum cost trims the least recently
+            // used items.
+            const int total = totalCost();
+            const int maxCost = this->maxCost();
+            QCache<Core::FileInfo, FileBrowserCacheItem>::setMaxCost(
+                bytes < static_cast<quint64>(total) ? total - static_cast<int>(bytes) : 0);
+            QCache<Core::FileInfo, FileBrowserCacheItem>::setMaxCost(maxCost);
+            usageUpdate();
+            return static_cast<quint64>(total - totalCost());
+        }
+
+        void FileBrowserCache::usageUpdate()
+        {
+            if (_p->memoryBudget)
+            {
+                _p->memoryBudget->setUsage(_p->budgetClient, static_cast<quint64>(totalCost()));
+            }
+        }
+
     } // namespace UI
 } // namespace djv
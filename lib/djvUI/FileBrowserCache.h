@@ -34,12 +34,22 @@
 #include <djvGraphics/ImageIO.h>
 
 #include <djvCore/FileInfo.h>
+#include <djvCore/Util.h>
 
 #include <QCache>
 #include <QPixmap>
+#include <QPointer>
+
+#include <memory>
 
 namespace djv
 {
+    namespace Core
+    {
+        class MemoryBudget;
+
+    } // namespace Core
+
     namespace UI
     {
         //! This struct provides a file browser thumbnail cache item.
@@ -58,9 +68,32 @@ namespace djv
             QPixmap                        thumbnail;
         };
 
-        //! This class provides a file browser thumbnail cache.
+        //! This class provides a file browser thumbnail cache. The cost of an
+        //! item is the size of the thumbnail in bytes, and the total cost is
+        //! reported to the memory budget.
         class FileBrowserCache : public QCache<Core::FileInfo, FileBrowserCacheItem>
-        {};
+        {
+        public:
+            explicit FileBrowserCache(const QPointer<Core::MemoryBudget> &);
+            ~FileBrowserCache();
+
+            bool insert(const Core::FileInfo &, FileBrowserCacheItem *, int cost);
+            bool remove(const Core::FileInfo &);
+            void clear();
+            void setMaxCost(int);
+
+            //! Remove the least recently used items until the given number of
+            //! bytes have been released. Returns the number of bytes released.
+            quint64 release(quint64 bytes);
+
+        private:
+            void usageUpdate();
+
+            DJV_PRIVATE_COPY(FileBrowserCache);
+
+            struct Private;
+            std::unique_ptr<Private> _p;
+        };
 
     } // namespace UI
 } // namespace djv
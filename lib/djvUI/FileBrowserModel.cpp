@@ -30,6 +30,7 @@
 #include <djvUI/FileBrowserModel.h>
 
 #include <djvUI/UIContext.h>
+#include <djvUI/FileBrowserCache.h>
 #include <djvUI/FileBrowserModelPrivate.h>
 #include <djvUI/FileBrowserThumbnailSystem.h>
 #include <djvUI/SequencePrefs.h>
@@ -40,6 +41,7 @@
 #include <djvCore/Error.h>
 #include <djvCore/ErrorUtil.h>
 #include <djvCore/FileInfoUtil.h>
+#include <djvCore/FileWatcher.h>
 #include <djvCore/Memory.h>
 #include <djvCore/User.h>
 #include <djvCore/VectorUtil.h>
@@ -47,17 +49,45 @@
 #include <QApplication>
 #include <QMimeData>
 #include <QStyle>
+#include <QTimer>
+
+#include <algorithm>
 
 namespace djv
 {
     namespace UI
     {
+        namespace
+        {
+            //! The maximum number of rows inserted each time the completion
+            //! queue is drained.
+            const int insertChunk = 1000;
+
+            //! The completion queue polling timeout.
+            const int timeout = 10;
+
+        } // namespace
+
         struct FileBrowserModel::Private
         {
             Private(const QPointer<UIContext> & context) :
-                context(context)
+                context(context),
+                queue(new FileBrowserCompletionQueue),
+                listThread(new FileBrowserListThread(queue))
             {}
 
+            //! Get the filtered and sorted item indices.
+            QVector<int> sortedRows() const;
+
+            //! Update the mapping from items to rows.
+            void updateItemRows();
+
+            //! Request the image information and thumbnail for an item.
+            void requestImage(int index);
+
+            //! Find the item that contains a file, or -1 if there is none.
+            int findItem(const Core::FileInfo &) const;
+
             QString path;
             Core::Sequence::FORMAT sequence = Core::Sequence::FORMAT_RANGE;
             QString filterText;
@@ -67,12 +97,150 @@ namespace djv
             bool sortDirsFirst = true;
             FileBrowserModel::THUMBNAIL_MODE thumbnailMode = FileBrowserModel::THUMBNAIL_MODE_HIGH;
             FileBrowserModel::THUMBNAIL_SIZE thumbnailSize = FileBrowserModel::THUMBNAIL_MEDIUM;
-            Core::FileInfoList list;
-            Core::FileInfoList listTmp;
-            mutable QVector<FileBrowserItem *> items;
             QPointer<UIContext> context;
+            std::shared_ptr<FileBrowserCompletionQueue> queue;
+            std::unique_ptr<FileBrowserListThread> listThread;
+            quint64 listGeneration = 0;
+            bool listPending = false;
+            quint64 requestGeneration = 0;
+
+            // The number of image information and thumbnail requests that have
+            // not completed. Directory listings are tracked by listPending
+            // since superseded requests are dropped by the list thread.
+            int outstanding = 0;
+            QTimer * timer = nullptr;
+            FileBrowserItems items;
+            QVector<int> rows;
+            QVector<int> itemRows;
+            QVector<int> pendingRows;
+            int pendingRowsPos = 0;
+            QPointer<Core::FileWatcher> fileWatcher;
         };
 
+        QVector<int> FileBrowserModel::Private::sortedRows() const
+        {
+            QVector<int> out;
+            out.reserve(items.count());
+            for (int i = 0; i < items.count(); ++i)
+            {
+                if (!(items.state[i] & FileBrowserItems::REMOVED))
+                {
+                    out.append(i);
+                }
+            }
+
+            // Filter directory contents.
+            if (filterText.length() > 0 || !showHidden)
+            {
+                const Core::FileInfoUtil::FILTER filter =
+                    !showHidden ?
+                    Core::FileInfoUtil::FILTER_HIDDEN :
+                    Core::FileInfoUtil::FILTER_NONE;
+                Core::FileInfoUtil::filter(items.fileInfo, out, filter, filterText);
+            }
+
+            // Sort directory contents.
+            Core::FileInfoUtil::SORT sort = static_cast<Core::FileInfoUtil::SORT>(0);
+            switch (columnsSort)
+            {
+            case NAME:        sort = Core::FileInfoUtil::SORT_NAME; break;
+            case SIZE:        sort = Core::FileInfoUtil::SORT_SIZE; break;
+#if ! defined(DJV_WINDOWS)
+            case USER:        sort = Core::FileInfoUtil::SORT_USER; break;
+#endif
+            case PERMISSIONS: sort = Core::FileInfoUtil::SORT_PERMISSIONS; break;
+            case TIME:        sort = Core::FileInfoUtil::SORT_TIME; break;
+            default: break;
+            }
+            Core::FileInfoUtil::sort(items.fileInfo, out, sort, reverseSort);
+            if (sortDirsFirst)
+            {
+                Core::FileInfoUtil::sortDirsFirst(items.fileInfo, out);
+            }
+            return out;
+        }
+
+        void FileBrowserModel::Private::updateItemRows()
+        {
+            itemRows = QVector<int>(items.count(), -1);
+            for (int i = 0; i < rows.count(); ++i)
+            {
+                itemRows[rows[i]] = i;
+            }
+        }
+
+        int FileBrowserModel::Private::findItem(const Core::FileInfo & fileInfo) const
+        {
+            const QString name = fileInfo.fileName(-1, false);
+            const qint64 frame = fileInfo.isSequenceValid() ? fileInfo.sequence().frames[0] : 0;
+            for (int i = 0; i < items.count(); ++i)
+            {
+                if (items.state[i] & FileBrowserItems::REMOVED)
+                    continue;
+                const Core::FileInfo & item = items.fileInfo[i];
+                if (item.fileName(-1, false) == name)
+                    return i;
+                if (Core::FileInfo::SEQUENCE == item.type() &&
+                    fileInfo.isSequenceValid() &&
+                    item.base() == fileInfo.base() &&
+                    item.extension() == fileInfo.extension() &&
+                    item.sequence().frames.contains(frame))
+                    return i;
+            }
+            return -1;
+        }
+
+        void FileBrowserModel::Private::requestImage(int index)
+        {
+            quint8 & state = items.state[index];
+            if (!(state & FileBrowserItems::INFO_REQUESTED))
+            {
+                // Check the cache to see if this item already exists.
+                if (items.setFromCache(index, context->fileBrowserCache()))
+                    return;
+                state |= FileBrowserItems::INFO_REQUESTED;
+                auto queue = this->queue;
+                const quint64 generation = requestGeneration;
+                context->fileBrowserThumbnailSystem()->getInfo(
+                    items.fileInfo[index],
+                    [queue, generation, index](const Graphics::ImageIOInfo & info)
+                {
+                    FileBrowserCompletion completion;
+                    completion.type = FileBrowserCompletion::INFO;
+                    completion.generation = generation;
+                    completion.index = index;
+                    completion.imageInfo = info;
+                    queue->push(std::move(completion));
+                });
+                ++outstanding;
+                timer->start();
+            }
+            if ((state & FileBrowserItems::INFO_DONE) &&
+                !(state & FileBrowserItems::THUMBNAIL_REQUESTED) &&
+                Core::VectorUtil::isSizeValid(items.thumbnailResolution[index]))
+            {
+                state |= FileBrowserItems::THUMBNAIL_REQUESTED;
+                auto queue = this->queue;
+                const quint64 generation = requestGeneration;
+                context->fileBrowserThumbnailSystem()->getPixmap(
+                    items.fileInfo[index],
+                    thumbnailMode,
+                    items.thumbnailResolution[index],
+                    items.thumbnailProxy[index],
+                    [queue, generation, index](const QPixmap & pixmap)
+                {
+                    FileBrowserCompletion completion;
+                    completion.type = FileBrowserCompletion::THUMBNAIL;
+                    completion.generation = generation;
+                    completion.index = index;
+                    completion.thumbnail = pixmap;
+                    queue->push(std::move(completion));
+                });
+                ++outstanding;
+                timer->start();
+            }
+        }
+
         const QStringList & FileBrowserModel::columnsLabels()
         {
             static const QStringList data = QStringList() <<
@@ -92,8 +260,32 @@ namespace djv
             _p(new Private(context))
         {
             //DJV_DEBUG("FileBrowserModel::FileBrowserModel");
-            //dirUpdate();
-            //modelUpdate();
+            _p->timer = new QTimer(this);
+            _p->timer->setInterval(timeout);
+            connect(
+                _p->timer,
+                SIGNAL(timeout()),
+                SLOT(completionCallback()));
+            _p->fileWatcher = new Core::FileWatcher(this);
+            connect(
+                _p->fileWatcher,
+                SIGNAL(fileCreated(const QString &)),
+                SLOT(fileCreatedCallback(const QString &)));
+            connect(
+                _p->fileWatcher,
+                SIGNAL(fileModified(const QString &)),
+                SLOT(fileModifiedCallback(const QString &)));
+            connect(
+                _p->fileWatcher,
+                SIGNAL(fileRemoved(const QString &)),
+                SLOT(fileRemovedCallback(const QString &)));
+            if (!Core::FileWatcher::hasFileEvents())
+            {
+                connect(
+                    _p->fileWatcher,
+                    SIGNAL(directoryChanged(const QString &)),
+                    SLOT(directoryChangedCallback()));
+            }
             connect(
                 context->sequencePrefs(),
                 SIGNAL(prefChanged()),
@@ -101,35 +293,38 @@ namespace djv
         }
         
         FileBrowserModel::~FileBrowserModel()
-        {
-            for (int i = 0; i < _p->items.count(); ++i)
-            {
-                delete _p->items[i];
-                _p->items[i] = 0;
-            }
-            _p->items.clear();
-        }
+        {}
 
         const QString & FileBrowserModel::path() const
         {
             return _p->path;
         }
 
-        const Core::FileInfoList & FileBrowserModel::contents() const
+        bool FileBrowserModel::isBusy() const
+        {
+            return _p->timer->isActive();
+        }
+
+        Core::FileInfoList FileBrowserModel::contents() const
         {
-            return _p->listTmp;
+            Core::FileInfoList out;
+            out.reserve(_p->rows.count());
+            Q_FOREACH(int i, _p->rows)
+            {
+                out.append(_p->items.fileInfo[i]);
+            }
+            return out;
         }
 
         Core::FileInfo FileBrowserModel::fileInfo(const QModelIndex & index) const
         {
             //DJV_DEBUG("FileBrowserModel::fileInfo");
             //DJV_DEBUG_PRINT("index = " << index.isValid());
-            Core::FileInfo * fileInfo = 0;
-            if (index.isValid())
+            if (index.isValid() && index.row() < _p->rows.count())
             {
-                fileInfo = (Core::FileInfo *)index.internalPointer();
+                return _p->items.fileInfo[_p->rows[index.row()]];
             }
-            return fileInfo ? *fileInfo : Core::FileInfo();
+            return Core::FileInfo();
         }
 
         Core::Sequence::FORMAT FileBrowserModel::sequence() const
@@ -209,7 +404,7 @@ namespace djv
         {
             if (!hasIndex(row, column, parent))
                 return QModelIndex();
-            return createIndex(row, column, &_p->listTmp[row]);
+            return createIndex(row, column);
         }
 
         QModelIndex	FileBrowserModel::parent(const QModelIndex & index) const
@@ -244,12 +439,12 @@ namespace djv
 
             const int row = index.row();
             const int column = index.column();
-            if (row < 0 || row >= _p->items.count() ||
+            if (row < 0 || row >= _p->rows.count() ||
                 column < 0 || column >= COLUMNS_COUNT)
                 return QVariant();
 
-            FileBrowserItem * item = _p->items[row];
-            const Core::FileInfo & fileInfo = item->fileInfo();
+            const int item = _p->rows[row];
+            const Core::FileInfo & fileInfo = _p->items.fileInfo[item];
             static const QVector<QPixmap> pixmaps = QVector<QPixmap>() <<
                 QPixmap(Core::FileInfo::typeIcons()[Core::FileInfo::FILE]) <<
                 QPixmap(Core::FileInfo::typeIcons()[Core::FileInfo::SEQUENCE]) <<
@@ -262,20 +457,20 @@ namespace djv
                 case NAME:
                     if (_p->thumbnailMode != THUMBNAIL_MODE_OFF)
                     {
-                        item->requestImage();
-                        return item->thumbnail();
+                        _p->requestImage(item);
+                        return _p->items.thumbnail[item];
                     }
                     return pixmaps[fileInfo.type()];
                 default: break;
                 }
                 break;
-            case Qt::DisplayRole: return item->displayRole(column);
-            case Qt::EditRole:    return item->editRole(column);
+            case Qt::DisplayRole: return _p->items.displayRole(item, column);
+            case Qt::EditRole:    return _p->items.editRole(item, column);
             case Qt::SizeHintRole:
-                if (NAME == column && !item->thumbnail().isNull())
+                if (NAME == column && !_p->items.thumbnail[item].isNull())
                 {
                     const int margin = qApp->style()->pixelMetric(QStyle::PM_ButtonMargin);
-                    return QSize(0, item->thumbnail().height() + margin * 2);
+                    return QSize(0, _p->items.thumbnail[item].height() + margin * 2);
                 }
                 break;
             default: break;
@@ -294,7 +489,7 @@ namespace djv
 
         int FileBrowserModel::rowCount(const QModelIndex & parent) const
         {
-            return parent.isValid() ? 0 : _p->listTmp.count();
+            return parent.isValid() ? 0 : _p->rows.count();
         }
 
         int FileBrowserModel::columnCount(const QModelIndex & parent) const
@@ -329,14 +524,12 @@ namespace djv
                 return;
             _p->path = path;
             dirUpdate();
-            modelUpdate();
             Q_EMIT pathChanged(_p->path);
         }
 
         void FileBrowserModel::reload()
         {
             dirUpdate();
-            modelUpdate();
         }
 
         void FileBrowserModel::setSequence(Core::Sequence::FORMAT in)
@@ -345,7 +538,6 @@ namespace djv
                 return;
             _p->sequence = in;
             dirUpdate();
-            modelUpdate();
             Q_EMIT sequenceChanged(_p->sequence);
             Q_EMIT optionChanged();
         }
@@ -375,7 +567,7 @@ namespace djv
             if (value == _p->columnsSort)
                 return;
             _p->columnsSort = value;
-            modelUpdate();
+            sortUpdate();
             Q_EMIT columnsSortChanged(_p->columnsSort);
             Q_EMIT optionChanged();
         }
@@ -385,7 +577,7 @@ namespace djv
             if (value == _p->reverseSort)
                 return;
             _p->reverseSort = value;
-            modelUpdate();
+            sortUpdate();
             Q_EMIT reverseSortChanged(_p->reverseSort);
             Q_EMIT optionChanged();
         }
@@ -395,7 +587,7 @@ namespace djv
             if (value == _p->sortDirsFirst)
                 return;
             _p->sortDirsFirst = value;
-            modelUpdate();
+            sortUpdate();
             Q_EMIT sortDirsFirstChanged(_p->sortDirsFirst);
             Q_EMIT optionChanged();
         }
@@ -405,7 +597,7 @@ namespace djv
             if (value == _p->thumbnailMode)
                 return;
             _p->thumbnailMode = value;
-            modelUpdate();
+            thumbnailUpdate();
             Q_EMIT thumbnailModeChanged(_p->thumbnailMode);
             Q_EMIT optionChanged();
         }
@@ -415,55 +607,270 @@ namespace djv
             if (size == _p->thumbnailSize)
                 return;
             _p->thumbnailSize = size;
-            modelUpdate();
+            thumbnailUpdate();
             Q_EMIT thumbnailSizeChanged(_p->thumbnailSize);
             Q_EMIT optionChanged();
         }
 
-        void FileBrowserModel::imageInfoCallback()
+        void FileBrowserModel::completionCallback()
         {
-            //DJV_DEBUG("FileBrowserModel::imageInfoCallback");
-            const int row = _p->items.indexOf(qobject_cast<FileBrowserItem *>(sender()));
-            if (row != -1)
+            //DJV_DEBUG("FileBrowserModel::completionCallback");
+            for (auto & completion : _p->queue->take())
             {
-                const QModelIndex index = this->index(row, 0);
-                Q_EMIT dataChanged(index, index);
+                if (completion.type != FileBrowserCompletion::LIST)
+                {
+                    --_p->outstanding;
+                }
+                switch (completion.type)
+                {
+                case FileBrowserCompletion::LIST:
+                    if (completion.generation == _p->listGeneration)
+                    {
+                        //DJV_DEBUG_PRINT("list = " << completion.list.count());
+                        _p->listPending = false;
+                        _p->fileWatcher->clear();
+                        _p->fileWatcher->addDirectory(_p->path);
+                        beginResetModel();
+                        ++_p->requestGeneration;
+                        _p->items.reset(completion.list);
+                        _p->rows.clear();
+                        _p->updateItemRows();
+                        _p->pendingRows = _p->sortedRows();
+                        _p->pendingRowsPos = 0;
+                        endResetModel();
+                    }
+                    break;
+                case FileBrowserCompletion::INFO:
+                    if (completion.generation == _p->requestGeneration)
+                    {
+                        _p->items.setImageInfo(
+                            completion.index,
+                            completion.imageInfo,
+                            _p->thumbnailMode,
+                            _p->thumbnailSize);
+                        const int row = _p->itemRows[completion.index];
+                        if (row != -1)
+                        {
+                            const QModelIndex index = this->index(row, 0);
+                            Q_EMIT dataChanged(index, index);
+                        }
+                    }
+                    break;
+                case FileBrowserCompletion::THUMBNAIL:
+                    if (completion.generation == _p->requestGeneration)
+                    {
+                        const int i = completion.index;
+                        _p->items.thumbnail[i] = completion.thumbnail;
+                        _p->items.state[i] |= FileBrowserItems::THUMBNAIL_DONE;
+                        _p->context->fileBrowserCache()->insert(
+                            _p->items.fileInfo[i],
+                            new FileBrowserCacheItem(
+                                _p->items.imageInfo[i],
+                                _p->items.thumbnailResolution[i],
+                                _p->items.thumbnailProxy[i],
+                                completion.thumbnail),
+                            completion.thumbnail.width() * completion.thumbnail.height() * 4);
+                        const int row = _p->itemRows[i];
+                        if (row != -1)
+                        {
+                            const QModelIndex index = this->index(row, 0);
+                            Q_EMIT dataChanged(index, index);
+                        }
+                    }
+                    break;
+                default: break;
+                }
+            }
+
+            // Insert the next chunk of rows.
+            const int pending = _p->pendingRows.count() - _p->pendingRowsPos;
+            if (pending > 0)
+            {
+                const int count = std::min(pending, insertChunk);
+                const int row = _p->rows.count();
+                beginInsertRows(QModelIndex(), row, row + count - 1);
+                for (int i = 0; i < count; ++i)
+                {
+                    const int item = _p->pendingRows[_p->pendingRowsPos + i];
+                    _p->itemRows[item] = _p->rows.count();
+                    _p->rows.append(item);
+                }
+                _p->pendingRowsPos += count;
+                endInsertRows();
+            }
+            if (_p->pendingRowsPos >= _p->pendingRows.count())
+            {
+                _p->pendingRows.clear();
+                _p->pendingRowsPos = 0;
+            }
+
+            if (!_p->listPending && _p->outstanding <= 0 && _p->pendingRows.isEmpty())
+            {
+                _p->timer->stop();
             }
         }
 
-        void FileBrowserModel::thumbnailCallback()
+        void FileBrowserModel::sequencePrefsCallback()
         {
-            //DJV_DEBUG("FileBrowserModel::thumbnailCallback");
-            const int row = _p->items.indexOf(qobject_cast<FileBrowserItem *>(sender()));
-            if (row != -1)
+            dirUpdate();
+        }
+
+        void FileBrowserModel::fileCreatedCallback(const QString & fileName)
+        {
+            //DJV_DEBUG("FileBrowserModel::fileCreatedCallback");
+            //DJV_DEBUG_PRINT("fileName = " << fileName);
+
+            // Changes made while the directory is being listed are picked up
+            // by the listing.
+            if (_p->listPending)
+                return;
+            const Core::FileInfo fileInfo(fileName);
+            if (!fileInfo.exists())
+                return;
+            if (_p->findItem(fileInfo) != -1)
+            {
+                fileModifiedCallback(fileName);
+                return;
+            }
+
+            // Add the file to an existing sequence.
+            if (_p->sequence != Core::Sequence::FORMAT_OFF && fileInfo.isSequenceValid())
+            {
+                for (int i = 0; i < _p->items.count(); ++i)
+                {
+                    if (_p->items.state[i] & FileBrowserItems::REMOVED)
+                        continue;
+                    Core::FileInfo tmp = _p->items.fileInfo[i];
+                    if (tmp.addSequence(fileInfo))
+                    {
+                        Core::Sequence sequence = tmp.sequence();
+                        sequence.sort();
+                        if (Core::Sequence::FORMAT_RANGE == _p->sequence)
+                        {
+                            sequence.setFrames(sequence.start(), sequence.end());
+                        }
+                        tmp.setSequence(sequence);
+                        _p->context->fileBrowserCache()->remove(_p->items.fileInfo[i]);
+                        _p->items.fileInfo[i] = tmp;
+                        itemUpdate(i);
+                        return;
+                    }
+                }
+            }
+
+            // Add a new item.
+            const int index = _p->items.append(fileInfo);
+            _p->itemRows.append(-1);
+            if (_p->pendingRows.count())
+            {
+                modelUpdate();
+                return;
+            }
+            const QVector<int> rows = _p->sortedRows();
+            const int row = rows.indexOf(index);
+            if (-1 == row)
+                return;
+            QVector<int> tmp = rows;
+            tmp.remove(row);
+            if (tmp != _p->rows)
             {
-                const QModelIndex index = this->index(row, 0);
-                Q_EMIT dataChanged(index, index);
+                modelUpdate();
+                return;
             }
+            beginInsertRows(QModelIndex(), row, row);
+            _p->rows = rows;
+            _p->updateItemRows();
+            endInsertRows();
         }
 
-        void FileBrowserModel::sequencePrefsCallback()
+        void FileBrowserModel::fileModifiedCallback(const QString & fileName)
+        {
+            //DJV_DEBUG("FileBrowserModel::fileModifiedCallback");
+            //DJV_DEBUG_PRINT("fileName = " << fileName);
+            if (_p->listPending)
+                return;
+            const Core::FileInfo fileInfo(fileName);
+            const int index = _p->findItem(fileInfo);
+            if (-1 == index)
+                return;
+            _p->context->fileBrowserCache()->remove(_p->items.fileInfo[index]);
+            if (_p->items.fileInfo[index].type() != Core::FileInfo::SEQUENCE)
+            {
+                _p->items.fileInfo[index] = fileInfo;
+            }
+            itemUpdate(index);
+        }
+
+        void FileBrowserModel::fileRemovedCallback(const QString & fileName)
+        {
+            //DJV_DEBUG("FileBrowserModel::fileRemovedCallback");
+            //DJV_DEBUG_PRINT("fileName = " << fileName);
+            if (_p->listPending)
+                return;
+            const Core::FileInfo fileInfo(fileName, false);
+            const int index = _p->findItem(fileInfo);
+            if (-1 == index)
+                return;
+            _p->context->fileBrowserCache()->remove(_p->items.fileInfo[index]);
+
+            // Remove the frame from the sequence.
+            Core::FileInfo & item = _p->items.fileInfo[index];
+            if (Core::FileInfo::SEQUENCE == item.type())
+            {
+                Core::Sequence sequence = item.sequence();
+                sequence.removeFrame(fileInfo.sequence().frames[0]);
+                if (sequence.frames.count() > 1)
+                {
+                    if (Core::Sequence::FORMAT_RANGE == _p->sequence)
+                    {
+                        sequence.setFrames(sequence.start(), sequence.end());
+                    }
+                    item.setSequence(sequence);
+                    itemUpdate(index);
+                    return;
+                }
+                else if (1 == sequence.frames.count())
+                {
+                    item = Core::FileInfo(item.fileName(sequence.frames[0]));
+                    itemUpdate(index);
+                    return;
+                }
+            }
+
+            // Remove the item.
+            _p->items.state[index] |= FileBrowserItems::REMOVED;
+            const int row = _p->itemRows[index];
+            if (_p->pendingRows.count())
+            {
+                modelUpdate();
+            }
+            else if (row != -1)
+            {
+                beginRemoveRows(QModelIndex(), row, row);
+                _p->rows.remove(row);
+                _p->updateItemRows();
+                endRemoveRows();
+            }
+        }
+
+        void FileBrowserModel::directoryChangedCallback()
         {
             dirUpdate();
-            modelUpdate();
         }
 
         void FileBrowserModel::dirUpdate()
         {
+            if (_p->path.isEmpty())
+                return;
+
             //DJV_DEBUG("FileBrowserModel::dirUpdate");
             //DJV_DEBUG_PRINT("path = " << _p->path);
 
-            // Get directory contents.
-            _p->list = Core::FileInfoUtil::list(_p->path, _p->sequence);
-
-            // Add parent directory.
-            if (Core::FileInfo(_p->path).exists())
-            {
-                _p->list.push_front(Core::FileInfo(_p->path + ".."));
-            }
-            //DJV_DEBUG_PRINT("list = " << _p->list.count());
-            //Q_FOREACH(const Core::FileInfo & fileInfo, _p->list)
-            //    DJV_DEBUG_PRINT("fileInfo = " << fileInfo << " " << fileInfo.type());
+            // The directory is listed on a separate thread; the rows are
+            // replaced when the listing is drained from the completion queue.
+            _p->listThread->list(_p->path, _p->sequence, ++_p->listGeneration);
+            _p->listPending = true;
+            _p->timer->start();
         }
 
         void FileBrowserModel::modelUpdate()
@@ -475,62 +882,62 @@ namespace djv
             //DJV_DEBUG_PRINT("path = " << _p->path);
 
             beginResetModel();
+            _p->rows = _p->sortedRows();
+            _p->pendingRows.clear();
+            _p->pendingRowsPos = 0;
+            _p->updateItemRows();
+            endResetModel();
+        }
 
-            _p->listTmp = _p->list;
-
-            // File sequence directory contents.
-            //Core::FileInfoUtil::sequence(_p->listTmp, _p->seq);
-
-            // Filter directory contents.
-            if (_p->filterText.length() > 0 || !_p->showHidden)
+        void FileBrowserModel::sortUpdate()
+        {
+            // Rows that are still being inserted change the row count, so
+            // fall back to resetting the model.
+            if (_p->pendingRows.count())
             {
-                const Core::FileInfoUtil::FILTER filter =
-                    !_p->showHidden ?
-                    Core::FileInfoUtil::FILTER_HIDDEN :
-                    Core::FileInfoUtil::FILTER_NONE;
-                Core::FileInfoUtil::filter(_p->listTmp, filter, _p->filterText);
+                modelUpdate();
+                return;
             }
 
-            // Sort directory contents.
-            Core::FileInfoUtil::SORT sort = static_cast<Core::FileInfoUtil::SORT>(0);
-            switch (_p->columnsSort)
+            //DJV_DEBUG("FileBrowserModel::sortUpdate");
+
+            // The same rows are re-ordered, so keep the persistent indexes
+            // (e.g., the selection) pointing at the same items.
+            Q_EMIT layoutAboutToBeChanged();
+            const QModelIndexList from = persistentIndexList();
+            QVector<int> fromItems;
+            Q_FOREACH(const QModelIndex & index, from)
             {
-            case NAME:        sort = Core::FileInfoUtil::SORT_NAME; break;
-            case SIZE:        sort = Core::FileInfoUtil::SORT_SIZE; break;
-#if ! defined(DJV_WINDOWS)
-            case USER:        sort = Core::FileInfoUtil::SORT_USER; break;
-#endif
-            case PERMISSIONS: sort = Core::FileInfoUtil::SORT_PERMISSIONS; break;
-            case TIME:        sort = Core::FileInfoUtil::SORT_TIME; break;
-            default: break;
+                fromItems.append(index.row() < _p->rows.count() ? _p->rows[index.row()] : -1);
             }
-            Core::FileInfoUtil::sort(_p->listTmp, sort, _p->reverseSort);
-            if (_p->sortDirsFirst)
+            _p->rows = _p->sortedRows();
+            _p->updateItemRows();
+            QModelIndexList to;
+            for (int i = 0; i < from.count(); ++i)
             {
-                Core::FileInfoUtil::sortDirsFirst(_p->listTmp);
+                const int row = fromItems[i] != -1 ? _p->itemRows[fromItems[i]] : -1;
+                to.append(row != -1 ? index(row, from[i].column()) : QModelIndex());
             }
+            changePersistentIndexList(from, to);
+            Q_EMIT layoutChanged();
+        }
 
-            for (int i = 0; i < _p->items.count(); ++i)
-            {
-                delete _p->items[i];
-                _p->items[i] = 0;
-            }
-            _p->items.clear();
-            _p->items.resize(_p->listTmp.count());
-            for (int i = 0; i < _p->listTmp.count(); ++i)
+        void FileBrowserModel::itemUpdate(int index)
+        {
+            _p->items.resetImage(index);
+            const int row = _p->itemRows[index];
+            if (row != -1)
             {
-                //DJV_DEBUG_PRINT("i = " << i);
-                FileBrowserItem * item = new FileBrowserItem(
-                    _p->listTmp[i],
-                    _p->thumbnailMode,
-                    _p->thumbnailSize,
-                    _p->context,
-                    this);
-                _p->items[i] = item;
-                connect(item, SIGNAL(imageInfoAvailable()), SLOT(imageInfoCallback()));
-                connect(item, SIGNAL(thumbnailAvailable()), SLOT(thumbnailCallback()));
+                Q_EMIT dataChanged(this->index(row, 0), this->index(row, COLUMNS_COUNT - 1));
             }
+        }
 
+        void FileBrowserModel::thumbnailUpdate()
+        {
+            //DJV_DEBUG("FileBrowserModel::thumbnailUpdate");
+            beginResetModel();
+            ++_p->requestGeneration;
+            _p->items.resetImages();
             endResetModel();
         }
 
@@ -42,7 +42,6 @@ namespace djv
 {
     namespace UI
     {
-        class FileBrowserItem;
         class UIContext;
 
         //! This class provides a file browser model.
@@ -139,8 +138,12 @@ namespace djv
             //! Get the path.
             const QString & path() const;
 
-            //! Get the list of files.
-            const Core::FileInfoList & contents() const;
+            //! Get the list of files in row order.
+            Core::FileInfoList contents() const;
+
+            //! Get whether the model is waiting for a directory listing, image
+            //! information, or thumbnails.
+            bool isBusy() const;
 
             //! Convert a model index to file information.
             Core::FileInfo fileInfo(const QModelIndex &) const;
@@ -273,14 +276,21 @@ namespace djv
             void optionChanged();
 
         private Q_SLOTS:
-            void imageInfoCallback();
-            void thumbnailCallback();
+            void completionCallback();
             void sequencePrefsCallback();
+            void fileCreatedCallback(const QString &);
+            void fileModifiedCallback(const QString &);
+            void fileRemovedCallback(const QString &);
+            void directoryChangedCallback();
 
             void dirUpdate();
             void modelUpdate();
+            void sortUpdate();
+            void thumbnailUpdate();
 
         private:
+            void itemUpdate(int index);
+
             DJV_PRIVATE_COPY(FileBrowserModel);
 
             struct Private;
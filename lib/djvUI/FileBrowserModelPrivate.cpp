@@ -30,115 +30,22 @@
 #include <djvUI/FileBrowserModelPrivate.h>
 
 #include <djvUI/FileBrowserCache.h>
-#include <djvUI/FileBrowserThumbnailSystem.h>
-#include <djvUI/UIContext.h>
 
-#include <djvGraphics/Image.h>
-#include <djvGraphics/OpenGLImage.h>
 #include <djvGraphics/PixelDataUtil.h>
 
+#include <djvCore/FileInfoUtil.h>
+#include <djvCore/Math.h>
+#include <djvCore/Memory.h>
 #include <djvCore/Time.h>
+#include <djvCore/User.h>
 #include <djvCore/VectorUtil.h>
 
 #include <QDateTime>
-#include <QOffscreenSurface>
-#include <QOpenGLContext>
-#include <QTimerEvent>
 
 namespace djv
 {
     namespace UI
     {
-        FileBrowserItem::FileBrowserItem(
-            const Core::FileInfo & fileInfo,
-            FileBrowserModel::THUMBNAIL_MODE thumbnailMode,
-            FileBrowserModel::THUMBNAIL_SIZE thumbnailSize,
-            const QPointer<UIContext> & context,
-            QObject * parent) :
-            QObject(parent),
-            _context(context),
-            _fileInfo(fileInfo),
-            _thumbnailMode(thumbnailMode),
-            _thumbnailSize(thumbnailSize)
-        {
-            // Initialize the display role data.
-            _displayRole[FileBrowserModel::NAME] = fileInfo.name();
-            _displayRole[FileBrowserModel::SIZE] = Core::Memory::sizeLabel(fileInfo.size());
-#if ! defined(DJV_WINDOWS)
-            _displayRole[FileBrowserModel::USER] =
-                Core::User::uidToString(fileInfo.user());
-#endif // DJV_WINDOWS
-            _displayRole[FileBrowserModel::PERMISSIONS] = Core::FileInfo::permissionsLabel(fileInfo.permissions());
-            _displayRole[FileBrowserModel::TIME] = Core::Time::timeToString(fileInfo.time());
-
-            // Initialize the edit role data.
-            _editRole[FileBrowserModel::NAME].setValue<Core::FileInfo>(fileInfo);
-            _editRole[FileBrowserModel::SIZE] = fileInfo.size();
-#if ! defined(DJV_WINDOWS)
-            _editRole[FileBrowserModel::USER] = fileInfo.user();
-#endif // DJV_WINDOWS
-            _editRole[FileBrowserModel::PERMISSIONS] = fileInfo.permissions();
-            _editRole[FileBrowserModel::TIME] = QDateTime::fromTime_t(fileInfo.time());
-
-            // Check the cache to see if this item already exists.
-            if (FileBrowserCacheItem * item = context->fileBrowserCache()->object(_fileInfo))
-            {
-                _thumbnailResolution = item->thumbnailResolution;
-                _thumbnailProxy = item->thumbnailProxy;
-                _imageInfoInit = true;
-                _imageInfo = item->imageInfo;
-                updateImageInfo();
-                _thumbnailInit = true;
-                _thumbnail = item->thumbnail;
-            }
-        }
-
-        const Core::FileInfo & FileBrowserItem::fileInfo() const
-        {
-            return _fileInfo;
-        }
-
-        const Graphics::ImageIOInfo & FileBrowserItem::imageInfo() const
-        {
-            return _imageInfo;
-        }
-
-        const QPixmap & FileBrowserItem::thumbnail() const
-        {
-            return _thumbnail;
-        }
-
-        const QVariant & FileBrowserItem::displayRole(int column) const
-        {
-            return _displayRole[column];
-        }
-
-        const QVariant & FileBrowserItem::editRole(int column) const
-        {
-            return _editRole[column];
-        }
-
-        void FileBrowserItem::requestImage()
-        {
-            if (!_imageInfoInit)
-            {
-                _imageInfoInit = true;
-                _imageInfoRequest = _context->fileBrowserThumbnailSystem()->getInfo(_fileInfo);
-                _imageInfoRequestTimer = startTimer(0);
-            }
-
-            if (!_thumbnailInit && Core::VectorUtil::isSizeValid(_thumbnailResolution))
-            {
-                _thumbnailInit = true;
-                _thumbnailRequest = _context->fileBrowserThumbnailSystem()->getPixmap(
-                    _fileInfo,
-                    _thumbnailMode,
-                    _thumbnailResolution,
-                    _thumbnailProxy);
-                _thumbnailRequestTimer = startTimer(0);
-            }
-        }
-
         namespace
         {
             glm::ivec2 thumbnailSize(
@@ -173,64 +80,230 @@ namespace djv
 
         } // namespace
 
-        void FileBrowserItem::timerEvent(QTimerEvent * event)
+        void FileBrowserItems::reset(const Core::FileInfoList & in)
+        {
+            const int count = in.count();
+            fileInfo = in;
+            imageInfo = QVector<Graphics::ImageIOInfo>(count);
+            thumbnailResolution = QVector<glm::ivec2>(count, glm::ivec2(0, 0));
+            thumbnailProxy = QVector<Graphics::PixelDataInfo::PROXY>(
+                count,
+                static_cast<Graphics::PixelDataInfo::PROXY>(0));
+            thumbnail = QVector<QPixmap>(count);
+            state = QVector<quint8>(count, 0);
+        }
+
+        int FileBrowserItems::append(const Core::FileInfo & in)
+        {
+            fileInfo.append(in);
+            imageInfo.append(Graphics::ImageIOInfo());
+            thumbnailResolution.append(glm::ivec2(0, 0));
+            thumbnailProxy.append(static_cast<Graphics::PixelDataInfo::PROXY>(0));
+            thumbnail.append(QPixmap());
+            state.append(0);
+            return fileInfo.count() - 1;
+        }
+
+        void FileBrowserItems::resetImages()
+        {
+            const int count = this->count();
+            for (int i = 0; i < count; ++i)
+            {
+                imageInfo[i] = Graphics::ImageIOInfo();
+                thumbnailResolution[i] = glm::ivec2(0, 0);
+                thumbnailProxy[i] = static_cast<Graphics::PixelDataInfo::PROXY>(0);
+                thumbnail[i] = QPixmap();
+                state[i] &= REMOVED;
+            }
+        }
+
+        void FileBrowserItems::resetImage(int index)
+        {
+            imageInfo[index] = Graphics::ImageIOInfo();
+            state[index] &= REMOVED;
+        }
+
+        int FileBrowserItems::count() const
+        {
+            return fileInfo.count();
+        }
+
+        void FileBrowserItems::setImageInfo(
+            int                              index,
+            const Graphics::ImageIOInfo &    info,
+            FileBrowserModel::THUMBNAIL_MODE thumbnailMode,
+            FileBrowserModel::THUMBNAIL_SIZE size)
+        {
+            imageInfo[index] = info;
+            Graphics::PixelDataInfo::PROXY proxy = static_cast<Graphics::PixelDataInfo::PROXY>(0);
+            const glm::ivec2 resolution = thumbnailSize(
+                thumbnailMode,
+                info.size,
+                FileBrowserModel::thumbnailSizeValue(size),
+                &proxy);
+            thumbnailResolution[index] = resolution;
+            thumbnailProxy[index] = proxy;
+            if (thumbnail[index].size() != QSize(resolution.x, resolution.y))
+            {
+                QPixmap pixmap(resolution.x, resolution.y);
+                pixmap.fill(Qt::transparent);
+                thumbnail[index] = pixmap;
+            }
+            state[index] |= INFO_DONE;
+        }
+
+        bool FileBrowserItems::setFromCache(int index, FileBrowserCache * cache)
+        {
+            if (FileBrowserCacheItem * item = cache->object(fileInfo[index]))
+            {
+                imageInfo[index] = item->imageInfo;
+                thumbnailResolution[index] = item->thumbnailResolution;
+                thumbnailProxy[index] = item->thumbnailProxy;
+                thumbnail[index] = item->thumbnail;
+                state[index] = INFO_REQUESTED | INFO_DONE | THUMBNAIL_REQUESTED | THUMBNAIL_DONE;
+                return true;
+            }
+            return false;
+        }
+
+        QVariant FileBrowserItems::displayRole(int index, int column) const
         {
-            if (_imageInfoRequestTimer == event->timerId())
+            const Core::FileInfo & fileInfo = this->fileInfo[index];
+            switch (column)
             {
-                if (_imageInfoRequest.valid())
+            case FileBrowserModel::NAME:
+            {
+                const Graphics::ImageIOInfo & imageInfo = this->imageInfo[index];
+                if (Core::VectorUtil::isSizeValid(imageInfo.size))
                 {
-                    _imageInfo = _imageInfoRequest.get();
-                    Graphics::PixelDataInfo::PROXY thumbnailProxy = static_cast<Graphics::PixelDataInfo::PROXY>(0);
-                    _thumbnailResolution = thumbnailSize(
-                        _thumbnailMode,
-                        _imageInfo.size,
-                        FileBrowserModel::thumbnailSizeValue(_thumbnailSize),
-                        &thumbnailProxy);
-                    _thumbnail = QPixmap(_thumbnailResolution.x, _thumbnailResolution.y);
-                    _thumbnail.fill(Qt::transparent);
-                    updateImageInfo();
-                    killTimer(_imageInfoRequestTimer);
-                    _imageInfoRequestTimer = 0;
-                    Q_EMIT imageInfoAvailable();
+                    QStringList pixelLabel;
+                    pixelLabel << imageInfo.pixel;
+                    return QString("%1\n%2x%3:%4 %5\n%6@%7").
+                        arg(fileInfo.name()).
+                        arg(imageInfo.size.x).
+                        arg(imageInfo.size.y).
+                        arg(Core::VectorUtil::aspect(imageInfo.size), 0, 'f', 2).
+                        arg(pixelLabel.join(", ")).
+                        arg(Core::Time::frameToString(
+                            imageInfo.sequence.frames.count(),
+                            imageInfo.sequence.speed)).
+                        arg(Core::Speed::speedToFloat(imageInfo.sequence.speed));
                 }
+                return fileInfo.name();
             }
-            else if (_thumbnailRequestTimer == event->timerId())
+            case FileBrowserModel::SIZE: return Core::Memory::sizeLabel(fileInfo.size());
+#if ! defined(DJV_WINDOWS)
+            case FileBrowserModel::USER:
             {
-                if (_thumbnailRequest.valid())
+                const uint user = fileInfo.user();
+                auto i = userNames.find(user);
+                if (i == userNames.end())
                 {
-                    _thumbnail = _thumbnailRequest.get();
-                    _context->fileBrowserCache()->insert(
-                        _fileInfo,
-                        new FileBrowserCacheItem(
-                            _imageInfo,
-                            _thumbnailResolution,
-                            _thumbnailProxy,
-                            _thumbnail),
-                        _thumbnail.width() * _thumbnail.height() * 4);
-                    killTimer(_thumbnailRequestTimer);
-                    _thumbnailRequestTimer = 0;
-                    Q_EMIT thumbnailAvailable();
+                    i = userNames.insert(user, Core::User::uidToString(user));
                 }
+                return i.value();
+            }
+#endif // DJV_WINDOWS
+            case FileBrowserModel::PERMISSIONS: return Core::FileInfo::permissionsLabel(fileInfo.permissions());
+            case FileBrowserModel::TIME: return Core::Time::timeToString(fileInfo.time());
+            default: break;
             }
+            return QVariant();
         }
 
-        void FileBrowserItem::updateImageInfo()
+        QVariant FileBrowserItems::editRole(int index, int column) const
         {
-            if (Core::VectorUtil::isSizeValid(_imageInfo.size))
+            const Core::FileInfo & fileInfo = this->fileInfo[index];
+            QVariant out;
+            switch (column)
             {
-                QStringList pixelLabel;
-                pixelLabel << _imageInfo.pixel;
-                _displayRole[FileBrowserModel::NAME] =
-                    QString("%1\n%2x%3:%4 %5\n%6@%7").
-                    arg(_fileInfo.name()).
-                    arg(_imageInfo.size.x).
-                    arg(_imageInfo.size.y).
-                    arg(Core::VectorUtil::aspect(_imageInfo.size), 0, 'f', 2).
-                    arg(pixelLabel.join(", ")).
-                    arg(Core::Time::frameToString(
-                        _imageInfo.sequence.frames.count(),
-                        _imageInfo.sequence.speed)).
-                    arg(Core::Speed::speedToFloat(_imageInfo.sequence.speed));
+            case FileBrowserModel::NAME: out.setValue<Core::FileInfo>(fileInfo); break;
+            case FileBrowserModel::SIZE: out = fileInfo.size(); break;
+#if ! defined(DJV_WINDOWS)
+            case FileBrowserModel::USER: out = fileInfo.user(); break;
+#endif // DJV_WINDOWS
+            case FileBrowserModel::PERMISSIONS: out = fileInfo.permissions(); break;
+            case FileBrowserModel::TIME: out = QDateTime::fromTime_t(fileInfo.time()); break;
+            default: break;
+            }
+            return out;
+        }
+
+        void FileBrowserCompletionQueue::push(FileBrowserCompletion && in)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _items.push_back(std::move(in));
+        }
+
+        std::vector<FileBrowserCompletion> FileBrowserCompletionQueue::take()
+        {
+            std::vector<FileBrowserCompletion> out;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                out.swap(_items);
+            }
+            return out;
+        }
+
+        FileBrowserListThread::FileBrowserListThread(const std::shared_ptr<FileBrowserCompletionQueue> & queue) :
+            _queue(queue)
+        {
+            _thread = std::thread(&FileBrowserListThread::_run, this);
+        }
+
+        FileBrowserListThread::~FileBrowserListThread()
+        {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _running = false;
+                _cv.notify_one();
+            }
+            _thread.join();
+        }
+
+        void FileBrowserListThread::list(const QString & path, Core::Sequence::FORMAT sequence, quint64 generation)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _pending = true;
+            _path = path;
+            _sequence = sequence;
+            _generation = generation;
+            _cv.notify_one();
+        }
+
+        void FileBrowserListThread::_run()
+        {
+            while (true)
+            {
+                QString path;
+                Core::Sequence::FORMAT sequence = Core::Sequence::FORMAT_RANGE;
+                quint64 generation = 0;
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _cv.wait(lock, [this] { return _pending || !_running; });
+                    if (!_running)
+                        break;
+                    _pending = false;
+                    path = _path;
+                    sequence = _sequence;
+                    generation = _generation;
+                }
+                //DJV_DEBUG("FileBrowserListThread::_run");
+                //DJV_DEBUG_PRINT("path = " << path);
+
+                // Get directory contents.
+                FileBrowserCompletion completion;
+                completion.type = FileBrowserCompletion::LIST;
+                completion.generation = generation;
+                completion.list = Core::FileInfoUtil::list(path, sequence);
+
+                // Add parent directory.
+                if (Core::FileInfo(path).exists())
+                {
+                    completion.list.push_front(Core::FileInfo(path + ".."));
+                }
+                //DJV_DEBUG_PRINT("list = " << completion.list.count());
+                _queue->push(std::move(completion));
             }
         }
 
@@ -33,79 +33,142 @@
 
 #include <djvGraphics/ImageIO.h>
 
+#include <QHash>
 #include <QPixmap>
 #include <QVariant>
 
-#include <future>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace djv
 {
     namespace UI
     {
-        class FileBrowserThumbnailSystem;
+        class FileBrowserCache;
 
-        class FileBrowserItem : public QObject
+        //! This struct provides the file browser items. The items are stored as
+        //! parallel arrays in directory listing order; the model rows are indices
+        //! into these arrays so filtering and sorting never rebuild the items.
+        struct FileBrowserItems
         {
-            Q_OBJECT
-
-        public:
-            explicit FileBrowserItem(
-                const Core::FileInfo &,
+            //! This enumeration provides the item request state flags.
+            enum STATE
+            {
+                INFO_REQUESTED      = 1,
+                INFO_DONE           = 2,
+                THUMBNAIL_REQUESTED = 4,
+                THUMBNAIL_DONE      = 8,
+                REMOVED             = 16 //!< The file was removed after listing
+            };
+
+            //! Replace the items.
+            void reset(const Core::FileInfoList &);
+
+            //! Add an item. Returns the index of the new item.
+            int append(const Core::FileInfo &);
+
+            //! Reset the image information and thumbnails.
+            void resetImages();
+
+            //! Reset the image information for an item so it is requested again.
+            //! The current thumbnail is kept until the new one is available.
+            void resetImage(int index);
+
+            //! Get the number of items.
+            int count() const;
+
+            //! Set the image information for an item. This also computes the
+            //! thumbnail resolution.
+            void setImageInfo(
+                int                              index,
+                const Graphics::ImageIOInfo &,
                 FileBrowserModel::THUMBNAIL_MODE,
-                FileBrowserModel::THUMBNAIL_SIZE,
-                const QPointer<UIContext> &,
-                QObject * parent);
-
-            //! Get the file information.
-            const Core::FileInfo & fileInfo() const;
-
-            //! Get the image information.
-            const Graphics::ImageIOInfo & imageInfo() const;
+                FileBrowserModel::THUMBNAIL_SIZE);
 
-            //! Get the thumbnail.
-            const QPixmap & thumbnail() const;
+            //! Initialize an item from the thumbnail cache. Returns false if the
+            //! item is not in the cache.
+            bool setFromCache(int index, FileBrowserCache *);
 
             //! Get the display role data.
-            const QVariant & displayRole(int column) const;
+            QVariant displayRole(int index, int column) const;
 
             //! Get the edit role data.
-            const QVariant & editRole(int column) const;
+            QVariant editRole(int index, int column) const;
+
+            Core::FileInfoList                      fileInfo;
+            QVector<Graphics::ImageIOInfo>          imageInfo;
+            QVector<glm::ivec2>                     thumbnailResolution;
+            QVector<Graphics::PixelDataInfo::PROXY> thumbnailProxy;
+            QVector<QPixmap>                        thumbnail;
+            QVector<quint8>                         state;
+            mutable QHash<uint, QString>            userNames;
+        };
+
+        //! This struct provides a completed file browser request.
+        struct FileBrowserCompletion
+        {
+            //! This enumeration provides the request types.
+            enum TYPE
+            {
+                LIST,
+                INFO,
+                THUMBNAIL
+            };
+
+            TYPE                  type       = LIST;
+            quint64               generation = 0;
+            int                   index      = -1;
+            Core::FileInfoList    list;
+            Graphics::ImageIOInfo imageInfo;
+            QPixmap               thumbnail;
+        };
 
-        public Q_SLOTS:
-            //! Request the image.
-            void requestImage();
+        //! This class provides the queue of completed file browser requests. It
+        //! is filled from the listing and thumbnail threads and drained by the
+        //! model on the GUI thread.
+        class FileBrowserCompletionQueue
+        {
+        public:
+            //! Add a completed request.
+            void push(FileBrowserCompletion &&);
 
-        Q_SIGNALS:
-            //! This signal is emitted when the image information is available.
-            void imageInfoAvailable();
+            //! Remove all of the completed requests.
+            std::vector<FileBrowserCompletion> take();
+
+        private:
+            std::mutex _mutex;
+            std::vector<FileBrowserCompletion> _items;
+        };
 
-            //! This signal is emitted when the thumbnail is available.
-            void thumbnailAvailable();
+        //! This class provides a thread for listing directories.
+        class FileBrowserListThread
+        {
+        public:
+            explicit FileBrowserListThread(const std::shared_ptr<FileBrowserCompletionQueue> &);
+            ~FileBrowserListThread();
 
-        protected:
-            void timerEvent(QTimerEvent *) override;
+            //! Request a directory listing. A pending request that has not been
+            //! started yet is replaced.
+            void list(const QString & path, Core::Sequence::FORMAT, quint64 generation);
 
         private:
-            void updateImageInfo();
-
-            QPointer<UIContext> _context;
-            Core::FileInfo _fileInfo;
-            FileBrowserModel::THUMBNAIL_MODE _thumbnailMode = static_cast<FileBrowserModel::THUMBNAIL_MODE>(0);
-            FileBrowserModel::THUMBNAIL_SIZE _thumbnailSize = static_cast<FileBrowserModel::THUMBNAIL_SIZE>(0);
-            glm::ivec2 _thumbnailResolution = glm::ivec2(0, 0);
-            Graphics::PixelDataInfo::PROXY _thumbnailProxy = static_cast<Graphics::PixelDataInfo::PROXY>(0);
-            bool _imageInfoInit = false;
-            std::future<Graphics::ImageIOInfo> _imageInfoRequest;
-            int _imageInfoRequestTimer = 0;
-            Graphics::ImageIOInfo _imageInfo;
-            bool _thumbnailInit = false;
-            std::future<QPixmap> _thumbnailRequest;
-            int _thumbnailRequestTimer = 0;
-            QPixmap _thumbnail;
-            QVariant _displayRole[FileBrowserModel::COLUMNS_COUNT];
-            QVariant _editRole[FileBrowserModel::COLUMNS_COUNT];
+            void _run();
+
+            DJV_PRIVATE_COPY(FileBrowserListThread);
+
+            std::shared_ptr<FileBrowserCompletionQueue> _queue;
+            std::mutex _mutex;
+            std::condition_variable _cv;
+            bool _pending = false;
+            QString _path;
+            Core::Sequence::FORMAT _sequence = Core::Sequence::FORMAT_RANGE;
+            quint64 _generation = 0;
+            bool _running = true;
+            std::thread _thread;
         };
 
     } // namespace UI
 } // namespace djv
-
@@ -38,6 +38,7 @@
 
 #include <djvCore/DebugLog.h>
 #include <djvCore/FileInfo.h>
+#include <djvCore/Trace.h>
 
 #include <QOffscreenSurface>
 #include <QOpenGLContext>
@@ -59,59 +60,17 @@ namespace djv
 
             struct InfoRequest
             {
-                InfoRequest()
-                {}
-
-                InfoRequest(InfoRequest&& other) :
-                    fileInfo(other.fileInfo),
-                    promise(std::move(other.promise))
-                {}
-
-                InfoRequest& operator = (InfoRequest&& other)
-                {
-                    if (this != &other)
-                    {
-                        fileInfo = other.fileInfo;
-                        promise = std::move(other.promise);
-                    }
-                    return *this;
-                }
-
                 Core::FileInfo fileInfo;
-                std::promise<Graphics::ImageIOInfo> promise;
+                FileBrowserThumbnailSystem::InfoCallback callback;
             };
 
             struct PixmapRequest
             {
-                PixmapRequest()
-                {}
-
-                PixmapRequest(PixmapRequest&& other) :
-                    fileInfo(other.fileInfo),
-                    thumbnailMode(other.thumbnailMode),
-                    resolution(other.resolution),
-                    proxy(other.proxy),
-                    promise(std::move(other.promise))
-                {}
-
-                PixmapRequest& operator = (PixmapRequest&& other)
-                {
-                    if (this != &other)
-                    {
-                        fileInfo = other.fileInfo;
-                        thumbnailMode = other.thumbnailMode;
-                        resolution = other.resolution;
-                        proxy = other.proxy;
-                        promise = std::move(other.promise);
-                    }
-                    return *this;
-                }
-
                 Core::FileInfo fileInfo;
                 FileBrowserModel::THUMBNAIL_MODE thumbnailMode = static_cast<FileBrowserModel::THUMBNAIL_MODE>(0);
                 glm::ivec2 resolution;
                 Graphics::PixelDataInfo::PROXY proxy = static_cast<Graphics::PixelDataInfo::PROXY>(0);
-                std::promise<QPixmap> promise;
+                FileBrowserThumbnailSystem::PixmapCallback callback;
             };
 
         } // namespace
@@ -166,32 +125,64 @@ namespace djv
         {}
 
         std::future<Graphics::ImageIOInfo> FileBrowserThumbnailSystem::getInfo(const Core::FileInfo& fileInfo)
+        {
+            auto promise = std::make_shared<std::promise<Graphics::ImageIOInfo> >();
+            auto future = promise->get_future();
+            getInfo(
+                fileInfo,
+                [promise](const Graphics::ImageIOInfo & info)
+            {
+                promise->set_value(info);
+            });
+            return future;
+        }
+
+        std::future<QPixmap> FileBrowserThumbnailSystem::getPixmap(
+            const Core::FileInfo& fileInfo,
+            FileBrowserModel::THUMBNAIL_MODE thumbnailMode,
+            const glm::ivec2 & resolution,
+            Graphics::PixelDataInfo::PROXY proxy)
+        {
+            auto promise = std::make_shared<std::promise<QPixmap> >();
+            auto future = promise->get_future();
+            getPixmap(
+                fileInfo,
+                thumbnailMode,
+                resolution,
+                proxy,
+                [promise](const QPixmap & pixmap)
+            {
+                promise->set_value(pixmap);
+            });
+            return future;
+        }
+
+        void FileBrowserThumbnailSystem::getInfo(const Core::FileInfo& fileInfo, const InfoCallback & callback)
         {
             InfoRequest request;
             request.fileInfo = fileInfo;
-            auto future = request.promise.get_future();
+            request.callback = callback;
             std::unique_lock<std::mutex> lock(_p->requestMutex);
             _p->infoQueue.push_back(std::move(request));
             _p->requestCV.notify_one();
-            return future;
         }
 
-        std::future<QPixmap> FileBrowserThumbnailSystem::getPixmap(
+        void FileBrowserThumbnailSystem::getPixmap(
             const Core::FileInfo& fileInfo,
             FileBrowserModel::THUMBNAIL_MODE thumbnailMode,
             const glm::ivec2 & resolution,
-            Graphics::PixelDataInfo::PROXY proxy)
+            Graphics::PixelDataInfo::PROXY proxy,
+            const PixmapCallback & callback)
         {
             PixmapRequest request;
             request.fileInfo = fileInfo;
             request.thumbnailMode = thumbnailMode;
             request.resolution = resolution;
             request.proxy = proxy;
-            auto future = request.promise.get_future();
+            request.callback = callback;
             std::unique_lock<std::mutex> lock(_p->requestMutex);
             _p->pixmapQueue.push_back(std::move(request));
             _p->requestCV.notify_one();
-            return future;
         }
 
         void FileBrowserThumbnailSystem::stop()
@@ -246,17 +237,16 @@ namespace djv
 
         void FileBrowserThumbnailSystem::_handleInfoRequests()
         {
-            for (auto& request : _p->infoRequests)
+            DJV_TRACE("FileBrowserThumbnailSystem::_handleInfoRequests", "Thumbnail");
+            Core::FileInfoList fileInfoList;
+            for (const auto& request : _p->infoRequests)
             {
-                Graphics::ImageIOInfo info;
-                try
-                {
-                    auto load = std::unique_ptr<Graphics::ImageLoad>(_p->imageIO->load(request.fileInfo, info));
-                }
-                catch (const Core::Error&)
-                {
-                }
-                request.promise.set_value(info);
+                fileInfoList.push_back(request.fileInfo);
+            }
+            const auto probes = _p->imageIO->probe(fileInfoList);
+            for (size_t i = 0; i < _p->infoRequests.size(); ++i)
+            {
+                _p->infoRequests[i].callback(probes[static_cast<int>(i)].info);
             }
             _p->infoRequests.clear();
         }
@@ -266,6 +256,7 @@ namespace djv
             //DJV_DEBUG("FileBrowserThumbnailSystem::_handlePixmapRequests");
             for (auto& request : _p->pixmapRequests)
             {
+                DJV_TRACE("FileBrowserThumbnailSystem::pixmap", "Thumbnail");
                 QPixmap pixmap;
                 try
                 {
@@ -273,8 +264,14 @@ namespace djv
                     
                     Graphics::ImageIOInfo info;
                     auto load = std::unique_ptr<Graphics::ImageLoad>(_p->imageIO->load(request.fileInfo, info));
+                    // Decode at the smallest proxy scale that still covers the
+                    // thumbnail resolution; loaders such as JPEG can then skip
+                    // most of the decoding work.
+                    Graphics::ImageIOFrameInfo frameInfo;
+                    frameInfo.proxy = Graphics::PixelDataUtil::proxyFit(info.size, request.resolution);
+                    frameInfo.tags = false;
                     Graphics::Image image;
-                    load->read(image);
+                    load->read(image, frameInfo);
                     //DJV_DEBUG_PRINT("image = " << image);
 
                     Graphics::Image tmp(Graphics::PixelDataInfo(request.resolution, image.pixel()));
@@ -295,7 +292,7 @@ namespace djv
                         _p->debugLog->addMessage(m.prefix, m.string);
                     }
                 }
-                request.promise.set_value(pixmap);
+                request.callback(pixmap);
             }
             _p->pixmapRequests.clear();
         }
@@ -35,6 +35,7 @@
 
 #include <QThread>
 
+#include <functional>
 #include <future>
 
 class QOpenGLDebugMessage;
@@ -53,6 +54,14 @@ namespace djv
             FileBrowserThumbnailSystem(const QPointer<UIContext> &, QObject * parent = nullptr);
             virtual ~FileBrowserThumbnailSystem();
 
+            //! This typedef provides an image information request callback.
+            //! The callback is run on the thumbnail thread.
+            typedef std::function<void(const Graphics::ImageIOInfo &)> InfoCallback;
+
+            //! This typedef provides a pixmap request callback. The callback is
+            //! run on the thumbnail thread.
+            typedef std::function<void(const QPixmap &)> PixmapCallback;
+
             std::future<Graphics::ImageIOInfo> getInfo(const Core::FileInfo&);
             std::future<QPixmap> getPixmap(
                 const Core::FileInfo&,
@@ -60,6 +69,14 @@ namespace djv
                 const glm::ivec2 &,
                 Graphics::PixelDataInfo::PROXY);
 
+            void getInfo(const Core::FileInfo&, const InfoCallback &);
+            void getPixmap(
+                const Core::FileInfo&,
+                FileBrowserModel::THUMBNAIL_MODE,
+                const glm::ivec2 &,
+                Graphics::PixelDataInfo::PROXY,
+                const PixmapCallback &);
+
             void stop();
 
         protected:
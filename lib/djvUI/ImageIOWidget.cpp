@@ -94,6 +94,8 @@ namespace djv
             _p(new Private)
         {
             _p->context = context;
+            indexUpdate();
+            indexSave();
         }
         
         ImageIOWidgetFactory::~ImageIOWidgetFactory()
@@ -35,12 +35,15 @@
 #include <djvGraphics/Image.h>
 #include <djvGraphics/OpenGLImage.h>
 #include <djvGraphics/PixelDataUtil.h>
+#include <djvGraphics/TilePyramid.h>
 
 #include <djvCore/DebugLog.h>
 #include <djvCore/Error.h>
 #include <djvCore/ErrorUtil.h>
+#include <djvCore/Math.h>
 
 #include <QPointer>
+#include <QTimer>
 
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -48,9 +51,22 @@ namespace djv
 {
     namespace UI
     {
+        namespace
+        {
+            //! The time in milliseconds between redraws while the tile pyramid
+            //! levels are being built.
+            const int tileTimeout = 100;
+
+            //! The time in milliseconds the view must be idle before tile
+            //! pyramid levels that were released are built again.
+            const int tileIdleTimeout = 2000;
+
+        } // namespace
+
         struct ImageView::Private
         {
             Private(const QPointer<UIContext> & context) :
+                tilePyramid(context->memoryBudget()),
                 context(context)
             {}
 
@@ -59,7 +75,11 @@ namespace djv
             glm::ivec2 viewPos = glm::ivec2(0, 0);
             float viewZoom = 1.f;
             bool viewFit = false;
+            bool playing = false;
             std::unique_ptr<Graphics::OpenGLImage> openGLImage;
+            Graphics::TilePyramid tilePyramid;
+            bool tilesDrawn = false;
+            QPointer<QTimer> tileTimer;
             QPointer<UIContext> context;
         };
 
@@ -69,7 +89,14 @@ namespace djv
             Qt::WindowFlags flags) :
             OpenGLWidget(context, parent, flags),
             _p(new Private(context))
-        {}
+        {
+            _p->tileTimer = new QTimer(this);
+            _p->tileTimer->setSingleShot(true);
+            connect(
+                _p->tileTimer,
+                SIGNAL(timeout()),
+                SLOT(tileTimerCallback()));
+        }
 
         ImageView::~ImageView()
         {
@@ -107,6 +134,11 @@ namespace djv
             return _p->viewFit;
         }
 
+        bool ImageView::isPlaying() const
+        {
+            return _p->playing;
+        }
+
         QSize ImageView::sizeHint() const
         {
             return QSize(200, 200);
@@ -118,6 +150,23 @@ namespace djv
                 return;
             //DJV_DEBUG("ImageView::setData");
             _p->data = data;
+
+            // Very large images are drawn with a tile pyramid so that only the
+            // visible tiles are uploaded. The reduced levels are only built
+            // when the image is not changing every frame.
+            if (_p->data && Graphics::TilePyramid::isTiled(_p->data->info()))
+            {
+                _p->tilePyramid.build(*_p->data);
+                if (!_p->playing)
+                {
+                    _p->tilePyramid.buildLevels();
+                }
+            }
+            else
+            {
+                _p->tilePyramid.clear();
+            }
+
             update();
             Q_EMIT dataChanged(_p->data);
             Q_EMIT viewChanged();
@@ -208,6 +257,18 @@ namespace djv
             _p->viewFit = true;
         }
 
+        void ImageView::setPlaying(bool value)
+        {
+            if (value == _p->playing)
+                return;
+            _p->playing = value;
+            if (!_p->playing && _p->tilePyramid.levelCount())
+            {
+                _p->tilePyramid.buildLevels();
+                update();
+            }
+        }
+
         void ImageView::initializeGL()
         {
             OpenGLWidget::initializeGL();
@@ -262,7 +323,35 @@ namespace djv
                     static_cast<float>(geom.h),
                     -1.f,
                     1.f);
-                _p->openGLImage->draw(*_p->data, viewMatrix, options);
+                // The tiles are only drawn when a level close to the view scale
+                // is available. During playback, or after the levels have been
+                // released, only the first level is available and drawing the
+                // pixel data directly is faster than uploading every tile.
+                Graphics::TilePyramid & pyramid = _p->tilePyramid;
+                const int proxyScale =
+                    options.proxyScale ?
+                    Graphics::PixelDataUtil::proxyScale(_p->data->info().proxy) :
+                    1;
+                const float scale = Core::Math::max(
+                    Core::Math::abs(options.xform.scale.x),
+                    Core::Math::abs(options.xform.scale.y)) * proxyScale;
+                _p->tilesDrawn = pyramid.levelCount() && pyramid.hasLevel(scale);
+                if (_p->tilesDrawn)
+                {
+                    _p->openGLImage->draw(pyramid, viewMatrix, options);
+                }
+                else
+                {
+                    _p->openGLImage->draw(*_p->data, viewMatrix, options);
+                }
+                if (pyramid.isBuilding())
+                {
+                    _p->tileTimer->start(tileTimeout);
+                }
+                else if (!_p->playing && pyramid.levelCount() && pyramid.levelsReady() < pyramid.levelCount())
+                {
+                    _p->tileTimer->start(tileIdleTimeout);
+                }
             }
             catch (const Core::Error & error)
             {
@@ -271,6 +360,41 @@ namespace djv
             }
         }
 
+        const Graphics::OpenGLImage * ImageView::openGLImage() const
+        {
+            return _p->openGLImage.get();
+        }
+
+        void ImageView::tileTimerCallback()
+        {
+            Graphics::TilePyramid & pyramid = _p->tilePyramid;
+            if (!pyramid.levelCount())
+                return;
+            if (pyramid.isBuilding())
+            {
+                // Redraw as the levels become available. When the pixel data is
+                // drawn directly, wait until the levels are finished instead of
+                // uploading it again.
+                if (_p->tilesDrawn)
+                {
+                    update();
+                }
+                else
+                {
+                    _p->tileTimer->start(tileTimeout);
+                }
+                return;
+            }
+
+            // Build the levels again if they were released while the view was
+            // idle.
+            if (!_p->playing && pyramid.levelsReady() < pyramid.levelCount())
+            {
+                pyramid.buildLevels();
+            }
+            update();
+        }
+
         Core::Box2f ImageView::bbox(const glm::ivec2 & pos, float zoom) const
         {
             if (!_p->data)
@@ -99,10 +99,14 @@ namespace djv
             //! Get whether the view has been fitted.
             bool hasViewFit() const;
 
+            //! Get whether the image is being played back.
+            bool isPlaying() const;
+
             QSize sizeHint() const override;
 
         public Q_SLOTS:
-            //! Set the pixel data.
+            //! Set the pixel data. The pixel data must stay valid until it is
+            //! replaced.
             void setData(const djv::Graphics::PixelData *);
 
             //! Set the image options.
@@ -129,6 +133,10 @@ namespace djv
             //! Adjust the zoom to fit the view.
             void viewFit();
 
+            //! Set whether the image is being played back. The reduced levels of
+            //! very large images are not built during playback.
+            void setPlaying(bool);
+
         Q_SIGNALS:
             //! This signal is emitted when the pixel data is changed.
             void dataChanged(const djv::Graphics::PixelData *);
@@ -152,6 +160,12 @@ namespace djv
             void initializeGL() override;
             void paintGL() override;
 
+            //! Get the OpenGL image used to draw the pixel data.
+            const Graphics::OpenGLImage * openGLImage() const;
+
+        private Q_SLOTS:
+            void tileTimerCallback();
+
         private:
             Core::Box2f bbox(const glm::ivec2 &, float) const;
 
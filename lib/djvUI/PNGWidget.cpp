@@ -0,0 +1,237 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvUI/PNGWidget.h>
+
+#include <djvUI/UIContext.h>
+#include <djvUI/IntEdit.h>
+#include <djvUI/PrefsGroupBox.h>
+
+#include <djvGraphics/ImageIO.h>
+
+#include <djvCore/SignalBlocker.h>
+
+#include <QApplication>
+#include <QComboBox>
+#include <QFormLayout>
+#include <QVBoxLayout>
+
+namespace djv
+{
+    namespace UI
+    {
+        PNGWidget::PNGWidget(Graphics::ImageIO * plugin, const QPointer<UIContext> & context) :
+            ImageIOWidget(plugin, context)
+        {
+            //DJV_DEBUG("PNGWidget::PNGWidget");
+
+            // Create the widgets.
+            _compressionLevelWidget = new IntEdit;
+            _compressionLevelWidget->setRange(0, 9);
+            _compressionLevelWidget->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+
+            _filterWidget = new QComboBox;
+            _filterWidget->addItems(Graphics::PNG::filterLabels());
+            _filterWidget->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+
+            _strategyWidget = new QComboBox;
+            _strategyWidget->addItems(Graphics::PNG::strategyLabels());
+            _strategyWidget->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+
+            _threadsWidget = new IntEdit;
+            _threadsWidget->setRange(0, 256);
+            _threadsWidget->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+
+            // Layout the widgets.
+            _layout = new QVBoxLayout(this);
+
+            PrefsGroupBox * prefsGroupBox = new PrefsGroupBox(
+                qApp->translate("djv::UI::PNGWidget", "Compression"),
+                qApp->translate("djv::UI::PNGWidget", "Set the file compression used when saving PNG images. "
+                    "Large images are compressed in parallel unless the number of threads is one."),
+                context);
+            QFormLayout * formLayout = prefsGroupBox->createLayout();
+            formLayout->addRow(
+                qApp->translate("djv::UI::PNGWidget", "Level:"),
+                _compressionLevelWidget);
+            formLayout->addRow(
+                qApp->translate("djv::UI::PNGWidget", "Filter:"),
+                _filterWidget);
+            formLayout->addRow(
+                qApp->translate("djv::UI::PNGWidget", "Strategy:"),
+                _strategyWidget);
+            formLayout->addRow(
+                qApp->translate("djv::UI::PNGWidget", "Threads:"),
+                _threadsWidget);
+            _layout->addWidget(prefsGroupBox);
+
+            _layout->addStretch();
+
+            // Initialize.
+            QStringList tmp;
+            tmp = plugin->option(
+                plugin->options()[Graphics::PNG::COMPRESSION_LEVEL_OPTION]);
+            tmp >> _options.compressionLevel;
+            tmp = plugin->option(
+                plugin->options()[Graphics::PNG::FILTER_OPTION]);
+            tmp >> _options.filter;
+            tmp = plugin->option(
+                plugin->options()[Graphics::PNG::STRATEGY_OPTION]);
+            tmp >> _options.strategy;
+            tmp = plugin->option(
+                plugin->options()[Graphics::PNG::THREADS_OPTION]);
+            tmp >> _options.threads;
+
+            widgetUpdate();
+
+            // Setup the callbacks.
+            connect(
+                plugin,
+                SIGNAL(optionChanged(const QString &)),
+                SLOT(pluginCallback(const QString &)));
+            connect(
+                _compressionLevelWidget,
+                SIGNAL(valueChanged(int)),
+                SLOT(compressionLevelCallback(int)));
+            connect(
+                _filterWidget,
+                SIGNAL(activated(int)),
+                SLOT(filterCallback(int)));
+            connect(
+                _strategyWidget,
+                SIGNAL(activated(int)),
+                SLOT(strategyCallback(int)));
+            connect(
+                _threadsWidget,
+                SIGNAL(valueChanged(int)),
+                SLOT(threadsCallback(int)));
+        }
+
+        void PNGWidget::resetPreferences()
+        {
+            _options = Graphics::PNG::Options();
+            pluginUpdate();
+            widgetUpdate();
+        }
+
+        void PNGWidget::pluginCallback(const QString & option)
+        {
+            try
+            {
+                QStringList tmp;
+                tmp = plugin()->option(option);
+                if (0 == option.compare(plugin()->options()[
+                    Graphics::PNG::COMPRESSION_LEVEL_OPTION], Qt::CaseInsensitive))
+                    tmp >> _options.compressionLevel;
+                else if (0 == option.compare(plugin()->options()[
+                    Graphics::PNG::FILTER_OPTION], Qt::CaseInsensitive))
+                    tmp >> _options.filter;
+                else if (0 == option.compare(plugin()->options()[
+                    Graphics::PNG::STRATEGY_OPTION], Qt::CaseInsensitive))
+                    tmp >> _options.strategy;
+                else if (0 == option.compare(plugin()->options()[
+                    Graphics::PNG::THREADS_OPTION], Qt::CaseInsensitive))
+                    tmp >> _options.threads;
+            }
+            catch (const QString &)
+            {
+            }
+            widgetUpdate();
+        }
+
+        void PNGWidget::compressionLevelCallback(int in)
+        {
+            _options.compressionLevel = in;
+            pluginUpdate();
+        }
+
+        void PNGWidget::filterCallback(int in)
+        {
+            _options.filter = static_cast<Graphics::PNG::FILTER>(in);
+            pluginUpdate();
+        }
+
+        void PNGWidget::strategyCallback(int in)
+        {
+            _options.strategy = static_cast<Graphics::PNG::STRATEGY>(in);
+            pluginUpdate();
+        }
+
+        void PNGWidget::threadsCallback(int in)
+        {
+            _options.threads = in;
+            pluginUpdate();
+        }
+
+        void PNGWidget::pluginUpdate()
+        {
+            QStringList tmp;
+            tmp << _options.compressionLevel;
+            plugin()->setOption(
+                plugin()->options()[Graphics::PNG::COMPRESSION_LEVEL_OPTION], tmp);
+            tmp << _options.filter;
+            plugin()->setOption(
+                plugin()->options()[Graphics::PNG::FILTER_OPTION], tmp);
+            tmp << _options.strategy;
+            plugin()->setOption(
+                plugin()->options()[Graphics::PNG::STRATEGY_OPTION], tmp);
+            tmp << _options.threads;
+            plugin()->setOption(
+                plugin()->options()[Graphics::PNG::THREADS_OPTION], tmp);
+        }
+
+        void PNGWidget::widgetUpdate()
+        {
+            Core::SignalBlocker signalBlocker(QObjectList() <<
+                _compressionLevelWidget <<
+                _filterWidget <<
+                _strategyWidget <<
+                _threadsWidget);
+            _compressionLevelWidget->setValue(_options.compressionLevel);
+            _filterWidget->setCurrentIndex(_options.filter);
+            _strategyWidget->setCurrentIndex(_options.strategy);
+            _threadsWidget->setValue(_options.threads);
+        }
+
+        PNGWidgetPlugin::PNGWidgetPlugin(const QPointer<Core::CoreContext> & context) :
+            ImageIOWidgetPlugin(context)
+        {}
+
+        ImageIOWidget * PNGWidgetPlugin::createWidget(Graphics::ImageIO * plugin) const
+        {
+            return new PNGWidget(plugin, uiContext());
+        }
+
+        QString PNGWidgetPlugin::pluginName() const
+        {
+            return Graphics::PNG::staticName;
+        }
+
+    } // namespace UI
+} // namespace djv
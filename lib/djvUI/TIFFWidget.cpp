@@ -30,6 +30,7 @@
 #include <djvUI/TIFFWidget.h>
 
 #include <djvUI/UIContext.h>
+#include <djvUI/IntEdit.h>
 #include <djvUI/PrefsGroupBox.h>
 
 #include <djvGraphics/ImageIO.h>
@@ -37,6 +38,7 @@
 #include <djvCore/SignalBlocker.h>
 
 #include <QApplication>
+#include <QCheckBox>
 #include <QComboBox>
 #include <QFormLayout>
 #include <QVBoxLayout>
@@ -56,6 +58,13 @@ namespace djv
             _compressionWidget->setSizePolicy(
                 QSizePolicy::Fixed, QSizePolicy::Fixed);
 
+            _predictorWidget = new QCheckBox(
+                qApp->translate("djv::UI::TIFFWidget", "Use a predictor"));
+
+            _rowsPerStripWidget = new IntEdit;
+            _rowsPerStripWidget->setRange(1, 65536);
+            _rowsPerStripWidget->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+
             // Layout the widgets.
             _layout = new QVBoxLayout(this);
 
@@ -67,6 +76,10 @@ namespace djv
             formLayout->addRow(
                 qApp->translate("djv::UI::TIFFWidget", "Compression:"),
                 _compressionWidget);
+            formLayout->addRow(_predictorWidget);
+            formLayout->addRow(
+                qApp->translate("djv::UI::TIFFWidget", "Rows per strip:"),
+                _rowsPerStripWidget);
             _layout->addWidget(prefsGroupBox);
 
             _layout->addStretch();
@@ -76,6 +89,12 @@ namespace djv
             tmp = plugin->option(
                 plugin->options()[Graphics::TIFF::COMPRESSION_OPTION]);
             tmp >> _options.compression;
+            tmp = plugin->option(
+                plugin->options()[Graphics::TIFF::PREDICTOR_OPTION]);
+            tmp >> _options.predictor;
+            tmp = plugin->option(
+                plugin->options()[Graphics::TIFF::ROWS_PER_STRIP_OPTION]);
+            tmp >> _options.rowsPerStrip;
 
             widgetUpdate();
 
@@ -88,6 +107,14 @@ namespace djv
                 _compressionWidget,
                 SIGNAL(activated(int)),
                 SLOT(compressionCallback(int)));
+            connect(
+                _predictorWidget,
+                SIGNAL(toggled(bool)),
+                SLOT(predictorCallback(bool)));
+            connect(
+                _rowsPerStripWidget,
+                SIGNAL(valueChanged(int)),
+                SLOT(rowsPerStripCallback(int)));
         }
 
         void TIFFWidget::resetPreferences()
@@ -106,6 +133,12 @@ namespace djv
                 if (0 == option.compare(plugin()->options()[
                     Graphics::TIFF::COMPRESSION_OPTION], Qt::CaseInsensitive))
                     tmp >> _options.compression;
+                else if (0 == option.compare(plugin()->options()[
+                    Graphics::TIFF::PREDICTOR_OPTION], Qt::CaseInsensitive))
+                    tmp >> _options.predictor;
+                else if (0 == option.compare(plugin()->options()[
+                    Graphics::TIFF::ROWS_PER_STRIP_OPTION], Qt::CaseInsensitive))
+                    tmp >> _options.rowsPerStrip;
             }
             catch (const QString &)
             {
@@ -119,18 +152,41 @@ namespace djv
             pluginUpdate();
         }
 
+        void TIFFWidget::predictorCallback(bool in)
+        {
+            _options.predictor = in;
+            pluginUpdate();
+        }
+
+        void TIFFWidget::rowsPerStripCallback(int in)
+        {
+            _options.rowsPerStrip = in;
+            pluginUpdate();
+        }
+
         void TIFFWidget::pluginUpdate()
         {
             QStringList tmp;
             tmp << _options.compression;
             plugin()->setOption(
                 plugin()->options()[Graphics::TIFF::COMPRESSION_OPTION], tmp);
+            tmp << _options.predictor;
+            plugin()->setOption(
+                plugin()->options()[Graphics::TIFF::PREDICTOR_OPTION], tmp);
+            tmp << _options.rowsPerStrip;
+            plugin()->setOption(
+                plugin()->options()[Graphics::TIFF::ROWS_PER_STRIP_OPTION], tmp);
         }
 
         void TIFFWidget::widgetUpdate()
         {
-            Core::SignalBlocker signalBlocker(_compressionWidget);
+            Core::SignalBlocker signalBlocker(QObjectList() <<
+                _compressionWidget <<
+                _predictorWidget <<
+                _rowsPerStripWidget);
             _compressionWidget->setCurrentIndex(_options.compression);
+            _predictorWidget->setChecked(_options.predictor);
+            _rowsPerStripWidget->setValue(_options.rowsPerStrip);
         }
 
         TIFFWidgetPlugin::TIFFWidgetPlugin(const QPointer<Core::CoreContext> & context) :
@@ -33,6 +33,7 @@
 
 #include <djvGraphics/TIFF.h>
 
+class QCheckBox;
 class QComboBox;
 class QVBoxLayout;
 
@@ -40,6 +41,8 @@ namespace djv
 {
     namespace UI
     {
+        class IntEdit;
+
         //! This class provides a TIFF widget.
         class TIFFWidget : public ImageIOWidget
         {
@@ -53,6 +56,8 @@ namespace djv
         private Q_SLOTS:
             void pluginCallback(const QString &);
             void compressionCallback(int);
+            void predictorCallback(bool);
+            void rowsPerStripCallback(int);
 
             void pluginUpdate();
             void widgetUpdate();
@@ -60,6 +65,8 @@ namespace djv
         private:
             Graphics::TIFF::Options _options;
             QComboBox * _compressionWidget = nullptr;
+            QCheckBox * _predictorWidget = nullptr;
+            IntEdit * _rowsPerStripWidget = nullptr;
             QVBoxLayout * _layout = nullptr;
         };
 
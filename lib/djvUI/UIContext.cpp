@@ -59,6 +59,9 @@
 #if defined(JPEG_FOUND)
 #include <djvUI/JPEGWidget.h>
 #endif // JPEG_FOUND
+#if defined(PNG_FOUND)
+#include <djvUI/PNGWidget.h>
+#endif // PNG_FOUND
 #if defined(TIFF_FOUND)
 #include <djvUI/TIFFWidget.h>
 #endif // TIFF_FOUND
@@ -167,7 +170,7 @@ namespace djv
             _p->prefs->fileBrowser.reset(new FileBrowserPrefs(this));
 
             // Initialize.
-            _p->fileBrowser->cache.reset(new FileBrowserCache);
+            _p->fileBrowser->cache.reset(new FileBrowserCache(memoryBudget()));
             _p->fileBrowser->cache->setMaxCost(fileBrowserPrefs()->thumbnailCache());
             _p->fileBrowser->thumbnailSystem.reset(new FileBrowserThumbnailSystem(this));
             _p->fileBrowser->thumbnailSystem->start();
@@ -243,6 +246,9 @@ namespace djv
 #if defined(JPEG_FOUND)
                 _p->widgets->imageIOWidgetFactory->addPlugin(new JPEGWidgetPlugin(that));
 #endif // JPEG_FOUND
+#if defined(PNG_FOUND)
+                _p->widgets->imageIOWidgetFactory->addPlugin(new PNGWidgetPlugin(that));
+#endif // PNG_FOUND
 #if defined(TIFF_FOUND)
                 _p->widgets->imageIOWidgetFactory->addPlugin(new TIFFWidgetPlugin(that));
 #endif // TIFF_FOUND
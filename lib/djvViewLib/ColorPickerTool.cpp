@@ -41,11 +41,9 @@
 #include <djvUI/Prefs.h>
 #include <djvUI/ToolButton.h>
 
-#include <djvGraphics/OpenGLImage.h>
-#include <djvGraphics/OpenGLOffscreenBuffer.h>
+#include <djvGraphics/ColorPipeline.h>
 
 #include <djvCore/Debug.h>
-#include <djvCore/Error.h>
 #include <djvCore/SignalBlocker.h>
 
 #include <QApplication>
@@ -69,7 +67,6 @@ namespace djv
             bool displayProfile = true;
             bool lock = false;
 
-            std::unique_ptr<Graphics::OpenGLImage> openGLImage;
             bool swatchInit = false;
 
             QPointer<UI::ColorWidget> widget;
@@ -197,9 +194,6 @@ namespace djv
             prefs.set("colorProfile", _p->colorProfile);
             prefs.set("displayProfile", _p->displayProfile);
             prefs.set("lock", _p->lock);
-
-            context()->makeGLContextCurrent();
-            _p->openGLImage.reset();
         }
 
         void ColorPickerTool::showEvent(QShowEvent *)
@@ -305,42 +299,25 @@ namespace djv
                     glm::vec2(_p->pick - viewWidget()->viewPos()) / viewWidget()->viewZoom());
                 //DJV_DEBUG_PRINT("pick = " << _p->pick);
 
-                // Render color sample.
+                // Sample the color.
                 //DJV_DEBUG_PRINT("pick size = " << _p->size);
-                Graphics::PixelData tmp(Graphics::PixelDataInfo(glm::ivec2(_p->size, _p->size), _p->value.pixel()));
-                //DJV_DEBUG_PRINT("tmp = " << tmp);
-                try
+                Graphics::OpenGLImageOptions options = viewWidget()->options();
+                options.xform.position -= pick - glm::ivec2((_p->size - 1) / 2);
+                if (!_p->colorProfile)
+                {
+                    options.colorProfile = Graphics::ColorProfile();
+                }
+                if (!_p->displayProfile)
                 {
-                    context()->makeGLContextCurrent();
-                    if (!_p->openGLImage)
-                    {
-                        _p->openGLImage.reset(new Graphics::OpenGLImage);
-                    }
-
-                    Graphics::OpenGLImageOptions options = viewWidget()->options();
-                    options.xform.position -= pick - glm::ivec2((_p->size - 1) / 2);
-                    if (!_p->colorProfile)
-                    {
-                        options.colorProfile = Graphics::ColorProfile();
-                    }
-                    if (!_p->displayProfile)
-                    {
-                        options.displayProfile = DisplayProfile();
-                    }
-                    //DJV_DEBUG_PRINT("color profile = " << options.colorProfile);
-                    Graphics::PixelData empty;
-                    if (!data)
-                    {
-                        data = &empty;
-                    }
-                    _p->openGLImage->copy(*data, tmp, options);
-                    _p->openGLImage->average(tmp, _p->value);
+                    options.displayProfile = DisplayProfile();
                 }
-                catch (Core::Error error)
+                //DJV_DEBUG_PRINT("color profile = " << options.colorProfile);
+                Graphics::PixelData empty;
+                if (!data)
                 {
-                    error.add(Enum::errorLabels()[Enum::ERROR_PICK_COLOR]);
-                    context()->printError(error);
+                    data = &empty;
                 }
+                Graphics::ColorPipeline::average(*data, glm::ivec2(_p->size, _p->size), _p->value, options);
 
                 //DJV_DEBUG_PRINT("value = " << _p->value);
             }
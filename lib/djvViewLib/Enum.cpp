@@ -83,11 +83,24 @@ namespace djv
                 qApp->translate("djv::ViewLib::Enum", "Pixel") <<
                 qApp->translate("djv::ViewLib::Enum", "Tags") <<
                 qApp->translate("djv::ViewLib::Enum", "Playback Frame") <<
-                qApp->translate("djv::ViewLib::Enum", "Playback Speed");
+                qApp->translate("djv::ViewLib::Enum", "Playback Speed") <<
+                qApp->translate("djv::ViewLib::Enum", "Memory") <<
+                qApp->translate("djv::ViewLib::Enum", "Frame Timing");
             DJV_ASSERT(data.count() == HUD_COUNT);
             return data;
         }
 
+        const QStringList & Enum::frameStageLabels()
+        {
+            static const QStringList data = QStringList() <<
+                qApp->translate("djv::ViewLib::Enum", "Read") <<
+                qApp->translate("djv::ViewLib::Enum", "Convert") <<
+                qApp->translate("djv::ViewLib::Enum", "Upload") <<
+                qApp->translate("djv::ViewLib::Enum", "Draw");
+            DJV_ASSERT(data.count() == FRAME_STAGE_COUNT);
+            return data;
+        }
+
         const QStringList & Enum::hudBackgroundLabels()
         {
             static const QStringList data = QStringList() <<
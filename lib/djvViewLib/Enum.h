@@ -110,6 +110,8 @@ namespace djv
                 HUD_TAG,
                 HUD_FRAME,
                 HUD_SPEED,
+                HUD_MEMORY,
+                HUD_TIMING,
 
                 HUD_COUNT
             };
@@ -118,6 +120,21 @@ namespace djv
             //! Get the HUD information labels.
             static const QStringList & hudInfoLabels();
 
+            //! This enumeration provides the frame timing stages.
+            enum FRAME_STAGE
+            {
+                FRAME_STAGE_READ,
+                FRAME_STAGE_CONVERT,
+                FRAME_STAGE_UPLOAD,
+                FRAME_STAGE_DRAW,
+
+                FRAME_STAGE_COUNT
+            };
+            Q_ENUM(FRAME_STAGE);
+
+            //! Get the frame timing stage labels.
+            static const QStringList & frameStageLabels();
+
             //! This enumeration provides the HUD backgrounds.
             enum HUD_BACKGROUND
             {
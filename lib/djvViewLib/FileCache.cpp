@@ -29,20 +29,34 @@
 
 #include <djvViewLib/FileCache.h>
 
+#include <djvViewLib/FileCacheDisk.h>
 #include <djvViewLib/FilePrefs.h>
 #include <djvViewLib/ViewContext.h>
 
 #include <djvGraphics/Image.h>
+#include <djvGraphics/PixelDataUtil.h>
 
 #include <djvCore/Assert.h>
+#include <djvCore/DebugLog.h>
 #include <djvCore/ListUtil.h>
+#include <djvCore/Math.h>
 #include <djvCore/Memory.h>
+#include <djvCore/MemoryBudget.h>
 #include <djvCore/Time.h>
+#include <djvCore/Timer.h>
+#include <djvCore/Trace.h>
 
+#include <QCoreApplication>
+#include <QDir>
 #include <QPointer>
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <functional>
+#include <mutex>
+#include <set>
+#include <thread>
 
 namespace djv
 {
@@ -67,16 +81,203 @@ namespace djv
             return frame < other.frame;
         }
 
+        namespace
+        {
+            //! \todo Should this be configurable?
+            const int workerCountMax = 4;
+
+            struct CompressedItem
+            {
+                Graphics::PixelDataInfo info;
+                Graphics::ImageTags     tags;
+                Graphics::ColorProfile  colorProfile;
+                std::vector<quint8>     data;
+                quint64                 serial = 0;
+            };
+
+            std::shared_ptr<Graphics::Image> decompress(const CompressedItem & item)
+            {
+                auto out = std::shared_ptr<Graphics::Image>(new Graphics::Image(item.info));
+                if (!Graphics::PixelDataUtil::decompress(item.data, *out))
+                {
+                    return nullptr;
+                }
+                out->tags = item.tags;
+                out->colorProfile = item.colorProfile;
+                return out;
+            }
+
+            struct WorkerJob
+            {
+                FileCacheKey                          key;
+                quint64                               generation = 0;
+                std::shared_ptr<Graphics::Image>      image;
+                std::shared_ptr<const CompressedItem> compressed;
+                bool                                  disk = false;
+            };
+
+            struct WorkerResult
+            {
+                FileCacheKey                          key;
+                quint64                               generation = 0;
+                std::shared_ptr<Graphics::Image>      image;
+                std::shared_ptr<CompressedItem>       compressed;
+                bool                                  disk = false;
+                quint64                               diskId = 0;
+                quint64                               byteCount = 0;
+                float                                 seconds = 0.f;
+            };
+
+        } // namespace
+
         struct FileCache::Private
         {
             Private(const QPointer<ViewContext> & context) :
-                maxBytes(static_cast<quint64>(context->filePrefs()->cacheSizeGB() * Core::Memory::gigabyte)),
+                totalBytes(static_cast<quint64>(context->filePrefs()->cacheSizeGB() * Core::Memory::gigabyte)),
+                compression(context->filePrefs()->cacheCompression()),
                 context(context)
-            {}
+            {
+                maxBytes = totalBytes / 100 * (100 - compression);
+            }
+
+            ~Private()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    running = false;
+                }
+                cv.notify_all();
+                for (auto & thread : threads)
+                {
+                    thread.join();
+                }
+            }
+
+            void work(FileCache * fileCache)
+            {
+                while (1)
+                {
+                    WorkerJob job;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        cv.wait(lock, [this]
+                        {
+                            return !running || jobs.size();
+                        });
+                        if (!running)
+                            return;
+                        job = jobs.front();
+                        jobs.pop_front();
+                    }
+                    WorkerResult result;
+                    result.key = job.key;
+                    result.generation = job.generation;
+                    result.disk = job.disk;
+                    Core::Timer timer;
+                    if (job.image && job.disk)
+                    {
+                        DJV_TRACE("FileCache::diskWrite", "FileCache");
+                        result.diskId = disk.write(*job.image);
+                        result.byteCount = job.image->dataByteCount();
+                    }
+                    else if (job.image)
+                    {
+                        DJV_TRACE("FileCache::compress", "FileCache");
+                        auto compressed = std::shared_ptr<CompressedItem>(new CompressedItem);
+                        compressed->info = job.image->info();
+                        compressed->tags = job.image->tags;
+                        compressed->colorProfile = job.image->colorProfile;
+                        Graphics::PixelDataUtil::compress(*job.image, compressed->data);
+                        result.compressed = compressed;
+                        result.byteCount = job.image->dataByteCount();
+                    }
+                    else if (job.compressed)
+                    {
+                        DJV_TRACE("FileCache::decompress", "FileCache");
+                        result.image = decompress(*job.compressed);
+                        result.byteCount = result.image ? result.image->dataByteCount() : 0;
+                    }
+                    timer.check();
+                    result.seconds = timer.seconds();
+                    bool notify = false;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        notify = results.empty();
+                        results.push_back(result);
+                    }
+                    if (notify)
+                    {
+                        QMetaObject::invokeMethod(fileCache, "workerCallback", Qt::QueuedConnection);
+                    }
+                }
+            }
+
+            void addJob(FileCache * fileCache, const WorkerJob & job)
+            {
+                if (threads.empty())
+                {
+                    running = true;
+                    const int count = std::max(1, std::min(
+                        workerCountMax,
+                        static_cast<int>(std::thread::hardware_concurrency()) / 2));
+                    for (int i = 0; i < count; ++i)
+                    {
+                        threads.push_back(std::thread([this, fileCache]
+                        {
+                            work(fileCache);
+                        }));
+                    }
+                }
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    jobs.push_back(job);
+                }
+                cv.notify_one();
+                (job.disk ? diskPending : pending).insert(job.key);
+            }
+
+            // Discard the results of the workers.
+            void discardResults()
+            {
+                ++generation;
+                pending.clear();
+                diskPending.clear();
+            }
 
             std::map<FileCacheKey, std::shared_ptr<Graphics::Image> > items;
+            quint64 totalBytes = 0;
             quint64 maxBytes = 0;
             quint64 cacheBytes = 0;
+            int budgetClient = 0;
+
+            std::map<FileCacheKey, std::shared_ptr<CompressedItem> > compressedItems;
+            int compression = 0;
+            quint64 compressedBytes = 0;
+            quint64 compressedSerial = 0;
+            int compressedBudgetClient = 0;
+            quint64 compressRawBytes = 0;
+            quint64 compressOutBytes = 0;
+            float compressSeconds = 0.f;
+            quint64 decompressBytes = 0;
+            float decompressSeconds = 0.f;
+
+            FileCacheDisk disk;
+            quint64 diskWriteBytes = 0;
+            float diskWriteSeconds = 0.f;
+
+            quint64 hits[TIER_COUNT] = { 0, 0, 0 };
+            quint64 misses[TIER_COUNT] = { 0, 0, 0 };
+
+            std::set<FileCacheKey> pending;
+            std::set<FileCacheKey> diskPending;
+            quint64 generation = 0;
+            std::vector<std::thread> threads;
+            std::mutex mutex;
+            std::condition_variable cv;
+            std::deque<WorkerJob> jobs;
+            std::vector<WorkerResult> results;
+            bool running = false;
+
             QPointer<ViewContext> context;
         };
 
@@ -85,6 +286,21 @@ namespace djv
             _p(new Private(context))
         {
             //DJV_DEBUG("FileCache::FileCache");
+            _p->budgetClient = context->memoryBudget()->addClient(
+                qApp->translate("djv::ViewLib::FileCache", "File cache"),
+                Core::MemoryBudget::PRIORITY_NORMAL,
+                [this](quint64 bytes)
+            {
+                return release(bytes);
+            });
+            _p->compressedBudgetClient = context->memoryBudget()->addClient(
+                qApp->translate("djv::ViewLib::FileCache", "File cache (compressed)"),
+                Core::MemoryBudget::PRIORITY_LOW,
+                [this](quint64 bytes)
+            {
+                return releaseCompressed(bytes);
+            });
+
             connect(
                 context->filePrefs(),
                 SIGNAL(cacheEnabledChanged(bool)),
@@ -93,12 +309,31 @@ namespace djv
                 context->filePrefs(),
                 SIGNAL(cacheSizeGBChanged(float)),
                 SLOT(cacheSizeGBCallback(float)));
+            connect(
+                context->filePrefs(),
+                SIGNAL(cacheCompressionChanged(int)),
+                SLOT(cacheCompressionCallback(int)));
+            connect(
+                context->filePrefs(),
+                SIGNAL(diskCacheSizeGBChanged(int)),
+                SLOT(diskCacheCallback()));
+            connect(
+                context->filePrefs(),
+                SIGNAL(diskCachePathChanged(const QString &)),
+                SLOT(diskCacheCallback()));
+
+            diskUpdate();
         }
 
         FileCache::~FileCache()
         {
             //DJV_DEBUG("FileCache::~FileCache");
             //debug();
+            if (_p->context)
+            {
+                _p->context->memoryBudget()->removeClient(_p->budgetClient);
+                _p->context->memoryBudget()->removeClient(_p->compressedBudgetClient);
+            }
         }
 
         bool FileCache::hasItem(const FileCacheKey & key)
@@ -111,6 +346,94 @@ namespace djv
             return _p->items.find(key)->second;
         }
 
+        bool FileCache::findItem(const FileCacheKey & key)
+        {
+            if (hasItem(key))
+            {
+                ++_p->hits[TIER_MEMORY];
+                return true;
+            }
+            ++_p->misses[TIER_MEMORY];
+            if (_p->compression)
+            {
+                if (decompressItem(key))
+                {
+                    ++_p->hits[TIER_COMPRESSED];
+                    return true;
+                }
+                ++_p->misses[TIER_COMPRESSED];
+            }
+            if (_p->disk.isOpen())
+            {
+                if (readDiskItem(key))
+                {
+                    ++_p->hits[TIER_DISK];
+                    return true;
+                }
+                ++_p->misses[TIER_DISK];
+            }
+            return false;
+        }
+
+        bool FileCache::hasCompressedItem(const FileCacheKey & key) const
+        {
+            return _p->compressedItems.find(key) != _p->compressedItems.end();
+        }
+
+        bool FileCache::decompressItem(const FileCacheKey & key)
+        {
+            //DJV_DEBUG("FileCache::decompressItem");
+            DJV_TRACE("FileCache::decompressItem", "FileCache");
+            const auto i = _p->compressedItems.find(key);
+            if (i == _p->compressedItems.end())
+                return false;
+            Core::Timer timer;
+            auto image = decompress(*i->second);
+            if (!image)
+                return false;
+            timer.check();
+            _p->decompressBytes += image->dataByteCount();
+            _p->decompressSeconds += timer.seconds();
+            addItem(FileCacheKey(key.window, key.frame), image);
+            return true;
+        }
+
+        bool FileCache::hasDiskItem(const FileCacheKey & key) const
+        {
+            return _p->disk.hasItem(key);
+        }
+
+        bool FileCache::readDiskItem(const FileCacheKey & key)
+        {
+            //DJV_DEBUG("FileCache::readDiskItem");
+            DJV_TRACE("FileCache::readDiskItem", "FileCache");
+            auto image = _p->disk.item(key);
+            if (!image)
+                return false;
+            addItem(FileCacheKey(key.window, key.frame), image);
+            return true;
+        }
+
+        bool FileCache::requestItem(const FileCacheKey & key)
+        {
+            const auto i = _p->compressedItems.find(key);
+            if (i == _p->compressedItems.end())
+            {
+                // Mapping an item from the disk tier is cheap, the pages are
+                // read ahead by the operating system.
+                return readDiskItem(key);
+            }
+            if (_p->pending.find(key) == _p->pending.end())
+            {
+                WorkerJob job;
+                job.key = key;
+                job.generation = _p->generation;
+                job.compressed = i->second;
+                _p->addJob(this, job);
+            }
+            return true;
+        }
+
         void FileCache::addItem(const FileCacheKey & key, const std::shared_ptr<Graphics::Image> & item)
         {
             _p->items[key] = item;
@@ -119,6 +442,7 @@ namespace djv
             {
                 purge();
             }
+            usageUpdate();
             Q_EMIT cacheChanged();
             debug();
         }
@@ -138,6 +462,9 @@ namespace djv
                     ++i;
                 }
             }
+            compressedClear(window);
+            _p->disk.clearItems(window);
+            usageUpdate();
             Q_EMIT cacheChanged();
             debug();
         }
@@ -150,6 +477,9 @@ namespace djv
                 _p->cacheBytes -= i->second->dataByteCount();
                 i = _p->items.erase(i);
             }
+            compressedClear(nullptr);
+            _p->disk.clearItems(nullptr);
+            usageUpdate();
             Q_EMIT cacheChanged();
             debug();
         }
@@ -162,6 +492,110 @@ namespace djv
                 _p->cacheBytes -= i->second->dataByteCount();
                 _p->items.erase(i);
             }
+            auto j = _p->compressedItems.find(key);
+            if (j != _p->compressedItems.end())
+            {
+                _p->compressedBytes -= j->second->data.size();
+                _p->compressedItems.erase(j);
+            }
+            _p->disk.removeItem(key);
+            if (_p->pending.find(key) != _p->pending.end() ||
+                _p->diskPending.find(key) != _p->diskPending.end())
+            {
+                _p->discardResults();
+            }
+            usageUpdate();
+        }
+
+        void FileCache::moveItems(void * window, qint64 frame, qint64 offset)
+        {
+            std::vector<std::pair<FileCacheKey, std::shared_ptr<Graphics::Image> > > moved;
+            auto i = _p->items.begin();
+            while (i != _p->items.end())
+            {
+                if (window == i->first.window && i->first.frame >= frame)
+                {
+                    FileCacheKey key = i->first;
+                    key.frame += offset;
+                    moved.push_back(std::make_pair(key, i->second));
+                    i = _p->items.erase(i);
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+            for (const auto & j : moved)
+            {
+                _p->items[j.first] = j.second;
+            }
+            std::vector<std::pair<FileCacheKey, std::shared_ptr<CompressedItem> > > compressedMoved;
+            auto j = _p->compressedItems.begin();
+            while (j != _p->compressedItems.end())
+            {
+                if (window == j->first.window && j->first.frame >= frame)
+                {
+                    FileCacheKey key = j->first;
+                    key.frame += offset;
+                    compressedMoved.push_back(std::make_pair(key, j->second));
+                    j = _p->compressedItems.erase(j);
+                }
+                else
+                {
+                    ++j;
+                }
+            }
+            for (const auto & k : compressedMoved)
+            {
+                _p->compressedItems[k.first] = k.second;
+            }
+            _p->disk.moveItems(window, frame, offset);
+            _p->discardResults();
+            Q_EMIT cacheChanged();
+        }
+
+        quint64 FileCache::release(quint64 bytes)
+        {
+            //DJV_DEBUG("FileCache::release");
+            //DJV_DEBUG_PRINT("bytes = " << bytes);
+
+            // Items that are still referenced elsewhere would not free any
+            // memory, so only the unused items are candidates.
+            std::multimap<::time_t, FileCacheKey> sortedByTime;
+            for (const auto & i : _p->items)
+            {
+                if (i.second.use_count() == 1)
+                {
+                    sortedByTime.insert(std::make_pair(i.first.timestamp, i.first));
+                }
+            }
+            quint64 released = 0;
+            for (auto i = sortedByTime.begin(); i != sortedByTime.end() && released < bytes; ++i)
+            {
+                auto j = _p->items.find(i->second);
+                const quint64 size = j->second->dataByteCount();
+                _p->cacheBytes -= size;
+                released += size;
+                _p->items.erase(j);
+            }
+            //DJV_DEBUG_PRINT("released = " << released);
+            if (released)
+            {
+                usageUpdate();
+                Q_EMIT cacheChanged();
+            }
+            return released;
+        }
+
+        quint64 FileCache::releaseCompressed(quint64 bytes)
+        {
+            const quint64 size = _p->compressedBytes;
+            const quint64 released = compressedPurge(bytes < size ? size - bytes : 0);
+            if (released)
+            {
+                usageUpdate();
+            }
+            return released;
         }
 
         std::vector<std::shared_ptr<Graphics::Image> > FileCache::items(void * window)
@@ -233,6 +667,76 @@ namespace djv
             return _p->cacheBytes;
         }
 
+        int FileCache::compression() const
+        {
+            return _p->compression;
+        }
+
+        quint64 FileCache::compressedMaxSizeBytes() const
+        {
+            return _p->totalBytes / 100 * _p->compression;
+        }
+
+        quint64 FileCache::compressedSizeBytes() const
+        {
+            return _p->compressedBytes;
+        }
+
+        float FileCache::compressionRatio() const
+        {
+            return _p->compressOutBytes ? (_p->compressRawBytes / static_cast<float>(_p->compressOutBytes)) : 0.f;
+        }
+
+        float FileCache::compressThroughput() const
+        {
+            return _p->compressSeconds > 0.f ? (_p->compressRawBytes / _p->compressSeconds) : 0.f;
+        }
+
+        float FileCache::decompressThroughput() const
+        {
+            return _p->decompressSeconds > 0.f ? (_p->decompressBytes / _p->decompressSeconds) : 0.f;
+        }
+
+        bool FileCache::hasDiskCache() const
+        {
+            return _p->disk.isOpen();
+        }
+
+        quint64 FileCache::diskMaxSizeBytes() const
+        {
+            return _p->disk.maxSizeBytes();
+        }
+
+        quint64 FileCache::diskSizeBytes() const
+        {
+            return _p->disk.sizeBytes();
+        }
+
+        float FileCache::diskWriteThroughput() const
+        {
+            return _p->diskWriteSeconds > 0.f ? (_p->diskWriteBytes / _p->diskWriteSeconds) : 0.f;
+        }
+
+        const QStringList & FileCache::tierLabels()
+        {
+            static const QStringList data = QStringList() <<
+                qApp->translate("djv::ViewLib::FileCache", "Memory") <<
+                qApp->translate("djv::ViewLib::FileCache", "Compressed") <<
+                qApp->translate("djv::ViewLib::FileCache", "Disk");
+            DJV_ASSERT(TIER_COUNT == data.count());
+            return data;
+        }
+
+        quint64 FileCache::hits(TIER tier) const
+        {
+            return _p->hits[tier];
+        }
+
+        quint64 FileCache::misses(TIER tier) const
+        {
+            return _p->misses[tier];
+        }
+
         const QVector<float> & FileCache::sizeGBDefaults()
         {
             static const QVector<float> data = QVector<float>() <<
@@ -253,6 +757,13 @@ namespace djv
             DJV_DEBUG_PRINT("items = " << _p->items.size());
             DJV_DEBUG_PRINT("max = " << maxSizeGB());
             DJV_DEBUG_PRINT("size = " << currentSizeGB());
+            DJV_DEBUG_PRINT("compressed items = " << _p->compressedItems.size());
+            DJV_DEBUG_PRINT("compressed size = " << _p->compressedBytes);
+            DJV_DEBUG_PRINT("disk size = " << _p->disk.sizeBytes());
+            for (int i = 0; i < TIER_COUNT; ++i)
+            {
+                DJV_DEBUG_PRINT(tierLabels()[i] << " hits = " << _p->hits[i] << " misses = " << _p->misses[i]);
+            }
             for (auto i = _p->items.begin(); i != _p->items.end(); ++i)
             {
                 DJV_DEBUG_PRINT(
@@ -270,12 +781,30 @@ namespace djv
             //DJV_DEBUG("FileCache::setMaxSizeGB");
             //DJV_DEBUG_PRINT("size = " << size);
             //debug();
-            _p->maxBytes = static_cast<quint64>(size * Core::Memory::gigabyte);
+            _p->totalBytes = static_cast<quint64>(size * Core::Memory::gigabyte);
+            _p->maxBytes = _p->totalBytes / 100 * (100 - _p->compression);
             //if (_p->cacheBytes > _p->maxBytes)
             purge();
+            compressedPurge(compressedMaxSizeBytes());
+            usageUpdate();
             //debug();
         }
 
+        void FileCache::setCompression(int value)
+        {
+            //DJV_DEBUG("FileCache::setCompression");
+            //DJV_DEBUG_PRINT("value = " << value);
+            value = Core::Math::clamp(value, 0, 100);
+            if (value == _p->compression)
+                return;
+            _p->compression = value;
+            if (!_p->compression)
+            {
+                compressedClear(nullptr);
+            }
+            setMaxSizeGB(_p->totalBytes / static_cast<float>(Core::Memory::gigabyte));
+        }
+
         void FileCache::purge()
         {
             //DJV_DEBUG("FileCache::purge");
@@ -294,15 +823,119 @@ namespace djv
                 if (k != _p->items.end())
                 {
                     _p->cacheBytes -= k->second->dataByteCount();
+                    compressItem(k->first, k->second);
+                    writeDiskItem(k->first, k->second);
                     _p->items.erase(k);
                     j = sortedByTime.erase(j);
                 }
             }
 
+            usageUpdate();
             Q_EMIT cacheChanged();
             debug();
         }
 
+        void FileCache::compressItem(const FileCacheKey & key, const std::shared_ptr<Graphics::Image> & image)
+        {
+            if (!_p->compression ||
+                hasCompressedItem(key) ||
+                _p->pending.find(key) != _p->pending.end())
+                return;
+            WorkerJob job;
+            job.key = key;
+            job.generation = _p->generation;
+            job.image = image;
+            _p->addJob(this, job);
+        }
+
+        void FileCache::writeDiskItem(const FileCacheKey & key, const std::shared_ptr<Graphics::Image> & image)
+        {
+            if (!_p->disk.isOpen() ||
+                _p->disk.hasItem(key) ||
+                _p->diskPending.find(key) != _p->diskPending.end())
+                return;
+            WorkerJob job;
+            job.key = key;
+            job.generation = _p->generation;
+            job.image = image;
+            job.disk = true;
+            _p->addJob(this, job);
+        }
+
+        void FileCache::diskUpdate()
+        {
+            //DJV_DEBUG("FileCache::diskUpdate");
+            const int sizeGB = _p->context->filePrefs()->diskCacheSizeGB();
+            const QString & path = _p->context->filePrefs()->diskCachePath();
+            //DJV_DEBUG_PRINT("size = " << sizeGB);
+            //DJV_DEBUG_PRINT("path = " << path);
+            _p->disk.close();
+            _p->discardResults();
+            if (sizeGB > 0)
+            {
+                try
+                {
+                    _p->disk.open(path, static_cast<quint64>(sizeGB) * Core::Memory::gigabyte);
+                    DJV_LOG(_p->context->debugLog(), "djv::ViewLib::FileCache",
+                        QString("Disk cache: %1, %2").
+                        arg(QDir::toNativeSeparators(_p->disk.fileName())).
+                        arg(Core::Memory::sizeLabel(_p->disk.maxSizeBytes())));
+                }
+                catch (const Core::Error & error)
+                {
+                    _p->context->printError(error);
+                }
+            }
+            Q_EMIT cacheChanged();
+        }
+
+        quint64 FileCache::compressedPurge(quint64 bytes)
+        {
+            std::map<quint64, FileCacheKey> sortedBySerial;
+            for (const auto & i : _p->compressedItems)
+            {
+                sortedBySerial[i.second->serial] = i.first;
+            }
+            quint64 released = 0;
+            for (auto i = sortedBySerial.begin(); i != sortedBySerial.end() && _p->compressedBytes > bytes; ++i)
+            {
+                auto j = _p->compressedItems.find(i->second);
+                const quint64 size = j->second->data.size();
+                _p->compressedBytes -= size;
+                released += size;
+                _p->compressedItems.erase(j);
+            }
+            return released;
+        }
+
+        void FileCache::compressedClear(void * window)
+        {
+            auto i = _p->compressedItems.begin();
+            while (i != _p->compressedItems.end())
+            {
+                if (!window || window == i->first.window)
+                {
+                    _p->compressedBytes -= i->second->data.size();
+                    i = _p->compressedItems.erase(i);
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+            _p->discardResults();
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                _p->jobs.clear();
+            }
+        }
+
+        void FileCache::usageUpdate()
+        {
+            _p->context->memoryBudget()->setUsage(_p->budgetClient, _p->cacheBytes);
+            _p->context->memoryBudget()->setUsage(_p->compressedBudgetClient, _p->compressedBytes);
+        }
+
         void FileCache::cacheEnabledCallback(bool cache)
         {
             if (!cache)
@@ -316,5 +949,87 @@ namespace djv
             setMaxSizeGB(size);
         }
 
+        void FileCache::cacheCompressionCallback(int value)
+        {
+            setCompression(value);
+        }
+
+        void FileCache::diskCacheCallback()
+        {
+            diskUpdate();
+        }
+
+        void FileCache::workerCallback()
+        {
+            //DJV_DEBUG("FileCache::workerCallback");
+            std::vector<WorkerResult> results;
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                results.swap(_p->results);
+            }
+            bool changed = false;
+            for (const auto & result : results)
+            {
+                if (result.generation != _p->generation)
+                {
+                    if (result.diskId)
+                    {
+                        _p->disk.discard(result.diskId);
+                    }
+                    continue;
+                }
+                if (result.disk)
+                {
+                    _p->diskPending.erase(result.key);
+                    _p->diskWriteBytes += result.byteCount;
+                    _p->diskWriteSeconds += result.seconds;
+                    if (result.diskId)
+                    {
+                        _p->disk.commit(result.diskId, result.key);
+                    }
+                    continue;
+                }
+                _p->pending.erase(result.key);
+                if (result.compressed)
+                {
+                    _p->compressRawBytes += result.byteCount;
+                    _p->compressOutBytes += result.compressed->data.size();
+                    _p->compressSeconds += result.seconds;
+                    if (_p->compression && !hasCompressedItem(result.key))
+                    {
+                        result.compressed->serial = ++_p->compressedSerial;
+                        _p->compressedItems[result.key] = result.compressed;
+                        _p->compressedBytes += result.compressed->data.size();
+                    }
+                }
+                else if (result.image)
+                {
+                    _p->decompressBytes += result.byteCount;
+                    _p->decompressSeconds += result.seconds;
+                    if (!hasItem(result.key))
+                    {
+                        // Refresh the timestamp so the item is not the first to be purged.
+                        const FileCacheKey key(result.key.window, result.key.frame);
+                        _p->items[key] = result.image;
+                        _p->cacheBytes += result.image->dataByteCount();
+                        changed = true;
+                    }
+                }
+            }
+            compressedPurge(compressedMaxSizeBytes());
+            if (_p->cacheBytes > _p->maxBytes)
+            {
+                purge();
+            }
+            else
+            {
+                usageUpdate();
+                if (changed)
+                {
+                    Q_EMIT cacheChanged();
+                }
+            }
+        }
+
     } // namespace ViewLib
 } // namespace djv
@@ -36,6 +36,7 @@
 #include <djvCore/Util.h>
 
 #include <QObject>
+#include <QStringList>
 
 #include <memory>
 #include <map>
@@ -65,6 +66,17 @@ namespace djv
         };
 
         //! This class provides the file cache.
+        //!
+        //! The cache has three tiers. Decoded images are kept in the first tier,
+        //! and when they are purged they can be losslessly compressed into an
+        //! optional second tier on worker threads. Compressed images are
+        //! decompressed back into the first tier on demand, or ahead of the
+        //! playhead with requestItem(). The maximum cache size is split between
+        //! the tiers by the compression percentage.
+        //!
+        //! Purged images can also be written to an optional third tier on
+        //! local disk (see FileCacheDisk), which re-admits them into the first
+        //! tier by memory-mapping them instead of decoding them again.
         class FileCache : public QObject
         {
             Q_OBJECT
@@ -79,6 +91,31 @@ namespace djv
             //! Get an item from the cache.
             std::shared_ptr<Graphics::Image> item(const FileCacheKey &) const;
 
+            //! Get whether the cache contains an item, restoring it from the
+            //! compressed or disk tiers if necessary. The result is counted in
+            //! the tier statistics.
+            bool findItem(const FileCacheKey &);
+
+            //! Get whether the compressed tier contains an item.
+            bool hasCompressedItem(const FileCacheKey &) const;
+
+            //! Decompress an item from the compressed tier into the cache on the
+            //! calling thread. Returns false if the item is not in the compressed
+            //! tier.
+            bool decompressItem(const FileCacheKey &);
+
+            //! Get whether the disk tier contains an item.
+            bool hasDiskItem(const FileCacheKey &) const;
+
+            //! Map an item from the disk tier into the cache. Returns false if
+            //! the item is not in the disk tier.
+            bool readDiskItem(const FileCacheKey &);
+
+            //! Decompress an item from the compressed tier into the cache on a
+            //! worker thread, or map it from the disk tier. Returns false if the
+            //! item is not in either tier.
+            bool requestItem(const FileCacheKey &);
+
             //! Add an item to the cache.
             void addItem(const FileCacheKey &, const std::shared_ptr<Graphics::Image> &);
 
@@ -91,6 +128,20 @@ namespace djv
             //! Remove an item.
             void removeItem(const FileCacheKey &);
 
+            //! Move the items that match the given window and have a frame greater
+            //! than or equal to the given frame by an offset. This is used when
+            //! frames are inserted or removed in the middle of a sequence.
+            void moveItems(void *, qint64 frame, qint64 offset);
+
+            //! Remove items that are not in use, oldest first, until the given
+            //! number of bytes have been released. Returns the number of bytes
+            //! released. This is called when the memory budget is exceeded.
+            quint64 release(quint64 bytes);
+
+            //! Remove compressed items, oldest first, until the given number of
+            //! bytes have been released. Returns the number of bytes released.
+            quint64 releaseCompressed(quint64 bytes);
+
             //! Get the list of items that match the given window.
             std::vector<std::shared_ptr<Graphics::Image> > items(void *);
 
@@ -113,6 +164,56 @@ namespace djv
             //! Get the current cache size in bytes.
             quint64 currentSizeBytes() const;
 
+            //! Get the percentage of the maximum cache size used by the compressed tier.
+            int compression() const;
+
+            //! Get the maximum compressed tier size in bytes.
+            quint64 compressedMaxSizeBytes() const;
+
+            //! Get the current compressed tier size in bytes.
+            quint64 compressedSizeBytes() const;
+
+            //! Get the ratio of uncompressed to compressed bytes.
+            float compressionRatio() const;
+
+            //! Get the compression throughput in bytes per second.
+            float compressThroughput() const;
+
+            //! Get the decompression throughput in bytes per second.
+            float decompressThroughput() const;
+
+            //! Get whether the disk tier is enabled.
+            bool hasDiskCache() const;
+
+            //! Get the maximum disk tier size in bytes.
+            quint64 diskMaxSizeBytes() const;
+
+            //! Get the current disk tier size in bytes.
+            quint64 diskSizeBytes() const;
+
+            //! Get the disk tier write throughput in bytes per second.
+            float diskWriteThroughput() const;
+
+            //! This enumeration provides the cache tiers.
+            enum TIER
+            {
+                TIER_MEMORY,
+                TIER_COMPRESSED,
+                TIER_DISK,
+
+                TIER_COUNT
+            };
+            Q_ENUM(TIER);
+
+            //! Get the cache tier labels.
+            static const QStringList & tierLabels();
+
+            //! Get the number of lookups that were found in the given tier.
+            quint64 hits(TIER) const;
+
+            //! Get the number of lookups that were not found in the given tier.
+            quint64 misses(TIER) const;
+
             //! Get the cache size defaults in gigabytes.
             static const QVector<float> & sizeGBDefaults();
 
@@ -123,6 +224,10 @@ namespace djv
             //! Set the maximum cache size in gigabytes.
             void setMaxSizeGB(float);
 
+            //! Set the percentage of the maximum cache size used by the compressed
+            //! tier. Zero disables the compressed tier.
+            void setCompression(int);
+
         Q_SIGNALS:
             //! This signal is emitted when the cache is modified.
             void cacheChanged();
@@ -130,13 +235,35 @@ namespace djv
         private Q_SLOTS:
             void cacheEnabledCallback(bool);
             void cacheSizeGBCallback(float);
+            void cacheCompressionCallback(int);
+            void diskCacheCallback();
+            void workerCallback();
 
         private:
             void removeItem(int index);
 
+            // Move an item into the compressed tier.
+            void compressItem(const FileCacheKey &, const std::shared_ptr<Graphics::Image> &);
+
+            // Write an item to the disk tier.
+            void writeDiskItem(const FileCacheKey &, const std::shared_ptr<Graphics::Image> &);
+
+            // Open or close the disk tier from the preferences.
+            void diskUpdate();
+
+            // Remove the oldest compressed items until the compressed tier is
+            // below the given size.
+            quint64 compressedPurge(quint64 bytes);
+
+            // Invalidate the compressed tier items and the worker results for
+            // the given window, or all windows if null.
+            void compressedClear(void *);
+
             // Delete null references only if the cache size exceeds the maximum.
             void purge();
 
+            void usageUpdate();
+
             DJV_PRIVATE_COPY(FileCache);
 
             struct Private;
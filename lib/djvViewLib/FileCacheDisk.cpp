@@ -0,0 +1,574 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvViewLib/FileCacheDisk.h>
+
+#include <djvGraphics/Image.h>
+#include <djvGraphics/PixelDataUtil.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Error.h>
+#include <djvCore/FileIO.h>
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QLockFile>
+
+#if ! defined(DJV_WINDOWS)
+#include <sys/mman.h>
+#endif // DJV_WINDOWS
+#if defined(DJV_LINUX)
+#include <fcntl.h>
+#endif // DJV_LINUX
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace djv
+{
+    namespace ViewLib
+    {
+        namespace
+        {
+            const quint32 headerMagic   = 0x43564a44;
+            const quint32 headerVersion = 1;
+
+            //! \todo Should this use the system page size?
+            const quint64 blockSize = 4096;
+
+            //! \todo Should this be configurable?
+            const int fileCountMax = 16;
+
+            struct EntryHeader
+            {
+                quint32 magic = 0;
+                quint32 version = 0;
+                quint64 session = 0;
+                quint64 id = 0;
+                quint64 dataByteCount = 0;
+                qint32  width = 0;
+                qint32  height = 0;
+                qint32  pixel = 0;
+                quint32 checksum = 0;
+            };
+
+            quint32 checksum(const EntryHeader & header)
+            {
+                // FNV-1a of the header fields.
+                quint32 out = 2166136261u;
+                const quint8 * p = reinterpret_cast<const quint8 *>(&header);
+                const quint8 * const end = reinterpret_cast<const quint8 *>(&header.checksum);
+                for (; p < end; ++p)
+                {
+                    out = (out ^ *p) * 16777619u;
+                }
+                return out;
+            }
+
+            quint64 align(quint64 value)
+            {
+                return (value + blockSize - 1) / blockSize * blockSize;
+            }
+
+            void dontNeed(const quint8 * p, quint64 size)
+            {
+#if ! defined(DJV_WINDOWS)
+                // The mapping is shared so this only drops the pages from the
+                // process, the data stays in the file.
+                ::madvise(const_cast<quint8 *>(p), size, MADV_DONTNEED);
+#endif // DJV_WINDOWS
+            }
+
+            void willNeed(const quint8 * p, quint64 size)
+            {
+#if ! defined(DJV_WINDOWS)
+                ::madvise(const_cast<quint8 *>(p), size, MADV_WILLNEED);
+#endif // DJV_WINDOWS
+            }
+
+            struct Mapping
+            {
+                ~Mapping()
+                {
+                    if (data)
+                    {
+                        file.unmap(data);
+                    }
+                    file.close();
+                    file.remove();
+                    lockFile.reset();
+                }
+
+                std::unique_ptr<QLockFile> lockFile;
+                QFile                      file;
+                uchar *                    data = nullptr;
+                quint64                    size = 0;
+                quint64                    session = 0;
+            };
+
+            enum STATE
+            {
+                STATE_WRITING,
+                STATE_READY,
+                STATE_FREE
+            };
+
+            struct Entry
+            {
+                STATE                   state = STATE_WRITING;
+                FileCacheKey            key;
+                quint64                 offset = 0;
+                quint64                 size = 0;
+                Graphics::PixelDataInfo info;
+                Graphics::ImageTags     tags;
+                Graphics::ColorProfile  colorProfile;
+                std::shared_ptr<int>    pin = std::make_shared<int>(0);
+            };
+
+            // Images that reference an entry keep the mapping alive and the
+            // entry pinned until they are destroyed.
+            struct ImageDeleter
+            {
+                std::shared_ptr<Mapping> mapping;
+                std::shared_ptr<int>     pin;
+                const quint8 *           p = nullptr;
+                quint64                  size = 0;
+
+                void operator () (Graphics::Image * image) const
+                {
+                    delete image;
+                    dontNeed(p, size);
+                }
+            };
+
+        } // namespace
+
+        struct FileCacheDisk::Private
+        {
+            // Remove an entry from the index. The space is not released
+            // until it is needed by allocate().
+            void unindex(Entry & entry)
+            {
+                if (STATE_READY == entry.state)
+                {
+                    keys.erase(entry.key);
+                    sizeBytes -= entry.size;
+                }
+                entry.state = STATE_FREE;
+            }
+
+            bool isBusy(const Entry & entry) const
+            {
+                return STATE_WRITING == entry.state || entry.pin.use_count() > 1;
+            }
+
+            // Find space in the ring for an entry of the given size, removing
+            // the entries that are overwritten.
+            bool allocate(quint64 size, quint64 & offset)
+            {
+                quint64 start = head;
+                quint64 scanned = 0;
+                while (scanned <= mapping->size)
+                {
+                    if (start + size > mapping->size)
+                    {
+                        scanned += mapping->size - start;
+                        start = 0;
+                        continue;
+                    }
+                    const quint64 end = start + size;
+                    auto i = offsets.lower_bound(start);
+                    if (i != offsets.begin())
+                    {
+                        auto j = i;
+                        --j;
+                        const Entry & entry = entries[j->second];
+                        if (entry.offset + entry.size > start)
+                        {
+                            i = j;
+                        }
+                    }
+                    std::vector<quint64> overlap;
+                    quint64 busyEnd = 0;
+                    for (; i != offsets.end() && i->first < end; ++i)
+                    {
+                        const Entry & entry = entries[i->second];
+                        if (isBusy(entry))
+                        {
+                            busyEnd = entry.offset + entry.size;
+                            break;
+                        }
+                        overlap.push_back(i->second);
+                    }
+                    if (busyEnd)
+                    {
+                        scanned += busyEnd - start;
+                        start = busyEnd;
+                        continue;
+                    }
+                    for (auto id : overlap)
+                    {
+                        auto j = entries.find(id);
+                        unindex(j->second);
+                        offsets.erase(j->second.offset);
+                        entries.erase(j);
+                    }
+                    offset = start;
+                    head = end;
+                    return true;
+                }
+                return false;
+            }
+
+            std::shared_ptr<Mapping>         mapping;
+            std::map<quint64, Entry>         entries;
+            std::map<quint64, quint64>       offsets;
+            std::map<FileCacheKey, quint64>  keys;
+            quint64                          head = 0;
+            quint64                          id = 0;
+            quint64                          sizeBytes = 0;
+            mutable std::mutex               mutex;
+        };
+
+        FileCacheDisk::FileCacheDisk() :
+            _p(new Private)
+        {}
+
+        FileCacheDisk::~FileCacheDisk()
+        {
+            close();
+        }
+
+        void FileCacheDisk::open(const QString & path, quint64 size)
+        {
+            //DJV_DEBUG("FileCacheDisk::open");
+            //DJV_DEBUG_PRINT("path = " << path);
+            //DJV_DEBUG_PRINT("size = " << size);
+
+            close();
+
+            auto mapping = std::shared_ptr<Mapping>(new Mapping);
+            mapping->size = size / blockSize * blockSize;
+
+            // Lock a cache file. Files that are locked by another process are
+            // skipped, files left behind by a process that has exited are
+            // reused.
+            const QDir dir(path);
+            if (!dir.exists() && !QDir().mkpath(path))
+            {
+                throw Core::Error(
+                    "djv::ViewLib::FileCacheDisk",
+                    errorLabels()[ERROR_OPEN].
+                    arg(QDir::toNativeSeparators(path)));
+            }
+            for (int i = 0; i < fileCountMax && !mapping->lockFile; ++i)
+            {
+                const QString base = i ? QString("djvFileCache%1").arg(i) : QString("djvFileCache");
+                std::unique_ptr<QLockFile> lockFile(new QLockFile(dir.absoluteFilePath(base + ".lock")));
+                lockFile->setStaleLockTime(0);
+                if (lockFile->tryLock(0))
+                {
+                    mapping->lockFile = std::move(lockFile);
+                    mapping->file.setFileName(dir.absoluteFilePath(base + ".raw"));
+                }
+            }
+            if (!mapping->lockFile)
+            {
+                throw Core::Error(
+                    "djv::ViewLib::FileCacheDisk",
+                    errorLabels()[ERROR_LOCK].
+                    arg(QDir::toNativeSeparators(path)));
+            }
+
+            // Open and preallocate the cache file.
+            const QString fileName = QDir::toNativeSeparators(mapping->file.fileName());
+            if (!mapping->file.open(QIODevice::ReadWrite) ||
+                !mapping->file.resize(mapping->size))
+            {
+                throw Core::Error(
+                    "djv::ViewLib::FileCacheDisk",
+                    errorLabels()[ERROR_OPEN].arg(fileName));
+            }
+#if defined(DJV_LINUX)
+            // Allocate the disk space up front, otherwise writing to the
+            // mapping would fault when the disk is full.
+            if (::posix_fallocate(mapping->file.handle(), 0, mapping->size) != 0)
+            {
+                throw Core::Error(
+                    "djv::ViewLib::FileCacheDisk",
+                    errorLabels()[ERROR_ALLOCATE].arg(fileName));
+            }
+#endif // DJV_LINUX
+            mapping->data = mapping->file.map(0, mapping->size);
+            if (!mapping->data)
+            {
+                throw Core::Error(
+                    "djv::ViewLib::FileCacheDisk",
+                    errorLabels()[ERROR_MEMORY_MAP].arg(fileName));
+            }
+
+            // Entries from previous sessions have a different session ID and
+            // are never read.
+            mapping->session =
+                static_cast<quint64>(QDateTime::currentMSecsSinceEpoch()) ^
+                (static_cast<quint64>(QCoreApplication::applicationPid()) << 40);
+
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            _p->mapping = mapping;
+        }
+
+        void FileCacheDisk::close()
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            _p->mapping.reset();
+            _p->entries.clear();
+            _p->offsets.clear();
+            _p->keys.clear();
+            _p->head = 0;
+            _p->sizeBytes = 0;
+        }
+
+        bool FileCacheDisk::isOpen() const
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            return _p->mapping != nullptr;
+        }
+
+        QString FileCacheDisk::fileName() const
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            return _p->mapping ? _p->mapping->file.fileName() : QString();
+        }
+
+        quint64 FileCacheDisk::maxSizeBytes() const
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            return _p->mapping ? _p->mapping->size : 0;
+        }
+
+        quint64 FileCacheDisk::sizeBytes() const
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            return _p->sizeBytes;
+        }
+
+        bool FileCacheDisk::hasItem(const FileCacheKey & key) const
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            return _p->keys.find(key) != _p->keys.end();
+        }
+
+        std::shared_ptr<Graphics::Image> FileCacheDisk::item(const FileCacheKey & key)
+        {
+            //DJV_DEBUG("FileCacheDisk::item");
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            const auto i = _p->keys.find(key);
+            if (i == _p->keys.end())
+                return nullptr;
+            const quint64 id = i->second;
+            Entry & entry = _p->entries[id];
+            const quint8 * p = _p->mapping->data + entry.offset;
+
+            // Verify the header before the data is used.
+            EntryHeader header;
+            memcpy(&header, p, sizeof(EntryHeader));
+            if (header.magic != headerMagic ||
+                header.version != headerVersion ||
+                header.session != _p->mapping->session ||
+                header.id != id ||
+                header.dataByteCount != Graphics::PixelDataUtil::dataByteCount(entry.info) ||
+                header.width != entry.info.size.x ||
+                header.height != entry.info.size.y ||
+                header.pixel != entry.info.pixel ||
+                header.checksum != checksum(header))
+            {
+                //DJV_DEBUG_PRINT("invalid entry");
+                _p->unindex(entry);
+                return nullptr;
+            }
+
+            // The FileIO marks the pixel data as referenced instead of owned,
+            // the memory is kept alive by the deleter.
+            p += blockSize;
+            willNeed(p, header.dataByteCount);
+            ImageDeleter deleter;
+            deleter.mapping = _p->mapping;
+            deleter.pin = entry.pin;
+            deleter.p = p;
+            deleter.size = header.dataByteCount;
+            auto out = std::shared_ptr<Graphics::Image>(
+                new Graphics::Image(entry.info, p, new Core::FileIO),
+                deleter);
+            out->tags = entry.tags;
+            out->colorProfile = entry.colorProfile;
+            return out;
+        }
+
+        quint64 FileCacheDisk::write(const Graphics::Image & image)
+        {
+            //DJV_DEBUG("FileCacheDisk::write");
+            const quint64 dataByteCount = image.dataByteCount();
+            const quint64 size = blockSize + align(dataByteCount);
+            std::shared_ptr<Mapping> mapping;
+            quint64 id = 0;
+            quint64 offset = 0;
+            {
+                std::lock_guard<std::mutex> lock(_p->mutex);
+                if (!_p->mapping ||
+                    size > _p->mapping->size ||
+                    !_p->allocate(size, offset))
+                    return 0;
+                id = ++_p->id;
+                Entry & entry = _p->entries[id];
+                entry.offset = offset;
+                entry.size = size;
+                entry.info = image.info();
+                entry.tags = image.tags;
+                entry.colorProfile = image.colorProfile;
+                _p->offsets[offset] = id;
+                mapping = _p->mapping;
+            }
+
+            // Write the data and then the header, so the entry is only valid
+            // once the data is complete.
+            quint8 * p = mapping->data + offset;
+            EntryHeader header;
+            memcpy(p, &header, sizeof(EntryHeader));
+            memcpy(p + blockSize, image.data(), dataByteCount);
+            header.magic = headerMagic;
+            header.version = headerVersion;
+            header.session = mapping->session;
+            header.id = id;
+            header.dataByteCount = dataByteCount;
+            header.width = image.info().size.x;
+            header.height = image.info().size.y;
+            header.pixel = image.info().pixel;
+            header.checksum = checksum(header);
+            memcpy(p, &header, sizeof(EntryHeader));
+            dontNeed(p, size);
+            return id;
+        }
+
+        void FileCacheDisk::commit(quint64 id, const FileCacheKey & key)
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            const auto i = _p->entries.find(id);
+            if (i == _p->entries.end() || i->second.state != STATE_WRITING)
+                return;
+            const auto j = _p->keys.find(key);
+            if (j != _p->keys.end())
+            {
+                _p->unindex(_p->entries[j->second]);
+            }
+            i->second.state = STATE_READY;
+            i->second.key = key;
+            _p->keys[key] = id;
+            _p->sizeBytes += i->second.size;
+        }
+
+        void FileCacheDisk::discard(quint64 id)
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            const auto i = _p->entries.find(id);
+            if (i != _p->entries.end())
+            {
+                _p->unindex(i->second);
+            }
+        }
+
+        void FileCacheDisk::removeItem(const FileCacheKey & key)
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            const auto i = _p->keys.find(key);
+            if (i != _p->keys.end())
+            {
+                _p->unindex(_p->entries[i->second]);
+            }
+        }
+
+        void FileCacheDisk::clearItems(void * window)
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            auto i = _p->keys.begin();
+            while (i != _p->keys.end())
+            {
+                if (!window || window == i->first.window)
+                {
+                    Entry & entry = _p->entries[i->second];
+                    ++i;
+                    _p->unindex(entry);
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+        }
+
+        void FileCacheDisk::moveItems(void * window, qint64 frame, qint64 offset)
+        {
+            std::lock_guard<std::mutex> lock(_p->mutex);
+            std::vector<quint64> moved;
+            auto i = _p->keys.begin();
+            while (i != _p->keys.end())
+            {
+                if (window == i->first.window && i->first.frame >= frame)
+                {
+                    moved.push_back(i->second);
+                    i = _p->keys.erase(i);
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+            for (auto id : moved)
+            {
+                Entry & entry = _p->entries[id];
+                entry.key.frame += offset;
+                _p->keys[entry.key] = id;
+            }
+        }
+
+        const QStringList & FileCacheDisk::errorLabels()
+        {
+            static const QStringList data = QStringList() <<
+                qApp->translate("djv::ViewLib::FileCacheDisk", "Cannot open the disk cache: %1") <<
+                qApp->translate("djv::ViewLib::FileCacheDisk", "Cannot lock a disk cache file in: %1") <<
+                qApp->translate("djv::ViewLib::FileCacheDisk", "Cannot allocate the disk cache: %1") <<
+                qApp->translate("djv::ViewLib::FileCacheDisk", "Cannot memory map the disk cache: %1");
+            DJV_ASSERT(ERROR_COUNT == data.count());
+            return data;
+        }
+
+    } // namespace ViewLib
+} // namespace djv
@@ -0,0 +1,148 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvViewLib/FileCache.h>
+
+#include <djvCore/Util.h>
+
+#include <QStringList>
+
+#include <memory>
+
+namespace djv
+{
+    namespace Graphics
+    {
+        class Image;
+
+    } // namespace Graphics
+
+    namespace ViewLib
+    {
+        //! This class provides the disk tier of the file cache.
+        //!
+        //! Images are written as raw pixel data into a preallocated cache file
+        //! on local disk that is memory-mapped. They are re-admitted by
+        //! referencing the mapped pixel data instead of decoding them again.
+        //! Space in the file is allocated in a ring so the oldest entries are
+        //! overwritten first. Entries that are referenced by an image or are
+        //! being written are never overwritten.
+        //!
+        //! Each entry is preceded by a header that is written after the pixel
+        //! data and verified before the data is used, so a partially written
+        //! entry is never read. The cache file is locked while it is open; a
+        //! file left behind by a crashed session is reused but its entries are
+        //! discarded.
+        //!
+        //! Writing may be done from multiple threads, all other functions
+        //! should only be called from the thread that owns the file cache.
+        class FileCacheDisk
+        {
+        public:
+            FileCacheDisk();
+            ~FileCacheDisk();
+
+            //! Open a cache file in the given directory with the given size in
+            //! bytes.
+            //!
+            //! Throws:
+            //! - Core::Error
+            void open(const QString & path, quint64 size);
+
+            //! Close the cache file. Images that reference the file keep it
+            //! mapped until they are destroyed.
+            void close();
+
+            //! Get whether the cache file is open.
+            bool isOpen() const;
+
+            //! Get the cache file name.
+            QString fileName() const;
+
+            //! Get the maximum size in bytes.
+            quint64 maxSizeBytes() const;
+
+            //! Get the size of the entries in bytes.
+            quint64 sizeBytes() const;
+
+            //! Get whether the cache contains an item.
+            bool hasItem(const FileCacheKey &) const;
+
+            //! Get an item from the cache. The image references the mapped
+            //! pixel data. Returns null if the item is not in the cache or the
+            //! entry is not valid.
+            std::shared_ptr<Graphics::Image> item(const FileCacheKey &);
+
+            //! Write an image into the cache file. This may be called from
+            //! any thread. Returns an entry ID that is passed to commit() or
+            //! discard(), or zero if there is not enough space.
+            quint64 write(const Graphics::Image &);
+
+            //! Add a written entry to the cache with the given key.
+            void commit(quint64 id, const FileCacheKey &);
+
+            //! Release the space of a written entry.
+            void discard(quint64 id);
+
+            //! Remove an item.
+            void removeItem(const FileCacheKey &);
+
+            //! Remove all items that match the given window, or all items if
+            //! the window is null.
+            void clearItems(void *);
+
+            //! Move the items that match the given window and have a frame
+            //! greater than or equal to the given frame by an offset.
+            void moveItems(void *, qint64 frame, qint64 offset);
+
+            //! This enumeration provides error codes.
+            enum ERROR
+            {
+                ERROR_OPEN,
+                ERROR_LOCK,
+                ERROR_ALLOCATE,
+                ERROR_MEMORY_MAP,
+
+                ERROR_COUNT
+            };
+
+            //! Get the error code labels.
+            static const QStringList & errorLabels();
+
+        private:
+            DJV_PRIVATE_COPY(FileCacheDisk);
+
+            struct Private;
+            std::unique_ptr<Private> _p;
+        };
+
+    } // namespace ViewLib
+} // namespace djv
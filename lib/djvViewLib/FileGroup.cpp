@@ -52,7 +52,9 @@
 #include <djvCore/DebugLog.h>
 #include <djvCore/Error.h>
 #include <djvCore/FileInfoUtil.h>
+#include <djvCore/FileWatcher.h>
 #include <djvCore/ListUtil.h>
+#include <djvCore/Timer.h>
 
 #include <QAction>
 #include <QActionGroup>
@@ -65,6 +67,23 @@ namespace djv
 {
     namespace ViewLib
     {
+        namespace
+        {
+            //! Get the frame number of a file if it belongs to the given sequence.
+            bool sequenceFrame(const Core::FileInfo & sequence, const QString & fileName, qint64 & frame)
+            {
+                if (sequence.type() != Core::FileInfo::SEQUENCE)
+                    return false;
+                const Core::FileInfo fileInfo(fileName, false);
+                Core::FileInfo tmp = sequence;
+                if (!tmp.addSequence(fileInfo) || fileInfo.sequence().frames.count() != 1)
+                    return false;
+                frame = fileInfo.sequence().frames[0];
+                return true;
+            }
+
+        } // namespace
+
         struct FileGroup::Private
         {
             Private(const QPointer<ViewContext> & context) :
@@ -88,6 +107,7 @@ namespace djv
             bool preloadActive = false;
             int preloadTimer = 0;
             qint64 preloadFrame = 0;
+            QPointer<Core::FileWatcher> fileWatcher;
             QPointer<FileActions> actions;
             QPointer<FileMenu> menu;
             QPointer<FileToolBar> toolBar;
@@ -112,6 +132,9 @@ namespace djv
                 _p->preload = copy->_p->preload;
             }
 
+            // Create the file watcher.
+            _p->fileWatcher = new Core::FileWatcher(this);
+
             // Create the actions.
             _p->actions = new FileActions(context, this);
 
@@ -241,6 +264,18 @@ namespace djv
                 context->imageIOFactory(),
                 SIGNAL(optionChanged()),
                 SLOT(reloadCallback()));
+            connect(
+                _p->fileWatcher,
+                SIGNAL(fileCreated(const QString &)),
+                SLOT(fileCreatedCallback(const QString &)));
+            connect(
+                _p->fileWatcher,
+                SIGNAL(fileModified(const QString &)),
+                SLOT(fileModifiedCallback(const QString &)));
+            connect(
+                _p->fileWatcher,
+                SIGNAL(fileRemoved(const QString &)),
+                SLOT(fileRemovedCallback(const QString &)));
         }
 
         FileGroup::~FileGroup()
@@ -304,7 +339,7 @@ namespace djv
             FileGroup * that = const_cast<FileGroup *>(this);
             FileCache * cache = context()->fileCache();
             const auto key = FileCacheKey(mainWindow(), frame);
-            if (cache->hasItem(key))
+            if (cache->findItem(key))
             {
                 _p->image = cache->item(key);
             }
@@ -316,6 +351,8 @@ namespace djv
                     auto image = std::shared_ptr<Graphics::Image>(new Graphics::Image);
                     try
                     {
+                        Core::Timer timer;
+                        timer.start();
                         _p->imageLoad->read(
                             *image,
                             Graphics::ImageIOFrameInfo(
@@ -324,6 +361,8 @@ namespace djv
                                 -1,
                                 _p->layer,
                                 _p->proxy));
+                        timer.check();
+                        context()->frameStats(Enum::FRAME_STAGE_READ)->add(timer.seconds(), image->dataByteCount());
                     }
                     catch (Core::Error error)
                     {
@@ -346,7 +385,11 @@ namespace djv
                             Graphics::OpenGLImageOptions options;
                             options.colorProfile = tmp->colorProfile;
                             options.proxyScale = false;
+                            Core::Timer timer;
+                            timer.start();
                             _p->openGLImage->copy(*tmp, *image, options);
+                            timer.check();
+                            context()->frameStats(Enum::FRAME_STAGE_CONVERT)->add(timer.seconds(), tmp->dataByteCount());
                         }
                     }
                     catch (Core::Error error)
@@ -420,6 +463,7 @@ namespace djv
                 _p->layers += _p->imageIOInfo[i].layerName;
             }
 
+            watcherUpdate();
             preloadUpdate();
             update();
         }
@@ -535,6 +579,12 @@ namespace djv
                 {
                     byteCount += cache->item(key)->dataByteCount();
                 }
+                else if (cache->requestItem(key))
+                {
+                    // The frame is decompressed by the cache workers, keep
+                    // searching for a frame that needs to be loaded.
+                    byteCount += Graphics::PixelDataUtil::dataByteCount(_p->imageIOInfo);
+                }
                 else
                 {
                     byteCount += Graphics::PixelDataUtil::dataByteCount(_p->imageIOInfo);
@@ -558,6 +608,8 @@ namespace djv
                     //DJV_DEBUG_PRINT("loading image");
                     try
                     {
+                        Core::Timer timer;
+                        timer.start();
                         _p->imageLoad->read(
                             *image,
                             Graphics::ImageIOFrameInfo(
@@ -566,6 +618,8 @@ namespace djv
                                 -1,
                                 _p->layer,
                                 _p->proxy));
+                        timer.check();
+                        context()->frameStats(Enum::FRAME_STAGE_READ)->add(timer.seconds(), image->dataByteCount());
                         if (image->isValid() && _p->u8Conversion)
                         {
                             //DJV_DEBUG_PRINT("u8 conversion");
@@ -578,7 +632,10 @@ namespace djv
                             Graphics::OpenGLImageOptions options;
                             options.colorProfile = tmp->colorProfile;
                             options.proxyScale = false;
+                            timer.start();
                             _p->openGLImage->copy(*tmp, *image, options);
+                            timer.check();
+                            context()->frameStats(Enum::FRAME_STAGE_CONVERT)->add(timer.seconds(), tmp->dataByteCount());
                         }
                     }
                     catch (const Core::Error &)
@@ -783,6 +840,75 @@ namespace djv
             context()->debugLogDialog()->raise();
         }
 
+        void FileGroup::fileCreatedCallback(const QString & fileName)
+        {
+            //DJV_DEBUG("FileGroup::fileCreatedCallback");
+            //DJV_DEBUG_PRINT("fileName = " << fileName);
+            qint64 frame = 0;
+            if (!_p->imageLoad.data() || !sequenceFrame(_p->fileInfo, fileName, frame))
+                return;
+            const int index = _p->imageIOInfo.sequence.insertFrame(frame);
+            if (-1 == index)
+            {
+                fileModifiedCallback(fileName);
+                return;
+            }
+
+            // Frames inserted before the end of the sequence shift the cached
+            // frames that follow them.
+            if (index < _p->imageIOInfo.sequence.frames.count() - 1)
+            {
+                context()->fileCache()->moveItems(mainWindow(), index, 1);
+            }
+            _p->fileInfo.setSequence(_p->imageIOInfo.sequence);
+            preloadUpdate();
+            Q_EMIT sequenceChanged();
+        }
+
+        void FileGroup::fileModifiedCallback(const QString & fileName)
+        {
+            //DJV_DEBUG("FileGroup::fileModifiedCallback");
+            //DJV_DEBUG_PRINT("fileName = " << fileName);
+            if (!_p->imageLoad.data())
+                return;
+            qint64 frame = 0;
+            if (sequenceFrame(_p->fileInfo, fileName, frame))
+            {
+                const int index = _p->imageIOInfo.sequence.frames.indexOf(frame);
+                if (index != -1)
+                {
+                    context()->fileCache()->removeItem(FileCacheKey(mainWindow(), index));
+                    preloadUpdate();
+                    Q_EMIT imageChanged();
+                }
+            }
+            else if (
+                Core::FileInfo(fileName, false).fileName(-1, false) ==
+                _p->fileInfo.fileName(-1, false))
+            {
+                reloadCallback();
+            }
+        }
+
+        void FileGroup::fileRemovedCallback(const QString & fileName)
+        {
+            //DJV_DEBUG("FileGroup::fileRemovedCallback");
+            //DJV_DEBUG_PRINT("fileName = " << fileName);
+            qint64 frame = 0;
+            if (!_p->imageLoad.data() ||
+                _p->imageIOInfo.sequence.frames.count() <= 1 ||
+                !sequenceFrame(_p->fileInfo, fileName, frame))
+                return;
+            const int index = _p->imageIOInfo.sequence.removeFrame(frame);
+            if (-1 == index)
+                return;
+            FileCache * cache = context()->fileCache();
+            cache->removeItem(FileCacheKey(mainWindow(), index));
+            cache->moveItems(mainWindow(), index + 1, -1);
+            _p->fileInfo.setSequence(_p->imageIOInfo.sequence);
+            Q_EMIT sequenceChanged();
+        }
+
         void FileGroup::preloadUpdate()
         {
             if (_p->cacheEnabled && _p->preload && _p->preloadActive)
@@ -826,5 +952,16 @@ namespace djv
             context()->fileCache()->clearItems(mainWindow());
         }
 
+        void FileGroup::watcherUpdate()
+        {
+            //DJV_DEBUG("FileGroup::watcherUpdate");
+            _p->fileWatcher->clear();
+            if (_p->imageLoad.data())
+            {
+                const QString & path = _p->fileInfo.path();
+                _p->fileWatcher->addDirectory(!path.isEmpty() ? path : QDir::currentPath());
+            }
+        }
+
     } // namespace ViewLib
 } // namespace djv
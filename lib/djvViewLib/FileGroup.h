@@ -119,6 +119,10 @@ namespace djv
             //! This signal is emitted when the current image is changed.
             void imageChanged();
 
+            //! This signal is emitted when frames are added to or removed from
+            //! the sequence while it is open.
+            void sequenceChanged();
+
             //! This signal is emitted to store the current frame.
             void setFrameStore();
 
@@ -151,12 +155,16 @@ namespace djv
             void messagesCallback();
             void prefsCallback();
             void debugLogCallback();
+            void fileCreatedCallback(const QString &);
+            void fileModifiedCallback(const QString &);
+            void fileRemovedCallback(const QString &);
 
             void preloadUpdate();
             void update();
 
         private:
             void cacheDel();
+            void watcherUpdate();
 
             DJV_PRIVATE_COPY(FileGroup);
 
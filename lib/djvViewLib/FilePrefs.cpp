@@ -36,6 +36,8 @@
 #include <djvCore/FileInfoUtil.h>
 #include <djvCore/ListUtil.h>
 
+#include <QDir>
+
 namespace djv
 {
     namespace ViewLib
@@ -46,6 +48,9 @@ namespace djv
             _u8Conversion(u8ConversionDefault()),
             _cacheEnabled(cacheEnabledDefault()),
             _cacheSizeGB(cacheSizeGBDefault()),
+            _cacheCompression(cacheCompressionDefault()),
+            _diskCacheSizeGB(diskCacheSizeGBDefault()),
+            _diskCachePath(diskCachePathDefault()),
             _preload(preloadDefault()),
             _displayCache(displayCacheDefault())
         {
@@ -55,6 +60,9 @@ namespace djv
             prefs.get("u8Conversion", _u8Conversion);
             prefs.get("cache", _cacheEnabled);
             prefs.get("cacheSize", _cacheSizeGB);
+            prefs.get("cacheCompression", _cacheCompression);
+            prefs.get("diskCacheSize", _diskCacheSizeGB);
+            prefs.get("diskCachePath", _diskCachePath);
             prefs.get("preload", _preload);
             prefs.get("displayCache", _displayCache);
             if (_recent.count() > Core::FileInfoUtil::recentMax)
@@ -69,6 +77,9 @@ namespace djv
             prefs.set("u8Conversion", _u8Conversion);
             prefs.set("cache", _cacheEnabled);
             prefs.set("cacheSize", _cacheSizeGB);
+            prefs.set("cacheCompression", _cacheCompression);
+            prefs.set("diskCacheSize", _diskCacheSizeGB);
+            prefs.set("diskCachePath", _diskCachePath);
             prefs.set("preload", _preload);
             prefs.set("displayCache", _displayCache);
         }
@@ -127,6 +138,36 @@ namespace djv
             return _cacheSizeGB;
         }
 
+        int FilePrefs::cacheCompressionDefault()
+        {
+            return 0;
+        }
+
+        int FilePrefs::cacheCompression() const
+        {
+            return _cacheCompression;
+        }
+
+        int FilePrefs::diskCacheSizeGBDefault()
+        {
+            return 0;
+        }
+
+        int FilePrefs::diskCacheSizeGB() const
+        {
+            return _diskCacheSizeGB;
+        }
+
+        QString FilePrefs::diskCachePathDefault()
+        {
+            return QDir::tempPath();
+        }
+
+        const QString & FilePrefs::diskCachePath() const
+        {
+            return _diskCachePath;
+        }
+
         bool FilePrefs::preloadDefault()
         {
             return true;
@@ -183,6 +224,33 @@ namespace djv
             Q_EMIT prefChanged();
         }
 
+        void FilePrefs::setCacheCompression(int value)
+        {
+            if (value == _cacheCompression)
+                return;
+            _cacheCompression = value;
+            Q_EMIT cacheCompressionChanged(_cacheCompression);
+            Q_EMIT prefChanged();
+        }
+
+        void FilePrefs::setDiskCacheSizeGB(int size)
+        {
+            if (size == _diskCacheSizeGB)
+                return;
+            _diskCacheSizeGB = size;
+            Q_EMIT diskCacheSizeGBChanged(_diskCacheSizeGB);
+            Q_EMIT prefChanged();
+        }
+
+        void FilePrefs::setDiskCachePath(const QString & path)
+        {
+            if (path == _diskCachePath)
+                return;
+            _diskCachePath = path;
+            Q_EMIT diskCachePathChanged(_diskCachePath);
+            Q_EMIT prefChanged();
+        }
+
         void FilePrefs::setPreload(bool preload)
         {
             if (preload == _preload)
@@ -80,6 +80,24 @@ namespace djv
             //! Get the cache size in gigabytes.
             float cacheSizeGB() const;
 
+            //! Get the default percentage of the cache used for compressed images.
+            static int cacheCompressionDefault();
+
+            //! Get the percentage of the cache used for compressed images.
+            int cacheCompression() const;
+
+            //! Get the default disk cache size in gigabytes.
+            static int diskCacheSizeGBDefault();
+
+            //! Get the disk cache size in gigabytes. Zero disables the disk cache.
+            int diskCacheSizeGB() const;
+
+            //! Get the default disk cache directory.
+            static QString diskCachePathDefault();
+
+            //! Get the disk cache directory.
+            const QString & diskCachePath() const;
+
             //! Get the default for whether the cache is pre-loaded.
             static bool preloadDefault();
 
@@ -105,6 +123,15 @@ namespace djv
             //! Set the cache size in gigabytes.
             void setCacheSizeGB(float);
 
+            //! Set the percentage of the cache used for compressed images.
+            void setCacheCompression(int);
+
+            //! Set the disk cache size in gigabytes.
+            void setDiskCacheSizeGB(int);
+
+            //! Set the disk cache directory.
+            void setDiskCachePath(const QString &);
+
             //! Set whether the cache pre-load is enabled.
             void setPreload(bool);
 
@@ -127,6 +154,15 @@ namespace djv
             //! This signal is emitted when the cache size is changed.
             void cacheSizeGBChanged(float);
 
+            //! This signal is emitted when the cache compression is changed.
+            void cacheCompressionChanged(int);
+
+            //! This signal is emitted when the disk cache size is changed.
+            void diskCacheSizeGBChanged(int);
+
+            //! This signal is emitted when the disk cache directory is changed.
+            void diskCachePathChanged(const QString &);
+
             //! This signal is emitted when the cache pre-load is changed.
             void preloadChanged(bool);
 
@@ -139,6 +175,9 @@ namespace djv
             bool                           _u8Conversion;
             bool                           _cacheEnabled;
             float                          _cacheSizeGB;
+            int                            _cacheCompression;
+            int                            _diskCacheSizeGB;
+            QString                        _diskCachePath;
             bool                           _preload;
             bool                           _displayCache;
         };
@@ -33,6 +33,7 @@
 #include <djvViewLib/MiscWidget.h>
 #include <djvViewLib/ViewContext.h>
 
+#include <djvUI/IntEdit.h>
 #include <djvUI/Prefs.h>
 #include <djvUI/PrefsGroupBox.h>
 
@@ -43,7 +44,9 @@
 #include <QApplication>
 #include <QCheckBox>
 #include <QComboBox>
+#include <QDir>
 #include <QFormLayout>
+#include <QLineEdit>
 #include <QVBoxLayout>
 
 namespace djv
@@ -56,6 +59,9 @@ namespace djv
             QPointer<QCheckBox>       u8ConversionWidget;
             QPointer<QCheckBox>       cacheWidget;
             QPointer<CacheSizeWidget> cacheSizeWidget;
+            QPointer<UI::IntEdit>     cacheCompressionWidget;
+            QPointer<UI::IntEdit>     diskCacheSizeWidget;
+            QPointer<QLineEdit>       diskCachePathWidget;
             QPointer<QCheckBox>       preloadWidget;
             QPointer<QCheckBox>       displayCacheWidget;
         };
@@ -79,6 +85,16 @@ namespace djv
 
             _p->cacheSizeWidget = new CacheSizeWidget(context.data());
 
+            _p->cacheCompressionWidget = new UI::IntEdit;
+            _p->cacheCompressionWidget->setRange(0, 90);
+            _p->cacheCompressionWidget->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+
+            _p->diskCacheSizeWidget = new UI::IntEdit;
+            _p->diskCacheSizeWidget->setRange(0, 4096);
+            _p->diskCacheSizeWidget->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+
+            _p->diskCachePathWidget = new QLineEdit;
+
             _p->preloadWidget = new QCheckBox(
                 qApp->translate("djv::ViewLib::FilePrefsWidget", "Preload cache"));
 
@@ -113,17 +129,38 @@ namespace djv
             prefsGroupBox = new UI::PrefsGroupBox(
                 qApp->translate("djv::ViewLib::FilePrefsWidget", "Memory Cache"),
                 qApp->translate("djv::ViewLib::FilePrefsWidget",
-                    "The memory cache stores images for faster playback performance."),
+                    "The memory cache stores images for faster playback performance. "
+                    "Part of the cache can be used to store images with lossless compression, "
+                    "which fits more images in memory at the expense of CPU time."),
                 context.data());
             formLayout = prefsGroupBox->createLayout();
             formLayout->addRow(_p->cacheWidget);
             formLayout->addRow(
                 qApp->translate("djv::ViewLib::FilePrefsWidget", "Cache size (gigabytes):"),
                 _p->cacheSizeWidget);
+            formLayout->addRow(
+                qApp->translate("djv::ViewLib::FilePrefsWidget", "Compressed (percentage of cache size):"),
+                _p->cacheCompressionWidget);
             formLayout->addRow(_p->preloadWidget);
             formLayout->addRow(_p->displayCacheWidget);
             layout->addWidget(prefsGroupBox);
 
+            prefsGroupBox = new UI::PrefsGroupBox(
+                qApp->translate("djv::ViewLib::FilePrefsWidget", "Disk Cache"),
+                qApp->translate("djv::ViewLib::FilePrefsWidget",
+                    "The disk cache stores images that are removed from the memory cache "
+                    "in a file on local disk, so they do not need to be loaded again. "
+                    "A fast local disk should be used. Set the size to zero to disable the disk cache."),
+                context.data());
+            formLayout = prefsGroupBox->createLayout();
+            formLayout->addRow(
+                qApp->translate("djv::ViewLib::FilePrefsWidget", "Disk cache size (gigabytes):"),
+                _p->diskCacheSizeWidget);
+            formLayout->addRow(
+                qApp->translate("djv::ViewLib::FilePrefsWidget", "Disk cache directory:"),
+                _p->diskCachePathWidget);
+            layout->addWidget(prefsGroupBox);
+
             layout->addStretch();
 
             // Initialize.
@@ -146,6 +183,18 @@ namespace djv
                 _p->cacheSizeWidget,
                 SIGNAL(cacheSizeGBChanged(float)),
                 SLOT(cacheSizeGBCallback(float)));
+            connect(
+                _p->cacheCompressionWidget,
+                SIGNAL(valueChanged(int)),
+                SLOT(cacheCompressionCallback(int)));
+            connect(
+                _p->diskCacheSizeWidget,
+                SIGNAL(valueChanged(int)),
+                SLOT(diskCacheSizeGBCallback(int)));
+            connect(
+                _p->diskCachePathWidget,
+                SIGNAL(editingFinished()),
+                SLOT(diskCachePathCallback()));
             connect(
                 _p->preloadWidget,
                 SIGNAL(toggled(bool)),
@@ -169,6 +218,9 @@ namespace djv
             context()->filePrefs()->setU8Conversion(FilePrefs::u8ConversionDefault());
             context()->filePrefs()->setCacheEnabled(FilePrefs::cacheEnabledDefault());
             context()->filePrefs()->setCacheSizeGB(FilePrefs::cacheSizeGBDefault());
+            context()->filePrefs()->setCacheCompression(FilePrefs::cacheCompressionDefault());
+            context()->filePrefs()->setDiskCacheSizeGB(FilePrefs::diskCacheSizeGBDefault());
+            context()->filePrefs()->setDiskCachePath(FilePrefs::diskCachePathDefault());
             context()->filePrefs()->setPreload(FilePrefs::preloadDefault());
             context()->filePrefs()->setDisplayCache(FilePrefs::displayCacheDefault());
         }
@@ -193,6 +245,22 @@ namespace djv
             context()->filePrefs()->setCacheSizeGB(in);
         }
 
+        void FilePrefsWidget::cacheCompressionCallback(int in)
+        {
+            context()->filePrefs()->setCacheCompression(in);
+        }
+
+        void FilePrefsWidget::diskCacheSizeGBCallback(int in)
+        {
+            context()->filePrefs()->setDiskCacheSizeGB(in);
+        }
+
+        void FilePrefsWidget::diskCachePathCallback()
+        {
+            context()->filePrefs()->setDiskCachePath(
+                QDir::fromNativeSeparators(_p->diskCachePathWidget->text()));
+        }
+
         void FilePrefsWidget::preloadCallback(bool in)
         {
             context()->filePrefs()->setPreload(in);
@@ -210,12 +278,18 @@ namespace djv
                 _p->u8ConversionWidget <<
                 _p->cacheWidget <<
                 _p->cacheSizeWidget <<
+                _p->cacheCompressionWidget <<
+                _p->diskCacheSizeWidget <<
+                _p->diskCachePathWidget <<
                 _p->preloadWidget <<
                 _p->displayCacheWidget);
             _p->proxyWidget->setCurrentIndex(context()->filePrefs()->proxy());
             _p->u8ConversionWidget->setChecked(context()->filePrefs()->hasU8Conversion());
             _p->cacheWidget->setChecked(context()->filePrefs()->isCacheEnabled());
             _p->cacheSizeWidget->setCacheSizeGB(context()->filePrefs()->cacheSizeGB());
+            _p->cacheCompressionWidget->setValue(context()->filePrefs()->cacheCompression());
+            _p->diskCacheSizeWidget->setValue(context()->filePrefs()->diskCacheSizeGB());
+            _p->diskCachePathWidget->setText(QDir::toNativeSeparators(context()->filePrefs()->diskCachePath()));
             _p->preloadWidget->setChecked(context()->filePrefs()->hasPreload());
             _p->displayCacheWidget->setChecked(context()->filePrefs()->hasDisplayCache());
         }
@@ -55,6 +55,9 @@ namespace djv
             void u8ConversionCallback(bool);
             void cacheEnabledCallback(bool);
             void cacheSizeGBCallback(float);
+            void cacheCompressionCallback(int);
+            void diskCacheSizeGBCallback(int);
+            void diskCachePathCallback();
             void preloadCallback(bool);
             void displayCacheCallback(bool);
 
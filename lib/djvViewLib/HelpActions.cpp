@@ -32,6 +32,8 @@
 #include <djvViewLib/ShortcutPrefs.h>
 #include <djvViewLib/ViewContext.h>
 
+#include <djvCore/Trace.h>
+
 #include <QAction>
 #include <QApplication>
 
@@ -56,6 +58,9 @@ namespace djv
             _actions[WHATS_THIS]->setText(qApp->translate("djv::ViewLib::HelpActions", "&What's This?"));
             _actions[INFO]->setText(qApp->translate("djv::ViewLib::HelpActions", "&Information"));
             _actions[ABOUT]->setText(qApp->translate("djv::ViewLib::HelpActions", "&About"));
+            _actions[SAVE_TRACE]->setText(qApp->translate("djv::ViewLib::HelpActions", "Save &Trace"));
+            _actions[SAVE_TRACE]->setToolTip(qApp->translate("djv::ViewLib::HelpActions",
+                "Write the trace to the file given with the -trace command line option."));
 
             update();
 
@@ -74,6 +79,8 @@ namespace djv
 
             _actions[WHATS_THIS]->setShortcut(shortcuts[Enum::SHORTCUT_HELP_WHATS_THIS].value);
 
+            _actions[SAVE_TRACE]->setVisible(Core::Trace::isEnabled());
+
             Q_EMIT changed();
         }
         
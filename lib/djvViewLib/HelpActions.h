@@ -50,6 +50,7 @@ namespace djv
                 WHATS_THIS,
                 INFO,
                 ABOUT,
+                SAVE_TRACE,
 
                 ACTION_COUNT
             };
@@ -38,10 +38,14 @@
 #include <djvUI/InfoDialog.h>
 
 #include <djvCore/Debug.h>
+#include <djvCore/Error.h>
 #include <djvCore/FileInfoUtil.h>
+#include <djvCore/Trace.h>
 
 #include <QAction>
+#include <QApplication>
 #include <QDesktopServices>
+#include <QDir>
 #include <QMenuBar>
 #include <QPointer>
 #include <QUrl>
@@ -85,6 +89,10 @@ namespace djv
                 _p->actions->action(HelpActions::ABOUT),
                 SIGNAL(triggered()),
                 SLOT(aboutCallback()));
+            connect(
+                _p->actions->action(HelpActions::SAVE_TRACE),
+                SIGNAL(triggered()),
+                SLOT(saveTraceCallback()));
         }
 
         HelpGroup::~HelpGroup()
@@ -110,5 +118,20 @@ namespace djv
             context()->aboutDialog()->show();
         }
 
+        void HelpGroup::saveTraceCallback()
+        {
+            try
+            {
+                Core::Trace::write(Core::Trace::fileName());
+                context()->printMessage(
+                    qApp->translate("djv::ViewLib::HelpGroup", "Saved trace: \"%1\"").
+                    arg(QDir::toNativeSeparators(Core::Trace::fileName())));
+            }
+            catch (const Core::Error & error)
+            {
+                context()->printError(error);
+            }
+        }
+
     } // namespace ViewLib
 } // namespace djv
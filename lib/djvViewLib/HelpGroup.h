@@ -55,6 +55,7 @@ namespace djv
             void whatsThisCallback();
             void infoCallback();
             void aboutCallback();
+            void saveTraceCallback();
 
         private:
             DJV_PRIVATE_COPY(HelpGroup);
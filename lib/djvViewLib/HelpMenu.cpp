@@ -51,6 +51,7 @@ namespace djv
             addAction(actions->action(HelpActions::WHATS_THIS));
             addAction(actions->action(HelpActions::INFO));
             addAction(actions->action(HelpActions::ABOUT));
+            addAction(actions->action(HelpActions::SAVE_TRACE));
 
             setTitle(qApp->translate("djv::ViewLib::HelpMenu", "&Help"));
         }
@@ -42,6 +42,11 @@ namespace djv
             a.speed == b.speed &&
             Core::Math::fuzzyCompare(a.actualSpeed, b.actualSpeed) &&
             a.droppedFrames == b.droppedFrames &&
+            a.memoryUsage == b.memoryUsage &&
+            a.memoryBudget == b.memoryBudget &&
+            a.frameStats == b.frameStats &&
+            Core::Math::fuzzyCompare(a.cacheHitRate, b.cacheHitRate) &&
+            a.preloadDepth == b.preloadDepth &&
             a.visible == b.visible;
     }
 
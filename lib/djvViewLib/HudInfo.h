@@ -35,6 +35,7 @@
 #include <djvGraphics/PixelData.h>
 
 #include <djvCore/Speed.h>
+#include <djvCore/TimingStats.h>
 
 namespace djv
 {
@@ -49,6 +50,18 @@ namespace djv
             Core::Speed             speed;
             float                   actualSpeed = 0.f;
             bool                    droppedFrames = false;
+            quint64                 memoryUsage = 0;
+            quint64                 memoryBudget = 0;
+
+            //! The frame timing statistics, indexed by Enum::FRAME_STAGE.
+            QVector<Core::TimingStats::Summary> frameStats;
+
+            //! The percentage of frames found in the memory cache.
+            float                   cacheHitRate = 0.f;
+
+            //! The number of frames cached ahead of the current frame.
+            int                     preloadDepth = 0;
+
             QVector<bool>           visible;
         };
 
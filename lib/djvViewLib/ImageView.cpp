@@ -45,6 +45,7 @@
 #include <djvCore/Assert.h>
 #include <djvCore/FileInfo.h>
 #include <djvCore/FileInfoUtil.h>
+#include <djvCore/Memory.h>
 #include <djvCore/Time.h>
 
 #include <QApplication>
@@ -485,6 +486,20 @@ namespace djv
         {
             //DJV_DEBUG("ImageView::paintGL");
             UI::ImageView::paintGL();
+            if (auto openGLImage = this->openGLImage())
+            {
+                if (this->data())
+                {
+                    // Cached tiles are not uploaded again.
+                    if (const quint64 uploadByteCount = openGLImage->uploadByteCount())
+                    {
+                        _p->context->frameStats(Enum::FRAME_STAGE_UPLOAD)->add(
+                            openGLImage->uploadTime(),
+                            uploadByteCount);
+                    }
+                    _p->context->frameStats(Enum::FRAME_STAGE_DRAW)->add(openGLImage->drawTime());
+                }
+            }
             if (_p->grid)
             {
                 drawGrid();
@@ -638,6 +653,35 @@ namespace djv
                     arg(_p->hudInfo.actualSpeed, 0, 'f', 2);
             }
 
+            // Generate the lower right contents.
+            if (_p->hudInfo.visible[Enum::HUD_TIMING])
+            {
+                for (int i = 0; i < _p->hudInfo.frameStats.count(); ++i)
+                {
+                    const auto & stats = _p->hudInfo.frameStats[i];
+                    QString text = qApp->translate("djv::ViewLib::ImageView", "%1 = %2 ms, p95 %3 ms, max %4 ms").
+                        arg(Enum::frameStageLabels()[i]).
+                        arg(stats.mean * 1000.f, 0, 'f', 2).
+                        arg(stats.p95 * 1000.f, 0, 'f', 2).
+                        arg(stats.max * 1000.f, 0, 'f', 2);
+                    if (stats.bytesPerSecond > 0.f)
+                    {
+                        text += qApp->translate("djv::ViewLib::ImageView", ", %1/s").
+                            arg(Core::Memory::sizeLabel(static_cast<quint64>(stats.bytesPerSecond)));
+                    }
+                    lowerRight += text;
+                }
+                lowerRight += qApp->translate("djv::ViewLib::ImageView", "Cache = %1% Preload = %2").
+                    arg(static_cast<int>(_p->hudInfo.cacheHitRate)).
+                    arg(_p->hudInfo.preloadDepth);
+            }
+            if (_p->hudInfo.visible[Enum::HUD_MEMORY])
+            {
+                lowerRight += qApp->translate("djv::ViewLib::ImageView", "Memory = %1/%2").
+                    arg(Core::Memory::sizeLabel(_p->hudInfo.memoryUsage)).
+                    arg(Core::Memory::sizeLabel(_p->hudInfo.memoryBudget));
+            }
+
             const glm::ivec2 size(width(), height());
             _p->hudPixelData.set(Graphics::PixelDataInfo(size, Graphics::Pixel::RGBA_U8));
             _p->hudPixelData.zero();
@@ -674,6 +718,15 @@ namespace djv
                 p.y += th + m;
             }
 
+            // Draw the lower right contents.
+            p = glm::ivec2(size.x - m, height() - th * lowerRight.count() - m);
+            for (int i = 0; i < lowerRight.count(); ++i)
+            {
+                const int tw = fontMetrics().width(lowerRight[i]);
+                drawHudItem(painter, lowerRight[i], Core::Box2i(p.x - tw - m, p.y, tw + m, th + m));
+                p.y += th + m;
+            }
+
             try
             {
                 auto glFuncs = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_3_3_Core>();
@@ -40,14 +40,14 @@
 #include <djvUI/Prefs.h>
 #include <djvUI/ToolButton.h>
 
-#include <djvGraphics/OpenGLImage.h>
-#include <djvGraphics/OpenGLOffscreenBuffer.h>
+#include <djvGraphics/ColorPipeline.h>
 
 #include <djvCore/Debug.h>
 #include <djvCore/SignalBlocker.h>
 
 #include <QApplication>
 #include <QHBoxLayout>
+#include <QImage>
 #include <QPainter>
 #include <QPointer>
 #include <QScopedPointer>
@@ -55,6 +55,8 @@
 #include <QTimer>
 #include <QVBoxLayout>
 
+#include <string.h>
+
 namespace
 {
     class Widget : public QWidget
@@ -106,7 +108,6 @@ namespace djv
             bool colorProfile = true;
             bool displayProfile = true;
             bool pixelDataInit = false;
-            std::unique_ptr<Graphics::OpenGLImage> openGLImage;
             QPointer<Widget> widget;
             QPointer<UI::IntEditSlider> slider;
             QPointer<UI::ToolButton> colorProfileButton;
@@ -196,9 +197,6 @@ namespace djv
             prefs.set("zoom", _p->zoom);
             prefs.set("colorProfile", _p->colorProfile);
             prefs.set("displayProfile", _p->displayProfile);
-
-            context()->makeGLContextCurrent();
-            _p->openGLImage.reset();
         }
 
         void MagnifyTool::showEvent(QShowEvent *)
@@ -284,32 +282,26 @@ namespace djv
                         glm::vec2(tmp.info().size) / 2.f);
                     //DJV_DEBUG_PRINT("zoom = " << zoom);
                     //DJV_DEBUG_PRINT("pick = " << pick);
-                    try
+                    Graphics::OpenGLImageOptions options = viewWidget()->options();
+                    options.xform.position -= pick;
+                    options.xform.scale *= zoom * viewWidget()->viewZoom();
+                    if (!_p->colorProfile)
                     {
-                        context()->makeGLContextCurrent();
-                        if (!_p->openGLImage)
-                        {
-                            _p->openGLImage.reset(new Graphics::OpenGLImage);
-                        }
-                        Graphics::OpenGLImageOptions options = viewWidget()->options();
-                        options.xform.position -= pick;
-                        options.xform.scale *= zoom * viewWidget()->viewZoom();
-                        if (!_p->colorProfile)
-                        {
-                            options.colorProfile = Graphics::ColorProfile();
-                        }
-                        if (!_p->displayProfile)
-                        {
-                            options.displayProfile = DisplayProfile();
-                        }
-                        _p->openGLImage->copy(*data, tmp, options);
-                        pixmap = _p->openGLImage->toQt(tmp);
+                        options.colorProfile = Graphics::ColorProfile();
                     }
-                    catch (Core::Error error)
+                    if (!_p->displayProfile)
+                    {
+                        options.displayProfile = DisplayProfile();
+                    }
+                    Graphics::ColorPipeline::sample(*data, tmp, options);
+
+                    // Convert to a QImage, flipping the scanlines.
+                    QImage image(size.x, size.y, QImage::Format_RGB888);
+                    for (int y = 0; y < size.y; ++y)
                     {
-                        error.add(Enum::errorLabels()[Enum::ERROR_MAGNIFY]);
-                        context()->printError(error);
+                        memcpy(image.scanLine(y), tmp.data(0, size.y - 1 - y), size.x * 3);
                     }
+                    pixmap = QPixmap::fromImage(image);
                 }
             }
             _p->widget->setPixmap(pixmap);
@@ -57,6 +57,8 @@
 #include <djvCore/Debug.h>
 #include <djvCore/DebugLog.h>
 #include <djvCore/Error.h>
+#include <djvCore/Memory.h>
+#include <djvCore/MemoryBudget.h>
 
 #include <QApplication>
 #include <QDesktopWidget>
@@ -71,6 +73,8 @@
 #include <QTimer>
 #include <QToolBar>
 
+#include <algorithm>
+
 namespace djv
 {
     namespace ViewLib
@@ -189,6 +193,10 @@ namespace djv
                 _p->fileGroup,
                 SIGNAL(reloadFrame()),
                 SLOT(reloadFrameCallback()));
+            connect(
+                _p->fileGroup,
+                SIGNAL(sequenceChanged()),
+                SLOT(sequenceCallback()));
             connect(
                 _p->fileGroup,
                 SIGNAL(exportSequence(const djv::Core::FileInfo &)),
@@ -287,6 +295,14 @@ namespace djv
                 context->fileCache(),
                 SIGNAL(cacheChanged()),
                 SLOT(fileCacheUpdate()));
+            connect(
+                context->fileCache(),
+                SIGNAL(cacheChanged()),
+                SLOT(viewOverlayUpdate()));
+            connect(
+                context->memoryBudget(),
+                SIGNAL(pressure(quint64, quint64)),
+                SLOT(viewOverlayUpdate()));
             connect(
                 context->UIContext::openGLPrefs(),
                 SIGNAL(filterChanged(const djv::Graphics::OpenGLImageFilter &)),
@@ -368,8 +384,8 @@ namespace djv
                 QString("Open file = \"%1\"").arg(fileInfo));
 
             // Initialize.
-            _p->image.reset();
             _p->viewWidget->setData(nullptr);
+            _p->image.reset();
 
             // Open the file.
             {
@@ -562,6 +578,14 @@ namespace djv
             _p->context->fileCache()->removeItem(FileCacheKey(this, frame));
         }
 
+        void MainWindow::sequenceCallback()
+        {
+            //DJV_DEBUG("MainWindow::sequenceCallback");
+            _p->playbackGroup->updateSequence(_p->fileGroup->imageIOInfo().sequence);
+            fileUpdate();
+            imageUpdate();
+        }
+
         void MainWindow::exportSequenceCallback(const Core::FileInfo & in)
         {
             //DJV_DEBUG("MainWindow::exportSequenceCallback");
@@ -677,21 +701,54 @@ namespace djv
         void MainWindow::fileCacheUpdate()
         {
             //DJV_DEBUG("MainWindow::cacheUpdate");
-            const float sizeGB = _p->context->fileCache()->currentSizeGB();
-            const float maxSizeGB = _p->context->fileCache()->maxSizeGB();
-            _p->infoCacheLabel->setText(
-                qApp->translate("djv::ViewLib::MainWindow", "Cache: %1% %2/%3GB").
+            const auto fileCache = _p->context->fileCache();
+            const float sizeGB = fileCache->currentSizeGB();
+            const float maxSizeGB = fileCache->maxSizeGB();
+            QString text = qApp->translate("djv::ViewLib::MainWindow", "Cache: %1% %2/%3GB").
                 arg(static_cast<int>(sizeGB / maxSizeGB * 100)).
                 arg(sizeGB, 0, 'f', 2).
-                arg(maxSizeGB, 0, 'f', 2));
+                arg(maxSizeGB, 0, 'f', 2);
+            if (fileCache->compression())
+            {
+                text += qApp->translate("djv::ViewLib::MainWindow", ", Compressed: %1/%2 %3:1 %4/s").
+                    arg(Core::Memory::sizeLabel(fileCache->compressedSizeBytes())).
+                    arg(Core::Memory::sizeLabel(fileCache->compressedMaxSizeBytes())).
+                    arg(fileCache->compressionRatio(), 0, 'f', 2).
+                    arg(Core::Memory::sizeLabel(static_cast<quint64>(fileCache->decompressThroughput())));
+            }
+            if (fileCache->hasDiskCache())
+            {
+                text += qApp->translate("djv::ViewLib::MainWindow", ", Disk: %1/%2").
+                    arg(Core::Memory::sizeLabel(fileCache->diskSizeBytes())).
+                    arg(Core::Memory::sizeLabel(fileCache->diskMaxSizeBytes()));
+            }
+            QStringList hits;
+            for (int i = 0; i < FileCache::TIER_COUNT; ++i)
+            {
+                const auto tier = static_cast<FileCache::TIER>(i);
+                const quint64 lookups = fileCache->hits(tier) + fileCache->misses(tier);
+                if (lookups)
+                {
+                    hits += qApp->translate("djv::ViewLib::MainWindow", "%1 %2%").
+                        arg(FileCache::tierLabels()[i]).
+                        arg(static_cast<int>(fileCache->hits(tier) * 100 / lookups));
+                }
+            }
+            if (hits.count())
+            {
+                text += qApp->translate("djv::ViewLib::MainWindow", ", Hits: %1").arg(hits.join(" "));
+            }
+            _p->infoCacheLabel->setText(text);
         }
 
         void MainWindow::imageUpdate()
         {
             //DJV_DEBUG("MainWindow::imageUpdate");
 
-            // Update the image.
+            // Update the image. The previous image is kept until the view has
+            // been given the new one, since the view references it.
             const qint64 frame = _p->playbackGroup->frame();
+            const auto previousImage = _p->image;
             _p->image = _p->fileGroup->image(frame);
             if (_p->image)
             {
@@ -786,7 +843,34 @@ namespace djv
             hudInfo.speed = _p->playbackGroup->speed();
             hudInfo.actualSpeed = _p->playbackGroup->actualSpeed();
             hudInfo.droppedFrames = _p->playbackGroup->hasDroppedFrames();
+            hudInfo.memoryUsage = std::max(
+                _p->context->memoryBudget()->usage(),
+                Core::MemoryBudget::residentMemory());
+            hudInfo.memoryBudget = _p->context->memoryBudget()->budget();
             hudInfo.visible = _p->context->viewPrefs()->hudInfo();
+            if (hudInfo.visible[Enum::HUD_TIMING])
+            {
+                for (int i = 0; i < Enum::FRAME_STAGE_COUNT; ++i)
+                {
+                    hudInfo.frameStats.append(_p->context->frameStats(static_cast<Enum::FRAME_STAGE>(i))->summary());
+                }
+                const auto fileCache = _p->context->fileCache();
+                const quint64 lookups =
+                    fileCache->hits(FileCache::TIER_MEMORY) +
+                    fileCache->misses(FileCache::TIER_MEMORY);
+                if (lookups)
+                {
+                    hudInfo.cacheHitRate = fileCache->hits(FileCache::TIER_MEMORY) * 100.f / lookups;
+                }
+                const qint64 frameCount = static_cast<qint64>(sequence.frames.count());
+                for (qint64 i = 1; i < frameCount; ++i)
+                {
+                    const qint64 frame = (_p->playbackGroup->frame() + i) % frameCount;
+                    if (!fileCache->hasItem(FileCacheKey(this, frame)))
+                        break;
+                    ++hudInfo.preloadDepth;
+                }
+            }
             _p->viewWidget->setHudInfo(hudInfo);
         }
 
@@ -848,9 +932,11 @@ namespace djv
             case Enum::FORWARD:
             case Enum::REVERSE:
                 _p->fileGroup->setPreloadActive(false);
+                _p->viewWidget->setPlaying(true);
                 break;
             case Enum::STOP:
                 _p->fileGroup->setPreloadActive(true);
+                _p->viewWidget->setPlaying(false);
                 break;
             default: break;
             }
@@ -121,6 +121,7 @@ namespace djv
             void windowResizeCallback();
             void enableUpdatesCallback();
             void reloadFrameCallback();
+            void sequenceCallback();
             void exportSequenceCallback(const djv::Core::FileInfo &);
             void exportFrameCallback(const djv::Core::FileInfo &);
             void setFrameStoreCallback();
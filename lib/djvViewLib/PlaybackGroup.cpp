@@ -327,6 +327,28 @@ namespace djv
             Q_EMIT droppedFramesChanged(_p->droppedFrames);
         }
 
+        void PlaybackGroup::updateSequence(const Core::Sequence & sequence)
+        {
+            if (sequence == _p->sequence)
+                return;
+            //DJV_DEBUG("PlaybackGroup::updateSequence");
+            //DJV_DEBUG_PRINT("sequence = " << sequence);
+            const bool outPointEnd = _p->outPoint >= sequenceEnd(_p->sequence);
+            _p->sequence = sequence;
+            const qint64 end = sequenceEnd(_p->sequence);
+            const qint64 inPoint = Core::Math::clamp<qint64>(_p->inPoint, 0, end);
+            const qint64 outPoint = outPointEnd ? end : Core::Math::clamp<qint64>(_p->outPoint, inPoint, end);
+            const qint64 frame = Core::Math::clamp<qint64>(_p->frame, 0, end);
+            timeUpdate();
+            Q_EMIT sequenceChanged(_p->sequence);
+            setInPoint(inPoint);
+            setOutPoint(outPoint);
+            if (frame != _p->frame)
+            {
+                setFrame(frame, false);
+            }
+        }
+
         void PlaybackGroup::setPlayback(Enum::PLAYBACK playback)
         {
             if (playback == _p->playback)
@@ -103,6 +103,11 @@ namespace djv
             //! Set the sequence.
             void setSequence(const djv::Core::Sequence &);
 
+            //! Update the sequence when frames are added or removed. Unlike
+            //! setSequence() the current frame and in/out points are kept; if the
+            //! out point is at the end of the sequence it follows the new end.
+            void updateSequence(const djv::Core::Sequence &);
+
             //! Set the playback.
             void setPlayback(djv::ViewLib::Enum::PLAYBACK);
 
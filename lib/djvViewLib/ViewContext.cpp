@@ -71,6 +71,8 @@ namespace djv
 
             QPointer<FileCache>  fileCache;
             QPointer<FileExport> fileExport;
+
+            std::unique_ptr<Core::TimingStats> frameStats[Enum::FRAME_STAGE_COUNT];
         };
 
         ViewContext::ViewContext(int & argc, char ** argv, QObject * parent) :
@@ -96,6 +98,10 @@ namespace djv
             DJV_LOG(debugLog(), "ViewContext", "Initialize objects...");
             _p->fileCache = new FileCache(this);
             _p->fileExport = new FileExport(this);
+            for (int i = 0; i < Enum::FRAME_STAGE_COUNT; ++i)
+            {
+                _p->frameStats[i].reset(new Core::TimingStats);
+            }
         }
 
         ViewContext::~ViewContext()
@@ -164,6 +170,11 @@ namespace djv
             return _p->fileExport;
         }
 
+        Core::TimingStats * ViewContext::frameStats(Enum::FRAME_STAGE stage) const
+        {
+            return _p->frameStats[stage].get();
+        }
+
         void ViewContext::setValid(bool valid)
         {
             UI::UIContext::setValid(true);
@@ -36,6 +36,7 @@
 #include <djvGraphics/PixelData.h>
 
 #include <djvCore/Sequence.h>
+#include <djvCore/TimingStats.h>
 
 #include <QScopedPointer>
 
@@ -108,6 +109,10 @@ namespace djv
             //! Get the file exporter.
             const QPointer<FileExport> & fileExport() const;
 
+            //! Get the frame timing statistics for a stage. The statistics may
+            //! be updated from any thread.
+            Core::TimingStats * frameStats(Enum::FRAME_STAGE) const;
+
             void setValid(bool) override;
 
         protected:
@@ -132,7 +132,9 @@ namespace djv
 
         QVector<bool> ViewPrefs::hudInfoDefault()
         {
-            return QVector<bool>(Enum::HUD_COUNT, true);
+            QVector<bool> out(Enum::HUD_COUNT, true);
+            out[Enum::HUD_TIMING] = false;
+            return out;
         }
 
         QVector<bool> ViewPrefs::hudInfo() const
@@ -0,0 +1,136 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+#include <djvCoreTest/DebugLogTest.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/DebugLog.h>
+#include <djvCore/Timer.h>
+
+#include <thread>
+#include <vector>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        void DebugLogTest::run(int &, char **)
+        {
+            DJV_DEBUG("DebugLogTest::run");
+            {
+                DebugLog log;
+                DJV_ASSERT(0 == log.messages().count());
+                log.addMessage("context", "a\nb");
+                log.addMessage("context", "c");
+                const auto messages = log.messages();
+                DJV_ASSERT(3 == messages.count());
+                DJV_ASSERT(messages[0] == QString("[%1] %2").arg("context", -30).arg("a"));
+                DJV_ASSERT(messages[1] == QString("[%1] %2").arg("context", -30).arg("b"));
+                DJV_ASSERT(messages[2] == QString("[%1] %2").arg("context", -30).arg("c"));
+            }
+            {
+                DebugLog log;
+                for (int i = 0; i < DebugLog::messagesMax + 10; ++i)
+                {
+                    log.addMessage("context", QString::number(i));
+                }
+                const auto messages = log.messages();
+                DJV_ASSERT(DebugLog::messagesMax == messages.count());
+                DJV_ASSERT(messages[0].endsWith("] 10"));
+                DJV_ASSERT(messages.last().endsWith(QString("] %1").arg(DebugLog::messagesMax + 9)));
+            }
+            {
+                DebugLog log;
+                const int threadCount = 8;
+                const int messageCount = 10000;
+                Timer timer;
+                timer.start();
+                std::vector<std::thread> threads;
+                for (int i = 0; i < threadCount; ++i)
+                {
+                    threads.push_back(std::thread([&log, i, messageCount]
+                    {
+                        const QString context = QString("thread %1").arg(i);
+                        for (int j = 0; j < messageCount; ++j)
+                        {
+                            log.addMessage(context, QString::number(j));
+                        }
+                    }));
+                }
+                for (auto & i : threads)
+                {
+                    i.join();
+                }
+                timer.check();
+                DJV_DEBUG_PRINT("messages/s = " << threadCount * messageCount / timer.seconds());
+                log.flush();
+                const auto messages = log.messages();
+                DJV_DEBUG_PRINT("messages = " << messages.count());
+                DJV_ASSERT(messages.count() > 0);
+                DJV_ASSERT(messages.count() <= DebugLog::messagesMax);
+
+                // The messages from each thread should be in order.
+                std::vector<int> last(threadCount, -1);
+                for (const auto & message : messages)
+                {
+                    for (int i = 0; i < threadCount; ++i)
+                    {
+                        if (message.startsWith(QString("[thread %1 ").arg(i)))
+                        {
+                            const int value = message.mid(message.lastIndexOf(' ') + 1).toInt();
+                            DJV_ASSERT(value > last[i]);
+                            last[i] = value;
+                        }
+                    }
+                }
+            }
+            {
+                // Messages that have not been delivered when the log is
+                // destroyed are delivered by the destructor.
+                int count = 0;
+                {
+                    DebugLog log;
+                    QObject::connect(&log, &DebugLog::message, [&count](const QString &) { ++count; });
+                    std::thread([&log]
+                    {
+                        for (int i = 0; i < 100; ++i)
+                        {
+                            log.addMessage("context", QString::number(i));
+                        }
+                    }).join();
+                    DJV_ASSERT(0 == count);
+                }
+                DJV_ASSERT(100 == count);
+            }
+        }
+
+    } // namespace CoreTest
+} // namespace djv
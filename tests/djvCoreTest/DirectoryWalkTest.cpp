@@ -0,0 +1,128 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCoreTest/DirectoryWalkTest.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/DirectoryWalk.h>
+#include <djvCore/FileInfoUtil.h>
+
+#include <QDir>
+#include <QFile>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        void DirectoryWalkTest::run(int &, char **)
+        {
+            DJV_DEBUG("DirectoryWalkTest::run");
+            const QString root = "DirectoryWalkTest";
+            QDir(root).removeRecursively();
+            QDir().mkpath(root + "/a/b");
+            QDir().mkpath(root + "/a/c");
+            QDir().mkpath(root + "/d");
+            QDir().mkpath(root + "/.hidden");
+            Q_FOREACH(const QString & fileName, QStringList() <<
+                root + "/file1.txt" <<
+                root + "/file2.txt" <<
+                root + "/a/b/file.txt")
+            {
+                QFile file(fileName);
+                file.open(QIODevice::WriteOnly);
+            }
+            {
+                DirectoryWalk walk;
+                DJV_ASSERT(!walk.hasRecurse());
+                DJV_ASSERT(!walk.hasHidden());
+                DJV_ASSERT(0 == walk.threads());
+                QStringList directories;
+                walk.walk(FileInfoList() << FileInfo(root), [&directories](const DirectoryWalk::Directory & directory)
+                {
+                    directories += directory.fileInfo;
+                });
+                DJV_ASSERT(1 == directories.count());
+            }
+            QStringList serial;
+            for (int threads = 1; threads <= 8; threads *= 8)
+            {
+                DJV_DEBUG_PRINT("threads = " << threads);
+                DirectoryWalk walk;
+                walk.setRecurse(true);
+                walk.setThreads(threads);
+                walk.setProcessCallback([](DirectoryWalk::Directory & directory)
+                {
+                    FileInfoUtil::filter(directory.items, FileInfoUtil::FILTER_DIRECTORIES);
+                });
+                QStringList directories;
+                int items = 0;
+                walk.walk(FileInfoList() << FileInfo(root), [&directories, &items](const DirectoryWalk::Directory & directory)
+                {
+                    DJV_ASSERT(directory.valid);
+                    directories += directory.fileInfo;
+                    items += directory.items.count();
+                });
+                DJV_DEBUG_PRINT("directories = " << directories);
+                DJV_ASSERT(5 == directories.count());
+                DJV_ASSERT(3 == items);
+                DJV_ASSERT(directories.indexOf(QRegExp(".*/a/?")) < directories.indexOf(QRegExp(".*/b/?")));
+                if (serial.isEmpty())
+                {
+                    serial = directories;
+                }
+                DJV_ASSERT(serial == directories);
+            }
+            {
+                DirectoryWalk walk;
+                walk.setRecurse(true);
+                walk.setHidden(true);
+                int count = 0;
+                walk.walk(FileInfoList() << FileInfo(root), [&count](const DirectoryWalk::Directory &)
+                {
+                    ++count;
+                });
+                DJV_ASSERT(6 == count);
+            }
+            {
+                DirectoryWalk walk;
+                bool valid = true;
+                walk.walk(FileInfoList() << FileInfo(root + "/missing"), [&valid](const DirectoryWalk::Directory & directory)
+                {
+                    valid = directory.valid;
+                });
+                DJV_ASSERT(!valid);
+            }
+            QDir(root).removeRecursively();
+        }
+
+    } // namespace CoreTest
+} // namespace djv
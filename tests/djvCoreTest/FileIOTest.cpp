@@ -33,6 +33,8 @@
 #include <djvCore/Debug.h>
 #include <djvCore/FileIO.h>
 
+#include <vector>
+
 using namespace djv::Core;
 
 namespace djv
@@ -197,6 +199,91 @@ namespace djv
                 {
                 }
             }
+            {
+                DJV_DEBUG_PRINT("no mmap");
+                FileIO io;
+                DJV_ASSERT(io.hasMmap());
+                io.setMmap(false);
+                DJV_ASSERT(!io.hasMmap());
+                io.open(fileName, FileIO::READ);
+                DJV_ASSERT(!io.mmapP());
+                const quint64 size = io.size();
+                qint8 read8 = 0;
+                quint8 readU8 = 0;
+                io.get8(&read8);
+                io.getU8(&readU8);
+                DJV_ASSERT(127 == readU8);
+                DJV_ASSERT(2 == io.pos());
+                io.setPos(1);
+                io.getU8(&readU8);
+                DJV_ASSERT(127 == readU8);
+                try
+                {
+                    io.setPos(size);
+                    io.get8(&read8);
+                    DJV_ASSERT(0);
+                }
+                catch (...)
+                {
+                }
+            }
+#if ! defined(DJV_WINDOWS)
+            {
+                DJV_DEBUG_PRINT("mmap range");
+                const quint64 alignment = FileIO::mmapAlignment();
+                DJV_ASSERT(alignment > 0);
+                std::vector<quint8> data(alignment * 3);
+                for (size_t i = 0; i < data.size(); ++i)
+                {
+                    data[i] = static_cast<quint8>(i % 251);
+                }
+                {
+                    FileIO io;
+                    io.open(fileName, FileIO::WRITE);
+                    io.set(data.data(), data.size());
+                }
+                const quint64 offset = alignment + 10;
+                FileIO io;
+                io.setMmapRange(offset, 100);
+                io.open(fileName, FileIO::READ);
+                DJV_ASSERT(data.size() == io.size());
+                DJV_ASSERT(alignment == io.pos());
+                DJV_ASSERT(offset + 100 == alignment + static_cast<quint64>(io.mmapEnd() - io.mmapP()));
+                io.setPos(offset);
+                DJV_ASSERT(data[offset] == *io.mmapP());
+                quint8 readU8 = 0;
+                io.getU8(&readU8);
+                DJV_ASSERT(data[offset] == readU8);
+                DJV_ASSERT(offset + 1 == io.pos());
+                try
+                {
+                    io.setPos(0);
+                    DJV_ASSERT(0);
+                }
+                catch (...)
+                {
+                }
+                try
+                {
+                    io.setPos(offset + 100);
+                    io.getU8(&readU8);
+                    DJV_ASSERT(0);
+                }
+                catch (...)
+                {
+                }
+                try
+                {
+                    FileIO io;
+                    io.setMmapRange(data.size(), 100);
+                    io.open(fileName, FileIO::READ);
+                    DJV_ASSERT(0);
+                }
+                catch (const Error &)
+                {
+                }
+            }
+#endif // DJV_WINDOWS
         }
 
     } // namespace CoreTest
@@ -235,6 +235,12 @@ namespace djv
             FileInfoUtil::filter(tmp, 0, QString(), QStringList() << "*1*" << "*3*");
             DJV_ASSERT(list[0] == tmp[0]);
             DJV_ASSERT(list[1] == tmp[1]);
+            {
+                QVector<int> indices = QVector<int>() << 0 << 1 << 2;
+                FileInfoUtil::filter(list, indices, 0, "3");
+                DJV_ASSERT(1 == indices.count());
+                DJV_ASSERT(1 == indices[0]);
+            }
         }
 
         void FileInfoUtilTest::sort()
@@ -297,6 +303,18 @@ namespace djv
             tmp[2].setType(FileInfo::DIRECTORY);
             FileInfoUtil::sortDirsFirst(tmp);
             DJV_ASSERT(tmp[0].fileName() == list[2].fileName());
+
+            {
+                QVector<int> indices = QVector<int>() << 0 << 1 << 2;
+                FileInfoUtil::sort(list, indices, FileInfoUtil::SORT_NAME);
+                DJV_ASSERT((QVector<int>() << 2 << 1 << 0) == indices);
+                FileInfoUtil::sort(list, indices, FileInfoUtil::SORT_NAME, true);
+                DJV_ASSERT((QVector<int>() << 0 << 1 << 2) == indices);
+                tmp = list;
+                tmp[1].setType(FileInfo::DIRECTORY);
+                FileInfoUtil::sortDirsFirst(tmp, indices);
+                DJV_ASSERT((QVector<int>() << 1 << 0 << 2) == indices);
+            }
         }
 
         void FileInfoUtilTest::recent()
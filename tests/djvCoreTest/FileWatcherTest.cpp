@@ -0,0 +1,114 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCoreTest/FileWatcherTest.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/FileWatcher.h>
+#include <djvCore/Timer.h>
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        void FileWatcherTest::run(int &, char **)
+        {
+            DJV_DEBUG("FileWatcherTest::run");
+            const QString root = "FileWatcherTest";
+            QDir(root).removeRecursively();
+            QDir().mkpath(root);
+            {
+                FileWatcher watcher;
+                DJV_ASSERT(watcher.directories().isEmpty());
+                watcher.addDirectory(root);
+                watcher.addDirectory(root);
+                DJV_ASSERT(1 == watcher.directories().count());
+                watcher.removeDirectory(root);
+                DJV_ASSERT(watcher.directories().isEmpty());
+                watcher.addDirectory(root + "/missing");
+                DJV_ASSERT(watcher.directories().isEmpty());
+            }
+            if (FileWatcher::hasFileEvents())
+            {
+                FileWatcher watcher;
+                watcher.addDirectory(root);
+                QStringList created;
+                QStringList modified;
+                QStringList removed;
+                QObject::connect(&watcher, &FileWatcher::fileCreated, [&created](const QString & fileName)
+                {
+                    created += fileName;
+                });
+                QObject::connect(&watcher, &FileWatcher::fileModified, [&modified](const QString & fileName)
+                {
+                    modified += fileName;
+                });
+                QObject::connect(&watcher, &FileWatcher::fileRemoved, [&removed](const QString & fileName)
+                {
+                    removed += fileName;
+                });
+                const QString fileName = root + "/file.1.txt";
+                {
+                    QFile file(fileName);
+                    file.open(QIODevice::WriteOnly);
+                    file.write("a");
+                }
+                {
+                    QFile file(fileName);
+                    file.open(QIODevice::WriteOnly);
+                    file.write("b");
+                }
+                QFile::remove(fileName);
+                Timer timer;
+                timer.start();
+                while (removed.isEmpty() && timer.seconds() < 5.f)
+                {
+                    QCoreApplication::processEvents();
+                    timer.check();
+                }
+                DJV_DEBUG_PRINT("created = " << created);
+                DJV_DEBUG_PRINT("modified = " << modified);
+                DJV_DEBUG_PRINT("removed = " << removed);
+                DJV_ASSERT(1 == created.count());
+                DJV_ASSERT(created[0].endsWith("file.1.txt"));
+                DJV_ASSERT(1 == modified.count());
+                DJV_ASSERT(1 == removed.count());
+            }
+            QDir(root).removeRecursively();
+        }
+
+    } // namespace CoreTest
+} // namespace djv
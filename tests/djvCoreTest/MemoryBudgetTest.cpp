@@ -0,0 +1,114 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCoreTest/MemoryBudgetTest.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/MemoryBudget.h>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        void MemoryBudgetTest::run(int &, char **)
+        {
+            DJV_DEBUG("MemoryBudgetTest::run");
+            DJV_DEBUG_PRINT("system = " << MemoryBudget::systemMemory());
+            DJV_DEBUG_PRINT("resident = " << MemoryBudget::residentMemory());
+            DJV_DEBUG_PRINT("cgroup = " << MemoryBudget::cgroupLimit());
+            {
+                MemoryBudget budget;
+                const int a = budget.addClient("a", MemoryBudget::PRIORITY_LOW);
+                const int b = budget.addClient("b", MemoryBudget::PRIORITY_HIGH);
+                DJV_ASSERT(a != b);
+                budget.setUsage(a, 1);
+                budget.setUsage(b, 2);
+                DJV_ASSERT(1 == budget.clientUsage(a));
+                DJV_ASSERT(2 == budget.clientUsage(b));
+                DJV_ASSERT(3 == budget.usage());
+                DJV_ASSERT(1 == budget.priorityUsage(MemoryBudget::PRIORITY_LOW));
+                DJV_ASSERT(0 == budget.priorityUsage(MemoryBudget::PRIORITY_NORMAL));
+                budget.removeClient(a);
+                DJV_ASSERT(0 == budget.clientUsage(a));
+                DJV_ASSERT(2 == budget.usage());
+                budget.setBudget(1000);
+                DJV_ASSERT(1000 == budget.budget());
+                DJV_DEBUG_PRINT("info = " << budget.info());
+            }
+            {
+                // The lowest priority clients are asked to release memory first.
+                MemoryBudget budget;
+                QStringList released;
+                int low = 0;
+                int normal = 0;
+                int high = 0;
+                normal = budget.addClient("normal", MemoryBudget::PRIORITY_NORMAL,
+                    [&budget, &released, &normal](quint64)
+                {
+                    released += "normal";
+                    const quint64 out = budget.clientUsage(normal);
+                    budget.setUsage(normal, 0);
+                    return out;
+                });
+                low = budget.addClient("low", MemoryBudget::PRIORITY_LOW,
+                    [&budget, &released, &low](quint64)
+                {
+                    released += "low";
+                    const quint64 out = budget.clientUsage(low);
+                    budget.setUsage(low, 0);
+                    return out;
+                });
+                high = budget.addClient("high", MemoryBudget::PRIORITY_HIGH);
+                budget.setUsage(low, 100);
+                budget.setUsage(normal, 200);
+                budget.setUsage(high, 300);
+                budget.setBudget(1);
+                DJV_ASSERT((QStringList() << "low" << "normal") == released);
+                DJV_ASSERT(0 == budget.priorityUsage(MemoryBudget::PRIORITY_LOW));
+                DJV_ASSERT(0 == budget.priorityUsage(MemoryBudget::PRIORITY_NORMAL));
+                DJV_ASSERT(300 == budget.priorityUsage(MemoryBudget::PRIORITY_HIGH));
+            }
+            {
+                // Without an explicit budget one is derived from the system.
+                MemoryBudget budget;
+                if (MemoryBudget::systemMemory())
+                {
+                    DJV_ASSERT(budget.budget() > 0);
+                    DJV_ASSERT(budget.budget() <= MemoryBudget::systemMemory());
+                }
+                budget.setCgroupAware(false);
+                DJV_ASSERT(!budget.isCgroupAware());
+            }
+        }
+
+    } // namespace CoreTest
+} // namespace djv
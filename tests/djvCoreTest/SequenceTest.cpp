@@ -136,6 +136,16 @@ namespace djv
                 seq.sort();
                 DJV_ASSERT((FrameList() << -3 << -2 << -1) == seq.frames);
             }
+            {
+                Sequence seq(FrameList() << 1 << 2 << 4);
+                DJV_ASSERT(3 == seq.insertFrame(5));
+                DJV_ASSERT(2 == seq.insertFrame(3));
+                DJV_ASSERT(-1 == seq.insertFrame(3));
+                DJV_ASSERT((FrameList() << 1 << 2 << 3 << 4 << 5) == seq.frames);
+                DJV_ASSERT(0 == seq.removeFrame(1));
+                DJV_ASSERT(-1 == seq.removeFrame(1));
+                DJV_ASSERT((FrameList() << 2 << 3 << 4 << 5) == seq.frames);
+            }
             {
                 const Sequence seq(FrameList() << 1 << 5 << 15);
                 DJV_ASSERT(0 == Sequence::findClosest(1, seq.frames));
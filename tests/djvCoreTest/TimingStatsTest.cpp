@@ -0,0 +1,106 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCoreTest/TimingStatsTest.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/Math.h>
+#include <djvCore/TimingStats.h>
+
+#include <thread>
+#include <vector>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        void TimingStatsTest::run(int &, char **)
+        {
+            DJV_DEBUG("TimingStatsTest::run");
+            {
+                const TimingStats stats(10);
+                DJV_ASSERT(10 == stats.windowSize());
+                DJV_ASSERT(0 == stats.summary().count);
+                DJV_ASSERT(TimingStats::Summary() == stats.summary());
+            }
+            {
+                TimingStats stats(100);
+                for (int i = 1; i <= 100; ++i)
+                {
+                    stats.add(i / 100.f, 100);
+                }
+                const auto summary = stats.summary();
+                DJV_DEBUG_PRINT("mean = " << summary.mean);
+                DJV_DEBUG_PRINT("p95 = " << summary.p95);
+                DJV_DEBUG_PRINT("max = " << summary.max);
+                DJV_DEBUG_PRINT("bytes/s = " << summary.bytesPerSecond);
+                DJV_ASSERT(100 == summary.count);
+                DJV_ASSERT(Math::fuzzyCompare(summary.mean, .505f, .001f));
+                DJV_ASSERT(Math::fuzzyCompare(summary.p95, .96f, .001f));
+                DJV_ASSERT(Math::fuzzyCompare(summary.max, 1.f));
+                DJV_ASSERT(Math::fuzzyCompare(summary.bytesPerSecond, 10000.f / 50.5f, .1f));
+            }
+            {
+                TimingStats stats(2);
+                stats.add(1.f);
+                stats.add(2.f);
+                stats.add(3.f);
+                const auto summary = stats.summary();
+                DJV_ASSERT(2 == summary.count);
+                DJV_ASSERT(Math::fuzzyCompare(summary.mean, 2.5f));
+                DJV_ASSERT(Math::fuzzyCompare(summary.max, 3.f));
+                stats.reset();
+                DJV_ASSERT(0 == stats.summary().count);
+            }
+            {
+                TimingStats stats(1000);
+                std::vector<std::thread> threads;
+                for (int i = 0; i < 4; ++i)
+                {
+                    threads.push_back(std::thread([&stats]
+                    {
+                        for (int j = 0; j < 100; ++j)
+                        {
+                            stats.add(1.f);
+                        }
+                    }));
+                }
+                for (auto & i : threads)
+                {
+                    i.join();
+                }
+                DJV_ASSERT(400 == stats.summary().count);
+            }
+        }
+
+    } // namespace CoreTest
+} // namespace djv
@@ -0,0 +1,120 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCoreTest/TraceTest.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/Error.h>
+#include <djvCore/ErrorUtil.h>
+#include <djvCore/Trace.h>
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <thread>
+#include <vector>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        void TraceTest::run(int &, char **)
+        {
+            DJV_DEBUG("TraceTest::run");
+            const quint64 eventCount = Trace::eventCount();
+            {
+                DJV_ASSERT(!Trace::isEnabled());
+                DJV_TRACE("TraceTest::disabled", "Test");
+            }
+            DJV_ASSERT(eventCount == Trace::eventCount());
+            Trace::setEnabled(true);
+            {
+                DJV_TRACE("TraceTest::run", "Test");
+                std::vector<std::thread> threads;
+                for (int i = 0; i < 4; ++i)
+                {
+                    threads.push_back(std::thread([]
+                    {
+                        for (int j = 0; j < 5000; ++j)
+                        {
+                            DJV_TRACE("TraceTest::\"thread\"", "Test");
+                        }
+                    }));
+                }
+                for (auto & i : threads)
+                {
+                    i.join();
+                }
+            }
+            Trace::setEnabled(false);
+            DJV_DEBUG_PRINT("events = " << Trace::eventCount());
+            DJV_ASSERT(eventCount + 20001 == Trace::eventCount());
+            try
+            {
+                const QString fileName("TraceTest.json");
+                Trace::write(fileName);
+                QFile file(fileName);
+                DJV_ASSERT(file.open(QIODevice::ReadOnly));
+                const QJsonDocument document = QJsonDocument::fromJson(file.readAll());
+                DJV_ASSERT(document.isObject());
+                const QJsonArray events = document.object()["traceEvents"].toArray();
+                int count = 0;
+                Q_FOREACH(const QJsonValue & value, events)
+                {
+                    const QJsonObject event = value.toObject();
+                    if ("X" == event["ph"].toString() &&
+                        "Test" == event["cat"].toString())
+                    {
+                        DJV_ASSERT(event["dur"].toDouble() >= 0.0);
+                        ++count;
+                    }
+                }
+                DJV_ASSERT(20001 == count);
+            }
+            catch (const Error & error)
+            {
+                DJV_DEBUG_PRINT(ErrorUtil::format(error));
+                DJV_ASSERT(0);
+            }
+            try
+            {
+                Trace::write("");
+                DJV_ASSERT(0);
+            }
+            catch (const Error &)
+            {}
+        }
+
+    } // namespace CoreTest
+} // namespace djv
@@ -0,0 +1,342 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+#include <djvGraphicsTest/ColorPipelineTest.h>
+
+#include <djvGraphics/ColorPipeline.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/Math.h>
+
+#include <string.h>
+
+using namespace djv::Core;
+using namespace djv::Graphics;
+
+namespace djv
+{
+    namespace GraphicsTest
+    {
+        void ColorPipelineTest::run(int &, char **)
+        {
+            DJV_DEBUG("ColorPipelineTest::run");
+            supported();
+            lut1D();
+            mixed();
+            threads();
+            sample();
+        }
+
+        void ColorPipelineTest::supported()
+        {
+            DJV_DEBUG("ColorPipelineTest::supported");
+            const PixelDataInfo u8(16, 16, Pixel::RGBA_U8);
+            const PixelDataInfo u16(16, 16, Pixel::RGB_U16);
+            DJV_ASSERT(ColorPipeline::isSupported(u8, u8, OpenGLImageOptions()));
+            DJV_ASSERT(ColorPipeline::isSupported(u8, u16, OpenGLImageOptions()));
+            DJV_ASSERT(!ColorPipeline::isSupported(PixelDataInfo(16, 16, Pixel::RGBA_F32), u8, OpenGLImageOptions()));
+            DJV_ASSERT(!ColorPipeline::isSupported(PixelDataInfo(16, 16, Pixel::RGB_U10), u8, OpenGLImageOptions()));
+            DJV_ASSERT(!ColorPipeline::isSupported(u8, PixelDataInfo(8, 8, Pixel::RGBA_U8), OpenGLImageOptions()));
+            OpenGLImageOptions options;
+            options.xform.scale = glm::vec2(2.f, 2.f);
+            DJV_ASSERT(!ColorPipeline::isSupported(u8, u8, options));
+            options = OpenGLImageOptions();
+            options.xform.mirror.x = true;
+            DJV_ASSERT(ColorPipeline::isSupported(u8, u8, options));
+        }
+
+        void ColorPipelineTest::lut1D()
+        {
+            DJV_DEBUG("ColorPipelineTest::lut1D");
+            {
+                PixelData input(PixelDataInfo(256, 1, Pixel::RGBA_U8));
+                for (int x = 0; x < 256; ++x)
+                {
+                    Pixel::U8_T * p = input.data(x, 0);
+                    p[0] = x;
+                    p[1] = 255 - x;
+                    p[2] = x / 2;
+                    p[3] = x;
+                }
+                PixelData output(input.info());
+                ColorPipeline pipeline;
+                pipeline.process(input, output);
+                DJV_ASSERT(!pipeline.isMixed());
+                DJV_ASSERT(input == output);
+            }
+            {
+                PixelData input(PixelDataInfo(2, 1, Pixel::L_U8));
+                input.data(0, 0)[0] = 10;
+                input.data(1, 0)[0] = 20;
+                PixelData output(PixelDataInfo(2, 1, Pixel::RGBA_U8));
+                OpenGLImageOptions options;
+                options.xform.mirror.x = true;
+                ColorPipeline pipeline;
+                pipeline.process(input, output, options);
+                DJV_ASSERT(20 == output.data(0, 0)[0]);
+                DJV_ASSERT(20 == output.data(0, 0)[2]);
+                DJV_ASSERT(255 == output.data(0, 0)[3]);
+                DJV_ASSERT(10 == output.data(1, 0)[0]);
+            }
+            {
+                PixelData input(PixelDataInfo(1024, 1, Pixel::L_U16));
+                for (int x = 0; x < 1024; ++x)
+                {
+                    reinterpret_cast<Pixel::U16_T *>(input.data(x, 0))[0] = x * 64;
+                }
+                PixelData output(PixelDataInfo(1024, 1, Pixel::L_U8));
+                OpenGLImageOptions options;
+                options.colorProfile.type = ColorProfile::GAMMA;
+                options.colorProfile.gamma = 2.2f;
+                ColorPipeline pipeline;
+                pipeline.process(input, output, options);
+                for (int x = 0; x < 1024; ++x)
+                {
+                    const Pixel::U8_T value = Pixel::f32ToU8(
+                        Math::pow(x * 64 / static_cast<float>(Pixel::u16Max), 1.f / 2.2f));
+                    DJV_ASSERT(value == output.data(x, 0)[0]);
+                }
+            }
+            {
+                PixelData input(PixelDataInfo(1, 1, Pixel::RGBA_U8));
+                Pixel::U8_T * p = input.data();
+                p[0] = 10;
+                p[1] = 20;
+                p[2] = 30;
+                p[3] = 40;
+                PixelData output(PixelDataInfo(1, 1, Pixel::LA_U8));
+                ColorPipeline pipeline;
+                pipeline.process(input, output);
+                DJV_ASSERT(10 == output.data()[0]);
+                DJV_ASSERT(40 == output.data()[1]);
+                OpenGLImageOptions options;
+                options.channel = OpenGLImageOptions::CHANNEL_GREEN;
+                pipeline.process(input, output, options);
+                DJV_ASSERT(20 == output.data()[0]);
+                DJV_ASSERT(20 == output.data()[1]);
+            }
+        }
+
+        void ColorPipelineTest::mixed()
+        {
+            DJV_DEBUG("ColorPipelineTest::mixed");
+            PixelData input(PixelDataInfo(256, 1, Pixel::RGB_U8));
+            for (int x = 0; x < 256; ++x)
+            {
+                Pixel::U8_T * p = input.data(x, 0);
+                p[0] = x;
+                p[1] = (x * 7) % 256;
+                p[2] = 255 - x;
+            }
+            PixelData output(input.info());
+            OpenGLImageOptions options;
+            options.displayProfile.color.saturation = 0.f;
+            ColorPipeline pipeline;
+            pipeline.process(input, output, options);
+            DJV_ASSERT(pipeline.isMixed());
+
+            // The saturation matrix is applied exactly.
+            for (int x = 0; x < 256; ++x)
+            {
+                const Pixel::U8_T * p = input.data(x, 0);
+                const int value = Pixel::f32ToU8(
+                    (p[0] * .3086f + p[1] * .6094f + p[2] * .0820f) / Pixel::u8Max);
+                const Pixel::U8_T * q = output.data(x, 0);
+                for (int c = 0; c < 3; ++c)
+                {
+                    DJV_ASSERT(Math::abs(value - q[c]) <= 1);
+                }
+            }
+
+            // Luminance input does not mix the channels.
+            const PixelData luminance(PixelDataInfo(1, 1, Pixel::L_U8));
+            PixelData luminanceOutput(luminance.info());
+            pipeline.process(luminance, luminanceOutput, options);
+            DJV_ASSERT(!pipeline.isMixed());
+
+            // Combine the saturation with the non-linear stages and compare
+            // against sampling the full pipeline for each pixel. The values
+            // near black are where the gamma curves are the steepest.
+            PixelData dark(PixelDataInfo(256, 4, Pixel::RGB_U16));
+            for (int y = 0; y < dark.h(); ++y)
+            {
+                Pixel::U16_T * p = reinterpret_cast<Pixel::U16_T *>(dark.data(0, y));
+                for (int x = 0; x < dark.w(); ++x, p += 3)
+                {
+                    const int value = 0 == y ? x : (x * 256 * y / 3);
+                    p[0] = value;
+                    p[1] = (value * 3) / 4;
+                    p[2] = value / 2;
+                }
+            }
+            options.colorProfile.type = ColorProfile::GAMMA;
+            options.colorProfile.gamma = 2.2f;
+            options.displayProfile.color.saturation = 1.5f;
+            options.displayProfile.levels.gamma = 2.2f;
+            options.displayProfile.softClip = .1f;
+            Q_FOREACH(Pixel::PIXEL pixel, QVector<Pixel::PIXEL>() << Pixel::RGB_U8 << Pixel::RGB_U16)
+            {
+                PixelData darkOutput(PixelDataInfo(dark.size(), pixel));
+                PixelData darkSample(darkOutput.info());
+                pipeline.process(dark, darkOutput, options);
+                DJV_ASSERT(pipeline.isMixed());
+                ColorPipeline::sample(dark, darkSample, options);
+                const int tolerance = Pixel::RGB_U8 == pixel ? 1 : 2;
+                for (int y = 0; y < dark.h(); ++y)
+                {
+                    for (int x = 0; x < dark.w(); ++x)
+                    {
+                        for (int c = 0; c < 3; ++c)
+                        {
+                            const int a = Pixel::RGB_U8 == pixel ?
+                                darkOutput.data(x, y)[c] :
+                                reinterpret_cast<const Pixel::U16_T *>(darkOutput.data(x, y))[c];
+                            const int b = Pixel::RGB_U8 == pixel ?
+                                darkSample.data(x, y)[c] :
+                                reinterpret_cast<const Pixel::U16_T *>(darkSample.data(x, y))[c];
+                            DJV_ASSERT(Math::abs(a - b) <= tolerance);
+                        }
+                    }
+                }
+            }
+        }
+
+        void ColorPipelineTest::threads()
+        {
+            DJV_DEBUG("ColorPipelineTest::threads");
+            PixelData input(PixelDataInfo(512, 512, Pixel::RGBA_U16));
+            for (int y = 0; y < input.h(); ++y)
+            {
+                Pixel::U16_T * p = reinterpret_cast<Pixel::U16_T *>(input.data(0, y));
+                for (int x = 0; x < input.w(); ++x, p += 4)
+                {
+                    p[0] = p[1] = p[2] = p[3] = x * 127 + y;
+                }
+            }
+            PixelData output(PixelDataInfo(512, 512, Pixel::RGBA_U16));
+            OpenGLImageOptions options;
+            options.xform.mirror.y = true;
+            ColorPipeline pipeline;
+            pipeline.process(input, output, options);
+            for (int y = 0; y < output.h(); ++y)
+            {
+                const Pixel::U16_T * p = reinterpret_cast<const Pixel::U16_T *>(output.data(0, y));
+                for (int x = 0; x < output.w(); ++x, p += 4)
+                {
+                    DJV_ASSERT(x * 127 + (output.h() - 1 - y) == p[0]);
+                }
+            }
+        }
+
+        void ColorPipelineTest::sample()
+        {
+            DJV_DEBUG("ColorPipelineTest::sample");
+            PixelData input(PixelDataInfo(64, 32, Pixel::RGBA_U16));
+            for (int y = 0; y < input.h(); ++y)
+            {
+                Pixel::U16_T * p = reinterpret_cast<Pixel::U16_T *>(input.data(0, y));
+                for (int x = 0; x < input.w(); ++x, p += 4)
+                {
+                    p[0] = x * 1000;
+                    p[1] = y * 2000;
+                    p[2] = x * 500 + y * 500;
+                    p[3] = 65535 - x * 1000;
+                }
+            }
+
+            // Without a transform the samples should match the lookup tables.
+            {
+                PixelData output(PixelDataInfo(input.size(), Pixel::RGBA_U8));
+                PixelData outputLut(output.info());
+                OpenGLImageOptions options;
+                options.xform.mirror.x = true;
+                options.colorProfile.type = ColorProfile::GAMMA;
+                ColorPipeline::sample(input, output, options);
+                ColorPipeline pipeline;
+                pipeline.process(input, outputLut, options);
+                for (int y = 0; y < output.h(); ++y)
+                {
+                    for (int x = 0; x < output.w(); ++x)
+                    {
+                        for (int c = 0; c < 4; ++c)
+                        {
+                            DJV_ASSERT(Math::abs(output.data(x, y)[c] - outputLut.data(x, y)[c]) <= 1);
+                        }
+                    }
+                }
+            }
+
+            // Sample a translated and magnified region.
+            {
+                PixelData output(PixelDataInfo(8, 8, Pixel::RGBA_U16));
+                OpenGLImageOptions options;
+                options.xform.position = glm::vec2(-6.f, -4.f);
+                options.xform.scale = glm::vec2(2.f, 2.f);
+                options.filter = OpenGLImageFilter(OpenGLImageFilter::NEAREST, OpenGLImageFilter::NEAREST);
+                ColorPipeline::sample(input, output, options);
+                for (int y = 0; y < output.h(); ++y)
+                {
+                    for (int x = 0; x < output.w(); ++x)
+                    {
+                        DJV_ASSERT(0 == memcmp(
+                            output.data(x, y),
+                            input.data((x + 6) / 2, (y + 4) / 2),
+                            output.pixelByteCount()));
+                    }
+                }
+            }
+
+            // Samples outside of the image are the background.
+            {
+                PixelData output(PixelDataInfo(2, 1, Pixel::RGB_F32));
+                OpenGLImageOptions options;
+                options.xform.position = glm::vec2(static_cast<float>(1 - input.w()), 0.f);
+                options.background = Color(1.f, 0.f, .5f);
+                ColorPipeline::sample(input, output, options);
+                const Pixel::F32_T * p = reinterpret_cast<const Pixel::F32_T *>(output.data(0, 0));
+                DJV_ASSERT(Math::fuzzyCompare(p[0], 63000.f / Pixel::u16Max, .0001f));
+                p = reinterpret_cast<const Pixel::F32_T *>(output.data(1, 0));
+                DJV_ASSERT(Math::fuzzyCompare(p[0], 1.f));
+                DJV_ASSERT(Math::fuzzyCompare(p[2], .5f));
+            }
+
+            // Average a region.
+            {
+                OpenGLImageOptions options;
+                options.xform.position = glm::vec2(-1.f, -2.f);
+                Color color(Pixel::RGBA_F32);
+                ColorPipeline::average(input, glm::ivec2(2, 2), color, options);
+                DJV_ASSERT(Math::fuzzyCompare(color.f32(0), 1500.f / Pixel::u16Max, .0001f));
+                DJV_ASSERT(Math::fuzzyCompare(color.f32(1), 5000.f / Pixel::u16Max, .0001f));
+                DJV_ASSERT(Math::fuzzyCompare(color.f32(2), 2000.f / Pixel::u16Max, .0001f));
+            }
+        }
+
+    } // namespace GraphicsTest
+} // namespace djv
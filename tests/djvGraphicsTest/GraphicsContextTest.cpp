@@ -49,6 +49,15 @@ namespace djv
             {
                 Graphics::GraphicsContext context(argc, argv);
                 DJV_ASSERT(context.openGLContext());
+                DJV_ASSERT(context.isOpenGLInitialized());
+            }
+            {
+                Graphics::GraphicsContext context(argc, argv, Graphics::GraphicsContext::OPENGL_INIT_DEFERRED);
+                DJV_ASSERT(!context.isOpenGLInitialized());
+                DJV_ASSERT(context.imageIOFactory());
+                context.makeGLContextCurrent();
+                DJV_ASSERT(context.isOpenGLInitialized());
+                DJV_ASSERT(context.openGLContext());
             }
             try
             {
@@ -41,10 +41,21 @@
 #include <djvCore/FileInfo.h>
 #include <djvCore/FileIO.h>
 #include <djvCore/Memory.h>
+#include <djvCore/Timer.h>
 
 #include <QPair>
 
+#if defined(TIFF_FOUND)
+#include <tiffio.h>
+#if !defined(PREDICTOR_FLOATINGPOINT)
+#define PREDICTOR_FLOATINGPOINT 3
+#endif // PREDICTOR_FLOATINGPOINT
+#endif // TIFF_FOUND
+
 #include <algorithm>
+#include <thread>
+
+#include <string.h>
 
 using namespace djv::Core;
 using namespace djv::Graphics;
@@ -101,6 +112,53 @@ namespace djv
                     }
                 }
             }
+
+            // Test reading a sequence from multiple threads.
+            for (int j = 0; j < _plugins.count(); ++j)
+            {
+                runThreadsTest(static_cast<Graphics::ImageIO *>(_plugins[j]));
+            }
+
+            // Test the TIFF compression, which uses a different code path for
+            // each of these.
+            for (int j = 0; j < _plugins.count(); ++j)
+            {
+                Graphics::ImageIO * plugin = static_cast<Graphics::ImageIO *>(_plugins[j]);
+                if (plugin->pluginName() != "TIFF")
+                    continue;
+                QStringList option;
+                option << 1;
+                plugin->setOption("Rows Per Strip", option);
+                Q_FOREACH(const QString & compression, QStringList() << "LZW" << "Deflate")
+                {
+                    option << compression;
+                    plugin->setOption("Compression", option);
+                    Q_FOREACH(bool predictor, QVector<bool>() << false << true)
+                    {
+                        option << predictor;
+                        plugin->setOption("Predictor", option);
+                        for (int i = 0; i < _images.count(); ++i)
+                        {
+                            runTest(plugin, _images[i]);
+                        }
+                    }
+                }
+                option << "None";
+                plugin->setOption("Compression", option);
+                option << 16;
+                plugin->setOption("Rows Per Strip", option);
+                runTIFFTest(plugin);
+            }
+
+            // Compare the serial and parallel PNG compression.
+            for (int j = 0; j < _plugins.count(); ++j)
+            {
+                Graphics::ImageIO * plugin = static_cast<Graphics::ImageIO *>(_plugins[j]);
+                if (plugin->pluginName() == "PNG")
+                {
+                    runPNGTest(plugin);
+                }
+            }
         }
 
         void ImageIOFormatsTest::initPlugins(const QPointer<Graphics::GraphicsContext> & context)
@@ -284,5 +342,348 @@ namespace djv
             }
         }
 
+        void ImageIOFormatsTest::runThreadsTest(Graphics::ImageIO * plugin)
+        {
+            DJV_DEBUG("ImageIOFormatsTest::runThreadsTest");
+            DJV_DEBUG_PRINT("plugin = " << plugin->pluginName());
+
+            const QStringList & extensions = plugin->extensions();
+            FileInfo fileInfo("ImageIOFormatsTest." + (extensions.count() ? extensions[0] : QString()));
+            const int frameCount = 8;
+            fileInfo.setSequence(Sequence(1, frameCount));
+            fileInfo.setType(FileInfo::SEQUENCE);
+            DJV_DEBUG_PRINT("file = " << fileInfo);
+
+            try
+            {
+                QScopedPointer<Graphics::ImageLoad> load(plugin->createLoad());
+                QScopedPointer<Graphics::ImageSave> save(plugin->createSave());
+                if (!load.data() || !save.data())
+                    return;
+
+                // Write the frames with the frame number in the first pixel so
+                // that mixing up frames between threads is detected. Pairs of
+                // frames share the same size so that loaders which reuse the
+                // header of the previous frame see both matching and
+                // mismatching layouts.
+                for (int i = 0; i < frameCount; ++i)
+                {
+                    const glm::ivec2 size(16 + i / 2, 8 + i / 2);
+                    Graphics::Image gradient(Graphics::PixelDataInfo(size, Graphics::Pixel::L_F32));
+                    Graphics::PixelDataUtil::gradient(gradient);
+                    Graphics::Image image(Graphics::PixelDataInfo(size, Graphics::Pixel::RGB_U8));
+                    Graphics::OpenGLImage().copy(gradient, image);
+                    image.data()[0] = i;
+                    if (0 == i)
+                    {
+                        save->open(fileInfo, image.info());
+                    }
+                    save->write(image, Graphics::ImageIOFrameInfo(1 + i));
+                }
+                save->close();
+
+                // Read the frames serially.
+                Graphics::ImageIOInfo info;
+                load->open(fileInfo, info);
+                std::vector<Graphics::Image> serial(frameCount);
+                for (int i = 0; i < frameCount; ++i)
+                {
+                    load->read(serial[i], Graphics::ImageIOFrameInfo(1 + i));
+                }
+
+                // Read the frames again without the image tags.
+                for (int i = 0; i < frameCount; ++i)
+                {
+                    Graphics::ImageIOFrameInfo frameInfo(1 + i);
+                    frameInfo.tags = false;
+                    Graphics::Image image;
+                    load->read(image, frameInfo);
+                    DJV_ASSERT(static_cast<const Graphics::PixelData &>(image) ==
+                        static_cast<const Graphics::PixelData &>(serial[i]));
+                }
+
+                // Read the frames from multiple threads, each thread starting
+                // on a different frame.
+                const int threadCount = 16;
+                std::vector<std::unique_ptr<Graphics::ImageLoad> > loads;
+                for (int i = 0; i < threadCount; ++i)
+                {
+                    loads.push_back(std::unique_ptr<Graphics::ImageLoad>(load->clone()));
+                    if (!loads.back())
+                    {
+                        DJV_DEBUG_PRINT("clone not supported");
+                        return;
+                    }
+                }
+                std::vector<std::vector<Graphics::Image> > parallel(threadCount);
+                std::vector<bool> errors(threadCount, false);
+                std::vector<std::thread> threads;
+                for (int i = 0; i < threadCount; ++i)
+                {
+                    parallel[i].resize(frameCount);
+                    threads.push_back(std::thread([i, frameCount, &loads, &parallel, &errors]
+                    {
+                        try
+                        {
+                            for (int j = 0; j < frameCount; ++j)
+                            {
+                                const int frame = (i + j) % frameCount;
+                                loads[i]->read(parallel[i][frame], Graphics::ImageIOFrameInfo(1 + frame));
+                            }
+                        }
+                        catch (const Error &)
+                        {
+                            errors[i] = true;
+                        }
+                    }));
+                }
+                for (auto & thread : threads)
+                {
+                    thread.join();
+                }
+                load->close();
+
+                for (int i = 0; i < threadCount; ++i)
+                {
+                    DJV_ASSERT(!errors[i]);
+                    for (int j = 0; j < frameCount; ++j)
+                    {
+                        DJV_ASSERT(serial[j] == parallel[i][j]);
+                    }
+                }
+            }
+            catch (const Error & error)
+            {
+                DJV_DEBUG_PRINT(ErrorUtil::format(error));
+            }
+        }
+
+        void ImageIOFormatsTest::runPNGTest(Graphics::ImageIO * plugin)
+        {
+            DJV_DEBUG("ImageIOFormatsTest::runPNGTest");
+
+            // The image needs to be large enough to be split into multiple
+            // blocks.
+            QVector<Graphics::Image> images;
+            Q_FOREACH(Graphics::Pixel::PIXEL pixel, QVector<Graphics::Pixel::PIXEL>() <<
+                Graphics::Pixel::L_U8 <<
+                Graphics::Pixel::RGB_U8 <<
+                Graphics::Pixel::RGBA_U16)
+            {
+                const glm::ivec2 size(1920, 1080);
+                Graphics::Image gradient(Graphics::PixelDataInfo(size, Graphics::Pixel::L_F32));
+                Graphics::PixelDataUtil::gradient(gradient);
+                Graphics::Image image(Graphics::PixelDataInfo(size, pixel));
+                Graphics::OpenGLImage().copy(gradient, image);
+                images += image;
+            }
+
+            typedef QPair<QString, QString> Options;
+            QVector<Options> options;
+            Q_FOREACH(const QString & filter, QStringList() <<
+                "None" << "Sub" << "Up" << "Average" << "Paeth" << "Adaptive")
+            {
+                options += Options(filter, "Filtered");
+            }
+            Q_FOREACH(const QString & strategy, QStringList() <<
+                "Default" << "Huffman" << "RLE" << "Fixed")
+            {
+                options += Options("Adaptive", strategy);
+            }
+
+            const QString fileName = "ImageIOFormatsTest.png";
+            QStringList option;
+            try
+            {
+                for (int i = 0; i < images.count(); ++i)
+                {
+                    for (int j = 0; j < options.count(); ++j)
+                    {
+                        option << options[j].first;
+                        plugin->setOption("Filter", option);
+                        option << options[j].second;
+                        plugin->setOption("Strategy", option);
+
+                        Graphics::Image tmp[2];
+                        quint64 fileSize[2] = { 0, 0 };
+                        float seconds[2] = { 0.f, 0.f };
+                        for (int k = 0; k < 2; ++k)
+                        {
+                            option << (0 == k ? 1 : 0);
+                            plugin->setOption("Threads", option);
+
+                            QScopedPointer<Graphics::ImageSave> save(plugin->createSave());
+                            Timer timer;
+                            timer.start();
+                            save->open(fileName, images[i].info());
+                            save->write(images[i]);
+                            save->close();
+                            timer.check();
+                            seconds[k] = timer.seconds();
+                            fileSize[k] = FileInfo(fileName).size();
+
+                            QScopedPointer<Graphics::ImageLoad> load(plugin->createLoad());
+                            Graphics::ImageIOInfo info;
+                            load->open(fileName, info);
+                            load->read(tmp[k]);
+                            load->close();
+                        }
+                        DJV_DEBUG_PRINT(images[i].pixel() << " " <<
+                            options[j].first << " " << options[j].second << ": " <<
+                            "serial = " << fileSize[0] << " bytes " << seconds[0] << " seconds, " <<
+                            "parallel = " << fileSize[1] << " bytes " << seconds[1] << " seconds");
+                        DJV_ASSERT(static_cast<const Graphics::PixelData &>(tmp[0]) ==
+                            static_cast<const Graphics::PixelData &>(tmp[1]));
+                    }
+                }
+            }
+            catch (const Error & error)
+            {
+                DJV_DEBUG_PRINT(ErrorUtil::format(error));
+                DJV_ASSERT(0);
+            }
+
+            option << "Adaptive";
+            plugin->setOption("Filter", option);
+            option << "Filtered";
+            plugin->setOption("Strategy", option);
+            option << 0;
+            plugin->setOption("Threads", option);
+        }
+
+        void ImageIOFormatsTest::runTIFFTest(Graphics::ImageIO * plugin)
+        {
+            DJV_DEBUG("ImageIOFormatsTest::runTIFFTest");
+#if defined(TIFF_FOUND)
+            const QString fileName = "ImageIOFormatsTest.tif";
+            try
+            {
+                // Check that the predictors are written for integer and
+                // floating point data.
+                QStringList option;
+                option << "LZW";
+                plugin->setOption("Compression", option);
+                option << true;
+                plugin->setOption("Predictor", option);
+                Q_FOREACH(Graphics::Pixel::PIXEL pixel, QVector<Graphics::Pixel::PIXEL>() <<
+                    Graphics::Pixel::RGB_U16 <<
+                    Graphics::Pixel::RGB_F32)
+                {
+                    Graphics::Image gradient(Graphics::PixelDataInfo(37, 21, Graphics::Pixel::L_F32));
+                    Graphics::PixelDataUtil::gradient(gradient);
+                    Graphics::Image image(Graphics::PixelDataInfo(gradient.size(), pixel));
+                    Graphics::OpenGLImage().copy(gradient, image);
+                    QScopedPointer<Graphics::ImageSave> save(plugin->createSave());
+                    save->open(fileName, image.info());
+                    save->write(image);
+                    save->close();
+
+                    ::TIFF * f = TIFFOpen(fileName.toUtf8().data(), "r");
+                    DJV_ASSERT(f);
+                    uint16 predictor = PREDICTOR_NONE;
+                    TIFFGetFieldDefaulted(f, TIFFTAG_PREDICTOR, &predictor);
+                    TIFFClose(f);
+                    DJV_DEBUG_PRINT(pixel << " predictor = " << predictor);
+                    DJV_ASSERT(predictor == (Graphics::Pixel::RGB_F32 == pixel ?
+                        PREDICTOR_FLOATINGPOINT :
+                        PREDICTOR_HORIZONTAL));
+                }
+                option << "None";
+                plugin->setOption("Compression", option);
+
+                // The plugin only writes strips so the tiled files are written
+                // with libTIFF. The size is not a multiple of the tile size so
+                // that the partial tiles on the edges are also decoded.
+                struct Tiled
+                {
+                    Graphics::Pixel::PIXEL pixel;
+                    uint16                 compression;
+                    uint16                 predictor;
+                };
+                const Tiled tiled[] =
+                {
+                    { Graphics::Pixel::L_U8,    COMPRESSION_NONE,          PREDICTOR_NONE          },
+                    { Graphics::Pixel::RGB_U8,  COMPRESSION_LZW,           PREDICTOR_HORIZONTAL    },
+                    { Graphics::Pixel::RGBA_U8, COMPRESSION_ADOBE_DEFLATE, PREDICTOR_NONE          },
+                    { Graphics::Pixel::RGB_U16, COMPRESSION_ADOBE_DEFLATE, PREDICTOR_HORIZONTAL    },
+                    { Graphics::Pixel::L_F32,   COMPRESSION_LZW,           PREDICTOR_FLOATINGPOINT },
+                    { Graphics::Pixel::RGB_F32, COMPRESSION_ADOBE_DEFLATE, PREDICTOR_FLOATINGPOINT }
+                };
+                const uint32 tileSize = 16;
+                for (size_t i = 0; i < sizeof(tiled) / sizeof(tiled[0]); ++i)
+                {
+                    Graphics::Image gradient(Graphics::PixelDataInfo(37, 21, Graphics::Pixel::L_F32));
+                    Graphics::PixelDataUtil::gradient(gradient);
+                    Graphics::PixelDataInfo info(gradient.size(), tiled[i].pixel);
+                    info.mirror.y = true;
+                    Graphics::Image image(info);
+                    Graphics::OpenGLImage().copy(gradient, image);
+                    DJV_DEBUG_PRINT("tiled = " << image << " " <<
+                        tiled[i].compression << " " << tiled[i].predictor);
+
+                    ::TIFF * f = TIFFOpen(fileName.toUtf8().data(), "w");
+                    DJV_ASSERT(f);
+                    const int channels = Graphics::Pixel::channels(tiled[i].pixel);
+                    const bool floatingPoint = Graphics::Pixel::F32 == Graphics::Pixel::type(tiled[i].pixel);
+                    TIFFSetField(f, TIFFTAG_IMAGEWIDTH, image.w());
+                    TIFFSetField(f, TIFFTAG_IMAGELENGTH, image.h());
+                    TIFFSetField(f, TIFFTAG_BITSPERSAMPLE, Graphics::Pixel::bitDepth(tiled[i].pixel));
+                    TIFFSetField(f, TIFFTAG_SAMPLESPERPIXEL, channels);
+                    TIFFSetField(f, TIFFTAG_SAMPLEFORMAT, floatingPoint ? SAMPLEFORMAT_IEEEFP : SAMPLEFORMAT_UINT);
+                    TIFFSetField(f, TIFFTAG_PHOTOMETRIC, channels >= 3 ? PHOTOMETRIC_RGB : PHOTOMETRIC_MINISBLACK);
+                    if (4 == channels)
+                    {
+                        const uint16 extra = EXTRASAMPLE_ASSOCALPHA;
+                        TIFFSetField(f, TIFFTAG_EXTRASAMPLES, 1, &extra);
+                    }
+                    TIFFSetField(f, TIFFTAG_PLANARCONFIG, PLANARCONFIG_CONTIG);
+                    TIFFSetField(f, TIFFTAG_ORIENTATION, ORIENTATION_TOPLEFT);
+                    TIFFSetField(f, TIFFTAG_COMPRESSION, tiled[i].compression);
+                    if (tiled[i].predictor != PREDICTOR_NONE)
+                    {
+                        TIFFSetField(f, TIFFTAG_PREDICTOR, tiled[i].predictor);
+                    }
+                    TIFFSetField(f, TIFFTAG_TILEWIDTH, tileSize);
+                    TIFFSetField(f, TIFFTAG_TILELENGTH, tileSize);
+                    std::vector<quint8> tile(TIFFTileSize(f));
+                    const quint64 pixelByteCount = image.pixelByteCount();
+                    for (uint32 y = 0; y < static_cast<uint32>(image.h()); y += tileSize)
+                    {
+                        for (uint32 x = 0; x < static_cast<uint32>(image.w()); x += tileSize)
+                        {
+                            std::fill(tile.begin(), tile.end(), 0);
+                            const uint32 w = std::min(tileSize, static_cast<uint32>(image.w()) - x);
+                            const uint32 h = std::min(tileSize, static_cast<uint32>(image.h()) - y);
+                            for (uint32 j = 0; j < h; ++j)
+                            {
+                                memcpy(
+                                    tile.data() + j * tileSize * pixelByteCount,
+                                    image.data(x, y + j),
+                                    w * pixelByteCount);
+                            }
+                            DJV_ASSERT(TIFFWriteEncodedTile(
+                                f, TIFFComputeTile(f, x, y, 0, 0), tile.data(), tile.size()) != -1);
+                        }
+                    }
+                    TIFFClose(f);
+
+                    QScopedPointer<Graphics::ImageLoad> load(plugin->createLoad());
+                    Graphics::ImageIOInfo ioInfo;
+                    load->open(fileName, ioInfo);
+                    Graphics::Image tmp;
+                    load->read(tmp);
+                    load->close();
+                    DJV_ASSERT(static_cast<const Graphics::PixelData &>(tmp) ==
+                        static_cast<const Graphics::PixelData &>(image));
+                }
+            }
+            catch (const Error & error)
+            {
+                DJV_DEBUG_PRINT(ErrorUtil::format(error));
+                DJV_ASSERT(0);
+            }
+#endif // TIFF_FOUND
+        }
+
     } // namespace GraphicsTest
 } // namespace djv
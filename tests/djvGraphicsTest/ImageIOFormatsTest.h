@@ -54,6 +54,9 @@ namespace djv
             void initData();
             void initImages();
             void runTest(Graphics::ImageIO *, const Graphics::Image &);
+            void runThreadsTest(Graphics::ImageIO *);
+            void runPNGTest(Graphics::ImageIO *);
+            void runTIFFTest(Graphics::ImageIO *);
 
             QVector<glm::ivec2>             _sizes;
             QVector<Graphics::Pixel::PIXEL> _pixels;
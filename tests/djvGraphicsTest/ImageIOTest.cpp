@@ -99,6 +99,7 @@ namespace djv
                 DJV_ASSERT(-1 == info.frame);
                 DJV_ASSERT(0 == info.layer);
                 DJV_ASSERT(Graphics::PixelDataInfo::PROXY_NONE == info.proxy);
+                DJV_ASSERT(info.tags);
             }
             {
                 Graphics::ImageIOFrameInfo info(1, 2, Graphics::PixelDataInfo::PROXY_1_2);
@@ -112,6 +113,8 @@ namespace djv
                     b(1, 2, Graphics::PixelDataInfo::PROXY_1_2);
                 DJV_ASSERT(a == b);
                 DJV_ASSERT(a != Graphics::ImageIOFrameInfo());
+                b.tags = false;
+                DJV_ASSERT(a != b);
             }
             {
                 DJV_DEBUG_PRINT(Graphics::ImageIOInfo());
@@ -122,12 +125,25 @@ namespace djv
         void ImageIOTest::plugin(int & argc, char ** argv)
         {
             DJV_DEBUG("ImageIOTest::plugin");
+            {
+                // The first context writes the plugin index, so the built-in
+                // plugins are not created by the second one.
+                {
+                    Graphics::GraphicsContext context(argc, argv);
+                }
+                Graphics::GraphicsContext context(argc, argv);
+                DJV_ASSERT(context.imageIOFactory()->names().contains("PPM"));
+                DJV_ASSERT(!context.imageIOFactory()->isLoaded("PPM"));
+            }
             Graphics::GraphicsContext context(argc, argv);
             Graphics::ImageIOFactory * factory = context.imageIOFactory();
             Q_FOREACH(QString plugin, QStringList() << "PPM")
             {
+                DJV_ASSERT(factory->names().contains(plugin));
+                DJV_ASSERT(factory->indexData(plugin)["extensions"].contains(".ppm"));
                 if (Graphics::ImageIO * io = static_cast<Graphics::ImageIO *>(factory->plugin(plugin)))
                 {
+                    DJV_ASSERT(factory->isLoaded(plugin));
                     DJV_ASSERT(io->extensions().count());
                     DJV_ASSERT(io->isSequence());
                     DJV_ASSERT(io->options().count());
@@ -177,6 +193,17 @@ namespace djv
                 load->read(image);
                 DJV_ASSERT(image.info().pixel == pixelDataInfo.pixel);
                 load->close();
+                const Graphics::ImageIOInfo probeInfo = context.imageIOFactory()->probe(fileInfo);
+                DJV_ASSERT(probeInfo.size == pixelDataInfo.size);
+                DJV_ASSERT(probeInfo.pixel == pixelDataInfo.pixel);
+                const QVector<Graphics::ImageIOProbe> probes = context.imageIOFactory()->probe(
+                    FileInfoList() << fileInfo << FileInfo("ImageIOTest.missing") << fileInfo, 2);
+                DJV_ASSERT(3 == probes.count());
+                DJV_ASSERT(probes[0].valid);
+                DJV_ASSERT(!probes[1].valid);
+                DJV_ASSERT(probes[1].error.count());
+                DJV_ASSERT(probes[2].valid);
+                DJV_ASSERT(probes[2].info.size == pixelDataInfo.size);
             }
             catch (const Error & error)
             {
@@ -29,13 +29,19 @@
 
 #include <djvGraphicsTest/OpenGLTest.h>
 
+#include <djvGraphics/GraphicsContext.h>
 #include <djvGraphics/OpenGL.h>
+#include <djvGraphics/OpenGLImage.h>
+#include <djvGraphics/OpenGLTexture.h>
+#include <djvGraphics/PixelDataUtil.h>
 
 #include <djvCore/Assert.h>
 #include <djvCore/Debug.h>
 
 #include <QString>
 
+#include <string.h>
+
 using namespace djv::Core;
 using namespace djv::Graphics;
 
@@ -43,10 +49,11 @@ namespace djv
 {
     namespace GraphicsTest
     {
-        void OpenGLTest::run(int &, char **)
+        void OpenGLTest::run(int & argc, char ** argv)
         {
             DJV_DEBUG("OpenGLTest::run");
             members();
+            texture(argc, argv);
         }
 
         void OpenGLTest::members()
@@ -61,5 +68,90 @@ namespace djv
             }
         }
 
+        namespace
+        {
+            void read(OpenGLTexture & texture, PixelData & out)
+            {
+                auto glFuncs = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_3_3_Core>();
+                out.set(texture.info());
+                texture.bind();
+                OpenGLImage::statePack(out.info());
+                glFuncs->glGetTexImage(
+                    texture.target(),
+                    0,
+                    OpenGL::format(out.pixel()),
+                    OpenGL::type(out.pixel()),
+                    out.data());
+            }
+
+        } // namespace
+
+        void OpenGLTest::texture(int & argc, char ** argv)
+        {
+            DJV_DEBUG("OpenGLTest::texture");
+            Graphics::GraphicsContext context(argc, argv);
+            context.makeGLContextCurrent();
+            const PixelDataInfo info(16, 16, Pixel::L_U8);
+            {
+                // Upload more frames than there are pixel buffers so that the
+                // ring wraps around and waits on the fences of the buffers that
+                // are reused.
+                OpenGLTexture texture;
+                texture.init(info);
+                DJV_DEBUG_PRINT("persistent = " << texture.isPersistent());
+                PixelData data;
+                for (int i = 0; i < OpenGLTexture::bufferCount * 2 + 1; ++i)
+                {
+                    DJV_ASSERT(i % OpenGLTexture::bufferCount == texture.bufferIndex());
+                    quint8 * p = texture.mapBuffer();
+                    memset(p, i + 1, PixelDataUtil::dataByteCount(info));
+                    texture.copyBuffer();
+                    DJV_ASSERT((i + 1) % OpenGLTexture::bufferCount == texture.bufferIndex());
+                    read(texture, data);
+                    DJV_ASSERT(i + 1 == data.data(0, 0)[0]);
+                    DJV_ASSERT(i + 1 == data.data(15, 15)[0]);
+                }
+
+                // Copying without a mapped buffer does nothing.
+                const int index = texture.bufferIndex();
+                texture.copyBuffer();
+                DJV_ASSERT(index == texture.bufferIndex());
+
+                // Pixel data is copied through the ring.
+                PixelData in(info);
+                for (int y = 0; y < in.h(); ++y)
+                {
+                    for (int x = 0; x < in.w(); ++x)
+                    {
+                        in.data(x, y)[0] = x + y;
+                    }
+                }
+                texture.copy(in);
+                read(texture, data);
+                DJV_ASSERT(0 == data.data(0, 0)[0]);
+                DJV_ASSERT(30 == data.data(15, 15)[0]);
+                DJV_ASSERT((index + 1) % OpenGLTexture::bufferCount == texture.bufferIndex());
+            }
+            {
+                // An area is copied directly from the pixel data.
+                PixelData in(info);
+                for (int y = 0; y < in.h(); ++y)
+                {
+                    for (int x = 0; x < in.w(); ++x)
+                    {
+                        in.data(x, y)[0] = x + y * 16;
+                    }
+                }
+                OpenGLTexture texture;
+                texture.init(PixelDataInfo(4, 4, Pixel::L_U8));
+                texture.copy(in, Box2i(8, 8, 4, 4));
+                PixelData data;
+                read(texture, data);
+                DJV_ASSERT(8 + 8 * 16 == data.data(0, 0)[0]);
+                DJV_ASSERT(11 + 11 * 16 == data.data(3, 3)[0]);
+                DJV_ASSERT(0 == texture.bufferIndex());
+            }
+        }
+
     } // namespace GraphicsTest
 } // namespace djv
@@ -52,6 +52,7 @@ namespace djv
             byteCount();
             proxy();
             interleave();
+            compress();
             gradient();
         }
 
@@ -112,6 +113,16 @@ namespace djv
                 DJV_DEBUG_PRINT("proxy = " << proxy);
                 DJV_DEBUG_PRINT("box = " << Graphics::PixelDataUtil::proxyScale(box, proxy));
             }
+            DJV_ASSERT(Graphics::PixelDataInfo::PROXY_NONE ==
+                Graphics::PixelDataUtil::proxyFit(glm::ivec2(100, 100), glm::ivec2(100, 100)));
+            DJV_ASSERT(Graphics::PixelDataInfo::PROXY_NONE ==
+                Graphics::PixelDataUtil::proxyFit(glm::ivec2(100, 100), glm::ivec2(200, 50)));
+            DJV_ASSERT(Graphics::PixelDataInfo::PROXY_1_2 ==
+                Graphics::PixelDataUtil::proxyFit(glm::ivec2(101, 100), glm::ivec2(51, 50)));
+            DJV_ASSERT(Graphics::PixelDataInfo::PROXY_1_4 ==
+                Graphics::PixelDataUtil::proxyFit(glm::ivec2(1920, 1080), glm::ivec2(256, 144)));
+            DJV_ASSERT(Graphics::PixelDataInfo::PROXY_1_8 ==
+                Graphics::PixelDataUtil::proxyFit(glm::ivec2(4096, 2160), glm::ivec2(128, 64)));
         }
 
         void PixelDataUtilTest::interleave()
@@ -129,7 +140,10 @@ namespace djv
             Q_FOREACH(Graphics::Pixel::PIXEL pixel, pixels)
             {
                 Graphics::PixelData data(Graphics::PixelDataInfo(32, 32, pixel));
-                data.zero();
+                for (quint64 i = 0; i < data.dataByteCount(); ++i)
+                {
+                    data.data()[i] = static_cast<quint8>(qrand());
+                }
                 DJV_DEBUG_PRINT("info = " << data.info());
                 Graphics::PixelData interleaveData(data.info());
                 Graphics::PixelDataUtil::planarInterleave(data, interleaveData);
@@ -139,6 +153,125 @@ namespace djv
                     data.data(),
                     deinterleaveData.data(),
                     data.dataByteCount()));
+
+                // Check the proxy decimation and endian conversion of a single
+                // scanline against the interleaved data.
+                const int channels = Graphics::Pixel::channels(pixel);
+                const int bytes = Graphics::Pixel::channelByteCount(pixel);
+                const quint64 channelStride = data.w() * data.h() * bytes;
+                const quint64 pixelByteCount = data.pixelByteCount();
+                for (int proxy = 0; proxy < Graphics::PixelDataInfo::PROXY_COUNT; ++proxy)
+                {
+                    const int proxyScale = Graphics::PixelDataUtil::proxyScale(
+                        static_cast<Graphics::PixelDataInfo::PROXY>(proxy));
+                    const int size = data.w() / proxyScale;
+                    std::vector<quint8> scanline(size * pixelByteCount);
+                    Graphics::PixelDataUtil::planarInterleave(
+                        data.data() + data.w() * bytes,
+                        channelStride,
+                        pixel,
+                        scanline.data(),
+                        pixel,
+                        size,
+                        static_cast<Graphics::PixelDataInfo::PROXY>(proxy),
+                        true);
+                    for (int x = 0; x < size; ++x)
+                    {
+                        const quint8 * a = interleaveData.data(x * proxyScale, 1);
+                        const quint8 * b = scanline.data() + x * pixelByteCount;
+                        for (int c = 0; c < channels; ++c)
+                        {
+                            for (int i = 0; i < bytes; ++i)
+                            {
+                                DJV_ASSERT(a[c * bytes + i] == b[c * bytes + bytes - 1 - i]);
+                            }
+                        }
+                    }
+                }
+
+                // Check the endian conversion when de-interleaving.
+                std::vector<quint8> planar(channels * data.w() * bytes);
+                Graphics::PixelDataUtil::planarDeinterleave(
+                    interleaveData.data(0, 1),
+                    pixel,
+                    planar.data(),
+                    data.w() * bytes,
+                    data.w(),
+                    true);
+                std::vector<quint8> scanline(data.w() * pixelByteCount);
+                Graphics::PixelDataUtil::planarInterleave(
+                    planar.data(),
+                    data.w() * bytes,
+                    pixel,
+                    scanline.data(),
+                    pixel,
+                    data.w(),
+                    Graphics::PixelDataInfo::PROXY_NONE,
+                    true);
+                DJV_ASSERT(0 == memcmp(
+                    interleaveData.data(0, 1),
+                    scanline.data(),
+                    scanline.size()));
+            }
+
+            // Check the conversion to a different pixel type.
+            Graphics::PixelData data(Graphics::PixelDataInfo(16, 8, Graphics::Pixel::RGB_U8));
+            for (quint64 i = 0; i < data.dataByteCount(); ++i)
+            {
+                data.data()[i] = static_cast<quint8>(qrand());
+            }
+            Graphics::PixelData interleaveData(data.info());
+            Graphics::PixelDataUtil::planarInterleave(data, interleaveData);
+            Graphics::PixelData convertData(Graphics::PixelDataInfo(16, 8, Graphics::Pixel::RGB_U16));
+            Graphics::PixelDataUtil::planarInterleave(data, convertData);
+            for (int y = 0; y < data.h(); ++y)
+            {
+                for (int x = 0; x < data.w(); ++x)
+                {
+                    quint8 tmp[6];
+                    Graphics::Pixel::convert(
+                        interleaveData.data(x, y),
+                        Graphics::Pixel::RGB_U8,
+                        tmp,
+                        Graphics::Pixel::RGB_U16);
+                    DJV_ASSERT(0 == memcmp(tmp, convertData.data(x, y), 6));
+                }
+            }
+        }
+
+        void PixelDataUtilTest::compress()
+        {
+            DJV_DEBUG("PixelDataUtilTest::compress");
+            for (int i = 0; i < Graphics::Pixel::PIXEL_COUNT; ++i)
+            {
+                const Graphics::Pixel::PIXEL pixel = static_cast<Graphics::Pixel::PIXEL>(i);
+                Graphics::PixelData data(Graphics::PixelDataInfo(67, 33, pixel));
+                quint8 * p = data.data();
+                for (quint64 j = 0; j < data.dataByteCount(); ++j)
+                {
+                    p[j] = j % 13 < 8 ? static_cast<quint8>(j / 64) : static_cast<quint8>(qrand());
+                }
+                std::vector<quint8> compressed;
+                Graphics::PixelDataUtil::compress(data, compressed);
+                DJV_DEBUG_PRINT("info = " << data.info());
+                DJV_DEBUG_PRINT("compressed = " << static_cast<quint64>(compressed.size()));
+                Graphics::PixelData decompressed(data.info());
+                DJV_ASSERT(Graphics::PixelDataUtil::decompress(compressed, decompressed));
+                DJV_ASSERT(0 == memcmp(
+                    data.data(),
+                    decompressed.data(),
+                    data.dataByteCount()));
+                compressed.resize(compressed.size() - 1);
+                DJV_ASSERT(!Graphics::PixelDataUtil::decompress(compressed, decompressed));
+            }
+            {
+                Graphics::PixelData data(Graphics::PixelDataInfo(256, 256, Graphics::Pixel::RGBA_U8));
+                data.zero();
+                std::vector<quint8> compressed;
+                Graphics::PixelDataUtil::compress(data, compressed);
+                DJV_ASSERT(compressed.size() < data.dataByteCount() / 100);
+                Graphics::PixelData wrongSize(Graphics::PixelDataInfo(128, 256, Graphics::Pixel::RGBA_U8));
+                DJV_ASSERT(!Graphics::PixelDataUtil::decompress(compressed, wrongSize));
             }
         }
 
@@ -44,6 +44,7 @@ namespace djv
             void byteCount();
             void proxy();
             void interleave();
+            void compress();
             void gradient();
             void qt();
         };
@@ -0,0 +1,177 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+#pragma once
+#include <djvGraphicsTest/ReviewCacheTest.h>
+
+#include <djvGraphics/GraphicsContext.h>
+#include <djvGraphics/Image.h>
+#include <djvGraphics/ImageIO.h>
+#include <djvGraphics/PixelDataUtil.h>
+#include <djvGraphics/ReviewCache.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/ErrorUtil.h>
+#include <djvCore/FileInfo.h>
+#include <djvCore/FileIO.h>
+
+#include <QFile>
+#include <QFileInfo>
+#include <QScopedPointer>
+
+#include <string.h>
+
+using namespace djv::Core;
+using namespace djv::Graphics;
+
+namespace djv
+{
+    namespace GraphicsTest
+    {
+        void ReviewCacheTest::run(int & argc, char ** argv)
+        {
+            DJV_DEBUG("ReviewCacheTest::run");
+            resume(argc, argv);
+        }
+
+        void ReviewCacheTest::resume(int & argc, char ** argv)
+        {
+            DJV_DEBUG("ReviewCacheTest::resume");
+            Graphics::GraphicsContext context(argc, argv);
+            const QString fileName = "ReviewCacheTest.rvc";
+            const FileInfo fileInfo(fileName);
+            const Graphics::PixelDataInfo pixelDataInfo(64, 32, Graphics::Pixel::RGB_U8);
+            const quint64 dataByteCount = Graphics::PixelDataUtil::dataByteCount(pixelDataInfo);
+            const int frameCount = 4;
+            Graphics::ImageIOInfo info(pixelDataInfo);
+            info.sequence = Sequence(1, frameCount);
+            try
+            {
+                // Build the cache the way djv_convert does, skipping the frames
+                // that were already written. Each build fills the frames with
+                // a different value so the reused frames can be told apart from
+                // the rebuilt ones.
+                auto build = [&](int generation) -> FrameList
+                {
+                    FrameList out;
+                    QScopedPointer<Graphics::ImageSave> save(context.imageIOFactory()->save(fileInfo, info));
+                    DJV_ASSERT(save);
+                    for (qint64 frame = 1; frame <= frameCount; ++frame)
+                    {
+                        const Graphics::ImageIOFrameInfo frameInfo(frame);
+                        if (!save->hasFrame(frameInfo))
+                        {
+                            Graphics::Image image(pixelDataInfo);
+                            memset(image.data(), static_cast<int>(generation * 16 + frame), image.dataByteCount());
+                            save->write(image, frameInfo);
+                            out.append(frame);
+                        }
+                    }
+                    save->close();
+                    return out;
+                };
+                auto check = [&](const QVector<int> & generations)
+                {
+                    Graphics::ImageIOInfo loadInfo;
+                    QScopedPointer<Graphics::ImageLoad> load(context.imageIOFactory()->load(fileInfo, loadInfo));
+                    DJV_ASSERT(load);
+                    DJV_ASSERT(loadInfo.sequence.frames.count() == frameCount);
+                    for (qint64 frame = 1; frame <= frameCount; ++frame)
+                    {
+                        Graphics::Image image;
+                        load->read(image, Graphics::ImageIOFrameInfo(frame));
+                        DJV_ASSERT(image.dataByteCount() == dataByteCount);
+                        const quint8 value = static_cast<quint8>(generations[frame - 1] * 16 + frame);
+                        for (quint64 i = 0; i < dataByteCount; ++i)
+                        {
+                            DJV_ASSERT(image.data()[i] == value);
+                        }
+                    }
+                    load->close();
+                };
+
+                QFile::remove(fileName);
+                DJV_ASSERT((FrameList() << 1 << 2 << 3 << 4) == build(0));
+                check(QVector<int>() << 0 << 0 << 0 << 0);
+
+                // A complete cache is not written again.
+                DJV_ASSERT(build(1).isEmpty());
+                check(QVector<int>() << 0 << 0 << 0 << 0);
+
+                ReviewCache::Header header;
+                {
+                    FileIO io;
+                    io.setMmap(false);
+                    io.open(fileName, FileIO::READ);
+                    header.load(io);
+                }
+                DJV_ASSERT(static_cast<quint64>(QFileInfo(fileName).size()) == header.fileSize());
+
+                // Simulate an interrupted build: the second frame has its data
+                // but not its index entry, and the file ends in the middle of
+                // the third frame.
+                {
+                    QFile file(fileName);
+                    DJV_ASSERT(file.open(QIODevice::ReadWrite));
+                    DJV_ASSERT(file.seek(header.indexOffset() + ReviewCache::indexEntryByteCount));
+                    const QByteArray entry(static_cast<int>(ReviewCache::indexEntryByteCount), 0);
+                    DJV_ASSERT(file.write(entry) == entry.size());
+                    DJV_ASSERT(file.resize(header.frameOffset(2) + dataByteCount / 2));
+                }
+                try
+                {
+                    Graphics::ImageIOInfo loadInfo;
+                    QScopedPointer<Graphics::ImageLoad> load(context.imageIOFactory()->load(fileInfo, loadInfo));
+                    DJV_ASSERT(0);
+                }
+                catch (const Error & error)
+                {
+                    DJV_DEBUG_PRINT(ErrorUtil::format(error));
+                }
+
+                // The resumed build keeps the first frame and rebuilds the rest.
+                DJV_ASSERT((FrameList() << 2 << 3 << 4) == build(2));
+                DJV_ASSERT(static_cast<quint64>(QFileInfo(fileName).size()) == header.fileSize());
+                check(QVector<int>() << 0 << 2 << 2 << 2);
+
+                // A file truncated inside the frame index is rebuilt.
+                DJV_ASSERT(QFile::resize(fileName, header.indexOffset() + ReviewCache::indexEntryByteCount / 2));
+                DJV_ASSERT((FrameList() << 1 << 2 << 3 << 4) == build(3));
+                check(QVector<int>() << 3 << 3 << 3 << 3);
+            }
+            catch (const Error & error)
+            {
+                DJV_DEBUG_PRINT(ErrorUtil::format(error));
+                DJV_ASSERT(0);
+            }
+            QFile::remove(fileName);
+        }
+
+    } // namespace GraphicsTest
+} // namespace djv
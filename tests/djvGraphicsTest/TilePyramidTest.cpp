@@ -0,0 +1,214 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+#include <djvGraphicsTest/TilePyramidTest.h>
+
+#include <djvGraphics/TilePyramid.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/Math.h>
+#include <djvCore/MemoryBudget.h>
+
+using namespace djv::Core;
+using namespace djv::Graphics;
+
+namespace djv
+{
+    namespace GraphicsTest
+    {
+        void TilePyramidTest::run(int &, char **)
+        {
+            DJV_DEBUG("TilePyramidTest::run");
+            levels();
+            tiles();
+            endian();
+            memory();
+        }
+
+        void TilePyramidTest::levels()
+        {
+            DJV_DEBUG("TilePyramidTest::levels");
+            DJV_ASSERT(!TilePyramid::isTiled(PixelDataInfo(1920, 1080, Pixel::RGBA_U8)));
+            DJV_ASSERT(TilePyramid::isTiled(PixelDataInfo(16384, 8192, Pixel::RGBA_U8)));
+
+            PixelData data(PixelDataInfo(1201, 700, Pixel::L_U8));
+            for (int y = 0; y < data.h(); ++y)
+            {
+                for (int x = 0; x < data.w(); ++x)
+                {
+                    data.data(x, y)[0] = (x + y) % 2 ? 200 : 100;
+                }
+            }
+            TilePyramid pyramid;
+            pyramid.build(data);
+            DJV_ASSERT(pyramid.id() != 0);
+            DJV_ASSERT(3 == pyramid.levelCount());
+            DJV_ASSERT(1 == pyramid.levelsReady());
+            pyramid.buildLevels();
+            pyramid.wait();
+            DJV_ASSERT(!pyramid.isBuilding());
+            DJV_ASSERT(3 == pyramid.levelsReady());
+            DJV_ASSERT(glm::ivec2(1201, 700) == pyramid.levelSize(0));
+            DJV_ASSERT(glm::ivec2(601, 350) == pyramid.levelSize(1));
+            DJV_ASSERT(glm::ivec2(301, 175) == pyramid.levelSize(2));
+            DJV_ASSERT(glm::ivec2(3, 2) == pyramid.tileCount(0));
+            DJV_ASSERT(glm::ivec2(2, 1) == pyramid.tileCount(1));
+            DJV_ASSERT(glm::ivec2(1, 1) == pyramid.tileCount(2));
+            DJV_ASSERT(0 == pyramid.level(2.f));
+            DJV_ASSERT(0 == pyramid.level(.75f));
+            DJV_ASSERT(1 == pyramid.level(.5f));
+            DJV_ASSERT(2 == pyramid.level(.1f));
+
+            // The checkerboard averages to grey in the second level.
+            PixelData tile;
+            pyramid.tile(1, glm::ivec2(0, 0), tile);
+            DJV_ASSERT(150 == tile.data(10, 10)[0]);
+
+            // Releasing the levels keeps the first one, which is only close
+            // enough to be drawn at scales down to one half.
+            DJV_ASSERT(pyramid.hasLevel(.1f));
+            pyramid.releaseLevels();
+            DJV_ASSERT(1 == pyramid.levelsReady());
+            DJV_ASSERT(pyramid.hasLevel(1.f));
+            DJV_ASSERT(pyramid.hasLevel(.5f));
+            DJV_ASSERT(!pyramid.hasLevel(.1f));
+            pyramid.buildLevels();
+            pyramid.wait();
+            DJV_ASSERT(3 == pyramid.levelsReady());
+
+            const quint64 id = pyramid.id();
+            pyramid.build(data);
+            DJV_ASSERT(pyramid.id() != id);
+            DJV_ASSERT(1 == pyramid.levelsReady());
+            pyramid.clear();
+            DJV_ASSERT(0 == pyramid.levelCount());
+            DJV_ASSERT(0 == pyramid.levelsReady());
+        }
+
+        void TilePyramidTest::tiles()
+        {
+            DJV_DEBUG("TilePyramidTest::tiles");
+            PixelData data(PixelDataInfo(600, 520, Pixel::RGB_U16));
+            for (int y = 0; y < data.h(); ++y)
+            {
+                Pixel::U16_T * p = reinterpret_cast<Pixel::U16_T *>(data.data(0, y));
+                for (int x = 0; x < data.w(); ++x, p += 3)
+                {
+                    p[0] = x;
+                    p[1] = y;
+                    p[2] = 0;
+                }
+            }
+            TilePyramid pyramid;
+            pyramid.build(data);
+            const int size   = TilePyramid::tileSize;
+            const int border = TilePyramid::tileBorder;
+            DJV_ASSERT(Box2i(0, 0, size, size) == pyramid.tileArea(0, glm::ivec2(0, 0)));
+            DJV_ASSERT(Box2i(size, size, 600 - size, 520 - size) == pyramid.tileArea(0, glm::ivec2(1, 1)));
+
+            // The tiles include a border that is clamped to the edges.
+            PixelData tile;
+            pyramid.tile(0, glm::ivec2(1, 0), tile);
+            DJV_ASSERT(glm::ivec2(600 - size + border * 2, size + border * 2) == tile.size());
+            for (int y = 0; y < tile.h(); ++y)
+            {
+                const Pixel::U16_T * p = reinterpret_cast<const Pixel::U16_T *>(tile.data(0, y));
+                for (int x = 0; x < tile.w(); ++x, p += 3)
+                {
+                    DJV_ASSERT(Math::clamp(size - border + x, 0, 599) == p[0]);
+                    DJV_ASSERT(Math::clamp(y - border, 0, 519) == p[1]);
+                }
+            }
+        }
+
+        void TilePyramidTest::endian()
+        {
+            DJV_DEBUG("TilePyramidTest::endian");
+            PixelDataInfo info(2, 1, Pixel::L_U16);
+            info.endian = Memory::endianOpposite(Memory::endian());
+            PixelData data(info);
+            data.data(0, 0)[0] = 1;
+            data.data(0, 0)[1] = 2;
+            data.data(1, 0)[0] = 3;
+            data.data(1, 0)[1] = 4;
+            TilePyramid pyramid;
+            pyramid.build(data);
+            DJV_ASSERT(Memory::endian() == pyramid.info().endian);
+            PixelData tile;
+            pyramid.tile(0, glm::ivec2(0, 0), tile);
+            const int border = TilePyramid::tileBorder;
+            DJV_ASSERT(2 == tile.data(border, border)[0]);
+            DJV_ASSERT(1 == tile.data(border, border)[1]);
+            DJV_ASSERT(4 == tile.data(border + 1, border)[0]);
+            DJV_ASSERT(3 == tile.data(border + 1, border)[1]);
+        }
+
+        void TilePyramidTest::memory()
+        {
+            DJV_DEBUG("TilePyramidTest::memory");
+            MemoryBudget memoryBudget;
+            {
+                // Native endian pixel data is referenced, only the other levels
+                // are charged to the budget.
+                PixelData data(PixelDataInfo(1024, 1024, Pixel::L_U8));
+                data.zero();
+                TilePyramid pyramid(&memoryBudget);
+                pyramid.build(data);
+                DJV_ASSERT(0 == memoryBudget.usage());
+                PixelData tile;
+                pyramid.tile(0, glm::ivec2(0, 0), tile);
+                DJV_ASSERT(0 == tile.data(0, 0)[0]);
+                data.data(0, 0)[0] = 1;
+                pyramid.tile(0, glm::ivec2(0, 0), tile);
+                DJV_ASSERT(1 == tile.data(TilePyramid::tileBorder, TilePyramid::tileBorder)[0]);
+                pyramid.buildLevels();
+                pyramid.wait();
+                DJV_ASSERT(512 * 512 == memoryBudget.usage());
+
+                // The levels are released under memory pressure.
+                memoryBudget.setBudget(1);
+                memoryBudget.checkPressure();
+                DJV_ASSERT(1 == pyramid.levelsReady());
+                DJV_ASSERT(0 == memoryBudget.usage());
+                memoryBudget.setBudget(0);
+            }
+            {
+                // Pixel data that is not in the native endian is copied.
+                PixelDataInfo info(1024, 1024, Pixel::L_U16);
+                info.endian = Memory::endianOpposite(Memory::endian());
+                PixelData data(info);
+                TilePyramid pyramid(&memoryBudget);
+                pyramid.build(data);
+                DJV_ASSERT(data.dataByteCount() == memoryBudget.usage());
+            }
+            DJV_ASSERT(0 == memoryBudget.usage());
+        }
+
+    } // namespace GraphicsTest
+} // namespace djv
@@ -0,0 +1,60 @@
+# Test that "djv_info -verify" reports images that cannot be opened, both
+# when they are given on the command line and when they are found by walking
+# a directory.
+
+file(REMOVE_RECURSE ${TEST_DIR})
+file(MAKE_DIRECTORY ${TEST_DIR}/sub)
+file(WRITE ${TEST_DIR}/good.ppm "P3\n1 1\n255\n0 0 0\n")
+file(WRITE ${TEST_DIR}/sub/bad.ppm "This is not an image.\n")
+file(WRITE ${TEST_DIR}/sub/readme.txt "This is not an image either.\n")
+
+function(djv_info_verify result output)
+    execute_process(
+        COMMAND ${DJV_INFO} ${ARGN}
+        RESULT_VARIABLE _result
+        OUTPUT_VARIABLE _output
+        ERROR_VARIABLE _error)
+    set(${result} ${_result} PARENT_SCOPE)
+    set(${output} "${_output}${_error}" PARENT_SCOPE)
+endfunction()
+
+# A valid image.
+djv_info_verify(result output ${TEST_DIR}/good.ppm -verify)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Valid image failed to verify:\n${output}")
+endif()
+
+# An invalid image on the command line.
+djv_info_verify(result output ${TEST_DIR}/sub/bad.ppm -verify)
+if(result EQUAL 0)
+    message(FATAL_ERROR "Invalid image verified:\n${output}")
+endif()
+if(NOT output MATCHES "bad\\.ppm")
+    message(FATAL_ERROR "Invalid image not reported:\n${output}")
+endif()
+
+# An invalid image in a walked directory. Files that are not images are
+# skipped.
+djv_info_verify(result output ${TEST_DIR} -recurse -verify)
+if(result EQUAL 0)
+    message(FATAL_ERROR "Directory with an invalid image verified:\n${output}")
+endif()
+if(NOT output MATCHES "bad\\.ppm")
+    message(FATAL_ERROR "Invalid image in directory not reported:\n${output}")
+endif()
+if(NOT output MATCHES "good\\.ppm")
+    message(FATAL_ERROR "Valid image in directory not reported:\n${output}")
+endif()
+if(output MATCHES "readme\\.txt")
+    message(FATAL_ERROR "Non-image file reported:\n${output}")
+endif()
+
+# Stop at the first error, so only one of the invalid images is reported.
+file(WRITE ${TEST_DIR}/sub/broken.ppm "This is not an image.\n")
+djv_info_verify(result output ${TEST_DIR} -recurse -verify_stop)
+if(result EQUAL 0)
+    message(FATAL_ERROR "Directory with invalid images verified:\n${output}")
+endif()
+if(output MATCHES "bad\\.ppm" AND output MATCHES "broken\\.ppm")
+    message(FATAL_ERROR "Verify did not stop at the first error:\n${output}")
+endif()
@@ -27,6 +27,9 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 
+#include <djvUITest/FileBrowserModelTest.h>
+
+#include <djvGraphicsTest/ColorPipelineTest.h>
 #include <djvGraphicsTest/ColorProfileTest.h>
 #include <djvGraphicsTest/ColorTest.h>
 #include <djvGraphicsTest/ColorUtilTest.h>
@@ -40,18 +43,24 @@
 #include <djvGraphicsTest/PixelDataTest.h>
 #include <djvGraphicsTest/PixelDataUtilTest.h>
 #include <djvGraphicsTest/PixelTest.h>
+#include <djvGraphicsTest/ReviewCacheTest.h>
+#include <djvGraphicsTest/TilePyramidTest.h>
 
 #include <djvCoreTest/BoxTest.h>
 #include <djvCoreTest/BoxUtilTest.h>
 #include <djvCoreTest/CoreContextTest.h>
+#include <djvCoreTest/DebugLogTest.h>
 #include <djvCoreTest/DebugTest.h>
+#include <djvCoreTest/DirectoryWalkTest.h>
 #include <djvCoreTest/ErrorTest.h>
 #include <djvCoreTest/FileInfoTest.h>
 #include <djvCoreTest/FileInfoUtilTest.h>
 #include <djvCoreTest/FileIOTest.h>
 #include <djvCoreTest/FileIOUtilTest.h>
+#include <djvCoreTest/FileWatcherTest.h>
 #include <djvCoreTest/ListUtilTest.h>
 #include <djvCoreTest/MathTest.h>
+#include <djvCoreTest/MemoryBudgetTest.h>
 #include <djvCoreTest/MemoryTest.h>
 #include <djvCoreTest/RangeTest.h>
 #include <djvCoreTest/SequenceTest.h>
@@ -61,6 +70,8 @@
 #include <djvCoreTest/SystemTest.h>
 #include <djvCoreTest/TimeTest.h>
 #include <djvCoreTest/TimerTest.h>
+#include <djvCoreTest/TimingStatsTest.h>
+#include <djvCoreTest/TraceTest.h>
 #include <djvCoreTest/UserTest.h>
 #include <djvCoreTest/VectorUtilTest.h>
 
@@ -83,14 +94,18 @@ int main(int argc, char ** argv)
             new CoreTest::BoxTest <<
             new CoreTest::BoxUtilTest <<
             new CoreTest::CoreContextTest <<
+            new CoreTest::DebugLogTest <<
             new CoreTest::DebugTest <<
+            new CoreTest::DirectoryWalkTest <<
             new CoreTest::ErrorTest <<
             new CoreTest::FileInfoTest <<
             new CoreTest::FileInfoUtilTest <<
             new CoreTest::FileIOTest <<
             new CoreTest::FileIOUtilTest <<
+            new CoreTest::FileWatcherTest <<
             new CoreTest::ListUtilTest <<
             new CoreTest::MathTest <<
+            new CoreTest::MemoryBudgetTest <<
             new CoreTest::MemoryTest <<
             new CoreTest::RangeTest <<
             new CoreTest::SequenceTest <<
@@ -100,9 +115,12 @@ int main(int argc, char ** argv)
             new CoreTest::SystemTest <<
             new CoreTest::TimeTest <<
             new CoreTest::TimerTest <<
+            new CoreTest::TimingStatsTest <<
+            new CoreTest::TraceTest <<
             new CoreTest::UserTest <<
             new CoreTest::VectorUtilTest <<
 
+            new GraphicsTest::ColorPipelineTest <<
             new GraphicsTest::ColorProfileTest <<
             new GraphicsTest::ColorTest <<
             new GraphicsTest::ColorUtilTest <<
@@ -115,7 +133,11 @@ int main(int argc, char ** argv)
             new GraphicsTest::OpenGLTest <<
             new GraphicsTest::PixelDataTest <<
             new GraphicsTest::PixelDataUtilTest <<
-            new GraphicsTest::PixelTest;
+            new GraphicsTest::PixelTest <<
+            new GraphicsTest::ReviewCacheTest <<
+            new GraphicsTest::TilePyramidTest <<
+
+            new UITest::FileBrowserModelTest;
 
         for (int i = 0; i < tests.count(); ++i)
         {
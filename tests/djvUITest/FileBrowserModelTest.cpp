@@ -0,0 +1,99 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2018 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvUITest/FileBrowserModelTest.h>
+
+#include <djvUI/FileBrowserModel.h>
+#include <djvUI/UIContext.h>
+
+#include <djvCore/Assert.h>
+#include <djvCore/Debug.h>
+#include <djvCore/Timer.h>
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+
+using namespace djv::Core;
+using namespace djv::UI;
+
+namespace djv
+{
+    namespace UITest
+    {
+        void FileBrowserModelTest::run(int & argc, char ** argv)
+        {
+            DJV_DEBUG("FileBrowserModelTest::run");
+            const QString root = "FileBrowserModelTest";
+            QDir(root).removeRecursively();
+            QDir().mkpath(root + "/a");
+            QDir().mkpath(root + "/b");
+            {
+                QFile file(root + "/b/file.txt");
+                file.open(QIODevice::WriteOnly);
+                file.write("b");
+            }
+            {
+                UIContext context(argc, argv);
+                FileBrowserModel model(&context);
+                DJV_ASSERT(!model.isBusy());
+
+                // Several directory listings requested back to back are
+                // coalesced, and the model goes idle once the last one is
+                // done.
+                model.setPath(root + "/a/");
+                model.reload();
+                model.setPath(root + "/");
+                model.reload();
+                model.setPath(root + "/b/");
+                model.reload();
+                DJV_ASSERT(model.isBusy());
+                Timer timer;
+                timer.start();
+                while (model.isBusy() && timer.seconds() < 5.f)
+                {
+                    QCoreApplication::processEvents();
+                    timer.check();
+                }
+                DJV_ASSERT(!model.isBusy());
+                bool found = false;
+                Q_FOREACH(const FileInfo & fileInfo, model.contents())
+                {
+                    if (fileInfo.fileName(-1, false) == "file.txt")
+                    {
+                        found = true;
+                    }
+                }
+                DJV_ASSERT(found);
+            }
+            QDir(root).removeRecursively();
+        }
+
+    } // namespace UITest
+} // namespace djv